@@ -987,6 +987,20 @@ extern DECLSPEC int SDLCALL SDL_ConvertAudio(SDL_AudioCVT * cvt);
 struct _SDL_AudioStream;
 typedef struct _SDL_AudioStream SDL_AudioStream;
 
+/**
+ * The filters an audio stream can resample with, from cheapest to best
+ * sounding.
+ *
+ * \sa SDL_AudioStreamSetResampleQuality
+ */
+typedef enum
+{
+    SDL_AUDIO_RESAMPLE_ZERO_ORDER_HOLD, /**< Repeat the nearest earlier sample, no added latency */
+    SDL_AUDIO_RESAMPLE_LINEAR,          /**< Linear interpolation between two samples */
+    SDL_AUDIO_RESAMPLE_CUBIC,           /**< Cubic (Catmull-Rom) interpolation over four samples, suits low latency voice */
+    SDL_AUDIO_RESAMPLE_HIGH             /**< Windowed sinc, the default */
+} SDL_AudioResampleQuality;
+
 /**
  * Create a new audio stream.
  *
@@ -1103,6 +1117,43 @@ extern DECLSPEC int SDLCALL SDL_AudioStreamFlush(SDL_AudioStream *stream);
  */
 extern DECLSPEC void SDLCALL SDL_AudioStreamClear(SDL_AudioStream *stream);
 
+/**
+ * Choose the filter an audio stream resamples with.
+ *
+ * Cheaper filters take less CPU time and hold back fewer samples between
+ * SDL_AudioStreamPut() and SDL_AudioStreamGet(), at the cost of more
+ * aliasing. New streams use SDL_AUDIO_RESAMPLE_HIGH, which is also the only
+ * quality that honors SDL_HINT_AUDIO_RESAMPLING_MODE.
+ *
+ * Input that the resampler is still holding back is discarded when the
+ * quality changes, so call SDL_AudioStreamFlush() first to keep it. Data
+ * that is already available from SDL_AudioStreamGet() is not affected.
+ *
+ * \param stream the audio stream to change
+ * \param quality an SDL_AudioResampleQuality value
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_AudioStreamGetResampleQuality
+ * \sa SDL_NewAudioStream
+ */
+extern DECLSPEC int SDLCALL SDL_AudioStreamSetResampleQuality(SDL_AudioStream *stream, SDL_AudioResampleQuality quality);
+
+/**
+ * Get the filter an audio stream resamples with.
+ *
+ * \param stream the audio stream to query
+ * \returns the stream's SDL_AudioResampleQuality, or
+ *          SDL_AUDIO_RESAMPLE_HIGH if `stream` is NULL.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_AudioStreamSetResampleQuality
+ */
+extern DECLSPEC SDL_AudioResampleQuality SDLCALL SDL_AudioStreamGetResampleQuality(SDL_AudioStream *stream);
+
 /**
  * Free an audio stream
  *
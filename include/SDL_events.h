@@ -912,6 +912,52 @@ extern DECLSPEC void SDLCALL SDL_FlushEvents(Uint32 minType, Uint32 maxType);
  */
 extern DECLSPEC int SDLCALL SDL_PollEvent(SDL_Event * event);
 
+/**
+ * Poll for currently pending events, retrieving as many as fit in one call.
+ *
+ * This pumps the event loop once, like SDL_PollEvent(), and then removes up
+ * to `numevents` events from the front of the queue in a single pass. This
+ * is much cheaper than calling SDL_PollEvent() in a loop when a frame has
+ * lots of input events, such as high frequency mouse or touch motion.
+ *
+ * Every call pumps the event loop and returns the events that are queued at
+ * that point, events that are added while the application is handling the
+ * batch are returned by the next call. A batch that is shorter than
+ * `numevents` got all of them, so a loop that stops there ends even while
+ * new events keep arriving. The calls are independent of each other and can
+ * be mixed with SDL_PollEvent().
+ *
+ * As this function may implicitly call SDL_PumpEvents(), you can only call
+ * this function in the thread that set the video mode.
+ *
+ * ```c
+ * while (game_is_still_running) {
+ *     SDL_Event events[64];
+ *     int i, count;
+ *     do {
+ *         count = SDL_PollEvents(events, SDL_arraysize(events));
+ *         for (i = 0; i < count; ++i) {
+ *             // decide what to do with events[i].
+ *         }
+ *     } while (count == SDL_arraysize(events));
+ *
+ *     // update game state, draw the current frame
+ * }
+ * ```
+ *
+ * \param events destination buffer for the retrieved events.
+ * \param numevents the maximum number of events to retrieve.
+ * \returns the number of events stored in `events`, 0 if there are none
+ *          available, or -1 on error; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_PeepEvents
+ * \sa SDL_PollEvent
+ */
+extern DECLSPEC int SDLCALL SDL_PollEvents(SDL_Event * events, int numevents);
+
 /**
  * Wait indefinitely for the next available event.
  *
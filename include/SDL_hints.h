@@ -427,6 +427,32 @@ extern "C" {
  */
 #define SDL_HINT_ENABLE_SCREEN_KEYBOARD "SDL_ENABLE_SCREEN_KEYBOARD"
 
+/**
+ * A variable controlling whether consecutive motion events are merged in the
+ * event queue.
+ *
+ * When enabled, an SDL_MOUSEMOTION, SDL_FINGERMOTION or
+ * SDL_CONTROLLERSENSORUPDATE event is folded into the newest queued event if
+ * that event has the same type and comes from the same window, device,
+ * finger or sensor. The merged event carries the latest position and the sum
+ * of the relative motion (xrel/yrel, dx/dy), so no movement is lost. Any
+ * other event, such as a button press, ends the run and is never reordered
+ * with respect to the motion around it.
+ *
+ * This can greatly reduce the number of events an application has to process
+ * with high polling rate mice or touch screens.
+ *
+ * This variable can be set to the following values:
+ *
+ * - "0": Every motion event is queued separately (default)
+ * - "1": Consecutive motion events from the same source are merged
+ *
+ * This hint can be changed at any time.
+ *
+ * This hint is available since SDL 2.32.0.
+ */
+#define SDL_HINT_EVENT_COALESCE_MOTION "SDL_EVENT_COALESCE_MOTION"
+
 /**
  * A variable controlling verbosity of the logging of SDL events pushed onto
  * the internal queue.
@@ -677,6 +703,36 @@ extern "C" {
  */
 #define SDL_HINT_IOS_HIDE_HOME_INDICATOR "SDL_IOS_HIDE_HOME_INDICATOR"
 
+/**
+ * A variable controlling how many threads run the jobs of SDL_RunJob() and
+ * SDL_ParallelFor()
+ *
+ * This variable can be set to the following values:
+ *
+ * - "0": Don't start any job threads, SDL_RunJob() runs each job right away
+ *   on the calling thread, and a job waiting for a counter runs on the
+ *   thread that finishes the counter's last job
+ * - A number: Start that many job threads
+ *
+ * The variable is checked when the first job is run. By default there is one
+ * job thread less than there are CPU cores, so none on single core machines.
+ */
+#define SDL_HINT_JOB_THREADS "SDL_JOB_THREADS"
+
+/**
+ * A variable setting the priority of the job threads
+ *
+ * This variable can be set to the following values:
+ *
+ * - "low": Run jobs at SDL_THREAD_PRIORITY_LOW
+ * - "normal": Run jobs at SDL_THREAD_PRIORITY_NORMAL (default)
+ * - "high": Run jobs at SDL_THREAD_PRIORITY_HIGH
+ * - "time_critical": Run jobs at SDL_THREAD_PRIORITY_TIME_CRITICAL
+ *
+ * The variable is checked when the first job is run.
+ */
+#define SDL_HINT_JOB_THREAD_PRIORITY "SDL_JOB_THREAD_PRIORITY"
+
 /**
  * A variable that lets you enable joystick (and gamecontroller) events even
  * when your app is in the background.
@@ -1948,6 +2004,27 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_SCALE_QUALITY       "SDL_RENDER_SCALE_QUALITY"
 
+/**
+ * A variable controlling how many threads the software renderer uses
+ *
+ * This variable can be set to the following values:
+ *
+ * - "0" or "1": Render on the calling thread only
+ * - A number greater than 1: Split the render target into that many bands of
+ *   rows and render each band on its own thread
+ *
+ * Every thread replays the whole batch of render commands clipped to its
+ * band, so the output is identical to rendering on a single thread. Commands
+ * that can't be split exactly, like scaled copies and lines that cross a band
+ * boundary or rotated copies, are rendered on the calling thread while the
+ * other threads wait. Textures used while this is enabled no longer use RLE
+ * acceleration.
+ *
+ * The variable is checked every time the software renderer flushes its
+ * command queue. By default the software renderer uses a single thread.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_THREADS    "SDL_RENDER_SOFTWARE_THREADS"
+
 /**
  * A variable controlling whether updates to the SDL screen surface should be
  * synchronized with the vertical refresh, to avoid tearing.
@@ -2060,6 +2137,27 @@ extern "C" {
  */
 #define SDL_HINT_SCREENSAVER_INHIBIT_ACTIVITY_NAME "SDL_SCREENSAVER_INHIBIT_ACTIVITY_NAME"
 
+/**
+ * A variable controlling how many threads are used to convert large images
+ *
+ * This variable can be set to the following values:
+ *
+ * - "0" or "1": Convert on the calling thread only
+ * - A number greater than 1: Split large images into up to that many bands of
+ *   rows and convert each band on its own thread
+ *
+ * This applies to SDL_ConvertSurface(), SDL_ConvertSurfaceFormat(),
+ * SDL_DuplicateSurface(), SDL_ConvertPixels() including conversions between
+ * YUV and RGB formats, and SDL_PremultiplyAlpha(). Small images and
+ * conversions that are started while another one is using the threads are
+ * always done on the calling thread. The result is the same whichever way
+ * the image was converted.
+ *
+ * The variable is checked on every conversion. By default images are
+ * converted on the calling thread.
+ */
+#define SDL_HINT_SURFACE_CONVERT_THREADS "SDL_SURFACE_CONVERT_THREADS"
+
 /**
  * Specifies whether SDL_THREAD_PRIORITY_TIME_CRITICAL should be treated as
  * realtime.
@@ -393,6 +393,60 @@ extern DECLSPEC void SDLCALL SDL_LogGetOutputFunction(SDL_LogOutputFunction *cal
  */
 extern DECLSPEC void SDLCALL SDL_LogSetOutputFunction(SDL_LogOutputFunction callback, void *userdata);
 
+/**
+ * Turn asynchronous logging on or off.
+ *
+ * Normally the output function runs on the thread that logs the message,
+ * one thread at a time, so a slow output function holds up every thread
+ * that logs. In asynchronous mode messages are formatted into a ring of
+ * preallocated slots and a background thread passes them to the output
+ * function, in the order they were logged. Logging never waits: when the
+ * ring is full the message is dropped and counted, see
+ * SDL_LogGetDroppedCount().
+ *
+ * Turning it off flushes the messages that are still waiting, after the
+ * threads that are in the middle of logging one are done. SDL_Quit() does
+ * the same.
+ *
+ * \param async SDL_TRUE to log asynchronously, SDL_FALSE to call the output
+ *              function directly again.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_LogFlush
+ * \sa SDL_LogGetDroppedCount
+ */
+extern DECLSPEC int SDLCALL SDL_LogSetAsync(SDL_bool async);
+
+/**
+ * Pass every waiting asynchronous log message to the output function now.
+ *
+ * This runs the output function on the calling thread and returns once the
+ * messages logged before the call are out, except ones another thread is
+ * still in the middle of logging. Call it before changing the output
+ * function, or from a crash handler to get the last messages out. It does
+ * nothing if logging isn't asynchronous.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_LogSetAsync
+ */
+extern DECLSPEC void SDLCALL SDL_LogFlush(void);
+
+/**
+ * Get the number of log messages dropped because the asynchronous ring was
+ * full.
+ *
+ * \returns the number of dropped messages since the program started.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_LogSetAsync
+ */
+extern DECLSPEC int SDLCALL SDL_LogGetDroppedCount(void);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
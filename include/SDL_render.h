@@ -96,6 +96,49 @@ typedef struct SDL_Vertex
     SDL_FPoint tex_coord;       /**< Normalized texture coordinates, if needed */
 } SDL_Vertex;
 
+/**
+ * Counts of the work a renderer did during one frame.
+ *
+ * Draw calls are counted by the software, OpenGL and OpenGL ES 2 renderers,
+ * texture binds by the OpenGL and OpenGL ES 2 renderers and program switches
+ * by the OpenGL ES 2 renderer. The other renderers leave them at zero.
+ *
+ * The pool fields at the end aren't per frame: they describe the command
+ * array and vertex buffer the renderer reuses from batch to batch, since the
+ * renderer was created.
+ *
+ * \sa SDL_RenderGetStats
+ */
+typedef struct SDL_RenderStats
+{
+    Uint32 flushes;                 /**< Times the queued commands were sent to the backend */
+    Uint32 commands;                /**< Commands sent, all of the types below together */
+    Uint32 set_viewport_commands;
+    Uint32 set_cliprect_commands;
+    Uint32 set_draw_color_commands;
+    Uint32 clear_commands;
+    Uint32 draw_points_commands;
+    Uint32 draw_lines_commands;
+    Uint32 fill_rects_commands;
+    Uint32 copy_commands;
+    Uint32 copy_ex_commands;
+    Uint32 geometry_commands;
+    Uint32 merged_copies;           /**< Texture copies appended to the previous copy's geometry */
+    Uint32 max_batch_commands;      /**< Most commands sent at once */
+    Uint32 draw_calls;              /**< Draw calls made to the underlying API */
+    Uint32 texture_binds;           /**< Texture changes in the underlying API */
+    Uint32 program_switches;        /**< Shader program changes (OpenGL ES 2) */
+    Uint64 vertex_bytes;            /**< Vertex data queued by the commands */
+    Uint64 max_batch_vertex_bytes;  /**< Most vertex data sent at once */
+    Uint64 texture_upload_bytes;    /**< Pixel data passed to the backend by texture updates and unlocks */
+    Uint64 flush_ns;                /**< Nanoseconds spent sending commands to the backend */
+    Uint32 command_pool_size;       /**< Commands the command array has room for */
+    Uint32 command_pool_high_water; /**< Most commands queued in one batch */
+    Uint32 command_pool_grows;      /**< Times the command array was enlarged */
+    Uint64 vertex_pool_size;        /**< Bytes the vertex buffer has room for */
+    Uint64 vertex_pool_high_water;  /**< Most vertex data queued in one batch */
+} SDL_RenderStats;
+
 /**
  * The scaling mode for a texture.
  */
@@ -148,6 +191,14 @@ typedef struct SDL_Renderer SDL_Renderer;
 struct SDL_Texture;
 typedef struct SDL_Texture SDL_Texture;
 
+/**
+ * A set of textures that many small images are packed into
+ *
+ * \sa SDL_CreateTextureAtlas
+ */
+struct SDL_TextureAtlas;
+typedef struct SDL_TextureAtlas SDL_TextureAtlas;
+
 /* Function prototypes */
 
 /**
@@ -1921,6 +1972,141 @@ extern DECLSPEC void *SDLCALL SDL_RenderGetMetalCommandEncoder(SDL_Renderer * re
  */
 extern DECLSPEC int SDLCALL SDL_RenderSetVSync(SDL_Renderer* renderer, int vsync);
 
+/**
+ * Get the counts of the work the renderer did for the last presented frame.
+ *
+ * The counts cover everything from the previous call to SDL_RenderPresent()
+ * up to and including the last one, so the final flush of a frame is part
+ * of it. They are all zero until the first frame is presented.
+ *
+ * \param renderer the rendering context.
+ * \param stats an SDL_RenderStats structure filled in with the counts.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_RenderPresent
+ */
+extern DECLSPEC int SDLCALL SDL_RenderGetStats(SDL_Renderer * renderer, SDL_RenderStats * stats);
+
+/**
+ * Create a texture atlas, which packs small images into a few large
+ * textures so they can be drawn without switching textures.
+ *
+ * The atlas creates pages of `page_width` by `page_height` pixels as images
+ * are added. Each image is surrounded by a copy of its edge pixels, so it
+ * can be as large as a page minus 2 pixels on each side. Once the atlas has
+ * `max_pages` pages and they are full, adding an image evicts all the
+ * images of the page that was least recently used, and their IDs stop
+ * working. Pass 0 for `max_pages` to never evict images.
+ *
+ * The page textures use SDL_BLENDMODE_BLEND. Their blend mode, color and
+ * alpha modulation and scale mode can be changed, but they apply to every
+ * image in the page.
+ *
+ * The atlas must be destroyed before its renderer.
+ *
+ * \param renderer the rendering context.
+ * \param format the pixel format of the pages, one of the enumerated values
+ *               in SDL_PixelFormatEnum, or 0 for SDL_PIXELFORMAT_ARGB8888.
+ *               YUV and palettized formats aren't supported.
+ * \param page_width the width of each page in pixels.
+ * \param page_height the height of each page in pixels.
+ * \param max_pages the number of pages before images are evicted, or 0.
+ * \returns the new texture atlas or NULL on failure; call SDL_GetError()
+ *          for more information.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_AddTextureAtlasImage
+ * \sa SDL_DestroyTextureAtlas
+ */
+extern DECLSPEC SDL_TextureAtlas *SDLCALL SDL_CreateTextureAtlas(SDL_Renderer * renderer, Uint32 format, int page_width, int page_height, int max_pages);
+
+/**
+ * Copy a surface into a texture atlas.
+ *
+ * The pixels are copied as they are, the surface's blend mode and color and
+ * alpha modulation are ignored.
+ *
+ * \param atlas the texture atlas.
+ * \param surface the image to add.
+ * \returns a positive ID for the image on success or a negative error code
+ *          on failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_QueryTextureAtlasImage
+ * \sa SDL_RemoveTextureAtlasImage
+ * \sa SDL_UpdateTextureAtlasImage
+ */
+extern DECLSPEC int SDLCALL SDL_AddTextureAtlasImage(SDL_TextureAtlas * atlas, SDL_Surface * surface);
+
+/**
+ * Replace the pixels of an image in a texture atlas.
+ *
+ * \param atlas the texture atlas.
+ * \param id the image ID returned by SDL_AddTextureAtlasImage().
+ * \param surface the new pixels, the same size as the image.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_AddTextureAtlasImage
+ */
+extern DECLSPEC int SDLCALL SDL_UpdateTextureAtlasImage(SDL_TextureAtlas * atlas, int id, SDL_Surface * surface);
+
+/**
+ * Get where an image is in a texture atlas.
+ *
+ * The texture and rectangle can be passed to SDL_RenderCopy() as the
+ * texture and source rectangle, or turned into texture coordinates for
+ * SDL_RenderGeometry(). The image counts as used, which keeps its page from
+ * being evicted before the pages that weren't used since.
+ *
+ * \param atlas the texture atlas.
+ * \param id the image ID returned by SDL_AddTextureAtlasImage().
+ * \param texture a pointer filled in with the page texture, may be NULL.
+ * \param rect a pointer filled in with the image's place in the page, may be
+ *             NULL.
+ * \returns 0 on success or a negative error code if the ID is invalid or
+ *          the image was removed or evicted; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_AddTextureAtlasImage
+ */
+extern DECLSPEC int SDLCALL SDL_QueryTextureAtlasImage(SDL_TextureAtlas * atlas, int id, SDL_Texture ** texture, SDL_Rect * rect);
+
+/**
+ * Remove an image from a texture atlas, making its space available to new
+ * images.
+ *
+ * \param atlas the texture atlas.
+ * \param id the image ID returned by SDL_AddTextureAtlasImage().
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_AddTextureAtlasImage
+ */
+extern DECLSPEC int SDLCALL SDL_RemoveTextureAtlasImage(SDL_TextureAtlas * atlas, int id);
+
+/**
+ * Destroy a texture atlas and its page textures.
+ *
+ * \param atlas the texture atlas.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_CreateTextureAtlas
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyTextureAtlas(SDL_TextureAtlas * atlas);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
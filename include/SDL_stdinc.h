@@ -501,6 +501,98 @@ extern DECLSPEC int SDLCALL SDL_SetMemoryFunctions(SDL_malloc_func malloc_func,
  */
 extern DECLSPEC int SDLCALL SDL_GetNumAllocations(void);
 
+/**
+ * The subsystems that SDL's own allocations are charged to.
+ *
+ * Allocations the application makes with SDL_malloc() and everything SDL
+ * doesn't charge to a subsystem count as SDL_MEMORY_TAG_OTHER.
+ *
+ * \since This enum is available since SDL 2.32.0.
+ *
+ * \sa SDL_GetMemoryStats
+ */
+typedef enum
+{
+    SDL_MEMORY_TAG_OTHER,
+    SDL_MEMORY_TAG_EVENTS,  /**< the event queue and event watchers */
+    SDL_MEMORY_TAG_VIDEO,   /**< surface pixels, including software renderer textures */
+    SDL_MEMORY_TAG_RENDER,  /**< renderers, textures and their command buffers */
+    SDL_MEMORY_TAG_AUDIO,   /**< audio devices, streams and queued audio */
+    SDL_NUM_MEMORY_TAGS
+} SDL_MemoryTag;
+
+/**
+ * What is allocated under one memory tag.
+ *
+ * \since This struct is available since SDL 2.32.0.
+ *
+ * \sa SDL_GetMemoryStats
+ */
+typedef struct SDL_MemoryStats
+{
+    size_t live_bytes;        /**< bytes allocated and not freed yet */
+    size_t peak_bytes;        /**< the most live bytes there have been */
+    int live_allocations;     /**< allocations not freed yet */
+    Uint64 total_allocations; /**< allocations made since tracking started */
+} SDL_MemoryStats;
+
+/**
+ * Start keeping memory statistics for each SDL_MemoryTag.
+ *
+ * With tracking on, every allocation made through SDL_malloc(),
+ * SDL_calloc() and SDL_realloc() carries a small header with its size and
+ * tag, so this has to be called before SDL allocates any memory, usually
+ * first thing in main(). Tracking can't be turned off again. Without it,
+ * allocations cost what they did before.
+ *
+ * \returns 0 on success or a negative error code if SDL has already
+ *          allocated memory; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_GetMemoryStats
+ * \sa SDL_LogMemoryStats
+ */
+extern DECLSPEC int SDLCALL SDL_EnableMemoryTracking(void);
+
+/**
+ * Get the memory statistics of a tag.
+ *
+ * This takes a lock for a moment and doesn't allocate, so it can be called
+ * every frame.
+ *
+ * \param tag the SDL_MemoryTag to query.
+ * \param stats filled in with the statistics of the tag.
+ * \returns 0 on success or a negative error code if memory tracking isn't
+ *          enabled; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_EnableMemoryTracking
+ * \sa SDL_GetMemoryTagName
+ */
+extern DECLSPEC int SDLCALL SDL_GetMemoryStats(SDL_MemoryTag tag, SDL_MemoryStats *stats);
+
+/**
+ * Get a short human readable name for a memory tag, like "audio".
+ *
+ * \param tag the SDL_MemoryTag.
+ * \returns the name of the tag, or NULL if it isn't valid.
+ *
+ * \since This function is available since SDL 2.32.0.
+ */
+extern DECLSPEC const char *SDLCALL SDL_GetMemoryTagName(SDL_MemoryTag tag);
+
+/**
+ * Log the memory statistics of every tag with SDL_Log().
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_EnableMemoryTracking
+ * \sa SDL_GetMemoryStats
+ */
+extern DECLSPEC void SDLCALL SDL_LogMemoryStats(void);
+
 extern DECLSPEC char *SDLCALL SDL_getenv(const char *name);
 extern DECLSPEC int SDLCALL SDL_setenv(const char *name, const char *value, int overwrite);
 
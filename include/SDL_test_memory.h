@@ -40,7 +40,9 @@ extern "C" {
 /*
  * \brief Start tracking SDL memory allocations
  * 
- * \note This should be called before any other SDL functions for complete tracking coverage
+ * \note This should be called before any other SDL functions for complete tracking coverage.
+ *       Then it also turns on SDL_EnableMemoryTracking(), the log reports the outstanding
+ *       allocations of each SDL_MemoryTag and the sizes include SDL's header.
  */
 int SDLTest_TrackAllocations(void);
 
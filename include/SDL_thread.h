@@ -457,6 +457,155 @@ extern DECLSPEC int SDLCALL SDL_TLSSet(SDL_TLSID id, const void *value, SDL_TLSD
  */
 extern DECLSPEC void SDLCALL SDL_TLSCleanup(void);
 
+/**
+ * A counter of unfinished jobs, see SDL_RunJob().
+ *
+ * \since This struct is available since SDL 2.32.0.
+ */
+typedef struct SDL_JobCounter SDL_JobCounter;
+
+/**
+ * The function run by a job.
+ *
+ * \param userdata what was passed as `userdata` to SDL_RunJob().
+ *
+ * \since This datatype is available since SDL 2.32.0.
+ *
+ * \sa SDL_RunJob
+ */
+typedef void (SDLCALL * SDL_JobFunction) (void *userdata);
+
+/**
+ * The function run on each part of an SDL_ParallelFor() range.
+ *
+ * \param userdata what was passed as `userdata` to SDL_ParallelFor().
+ * \param first the first index of this part.
+ * \param end the index after the last one of this part.
+ *
+ * \since This datatype is available since SDL 2.32.0.
+ *
+ * \sa SDL_ParallelFor
+ */
+typedef void (SDLCALL * SDL_ParallelForFunction) (void *userdata, int first, int end);
+
+/**
+ * Create a counter to wait for a group of jobs.
+ *
+ * A counter starts at zero. SDL_RunJob() adds one for each job it is given
+ * and the job takes it away again once it has run.
+ *
+ * \returns the new counter or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_DestroyJobCounter
+ * \sa SDL_RunJob
+ * \sa SDL_WaitJobCounter
+ */
+extern DECLSPEC SDL_JobCounter * SDLCALL SDL_CreateJobCounter(void);
+
+/**
+ * Run a function on SDL's shared pool of job threads.
+ *
+ * The pool is started the first time it is needed, with one thread less than
+ * there are CPU cores unless SDL_HINT_JOB_THREADS says otherwise. Each
+ * thread keeps the jobs it creates in its own queue and takes work from the
+ * other threads when it runs out. Threads that wait with
+ * SDL_WaitJobCounter() run jobs too. Without any job thread, the job runs on
+ * the calling thread before this function returns.
+ *
+ * A job should be short and must not block on other jobs except through
+ * SDL_WaitJobCounter() or SDL_ParallelFor().
+ *
+ * \param fn the function to run.
+ * \param userdata a pointer passed to `fn`.
+ * \param counter a counter that includes this job until it has run, or NULL.
+ * \param after a counter to wait for, the job doesn't start until it is
+ *              zero, or NULL to start it right away.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_CreateJobCounter
+ * \sa SDL_ParallelFor
+ * \sa SDL_WaitJobCounter
+ */
+extern DECLSPEC int SDLCALL SDL_RunJob(SDL_JobFunction fn, void *userdata, SDL_JobCounter *counter, SDL_JobCounter *after);
+
+/**
+ * Get how many jobs of a counter haven't finished yet.
+ *
+ * \param counter the counter to query.
+ * \returns the number of unfinished jobs, 0 when they are all done.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_WaitJobCounter
+ */
+extern DECLSPEC int SDLCALL SDL_GetJobCounterValue(SDL_JobCounter *counter);
+
+/**
+ * Wait until all the jobs of a counter have run.
+ *
+ * The calling thread runs queued jobs while it waits.
+ *
+ * \param counter the counter to wait for.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_RunJob
+ */
+extern DECLSPEC void SDLCALL SDL_WaitJobCounter(SDL_JobCounter *counter);
+
+/**
+ * Destroy a job counter.
+ *
+ * The counter must not be used by any job that hasn't finished.
+ *
+ * \param counter the counter to destroy.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_CreateJobCounter
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyJobCounter(SDL_JobCounter *counter);
+
+/**
+ * Run a function over a range of indices on the job threads.
+ *
+ * The range [0, count) is cut into parts of `grain` indices, which the
+ * calling thread and the job threads take in turn until none are left. This
+ * function returns once `fn` has been called on every part.
+ *
+ * \param fn the function to call on each part.
+ * \param userdata a pointer passed to `fn`.
+ * \param count the number of indices.
+ * \param grain the number of indices in a part, or 0 to pick one.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_RunJob
+ */
+extern DECLSPEC int SDLCALL SDL_ParallelFor(SDL_ParallelForFunction fn, void *userdata, int count, int grain);
+
+/**
+ * Get the number of threads in SDL's job pool, starting it if needed.
+ *
+ * The threads calling SDL_WaitJobCounter() and SDL_ParallelFor() help out,
+ * so jobs can run even when this is 0.
+ *
+ * \returns the number of job threads.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_RunJob
+ */
+extern DECLSPEC int SDLCALL SDL_GetJobThreadCount(void);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
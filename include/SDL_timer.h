@@ -198,7 +198,62 @@ extern DECLSPEC SDL_TimerID SDLCALL SDL_AddTimer(Uint32 interval,
                                                  void *param);
 
 /**
- * Remove a timer created with SDL_AddTimer().
+ * Number of nanoseconds in a second, millisecond and microsecond.
+ */
+#define SDL_NS_PER_SECOND   ((Uint64)1000000000)
+#define SDL_NS_PER_MS       ((Uint64)1000000)
+#define SDL_NS_PER_US       ((Uint64)1000)
+
+/**
+ * Function prototype for the nanosecond timer callback function.
+ *
+ * The callback function is passed the current timer interval, in
+ * nanoseconds, and returns the next timer interval. If the callback returns
+ * 0, the periodic alarm is cancelled.
+ *
+ * \sa SDL_AddTimerNS
+ */
+typedef Uint64 (SDLCALL * SDL_NSTimerCallback) (Uint64 interval, void *param);
+
+/**
+ * Call a callback function at a future time, with nanosecond resolution.
+ *
+ * This works like SDL_AddTimer(), but the interval is measured in
+ * nanoseconds using the high resolution performance counter, and the timer
+ * keeps to a fixed schedule: each new interval is counted from the time the
+ * callback was due, not from the time it actually ran. A periodic timer
+ * therefore does not drift, no matter how long the callback takes or how
+ * late the OS wakes up the timer thread. If the timer falls behind by more
+ * than a whole interval, the missed iterations are skipped rather than run
+ * back to back, and the timer stays in phase with its original schedule.
+ *
+ * The callback is run on the same thread as the SDL_AddTimer() callbacks, so
+ * a slow callback delays every other timer.
+ *
+ * Waiting for a deadline with sub-millisecond precision costs a little CPU
+ * time just before the callback is due, because most OS sleep functions
+ * can't wake up with that accuracy.
+ *
+ * If you use this function, you must pass `SDL_INIT_TIMER` to SDL_Init().
+ *
+ * \param interval the timer delay, in nanoseconds, passed to `callback`.
+ * \param callback the SDL_NSTimerCallback function to call when the
+ *                 specified `interval` elapses.
+ * \param param a pointer that is passed to `callback`.
+ * \returns a timer ID or 0 if an error occurs; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 2.32.0.
+ *
+ * \sa SDL_AddTimer
+ * \sa SDL_RemoveTimer
+ */
+extern DECLSPEC SDL_TimerID SDLCALL SDL_AddTimerNS(Uint64 interval,
+                                                   SDL_NSTimerCallback callback,
+                                                   void *param);
+
+/**
+ * Remove a timer created with SDL_AddTimer() or SDL_AddTimerNS().
  *
  * \param id the ID of the timer to remove.
  * \returns SDL_TRUE if the timer is removed or SDL_FALSE if the timer wasn't
@@ -207,6 +262,7 @@ extern DECLSPEC SDL_TimerID SDLCALL SDL_AddTimer(Uint32 interval,
  * \since This function is available since SDL 2.0.0.
  *
  * \sa SDL_AddTimer
+ * \sa SDL_AddTimerNS
  */
 extern DECLSPEC SDL_bool SDLCALL SDL_RemoveTimer(SDL_TimerID id);
 
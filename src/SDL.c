@@ -45,6 +45,7 @@
 #include "SDL_revision.h"
 #include "SDL_assert_c.h"
 #include "SDL_log_c.h"
+#include "SDL_slab.h"
 #include "events/SDL_events_c.h"
 #include "haptic/SDL_haptic_c.h"
 #include "joystick/SDL_joystick_c.h"
@@ -59,6 +60,7 @@
 extern int SDL_HelperWindowCreate(void);
 extern int SDL_HelperWindowDestroy(void);
 #endif
+extern void SDL_QuitRowBands(void);
 
 #ifdef SDL_BUILD_MAJOR_VERSION
 SDL_COMPILE_TIME_ASSERT(SDL_BUILD_MAJOR_VERSION,
@@ -207,6 +209,9 @@ static void SDL_QuitMainThread(void)
 #endif
     SDL_QuitTLSData();
 
+    /* The main thread gave its blocks back with the rest of its storage */
+    SDL_QuitSlabs();
+
     SDL_main_thread_initialized = SDL_FALSE;
 }
 
@@ -520,6 +525,12 @@ void SDL_Quit(void)
 #endif
     SDL_QuitSubSystem(SDL_INIT_EVERYTHING);
 
+    /* Stop the threads used to convert large images */
+    SDL_QuitRowBands();
+    SDL_QuitJobs();
+
+    SDL_ReportSlabStats();
+
 #ifdef SDL_USE_LIBDBUS
     SDL_DBus_Quit();
 #endif
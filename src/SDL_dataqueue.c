@@ -22,6 +22,7 @@
 
 #include "SDL.h"
 #include "./SDL_dataqueue.h"
+#include "./SDL_slab.h"
 
 typedef struct SDL_DataQueuePacket
 {
@@ -31,6 +32,28 @@ typedef struct SDL_DataQueuePacket
     Uint8 data[SDL_VARIABLE_LENGTH_ARRAY]; /* packet data */
 } SDL_DataQueuePacket;
 
+/* Ring queues (see SDL_NewRingDataQueue) keep their data in a chain of
+   power-of-two byte rings. The producer only ever writes to the newest ring
+   and the consumer only ever reads from the oldest one that still has data,
+   so neither side needs a lock. When the newest ring fills up, the producer
+   links a bigger one after it; the consumer moves on once the old ring is
+   drained and the producer frees it later. */
+typedef struct SDL_DataQueueRing
+{
+    SDL_atomic_t head;                               /* bytes consumed, only written by the consumer. */
+    char head_pad[SDL_CACHELINE_SIZE - sizeof(SDL_atomic_t)];
+    SDL_atomic_t tail;                               /* bytes produced, only written by the producer. */
+    char tail_pad[SDL_CACHELINE_SIZE - sizeof(SDL_atomic_t)];
+    void *next;                                      /* newer ring, set once by the producer. */
+    Uint32 size;                                     /* a power of two, at most SDL_DATAQUEUE_MAX_RING. */
+    Uint8 data[SDL_VARIABLE_LENGTH_ARRAY];           /* ring data */
+} SDL_DataQueueRing;
+
+#define SDL_DATAQUEUE_MAX_RING (1u << 30)
+
+/* Only audio uses data queues so far */
+SDL_SLAB_SITE(SDL_dataqueue_packet_site, "data queue packets", SDL_MEMORY_TAG_AUDIO);
+
 struct SDL_DataQueue
 {
     SDL_mutex *lock;
@@ -39,20 +62,281 @@ struct SDL_DataQueue
     SDL_DataQueuePacket *pool; /* these are unused packets. */
     size_t packet_size;        /* size of new packets */
     size_t queued_bytes;       /* number of bytes of data in the queue. */
+
+    /* only used by ring queues. */
+    SDL_bool is_ring;
+    SDL_DataQueueRing *oldest;     /* rings not yet freed start here, owned by the producer. */
+    SDL_DataQueueRing *write_ring; /* producer writes here. */
+    void *read_ring;               /* consumer reads here, set by the consumer. */
+    SDL_atomic_t written;          /* total bytes produced, wraps around. */
+    SDL_atomic_t consumed;         /* total bytes consumed, wraps around. */
 };
 
-static void SDL_FreeDataQueueList(SDL_DataQueuePacket *packet)
+static void SDL_FreeDataQueueList(SDL_DataQueuePacket *packet, const size_t packet_size)
 {
     while (packet) {
         SDL_DataQueuePacket *next = packet->next;
-        SDL_free(packet);
+        SDL_SlabFree(&SDL_dataqueue_packet_site, packet, sizeof(SDL_DataQueuePacket) + packet_size);
         packet = next;
     }
 }
 
+static SDL_DataQueueRing *SDL_NewDataQueueRingBuffer(const size_t minsize)
+{
+    SDL_DataQueueRing *ring;
+    Uint32 size = 256;
+
+    if (minsize > SDL_DATAQUEUE_MAX_RING) {
+        SDL_SetError("Data queue write is too large");
+        return NULL;
+    }
+    while (size < minsize) {
+        size <<= 1;
+    }
+
+    ring = (SDL_DataQueueRing *)SDL_TaggedMalloc(SDL_MEMORY_TAG_AUDIO, sizeof(SDL_DataQueueRing) + size);
+    if (!ring) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    SDL_AtomicSet(&ring->head, 0);
+    SDL_AtomicSet(&ring->tail, 0);
+    ring->next = NULL;
+    ring->size = size;
+    return ring;
+}
+
+SDL_DataQueue *SDL_NewRingDataQueue(const size_t capacity)
+{
+    SDL_DataQueue *queue = (SDL_DataQueue *)SDL_TaggedCalloc(SDL_MEMORY_TAG_AUDIO, 1, sizeof(SDL_DataQueue));
+
+    if (!queue) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    queue->is_ring = SDL_TRUE;
+    queue->lock = SDL_CreateMutex();
+    if (!queue->lock) {
+        SDL_free(queue);
+        return NULL;
+    }
+
+    queue->oldest = SDL_NewDataQueueRingBuffer(SDL_min(capacity, SDL_DATAQUEUE_MAX_RING));
+    if (!queue->oldest) {
+        SDL_DestroyMutex(queue->lock);
+        SDL_free(queue);
+        return NULL;
+    }
+    queue->write_ring = queue->oldest;
+    queue->read_ring = queue->oldest;
+    return queue;
+}
+
+/* Producer side: give back the rings the consumer has moved past. */
+static void SDL_FreeConsumedRings(SDL_DataQueue *queue)
+{
+    SDL_DataQueueRing *current = (SDL_DataQueueRing *)SDL_AtomicGetPtr(&queue->read_ring);
+
+    while (queue->oldest != current) {
+        SDL_DataQueueRing *next = (SDL_DataQueueRing *)queue->oldest->next;
+        SDL_free(queue->oldest);
+        queue->oldest = next;
+    }
+}
+
+/* Consumer side: the ring with readable data, or the newest ring if the
+   queue is empty. Sets *avail to the number of bytes readable from it. */
+static SDL_DataQueueRing *SDL_GetReadRing(SDL_DataQueue *queue, Uint32 *avail)
+{
+    SDL_DataQueueRing *ring = (SDL_DataQueueRing *)queue->read_ring;
+
+    for (;;) {
+        /* The producer stops writing to a ring before it links the next
+           one, so check the link first: if it's there, the tail is final. */
+        SDL_DataQueueRing *next = (SDL_DataQueueRing *)SDL_AtomicGetPtr(&ring->next);
+        *avail = (Uint32)SDL_AtomicGet(&ring->tail) - (Uint32)ring->head.value;
+        if (*avail || !next) {
+            break;
+        }
+        SDL_AtomicCASPtr(&queue->read_ring, ring, next);
+        ring = next;
+    }
+    return ring;
+}
+
+void *SDL_BeginWriteToDataQueue(SDL_DataQueue *queue, size_t *len)
+{
+    SDL_DataQueueRing *ring;
+    Uint32 used, offset, avail;
+
+    if (!queue) {
+        SDL_InvalidParamError("queue");
+        return NULL;
+    } else if (!len) {
+        SDL_InvalidParamError("len");
+        return NULL;
+    } else if (!queue->is_ring) {
+        SDL_SetError("Data queue is not a ring queue");
+        return NULL;
+    }
+
+    SDL_FreeConsumedRings(queue);
+
+    ring = queue->write_ring;
+    used = (Uint32)ring->tail.value - (Uint32)SDL_AtomicGet(&ring->head);
+    if (used == ring->size) {
+        /* Full, start a bigger ring that the consumer will move on to. */
+        SDL_DataQueueRing *next = SDL_NewDataQueueRingBuffer(SDL_max(SDL_min((size_t)ring->size * 2, SDL_DATAQUEUE_MAX_RING), *len));
+        if (!next) {
+            return NULL;
+        }
+        SDL_AtomicCASPtr(&ring->next, NULL, next);
+        queue->write_ring = ring = next;
+        used = 0;
+    }
+
+    offset = (Uint32)ring->tail.value & (ring->size - 1);
+    avail = SDL_min(ring->size - used, ring->size - offset);
+    if (*len > avail) {
+        *len = avail;
+    }
+    return ring->data + offset;
+}
+
+void SDL_EndWriteToDataQueue(SDL_DataQueue *queue, const size_t len)
+{
+    SDL_DataQueueRing *ring;
+
+    if (!queue || !queue->is_ring || !len) {
+        return;
+    }
+
+    ring = queue->write_ring;
+    SDL_AtomicAdd(&ring->tail, (int)len);
+    SDL_AtomicAdd(&queue->written, (int)len);
+}
+
+const void *SDL_BeginReadFromDataQueue(SDL_DataQueue *queue, size_t *len)
+{
+    SDL_DataQueueRing *ring;
+    Uint32 offset, avail;
+
+    if (!queue || !len || !queue->is_ring) {
+        if (len) {
+            *len = 0;
+        }
+        return NULL;
+    }
+
+    ring = SDL_GetReadRing(queue, &avail);
+    offset = (Uint32)ring->head.value & (ring->size - 1);
+    avail = SDL_min(avail, ring->size - offset);
+    if (*len > avail) {
+        *len = avail;
+    }
+    return *len ? ring->data + offset : NULL;
+}
+
+void SDL_EndReadFromDataQueue(SDL_DataQueue *queue, const size_t len)
+{
+    SDL_DataQueueRing *ring;
+
+    if (!queue || !queue->is_ring || !len) {
+        return;
+    }
+
+    ring = (SDL_DataQueueRing *)queue->read_ring;
+    SDL_AtomicAdd(&ring->head, (int)len);
+    SDL_AtomicAdd(&queue->consumed, (int)len);
+}
+
+static int SDL_WriteToRingDataQueue(SDL_DataQueue *queue, const Uint8 *data, size_t len)
+{
+    SDL_DataQueueRing *ring;
+    Uint32 used;
+
+    SDL_FreeConsumedRings(queue);
+
+    /* Never split a write across rings, so a failed allocation leaves
+       nothing half queued. */
+    ring = queue->write_ring;
+    used = (Uint32)ring->tail.value - (Uint32)SDL_AtomicGet(&ring->head);
+    if (len > (size_t)(ring->size - used)) {
+        SDL_DataQueueRing *next = SDL_NewDataQueueRingBuffer(SDL_max(SDL_min((size_t)ring->size * 2, SDL_DATAQUEUE_MAX_RING), len));
+        if (!next) {
+            return -1;
+        }
+        SDL_AtomicCASPtr(&ring->next, NULL, next);
+        queue->write_ring = next;
+    }
+
+    while (len > 0) {
+        size_t datalen = len;
+        Uint8 *ptr = (Uint8 *)SDL_BeginWriteToDataQueue(queue, &datalen);
+        SDL_assert(ptr != NULL);
+        SDL_memcpy(ptr, data, datalen);
+        SDL_EndWriteToDataQueue(queue, datalen);
+        data += datalen;
+        len -= datalen;
+    }
+    return 0;
+}
+
+static size_t SDL_PeekIntoRingDataQueue(SDL_DataQueue *queue, Uint8 *buf, size_t len)
+{
+    SDL_DataQueueRing *ring;
+    Uint8 *ptr = buf;
+    Uint32 avail, pos;
+
+    for (ring = SDL_GetReadRing(queue, &avail); len && ring; ring = (SDL_DataQueueRing *)SDL_AtomicGetPtr(&ring->next)) {
+        pos = (Uint32)ring->head.value;
+        avail = (Uint32)SDL_AtomicGet(&ring->tail) - pos;
+        while (len && avail) {
+            const Uint32 offset = pos & (ring->size - 1);
+            const size_t cpy = SDL_min(SDL_min(len, avail), ring->size - offset);
+            SDL_memcpy(ptr, ring->data + offset, cpy);
+            ptr += cpy;
+            len -= cpy;
+            pos += (Uint32)cpy;
+            avail -= (Uint32)cpy;
+        }
+    }
+    return (size_t)(ptr - buf);
+}
+
+static size_t SDL_ReadFromRingDataQueue(SDL_DataQueue *queue, Uint8 *buf, size_t len)
+{
+    Uint8 *ptr = buf;
+
+    while (len > 0) {
+        size_t cpy = len;
+        const void *data = SDL_BeginReadFromDataQueue(queue, &cpy);
+        if (!data) {
+            break;
+        }
+        SDL_memcpy(ptr, data, cpy);
+        SDL_EndReadFromDataQueue(queue, cpy);
+        ptr += cpy;
+        len -= cpy;
+    }
+    return (size_t)(ptr - buf);
+}
+
+static void SDL_ClearRingDataQueue(SDL_DataQueue *queue)
+{
+    size_t len = (size_t)-1;
+
+    /* This is a consumer-side operation: skip whatever is readable now. */
+    while (SDL_BeginReadFromDataQueue(queue, &len)) {
+        SDL_EndReadFromDataQueue(queue, len);
+        len = (size_t)-1;
+    }
+}
+
 SDL_DataQueue *SDL_NewDataQueue(const size_t _packetlen, const size_t initialslack)
 {
-    SDL_DataQueue *queue = (SDL_DataQueue *)SDL_calloc(1, sizeof(SDL_DataQueue));
+    SDL_DataQueue *queue = (SDL_DataQueue *)SDL_TaggedCalloc(SDL_MEMORY_TAG_AUDIO, 1, sizeof(SDL_DataQueue));
 
     if (!queue) {
         SDL_OutOfMemory();
@@ -70,7 +354,7 @@ SDL_DataQueue *SDL_NewDataQueue(const size_t _packetlen, const size_t initialsla
         }
 
         for (i = 0; i < wantpackets; i++) {
-            SDL_DataQueuePacket *packet = (SDL_DataQueuePacket *)SDL_malloc(sizeof(SDL_DataQueuePacket) + packetlen);
+            SDL_DataQueuePacket *packet = (SDL_DataQueuePacket *)SDL_SlabAlloc(&SDL_dataqueue_packet_site, sizeof(SDL_DataQueuePacket) + packetlen);
             if (packet) { /* don't care if this fails, we'll deal later. */
                 packet->datalen = 0;
                 packet->startpos = 0;
@@ -86,8 +370,13 @@ SDL_DataQueue *SDL_NewDataQueue(const size_t _packetlen, const size_t initialsla
 void SDL_FreeDataQueue(SDL_DataQueue *queue)
 {
     if (queue) {
-        SDL_FreeDataQueueList(queue->head);
-        SDL_FreeDataQueueList(queue->pool);
+        while (queue->oldest) {
+            SDL_DataQueueRing *next = (SDL_DataQueueRing *)queue->oldest->next;
+            SDL_free(queue->oldest);
+            queue->oldest = next;
+        }
+        SDL_FreeDataQueueList(queue->head, queue->packet_size);
+        SDL_FreeDataQueueList(queue->pool, queue->packet_size);
         SDL_DestroyMutex(queue->lock);
         SDL_free(queue);
     }
@@ -95,16 +384,21 @@ void SDL_FreeDataQueue(SDL_DataQueue *queue)
 
 void SDL_ClearDataQueue(SDL_DataQueue *queue, const size_t slack)
 {
-    const size_t packet_size = queue ? queue->packet_size : 1;
-    const size_t slackpackets = (slack + (packet_size - 1)) / packet_size;
+    size_t slackpackets;
     SDL_DataQueuePacket *packet;
     SDL_DataQueuePacket *prev = NULL;
     size_t i;
 
     if (!queue) {
         return;
+    } else if (queue->is_ring) {
+        /* Ring queues have no packets, and no packet size to divide by */
+        SDL_ClearRingDataQueue(queue);
+        return;
     }
 
+    slackpackets = (slack + (queue->packet_size - 1)) / queue->packet_size;
+
     SDL_LockMutex(queue->lock);
 
     packet = queue->head;
@@ -136,7 +430,7 @@ void SDL_ClearDataQueue(SDL_DataQueue *queue, const size_t slack)
 
     SDL_UnlockMutex(queue->lock);
 
-    SDL_FreeDataQueueList(packet); /* free extra packets */
+    SDL_FreeDataQueueList(packet, queue->packet_size); /* free extra packets */
 }
 
 /* You must hold queue->lock before calling this! */
@@ -152,7 +446,7 @@ static SDL_DataQueuePacket *AllocateDataQueuePacket(SDL_DataQueue *queue)
         queue->pool = packet->next;
     } else {
         /* Have to allocate a new one! */
-        packet = (SDL_DataQueuePacket *)SDL_malloc(sizeof(SDL_DataQueuePacket) + queue->packet_size);
+        packet = (SDL_DataQueuePacket *)SDL_SlabAlloc(&SDL_dataqueue_packet_site, sizeof(SDL_DataQueuePacket) + queue->packet_size);
         if (!packet) {
             return NULL;
         }
@@ -184,6 +478,8 @@ int SDL_WriteToDataQueue(SDL_DataQueue *queue, const void *_data, const size_t _
 
     if (!queue) {
         return SDL_InvalidParamError("queue");
+    } else if (queue->is_ring) {
+        return SDL_WriteToRingDataQueue(queue, data, len);
     }
 
     SDL_LockMutex(queue->lock);
@@ -212,7 +508,7 @@ int SDL_WriteToDataQueue(SDL_DataQueue *queue, const void *_data, const size_t _
                 queue->pool = NULL;
 
                 SDL_UnlockMutex(queue->lock);
-                SDL_FreeDataQueueList(packet); /* give back what we can. */
+                SDL_FreeDataQueueList(packet, packet_size); /* give back what we can. */
                 return SDL_OutOfMemory();
             }
         }
@@ -240,6 +536,8 @@ SDL_PeekIntoDataQueue(SDL_DataQueue *queue, void *_buf, const size_t _len)
 
     if (!queue) {
         return 0;
+    } else if (queue->is_ring) {
+        return SDL_PeekIntoRingDataQueue(queue, buf, len);
     }
 
     SDL_LockMutex(queue->lock);
@@ -269,6 +567,8 @@ SDL_ReadFromDataQueue(SDL_DataQueue *queue, void *_buf, const size_t _len)
 
     if (!queue) {
         return 0;
+    } else if (queue->is_ring) {
+        return SDL_ReadFromRingDataQueue(queue, buf, len);
     }
 
     SDL_LockMutex(queue->lock);
@@ -307,7 +607,11 @@ size_t
 SDL_CountDataQueue(SDL_DataQueue *queue)
 {
     size_t retval = 0;
-    if (queue) {
+    if (queue && queue->is_ring) {
+        /* consumed first: it can only catch up to what was written. */
+        const Uint32 consumed = (Uint32)SDL_AtomicGet(&queue->consumed);
+        retval = (size_t)((Uint32)SDL_AtomicGet(&queue->written) - consumed);
+    } else if (queue) {
         SDL_LockMutex(queue->lock);
         retval = queue->queued_bytes;
         SDL_UnlockMutex(queue->lock);
@@ -35,6 +35,27 @@ size_t SDL_PeekIntoDataQueue(SDL_DataQueue *queue, void *buf, const size_t len);
 size_t SDL_CountDataQueue(SDL_DataQueue *queue);
 SDL_mutex *SDL_GetDataQueueMutex(SDL_DataQueue *queue);  /* don't destroy this, obviously. */
 
+/* A ring queue is a lock-free single-producer, single-consumer queue that
+   grows as needed. The write functions, SDL_BeginWriteToDataQueue and
+   SDL_EndWriteToDataQueue are the producer side; the read and peek
+   functions, SDL_ClearDataQueue, SDL_BeginReadFromDataQueue and
+   SDL_EndReadFromDataQueue are the consumer side. SDL_CountDataQueue may be
+   called from anywhere. Only one thread at a time may be on each side; the
+   queue doesn't lock its mutex itself, callers can use it to serialize
+   several threads on one side without ever blocking the other. */
+SDL_DataQueue *SDL_NewRingDataQueue(const size_t capacity);
+
+/* Get up to *len contiguous bytes to write into, in place; *len is set to
+   what is available, at least 1. Publish them with SDL_EndWriteToDataQueue. */
+void *SDL_BeginWriteToDataQueue(SDL_DataQueue *queue, size_t *len);
+void SDL_EndWriteToDataQueue(SDL_DataQueue *queue, const size_t len);
+
+/* Get up to *len contiguous bytes to read, in place; *len is set to what is
+   available, returns NULL if the queue is empty. Release them with
+   SDL_EndReadFromDataQueue. */
+const void *SDL_BeginReadFromDataQueue(SDL_DataQueue *queue, size_t *len);
+void SDL_EndReadFromDataQueue(SDL_DataQueue *queue, const size_t len);
+
 #endif /* SDL_dataqueue_h_ */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -210,6 +210,13 @@
 
 extern void SDL_InitMainThread(void);
 
+/* Allocations charged to a subsystem, see SDL_EnableMemoryTracking().
+   SDL_realloc() and SDL_free() keep the tag a block was allocated with. */
+extern void *SDL_TaggedMalloc(SDL_MemoryTag tag, size_t size);
+extern void *SDL_TaggedCalloc(SDL_MemoryTag tag, size_t nmemb, size_t size);
+extern void *SDL_TaggedRealloc(SDL_MemoryTag tag, void *ptr, size_t size);
+extern void *SDL_TaggedSIMDAlloc(SDL_MemoryTag tag, const size_t len);
+
 #endif /* SDL_internal_h_ */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -30,7 +30,11 @@
 #include "SDL_log.h"
 #include "SDL_hints.h"
 #include "SDL_mutex.h"
+#include "SDL_thread.h"
+#include "SDL_timer.h"
 #include "SDL_log_c.h"
+#include "SDL_slab.h"
+#include "thread/SDL_systhread.h"
 
 #ifdef HAVE_STDIO_H
 #include <stdio.h>
@@ -45,6 +49,9 @@
 /* The size of the stack buffer to use for rendering log messages. */
 #define SDL_MAX_LOG_MESSAGE_STACK 256
 
+/* Messages waiting for the log thread in asynchronous mode, a power of two */
+#define SDL_LOG_ASYNC_SLOTS 256
+
 #define DEFAULT_CATEGORY -1
 
 typedef struct SDL_LogLevel
@@ -54,6 +61,8 @@ typedef struct SDL_LogLevel
     struct SDL_LogLevel *next;
 } SDL_LogLevel;
 
+SDL_SLAB_SITE(SDL_log_message_site, "log messages", SDL_MEMORY_TAG_OTHER);
+
 /* The default log output function */
 static void SDLCALL SDL_LogOutput(void *userdata, int category, SDL_LogPriority priority, const char *message);
 
@@ -64,6 +73,40 @@ static SDL_LogOutputFunction SDL_log_function = SDL_LogOutput;
 static void *SDL_log_userdata = NULL;
 static SDL_mutex *log_function_mutex = NULL;
 
+/* In asynchronous mode messages are formatted straight into a bounded
+   multi-producer ring, with the sequence numbered slots of the event queue
+   (see Dmitry Vyukov's bounded MPMC queue). The log thread is the consumer
+   and passes them to the output function; SDL_LogFlush() drains the ring
+   from other threads, consumer_lock keeps the two apart. Producers count
+   themselves in producers while they might touch the ring, so that turning
+   asynchronous mode off can wait for them. */
+typedef struct
+{
+    SDL_atomic_t sequence;
+    int category;
+    SDL_LogPriority priority;
+    char *message;       /* text, a buffer from the slabs for longer messages, or NULL */
+    size_t message_size; /* of the buffer from the slabs */
+    char text[SDL_MAX_LOG_MESSAGE_STACK];
+} SDL_LogSlot;
+
+static struct
+{
+    SDL_atomic_t enabled;
+    SDL_atomic_t producers;
+    SDL_LogSlot *slots;
+    SDL_atomic_t head; /* next slot to fill, shared by the producers */
+    Uint32 tail;       /* next slot to drain, protected by consumer_lock */
+    SDL_bool draining; /* an output function is running, protected by consumer_lock */
+    SDL_mutex *consumer_lock;
+    SDL_sem *wakeup;
+    SDL_atomic_t sleeping;
+    SDL_atomic_t quit;
+    SDL_Thread *thread;
+} SDL_log_async;
+
+static SDL_atomic_t SDL_log_dropped;
+
 /* If this list changes, update the documentation for SDL_HINT_LOGGING */
 static const char *SDL_priority_prefixes[] = {
     NULL,
@@ -112,6 +155,18 @@ void SDL_LogInit(void)
 
 void SDL_LogQuit(void)
 {
+    SDL_LogSetAsync(SDL_FALSE);
+    SDL_free(SDL_log_async.slots);
+    SDL_log_async.slots = NULL;
+    if (SDL_log_async.wakeup) {
+        SDL_DestroySemaphore(SDL_log_async.wakeup);
+        SDL_log_async.wakeup = NULL;
+    }
+    if (SDL_log_async.consumer_lock) {
+        SDL_DestroyMutex(SDL_log_async.consumer_lock);
+        SDL_log_async.consumer_lock = NULL;
+    }
+
     SDL_LogResetPriorities();
     if (log_function_mutex) {
         SDL_DestroyMutex(log_function_mutex);
@@ -382,11 +437,227 @@ static const char *GetCategoryPrefix(int category)
 }
 #endif /* __ANDROID__ */
 
+static void SDL_ChopLogNewline(char *message, int len)
+{
+    /* Chop off final endline. */
+    if ((len > 0) && (message[len - 1] == '\n')) {
+        message[--len] = '\0';
+        if ((len > 0) && (message[len - 1] == '\r')) { /* catch "\r\n", too. */
+            message[--len] = '\0';
+        }
+    }
+}
+
+/* Format a message into the ring -- never waits for the log thread */
+static void SDL_LogMessageAsync(int category, SDL_LogPriority priority, const char *fmt, va_list ap)
+{
+    SDL_LogSlot *slot;
+    Uint32 pos = (Uint32)SDL_AtomicGet(&SDL_log_async.head);
+    size_t len_plus_term;
+    int len;
+    va_list aq;
+
+    for (;;) {
+        int diff;
+
+        slot = &SDL_log_async.slots[pos & (SDL_LOG_ASYNC_SLOTS - 1)];
+        diff = (int)((Uint32)SDL_AtomicGet(&slot->sequence) - pos);
+        if (diff == 0) {
+            /* The slot is free, try to claim it */
+            if (SDL_AtomicCAS(&SDL_log_async.head, (int)pos, (int)(pos + 1))) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* The log thread hasn't caught up, the ring is full */
+            SDL_AtomicIncRef(&SDL_log_dropped);
+            return;
+        }
+        pos = (Uint32)SDL_AtomicGet(&SDL_log_async.head);
+    }
+
+    slot->category = category;
+    slot->priority = priority;
+    slot->message = slot->text;
+    va_copy(aq, ap);
+    len = SDL_vsnprintf(slot->text, sizeof(slot->text), fmt, aq);
+    va_end(aq);
+
+    if (len < 0) {
+        /* The slot is ours, it still has to be handed over */
+        slot->message = NULL;
+    } else if (len >= sizeof(slot->text)) {
+        char *message = NULL;
+
+        if (SDL_size_add_overflow(len, 1, &len_plus_term) == 0) {
+            message = (char *)SDL_SlabAlloc(&SDL_log_message_site, len_plus_term);
+        }
+        if (message) {
+            va_copy(aq, ap);
+            len = SDL_vsnprintf(message, len_plus_term, fmt, aq);
+            va_end(aq);
+            slot->message = message;
+            slot->message_size = len_plus_term;
+        } else {
+            /* Better truncated than lost */
+            len = (int)sizeof(slot->text) - 1;
+        }
+    }
+    if (slot->message) {
+        SDL_ChopLogNewline(slot->message, len);
+    }
+    SDL_AtomicSet(&slot->sequence, (int)(pos + 1));
+
+    if (SDL_AtomicGet(&SDL_log_async.sleeping) && SDL_AtomicCAS(&SDL_log_async.sleeping, 1, 0)) {
+        SDL_SemPost(SDL_log_async.wakeup);
+    }
+}
+
+static SDL_bool SDL_LogSlotReady(void)
+{
+    const Uint32 pos = SDL_log_async.tail;
+
+    return (Uint32)SDL_AtomicGet(&SDL_log_async.slots[pos & (SDL_LOG_ASYNC_SLOTS - 1)].sequence) == pos + 1;
+}
+
+/* Pass the finished messages to the output function -- called with consumer_lock held
+
+   This stops at a slot that was claimed but isn't filled yet, it shows up
+   with the next drain. */
+static void SDL_DrainLogRing(void)
+{
+    if (SDL_log_async.draining) {
+        /* SDL_LogFlush() from inside the output function */
+        return;
+    }
+
+    SDL_log_async.draining = SDL_TRUE;
+    while (SDL_LogSlotReady()) {
+        const Uint32 pos = SDL_log_async.tail;
+        SDL_LogSlot *slot = &SDL_log_async.slots[pos & (SDL_LOG_ASYNC_SLOTS - 1)];
+
+        if (slot->message) {
+            SDL_LockMutex(log_function_mutex);
+            if (SDL_log_function) {
+                SDL_log_function(SDL_log_userdata, slot->category, slot->priority, slot->message);
+            }
+            SDL_UnlockMutex(log_function_mutex);
+
+            if (slot->message != slot->text) {
+                SDL_SlabFree(&SDL_log_message_site, slot->message, slot->message_size);
+            }
+        }
+        SDL_log_async.tail = pos + 1;
+        SDL_AtomicSet(&slot->sequence, (int)(pos + SDL_LOG_ASYNC_SLOTS));
+    }
+    SDL_log_async.draining = SDL_FALSE;
+}
+
+static int SDLCALL SDL_LogThread(void *data)
+{
+    for (;;) {
+        SDL_LockMutex(SDL_log_async.consumer_lock);
+        SDL_DrainLogRing();
+        SDL_UnlockMutex(SDL_log_async.consumer_lock);
+
+        if (SDL_AtomicGet(&SDL_log_async.quit)) {
+            break;
+        }
+
+        /* Producers check this after publishing a message, so either they
+           see us asleep or we see their message */
+        SDL_AtomicSet(&SDL_log_async.sleeping, 1);
+        if (SDL_LogSlotReady() || SDL_AtomicGet(&SDL_log_async.quit)) {
+            SDL_AtomicSet(&SDL_log_async.sleeping, 0);
+            continue;
+        }
+        SDL_SemWait(SDL_log_async.wakeup);
+    }
+    return 0;
+}
+
+int SDL_LogSetAsync(SDL_bool async)
+{
+    int i;
+
+    if (!async == !SDL_AtomicGet(&SDL_log_async.enabled)) {
+        return 0;
+    }
+
+    if (!async) {
+        /* New messages go straight to the output function from now on, wait
+           for the ones that were started before to be published */
+        SDL_AtomicSet(&SDL_log_async.enabled, 0);
+        while (SDL_AtomicGet(&SDL_log_async.producers) > 0) {
+            SDL_Delay(0);
+        }
+
+        SDL_AtomicSet(&SDL_log_async.quit, 1);
+        SDL_SemPost(SDL_log_async.wakeup);
+        SDL_WaitThread(SDL_log_async.thread, NULL);
+        SDL_log_async.thread = NULL;
+
+        /* Every claimed slot is filled now */
+        SDL_LockMutex(SDL_log_async.consumer_lock);
+        SDL_DrainLogRing();
+        SDL_UnlockMutex(SDL_log_async.consumer_lock);
+        return 0;
+    }
+
+    if (!SDL_log_async.slots) {
+        SDL_log_async.slots = (SDL_LogSlot *)SDL_malloc(SDL_LOG_ASYNC_SLOTS * sizeof(*SDL_log_async.slots));
+        if (!SDL_log_async.slots) {
+            return SDL_OutOfMemory();
+        }
+        for (i = 0; i < SDL_LOG_ASYNC_SLOTS; ++i) {
+            SDL_AtomicSet(&SDL_log_async.slots[i].sequence, i);
+        }
+        SDL_AtomicSet(&SDL_log_async.head, 0);
+        SDL_log_async.tail = 0;
+    }
+    if (!SDL_log_async.consumer_lock) {
+        SDL_log_async.consumer_lock = SDL_CreateMutex();
+        if (!SDL_log_async.consumer_lock) {
+            return -1;
+        }
+    }
+    if (!SDL_log_async.wakeup) {
+        SDL_log_async.wakeup = SDL_CreateSemaphore(0);
+        if (!SDL_log_async.wakeup) {
+            return -1;
+        }
+    }
+
+    SDL_AtomicSet(&SDL_log_async.quit, 0);
+    SDL_AtomicSet(&SDL_log_async.sleeping, 0);
+    SDL_log_async.thread = SDL_CreateThreadInternal(SDL_LogThread, "SDLLog", 0, NULL);
+    if (!SDL_log_async.thread) {
+        return -1;
+    }
+    SDL_AtomicSet(&SDL_log_async.enabled, 1);
+    return 0;
+}
+
+void SDL_LogFlush(void)
+{
+    if (!SDL_log_async.slots || !SDL_log_async.consumer_lock) {
+        return;
+    }
+
+    SDL_LockMutex(SDL_log_async.consumer_lock);
+    SDL_DrainLogRing();
+    SDL_UnlockMutex(SDL_log_async.consumer_lock);
+}
+
+int SDL_LogGetDroppedCount(void)
+{
+    return SDL_AtomicGet(&SDL_log_dropped);
+}
+
 void SDL_LogMessageV(int category, SDL_LogPriority priority, const char *fmt, va_list ap)
 {
     char *message = NULL;
     char stack_buf[SDL_MAX_LOG_MESSAGE_STACK];
-    size_t len_plus_term;
+    size_t len_plus_term = 0;
     int len;
     va_list aq;
 
@@ -410,6 +681,18 @@ void SDL_LogMessageV(int category, SDL_LogPriority priority, const char *fmt, va
         log_function_mutex = SDL_CreateMutex();
     }
 
+    if (SDL_AtomicGet(&SDL_log_async.enabled)) {
+        /* Check again after counting ourselves, SDL_LogSetAsync() may have
+           turned it off and stopped waiting for us in between */
+        SDL_AtomicIncRef(&SDL_log_async.producers);
+        if (SDL_AtomicGet(&SDL_log_async.enabled)) {
+            SDL_LogMessageAsync(category, priority, fmt, ap);
+            SDL_AtomicAdd(&SDL_log_async.producers, -1);
+            return;
+        }
+        SDL_AtomicAdd(&SDL_log_async.producers, -1);
+    }
+
     /* Render into stack buffer */
     va_copy(aq, ap);
     len = SDL_vsnprintf(stack_buf, sizeof(stack_buf), fmt, aq);
@@ -422,7 +705,7 @@ void SDL_LogMessageV(int category, SDL_LogPriority priority, const char *fmt, va
     /* If message truncated, allocate and re-render */
     if (len >= sizeof(stack_buf) && SDL_size_add_overflow(len, 1, &len_plus_term) == 0) {
         /* Allocate exactly what we need, including the zero-terminator */
-        message = (char *)SDL_malloc(len_plus_term);
+        message = (char *)SDL_SlabAlloc(&SDL_log_message_site, len_plus_term);
         if (!message) {
             return;
         }
@@ -433,13 +716,7 @@ void SDL_LogMessageV(int category, SDL_LogPriority priority, const char *fmt, va
         message = stack_buf;
     }
 
-    /* Chop off final endline. */
-    if ((len > 0) && (message[len - 1] == '\n')) {
-        message[--len] = '\0';
-        if ((len > 0) && (message[len - 1] == '\r')) { /* catch "\r\n", too. */
-            message[--len] = '\0';
-        }
-    }
+    SDL_ChopLogNewline(message, len);
 
     SDL_LockMutex(log_function_mutex);
     SDL_log_function(SDL_log_userdata, category, priority, message);
@@ -447,7 +724,7 @@ void SDL_LogMessageV(int category, SDL_LogPriority priority, const char *fmt, va
 
     /* Free only if dynamically allocated */
     if (message != stack_buf) {
-        SDL_free(message);
+        SDL_SlabFree(&SDL_log_message_site, message, len_plus_term);
     }
 }
 
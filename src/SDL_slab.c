@@ -0,0 +1,467 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "./SDL_internal.h"
+
+#include "SDL.h"
+#include "SDL_bits.h"
+#include "./SDL_slab.h"
+
+/* Size classes are powers of two from 16 bytes to SDL_SLAB_MAX_SIZE */
+#define SDL_SLAB_MIN_SHIFT  4
+#define SDL_SLAB_CLASSES    7
+#define SDL_SLAB_CHUNK_SIZE (16 * 1024)
+
+/* Blocks move between a thread and the depot this many at a time, and a
+   thread keeps at most twice as many free blocks of each class */
+#define SDL_SLAB_BATCH 16
+
+/* The first site slot counts the sites that didn't get one of their own */
+#define SDL_SLAB_MAX_SITES 64
+
+typedef struct SDL_SlabBlock
+{
+    struct SDL_SlabBlock *next;
+} SDL_SlabBlock;
+
+/* The header keeps the blocks after it 16 byte aligned */
+typedef union SDL_SlabChunk
+{
+    union SDL_SlabChunk *next;
+    Uint8 padding[16];
+} SDL_SlabChunk;
+
+typedef struct SDL_SlabList
+{
+    SDL_SlabBlock *head;
+    int count;
+} SDL_SlabList;
+
+typedef struct SDL_SlabCache
+{
+    SDL_SlabList lists[SDL_SLAB_CLASSES];
+    int generation;
+    Sint64 in_use; /* blocks from the slabs, goes negative on the threads that free them */
+    Uint64 allocations[SDL_SLAB_MAX_SITES];
+    Uint64 frees[SDL_SLAB_MAX_SITES];
+    Uint64 bytes[SDL_SLAB_MAX_SITES];
+    struct SDL_SlabCache *prev;
+    struct SDL_SlabCache *next;
+} SDL_SlabCache;
+
+/* Everything below is protected by slab_lock, except the counters of each
+   cache, which only its thread writes */
+static SDL_SpinLock slab_lock;
+static SDL_TLSID slab_tls;
+static SDL_SlabChunk *slab_chunks;
+static SDL_SlabList slab_depot[SDL_SLAB_CLASSES];
+static SDL_SlabCache *slab_caches;
+static const char *slab_site_names[SDL_SLAB_MAX_SITES] = { "other" };
+static int slab_num_sites = 1;
+
+/* Counters of the threads that are gone, and of allocations made without a
+   thread cache. Its lists are unused. */
+static SDL_SlabCache slab_global;
+
+/* Bumped when the slabs are released, the blocks in older caches are gone */
+static int slab_generation;
+
+/* The generation of a cache SDL_QuitSlabs() took off the list */
+#define SDL_SLAB_DETACHED -1
+
+static SDL_INLINE int SDL_GetSlabClass(size_t size)
+{
+    if (size == 0) {
+        size = 1;
+    }
+    return SDL_MostSignificantBitIndex32((Uint32)(size - 1) | ((1 << SDL_SLAB_MIN_SHIFT) - 1)) - (SDL_SLAB_MIN_SHIFT - 1);
+}
+
+static SDL_INLINE size_t SDL_GetSlabClassSize(int sizeclass)
+{
+    return (size_t)1 << (sizeclass + SDL_SLAB_MIN_SHIFT);
+}
+
+static SDL_INLINE void *SDL_PopSlabBlock(SDL_SlabList *list)
+{
+    SDL_SlabBlock *block = list->head;
+
+    list->head = block->next;
+    --list->count;
+    return block;
+}
+
+static SDL_INLINE void SDL_PushSlabBlock(SDL_SlabList *list, void *ptr)
+{
+    SDL_SlabBlock *block = (SDL_SlabBlock *)ptr;
+
+    block->next = list->head;
+    list->head = block;
+    ++list->count;
+}
+
+static void SDL_MoveSlabBlocks(SDL_SlabList *dst, SDL_SlabList *src, int count)
+{
+    while (count-- > 0 && src->head) {
+        SDL_PushSlabBlock(dst, SDL_PopSlabBlock(src));
+    }
+}
+
+static int SDL_GetSlabSiteIndex(SDL_SlabSite *site)
+{
+    /* The index is stored plus one, so zero means not assigned yet */
+    if (!site->index) {
+        SDL_AtomicLock(&slab_lock);
+        if (!site->index) {
+            if (slab_num_sites < SDL_SLAB_MAX_SITES) {
+                slab_site_names[slab_num_sites] = site->name;
+                site->index = ++slab_num_sites;
+            } else {
+                site->index = 1;
+            }
+        }
+        SDL_AtomicUnlock(&slab_lock);
+    }
+    return site->index - 1;
+}
+
+/* Called with the lock held, the cache must be from the current generation */
+static void SDL_ReturnSlabCacheBlocks(SDL_SlabCache *cache)
+{
+    int i;
+
+    for (i = 0; i < SDL_SLAB_CLASSES; ++i) {
+        SDL_MoveSlabBlocks(&slab_depot[i], &cache->lists[i], cache->lists[i].count);
+    }
+}
+
+/* Called with the lock held */
+static void SDL_LinkSlabCache(SDL_SlabCache *cache)
+{
+    cache->generation = slab_generation;
+    cache->prev = NULL;
+    cache->next = slab_caches;
+    if (slab_caches) {
+        slab_caches->prev = cache;
+    }
+    slab_caches = cache;
+}
+
+/* Give the blocks of the cache to the depot and its counters to slab_global,
+   and take it off the list -- called with the lock held */
+static void SDL_DetachSlabCache(SDL_SlabCache *cache)
+{
+    int i;
+
+    if (cache->generation == slab_generation) {
+        SDL_ReturnSlabCacheBlocks(cache);
+    } else {
+        SDL_zeroa(cache->lists);
+    }
+    slab_global.in_use += cache->in_use;
+    for (i = 0; i < SDL_SLAB_MAX_SITES; ++i) {
+        slab_global.allocations[i] += cache->allocations[i];
+        slab_global.frees[i] += cache->frees[i];
+        slab_global.bytes[i] += cache->bytes[i];
+    }
+    cache->in_use = 0;
+    SDL_zeroa(cache->allocations);
+    SDL_zeroa(cache->frees);
+    SDL_zeroa(cache->bytes);
+
+    if (cache->prev) {
+        cache->prev->next = cache->next;
+    } else {
+        slab_caches = cache->next;
+    }
+    if (cache->next) {
+        cache->next->prev = cache->prev;
+    }
+    cache->prev = NULL;
+    cache->next = NULL;
+    cache->generation = SDL_SLAB_DETACHED;
+}
+
+static void SDL_FreeSlabCache(void *data)
+{
+    SDL_SlabCache *cache = (SDL_SlabCache *)data;
+
+    SDL_AtomicLock(&slab_lock);
+    if (cache->generation != SDL_SLAB_DETACHED) {
+        SDL_DetachSlabCache(cache);
+    }
+    SDL_AtomicUnlock(&slab_lock);
+
+    SDL_free(cache);
+}
+
+static SDL_SlabCache *SDL_GetSlabCache(void)
+{
+    SDL_SlabCache *cache;
+
+    if (!slab_tls) {
+        SDL_AtomicLock(&slab_lock);
+        if (!slab_tls) {
+            slab_tls = SDL_TLSCreate();
+        }
+        SDL_AtomicUnlock(&slab_lock);
+    }
+
+    cache = (SDL_SlabCache *)SDL_TLSGet(slab_tls);
+    if (!cache) {
+        cache = (SDL_SlabCache *)SDL_calloc(1, sizeof(*cache));
+        if (!cache) {
+            return NULL;
+        }
+        if (SDL_TLSSet(slab_tls, cache, SDL_FreeSlabCache) < 0) {
+            SDL_free(cache);
+            return NULL;
+        }
+
+        SDL_AtomicLock(&slab_lock);
+        SDL_LinkSlabCache(cache);
+        SDL_AtomicUnlock(&slab_lock);
+    } else if (cache->generation != slab_generation) {
+        /* SDL_QuitSlabs() took our blocks and counters, start over */
+        SDL_AtomicLock(&slab_lock);
+        SDL_LinkSlabCache(cache);
+        SDL_AtomicUnlock(&slab_lock);
+    }
+    return cache;
+}
+
+/* Move a batch of blocks from the depot to the list, carving a new chunk
+   if the depot is empty */
+static SDL_bool SDL_RefillSlabList(SDL_SlabList *list, int sizeclass)
+{
+    SDL_SlabList *depot = &slab_depot[sizeclass];
+    const size_t size = SDL_GetSlabClassSize(sizeclass);
+    SDL_SlabChunk *chunk;
+    Uint8 *block;
+    size_t i, count;
+
+    SDL_AtomicLock(&slab_lock);
+    if (!depot->head) {
+        /* Don't call into SDL_malloc() with the other threads spinning */
+        SDL_AtomicUnlock(&slab_lock);
+        chunk = (SDL_SlabChunk *)SDL_malloc(SDL_SLAB_CHUNK_SIZE);
+        if (!chunk) {
+            return SDL_FALSE;
+        }
+        SDL_AtomicLock(&slab_lock);
+
+        /* Another thread may have refilled the depot meanwhile, that's fine */
+        chunk->next = slab_chunks;
+        slab_chunks = chunk;
+        block = (Uint8 *)(chunk + 1);
+        count = (SDL_SLAB_CHUNK_SIZE - sizeof(*chunk)) / size;
+        for (i = 0; i < count; ++i, block += size) {
+            SDL_PushSlabBlock(depot, block);
+        }
+    }
+    SDL_MoveSlabBlocks(list, depot, SDL_SLAB_BATCH);
+    SDL_AtomicUnlock(&slab_lock);
+    return SDL_TRUE;
+}
+
+/* Without thread storage every allocation goes through the depot */
+static void *SDL_SlabAllocUncached(SDL_SlabSite *site, int index, size_t size)
+{
+    SDL_SlabList blocks = { NULL, 0 };
+    void *ptr;
+
+    if (size > SDL_SLAB_MAX_SIZE) {
+        ptr = SDL_TaggedMalloc(site->tag, size);
+        if (!ptr) {
+            return NULL;
+        }
+        SDL_AtomicLock(&slab_lock);
+    } else {
+        const int sizeclass = SDL_GetSlabClass(size);
+
+        if (!SDL_RefillSlabList(&blocks, sizeclass)) {
+            return NULL;
+        }
+        ptr = SDL_PopSlabBlock(&blocks);
+        SDL_AtomicLock(&slab_lock);
+        SDL_MoveSlabBlocks(&slab_depot[sizeclass], &blocks, blocks.count);
+        ++slab_global.in_use;
+    }
+    ++slab_global.allocations[index];
+    slab_global.bytes[index] += size;
+    SDL_AtomicUnlock(&slab_lock);
+    return ptr;
+}
+
+static void SDL_SlabFreeUncached(int index, void *ptr, size_t size)
+{
+    SDL_AtomicLock(&slab_lock);
+    ++slab_global.frees[index];
+    if (size <= SDL_SLAB_MAX_SIZE) {
+        SDL_PushSlabBlock(&slab_depot[SDL_GetSlabClass(size)], ptr);
+        --slab_global.in_use;
+    }
+    SDL_AtomicUnlock(&slab_lock);
+
+    if (size > SDL_SLAB_MAX_SIZE) {
+        SDL_free(ptr);
+    }
+}
+
+void *SDL_SlabAlloc(SDL_SlabSite *site, size_t size)
+{
+    SDL_SlabCache *cache = SDL_GetSlabCache();
+    const int index = SDL_GetSlabSiteIndex(site);
+    void *ptr;
+
+    if (!cache) {
+        return SDL_SlabAllocUncached(site, index, size);
+    }
+
+    if (size > SDL_SLAB_MAX_SIZE) {
+        ptr = SDL_TaggedMalloc(site->tag, size);
+        if (!ptr) {
+            return NULL;
+        }
+    } else {
+        const int sizeclass = SDL_GetSlabClass(size);
+        SDL_SlabList *list = &cache->lists[sizeclass];
+
+        if (!list->head && !SDL_RefillSlabList(list, sizeclass)) {
+            return NULL;
+        }
+        ptr = SDL_PopSlabBlock(list);
+        ++cache->in_use;
+    }
+    ++cache->allocations[index];
+    cache->bytes[index] += size;
+    return ptr;
+}
+
+void SDL_SlabFree(SDL_SlabSite *site, void *ptr, size_t size)
+{
+    SDL_SlabCache *cache;
+    SDL_SlabList *list;
+    int index;
+
+    if (!ptr) {
+        return;
+    }
+
+    cache = SDL_GetSlabCache();
+    index = SDL_GetSlabSiteIndex(site);
+    if (!cache) {
+        SDL_SlabFreeUncached(index, ptr, size);
+        return;
+    }
+
+    ++cache->frees[index];
+    if (size > SDL_SLAB_MAX_SIZE) {
+        SDL_free(ptr);
+        return;
+    }
+
+    list = &cache->lists[SDL_GetSlabClass(size)];
+    SDL_PushSlabBlock(list, ptr);
+    --cache->in_use;
+    if (list->count > 2 * SDL_SLAB_BATCH) {
+        SDL_AtomicLock(&slab_lock);
+        SDL_MoveSlabBlocks(&slab_depot[SDL_GetSlabClass(size)], list, SDL_SLAB_BATCH);
+        SDL_AtomicUnlock(&slab_lock);
+    }
+}
+
+int SDL_GetSlabStats(SDL_SlabStats *stats, int maxstats)
+{
+    SDL_SlabCache *cache;
+    int i, count;
+
+    SDL_AtomicLock(&slab_lock);
+    count = slab_num_sites;
+    for (i = 0; i < count && i < maxstats; ++i) {
+        /* The other threads may be counting, this is only a snapshot */
+        stats[i].name = slab_site_names[i];
+        stats[i].allocations = slab_global.allocations[i];
+        stats[i].frees = slab_global.frees[i];
+        stats[i].bytes = slab_global.bytes[i];
+        for (cache = slab_caches; cache; cache = cache->next) {
+            stats[i].allocations += cache->allocations[i];
+            stats[i].frees += cache->frees[i];
+            stats[i].bytes += cache->bytes[i];
+        }
+    }
+    SDL_AtomicUnlock(&slab_lock);
+
+    return count;
+}
+
+void SDL_ReportSlabStats(void)
+{
+    const char *report = SDL_GetHint("SDL_SLAB_STATISTICS");
+    SDL_SlabStats stats[SDL_SLAB_MAX_SITES];
+    int i, count;
+
+    if (!report || !SDL_atoi(report)) {
+        return;
+    }
+
+    count = SDL_GetSlabStats(stats, SDL_arraysize(stats));
+    for (i = 0; i < count; ++i) {
+        if (stats[i].allocations == 0) {
+            continue;
+        }
+        SDL_Log("SDL SLAB: %s: %" SDL_PRIu64 " allocations, %" SDL_PRIu64 " frees, %" SDL_PRIu64 " bytes, %" SDL_PRIu64 " live\n",
+                stats[i].name, stats[i].allocations, stats[i].frees, stats[i].bytes,
+                stats[i].allocations - stats[i].frees);
+    }
+}
+
+void SDL_QuitSlabs(void)
+{
+    SDL_SlabChunk *chunks = NULL;
+    Sint64 in_use;
+
+    SDL_AtomicLock(&slab_lock);
+
+    /* Threads that SDL didn't create never run the thread storage destructor,
+       take back the blocks they still hold. The cache itself belongs to the
+       thread, it links itself again if the thread allocates after this. */
+    while (slab_caches) {
+        SDL_DetachSlabCache(slab_caches);
+    }
+    in_use = slab_global.in_use;
+
+    /* If something still holds a block, leaking the slabs beats crashing */
+    if (in_use == 0) {
+        chunks = slab_chunks;
+        slab_chunks = NULL;
+        SDL_zeroa(slab_depot);
+        ++slab_generation;
+    }
+    SDL_AtomicUnlock(&slab_lock);
+
+    while (chunks) {
+        SDL_SlabChunk *next = chunks->next;
+        SDL_free(chunks);
+        chunks = next;
+    }
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,74 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#ifndef SDL_slab_h_
+#define SDL_slab_h_
+
+/* this is not a public API. */
+
+/* Small objects that SDL allocates and frees all the time (event entries,
+   timers, queue packets, log buffers) come from size-class slabs instead of
+   SDL_malloc. Each thread keeps a few free blocks of every class, so most
+   allocations touch neither a lock nor an atomic; the rest move between the
+   thread and a shared depot in batches. Requests larger than
+   SDL_SLAB_MAX_SIZE go straight to SDL_malloc.
+
+   Every call site declares a site, which counts what it allocates and frees.
+   The caller has to pass the same size to SDL_SlabFree() that it passed to
+   SDL_SlabAlloc(), blocks don't remember their size. Requests too large for
+   the slabs are charged to the memory tag of their site, the slabs
+   themselves are shared and charged to SDL_MEMORY_TAG_OTHER. */
+
+#define SDL_SLAB_MAX_SIZE 1024
+
+typedef struct SDL_SlabSite
+{
+    const char *name;
+    SDL_MemoryTag tag;
+    int index; /* assigned on first use */
+} SDL_SlabSite;
+
+#define SDL_SLAB_SITE(var, name, tag) static SDL_SlabSite var = { name, tag, 0 }
+
+typedef struct SDL_SlabStats
+{
+    const char *name;
+    Uint64 allocations;
+    Uint64 frees;
+    Uint64 bytes; /* total requested */
+} SDL_SlabStats;
+
+extern void *SDL_SlabAlloc(SDL_SlabSite *site, size_t size);
+extern void SDL_SlabFree(SDL_SlabSite *site, void *ptr, size_t size);
+
+/* Fill in up to maxstats entries, returns the number of sites */
+extern int SDL_GetSlabStats(SDL_SlabStats *stats, int maxstats);
+
+/* Log the counters if the SDL_SLAB_STATISTICS hint is set */
+extern void SDL_ReportSlabStats(void);
+
+/* Release the slabs, after SDL's own threads have been cleaned up. This takes
+   back the blocks of threads that SDL didn't create, they mustn't be using
+   the slabs meanwhile. */
+extern void SDL_QuitSlabs(void);
+
+#endif /* SDL_slab_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -552,6 +552,10 @@ void SDL_RemoveAudioDevice(const SDL_bool iscapture, void *handle)
 
 /* buffer queueing support... */
 
+/* The buffer queue is a ring queue: the device thread is the only thread on
+   its side, and the application threads serialize on the queue's mutex for
+   the other side, so the device thread never waits on the application. */
+
 static void SDLCALL SDL_BufferQueueDrainCallback(void *userdata, Uint8 *stream, int len)
 {
     /* this function always holds the mixer lock before being called. */
@@ -566,8 +570,8 @@ static void SDLCALL SDL_BufferQueueDrainCallback(void *userdata, Uint8 *stream,
     stream += dequeued;
     len -= (int)dequeued;
 
+    /* the application may have queued more by now, it'll play next time. */
     if (len > 0) { /* fill any remaining space in the stream with silence. */
-        SDL_assert(SDL_CountDataQueue(device->buffer_queue) == 0);
         SDL_memset(stream, device->callbackspec.silence, len);
     }
 }
@@ -601,9 +605,10 @@ int SDL_QueueAudio(SDL_AudioDeviceID devid, const void *data, Uint32 len)
     }
 
     if (len > 0) {
-        current_audio.impl.LockDevice(device);
+        SDL_mutex *lock = SDL_GetDataQueueMutex(device->buffer_queue);
+        SDL_LockMutex(lock);
         rc = SDL_WriteToDataQueue(device->buffer_queue, data, len);
-        current_audio.impl.UnlockDevice(device);
+        SDL_UnlockMutex(lock);
     }
 
     return rc;
@@ -612,6 +617,7 @@ int SDL_QueueAudio(SDL_AudioDeviceID devid, const void *data, Uint32 len)
 Uint32 SDL_DequeueAudio(SDL_AudioDeviceID devid, void *data, Uint32 len)
 {
     SDL_AudioDevice *device = get_audio_device(devid);
+    SDL_mutex *lock;
     Uint32 rc;
 
     if ((len == 0) ||                                                     /* nothing to do? */
@@ -621,9 +627,10 @@ Uint32 SDL_DequeueAudio(SDL_AudioDeviceID devid, void *data, Uint32 len)
         return 0;                                                         /* just report zero bytes dequeued. */
     }
 
-    current_audio.impl.LockDevice(device);
+    lock = SDL_GetDataQueueMutex(device->buffer_queue);
+    SDL_LockMutex(lock);
     rc = (Uint32)SDL_ReadFromDataQueue(device->buffer_queue, data, len);
-    current_audio.impl.UnlockDevice(device);
+    SDL_UnlockMutex(lock);
     return rc;
 }
 
@@ -639,9 +646,7 @@ Uint32 SDL_GetQueuedAudioSize(SDL_AudioDeviceID devid)
     /* Nothing to do unless we're set up for queueing. */
     if (device->callbackspec.callback == SDL_BufferQueueDrainCallback ||
         device->callbackspec.callback == SDL_BufferQueueFillCallback) {
-        current_audio.impl.LockDevice(device);
         retval = (Uint32)SDL_CountDataQueue(device->buffer_queue);
-        current_audio.impl.UnlockDevice(device);
     }
 
     return retval;
@@ -655,12 +660,14 @@ void SDL_ClearQueuedAudio(SDL_AudioDeviceID devid)
         return; /* nothing to do. */
     }
 
-    /* Blank out the device and release the mutex. Free it afterwards. */
+    /* Clearing reads from the queue, so keep both the device thread and
+       other application threads off the reading side while it runs. */
     current_audio.impl.LockDevice(device);
+    SDL_LockMutex(SDL_GetDataQueueMutex(device->buffer_queue));
 
-    /* Keep up to two packets in the pool to reduce future memory allocation pressure. */
-    SDL_ClearDataQueue(device->buffer_queue, SDL_AUDIOBUFFERQUEUE_PACKETLEN * 2);
+    SDL_ClearDataQueue(device->buffer_queue, 0);
 
+    SDL_UnlockMutex(SDL_GetDataQueueMutex(device->buffer_queue));
     current_audio.impl.UnlockDevice(device);
 }
 
@@ -1401,7 +1408,7 @@ static SDL_AudioDeviceID open_audio_device(const char *devname, int iscapture,
         }
     }
 
-    device = (SDL_AudioDevice *)SDL_calloc(1, sizeof(SDL_AudioDevice));
+    device = (SDL_AudioDevice *)SDL_TaggedCalloc(SDL_MEMORY_TAG_AUDIO, 1, sizeof(SDL_AudioDevice));
     if (device == NULL) {
         SDL_OutOfMemory();
         return 0;
@@ -1493,8 +1500,8 @@ static SDL_AudioDeviceID open_audio_device(const char *devname, int iscapture,
     }
 
     if (device->spec.callback == NULL) { /* use buffer queueing? */
-        /* pool a few packets to start. Enough for two callbacks. */
-        device->buffer_queue = SDL_NewDataQueue(SDL_AUDIOBUFFERQUEUE_PACKETLEN, obtained->size * 2);
+        /* start with enough room for a few callbacks, it grows as needed. */
+        device->buffer_queue = SDL_NewRingDataQueue(SDL_max(SDL_AUDIOBUFFERQUEUE_PACKETLEN, obtained->size * 4));
         if (!device->buffer_queue) {
             close_audio_device(device);
             SDL_SetError("Couldn't create audio buffer queue");
@@ -1511,7 +1518,7 @@ static SDL_AudioDeviceID open_audio_device(const char *devname, int iscapture,
     }
     SDL_assert(device->work_buffer_len > 0);
 
-    device->work_buffer = (Uint8 *)SDL_malloc(device->work_buffer_len);
+    device->work_buffer = (Uint8 *)SDL_TaggedMalloc(SDL_MEMORY_TAG_AUDIO, device->work_buffer_len);
     if (device->work_buffer == NULL) {
         close_audio_device(device);
         SDL_OutOfMemory();
@@ -29,6 +29,7 @@
 #include "SDL_loadso.h"
 #include "../SDL_dataqueue.h"
 #include "SDL_cpuinfo.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
 
 #define DEBUG_AUDIOSTREAM 0
 
@@ -181,7 +182,26 @@ static void SDLCALL SDL_ConvertMonoToStereo_SSE(SDL_AudioCVT *cvt, SDL_AudioForm
 
 #include "SDL_audio_resampler_filter.h"
 
-static Sint32 ResamplerPadding(const Sint32 inrate, const Sint32 outrate)
+/* Input frames before the source frame that can contribute to an output frame */
+#define RESAMPLER_LEFT_TAPS  RESAMPLER_ZERO_CROSSINGS
+/* Input frames that can contribute to an output frame, rounded up for SIMD */
+#define RESAMPLER_TAPS       (((2 * RESAMPLER_ZERO_CROSSINGS) + 2 + 3) & ~3)
+
+/* The window of input frames each SDL_AudioResampleQuality looks at */
+typedef struct SDL_ResampleKernel
+{
+    int left_taps; /* input frames before the source frame */
+    int taps;      /* all input frames, including the source frame */
+} SDL_ResampleKernel;
+
+static const SDL_ResampleKernel ResampleKernels[] = {
+    { 0, 1 },                                  /* SDL_AUDIO_RESAMPLE_ZERO_ORDER_HOLD */
+    { 0, 2 },                                  /* SDL_AUDIO_RESAMPLE_LINEAR */
+    { 1, 4 },                                  /* SDL_AUDIO_RESAMPLE_CUBIC */
+    { RESAMPLER_LEFT_TAPS, RESAMPLER_TAPS }    /* SDL_AUDIO_RESAMPLE_HIGH */
+};
+
+static Sint32 ResamplerPadding(const SDL_AudioResampleQuality quality, const Sint32 inrate, const Sint32 outrate)
 {
     /* This function uses integer arithmetics to avoid precision loss caused
      * by large floating point numbers. Sint32 is needed for the large number
@@ -190,14 +210,514 @@ static Sint32 ResamplerPadding(const Sint32 inrate, const Sint32 outrate)
     if (inrate == outrate) {
         return 0;
     }
+    if (quality != SDL_AUDIO_RESAMPLE_HIGH) {
+        /* The short kernels only need their own window, keep at least a frame so the padding buffers exist */
+        const SDL_ResampleKernel *kernel = &ResampleKernels[quality];
+        return SDL_max(SDL_max(kernel->left_taps, kernel->taps - kernel->left_taps - 1), 1);
+    }
     if (inrate > outrate) {
         return (RESAMPLER_SAMPLES_PER_ZERO_CROSSING * inrate + outrate - 1) / outrate;
     }
     return RESAMPLER_SAMPLES_PER_ZERO_CROSSING;
 }
 
-/* lpadding and rpadding are expected to be buffers of (ResamplePadding(inrate, outrate) * chans * sizeof(float)) bytes. */
-static int SDL_ResampleAudio(const int chans, const int inrate, const int outrate,
+/* For the common rate pairs, inrate/outrate reduces to a fraction with a small
+   denominator, so an output frame can only land on a handful of positions
+   ("phases") between two input frames. The polyphase resampler precomputes the
+   filter taps for each of them once, which turns the inner loop into a plain
+   dot product over a fixed window of input frames. 44100 -> 48000 has 160
+   phases, for example. */
+
+/* Don't bother with a filter bank for unusual rate pairs */
+#define RESAMPLER_MAX_PHASES 1024
+
+typedef struct SDL_ResamplerBank SDL_ResamplerBank;
+
+typedef void (*SDL_ResampleSpanFunc)(const SDL_ResamplerBank *bank, const float *inbuf, int srcindex, int phase, float *dst, int frames);
+
+struct SDL_ResamplerBank
+{
+    int chans;
+    int left_taps;  /* input frames before the source frame */
+    int taps;       /* input frames per output frame, the SIMD spans need a multiple of 4 */
+    int numerator;  /* inrate / gcd(inrate, outrate) */
+    int phases;     /* outrate / gcd(inrate, outrate) */
+    int step;       /* whole input frames per output frame */
+    int phase_step; /* remaining fraction of an input frame per output frame, in phases */
+    float *coefs;   /* phases * taps taps, each repeated for every channel */
+    SDL_ResampleSpanFunc span;
+};
+
+/* Move on to the next output frame in the SDL_ResampleSpan_* functions */
+#define RESAMPLER_NEXT_FRAME()  \
+    dst += chans;               \
+    src += step;                \
+    phase += phase_step;        \
+    if (phase >= phases) {      \
+        phase -= phases;        \
+        src += chans;           \
+    }
+
+#define RESAMPLER_SPAN_LOCALS()                                                     \
+    const int chans = bank->chans;                                                  \
+    const int stride = bank->taps * chans;                                          \
+    const int step = bank->step * chans;                                            \
+    const int phase_step = bank->phase_step;                                        \
+    const int phases = bank->phases;                                                \
+    const float *src = inbuf + ((srcindex - bank->left_taps) * chans)
+
+static void SDL_ResampleSpan_Scalar(const SDL_ResamplerBank *bank, const float *inbuf, int srcindex, int phase, float *dst, int frames)
+{
+    RESAMPLER_SPAN_LOCALS();
+    int k, chan;
+
+    while (frames--) {
+        const float *coefs = bank->coefs + (phase * stride);
+        for (chan = 0; chan < chans; chan++) {
+            float outsample = 0.0f;
+            for (k = chan; k < stride; k += chans) {
+                outsample += coefs[k] * src[k];
+            }
+            dst[chan] = outsample;
+        }
+        RESAMPLER_NEXT_FRAME();
+    }
+}
+
+/* The short kernels don't have enough taps to fill a vector, but they don't need the generic tap loop either */
+static void SDL_ResampleSpan_ZeroOrderHold(const SDL_ResamplerBank *bank, const float *inbuf, int srcindex, int phase, float *dst, int frames)
+{
+    RESAMPLER_SPAN_LOCALS();
+    int chan;
+
+    (void)stride;
+    while (frames--) {
+        for (chan = 0; chan < chans; chan++) {
+            dst[chan] = src[chan];
+        }
+        RESAMPLER_NEXT_FRAME();
+    }
+}
+
+static void SDL_ResampleSpan_Linear(const SDL_ResamplerBank *bank, const float *inbuf, int srcindex, int phase, float *dst, int frames)
+{
+    RESAMPLER_SPAN_LOCALS();
+    int chan;
+
+    while (frames--) {
+        const float *coefs = bank->coefs + (phase * stride);
+        const float coef0 = coefs[0];
+        const float coef1 = coefs[chans];
+        for (chan = 0; chan < chans; chan++) {
+            dst[chan] = (src[chan] * coef0) + (src[chans + chan] * coef1);
+        }
+        RESAMPLER_NEXT_FRAME();
+    }
+}
+
+#ifdef HAVE_SSE_INTRINSICS
+static void SDL_ResampleSpan_SSE(const SDL_ResamplerBank *bank, const float *inbuf, int srcindex, int phase, float *dst, int frames)
+{
+    RESAMPLER_SPAN_LOCALS();
+    int k;
+
+    switch (chans) {
+    case 1:
+        while (frames--) {
+            const float *coefs = bank->coefs + (phase * stride);
+            __m128 acc = _mm_mul_ps(_mm_load_ps(coefs), _mm_loadu_ps(src));
+            for (k = 4; k < stride; k += 4) {
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_load_ps(coefs + k), _mm_loadu_ps(src + k)));
+            }
+            acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+            acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1, 1, 1, 1)));
+            _mm_store_ss(dst, acc);
+            RESAMPLER_NEXT_FRAME();
+        }
+        break;
+    case 2:
+        while (frames--) {
+            const float *coefs = bank->coefs + (phase * stride);
+            __m128 acc = _mm_mul_ps(_mm_load_ps(coefs), _mm_loadu_ps(src));
+            for (k = 4; k < stride; k += 4) {
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_load_ps(coefs + k), _mm_loadu_ps(src + k)));
+            }
+            acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+            _mm_storel_pi((__m64 *)dst, acc);
+            RESAMPLER_NEXT_FRAME();
+        }
+        break;
+    case 4:
+        while (frames--) {
+            const float *coefs = bank->coefs + (phase * stride);
+            __m128 acc = _mm_mul_ps(_mm_load_ps(coefs), _mm_loadu_ps(src));
+            for (k = 4; k < stride; k += 4) {
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_load_ps(coefs + k), _mm_loadu_ps(src + k)));
+            }
+            _mm_storeu_ps(dst, acc);
+            RESAMPLER_NEXT_FRAME();
+        }
+        break;
+    case 8:
+        while (frames--) {
+            const float *coefs = bank->coefs + (phase * stride);
+            __m128 acc0 = _mm_mul_ps(_mm_load_ps(coefs), _mm_loadu_ps(src));
+            __m128 acc1 = _mm_mul_ps(_mm_load_ps(coefs + 4), _mm_loadu_ps(src + 4));
+            for (k = 8; k < stride; k += 8) {
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load_ps(coefs + k), _mm_loadu_ps(src + k)));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load_ps(coefs + k + 4), _mm_loadu_ps(src + k + 4)));
+            }
+            _mm_storeu_ps(dst, acc0);
+            _mm_storeu_ps(dst + 4, acc1);
+            RESAMPLER_NEXT_FRAME();
+        }
+        break;
+    default:
+        SDL_assert(!"unsupported channel count");
+        break;
+    }
+}
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+/* Mono doesn't fill an AVX register evenly, it's left to the SSE version */
+static void SDL_TARGETING_AVX2 SDL_ResampleSpan_AVX2(const SDL_ResamplerBank *bank, const float *inbuf, int srcindex, int phase, float *dst, int frames)
+{
+    RESAMPLER_SPAN_LOCALS();
+    int k;
+
+    switch (chans) {
+    case 2:
+        while (frames--) {
+            const float *coefs = bank->coefs + (phase * stride);
+            __m256 acc = _mm256_mul_ps(_mm256_loadu_ps(coefs), _mm256_loadu_ps(src));
+            __m128 sum;
+            for (k = 8; k < stride; k += 8) {
+                acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(coefs + k), _mm256_loadu_ps(src + k)));
+            }
+            sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+            sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+            _mm_storel_pi((__m64 *)dst, sum);
+            RESAMPLER_NEXT_FRAME();
+        }
+        break;
+    case 4:
+        while (frames--) {
+            const float *coefs = bank->coefs + (phase * stride);
+            __m256 acc = _mm256_mul_ps(_mm256_loadu_ps(coefs), _mm256_loadu_ps(src));
+            for (k = 8; k < stride; k += 8) {
+                acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(coefs + k), _mm256_loadu_ps(src + k)));
+            }
+            _mm_storeu_ps(dst, _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1)));
+            RESAMPLER_NEXT_FRAME();
+        }
+        break;
+    case 8:
+        while (frames--) {
+            const float *coefs = bank->coefs + (phase * stride);
+            __m256 acc = _mm256_mul_ps(_mm256_loadu_ps(coefs), _mm256_loadu_ps(src));
+            for (k = 8; k < stride; k += 8) {
+                acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(coefs + k), _mm256_loadu_ps(src + k)));
+            }
+            _mm256_storeu_ps(dst, acc);
+            RESAMPLER_NEXT_FRAME();
+        }
+        break;
+    default:
+        SDL_assert(!"unsupported channel count");
+        break;
+    }
+}
+#endif
+
+#ifdef HAVE_NEON_INTRINSICS
+static void SDL_ResampleSpan_NEON(const SDL_ResamplerBank *bank, const float *inbuf, int srcindex, int phase, float *dst, int frames)
+{
+    RESAMPLER_SPAN_LOCALS();
+    int k;
+
+    switch (chans) {
+    case 1:
+        while (frames--) {
+            const float *coefs = bank->coefs + (phase * stride);
+            float32x4_t acc = vmulq_f32(vld1q_f32(coefs), vld1q_f32(src));
+            float32x2_t sum;
+            for (k = 4; k < stride; k += 4) {
+                acc = vmlaq_f32(acc, vld1q_f32(coefs + k), vld1q_f32(src + k));
+            }
+            sum = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+            sum = vpadd_f32(sum, sum);
+            vst1_lane_f32(dst, sum, 0);
+            RESAMPLER_NEXT_FRAME();
+        }
+        break;
+    case 2:
+        while (frames--) {
+            const float *coefs = bank->coefs + (phase * stride);
+            float32x4_t acc = vmulq_f32(vld1q_f32(coefs), vld1q_f32(src));
+            for (k = 4; k < stride; k += 4) {
+                acc = vmlaq_f32(acc, vld1q_f32(coefs + k), vld1q_f32(src + k));
+            }
+            vst1_f32(dst, vadd_f32(vget_low_f32(acc), vget_high_f32(acc)));
+            RESAMPLER_NEXT_FRAME();
+        }
+        break;
+    case 4:
+        while (frames--) {
+            const float *coefs = bank->coefs + (phase * stride);
+            float32x4_t acc = vmulq_f32(vld1q_f32(coefs), vld1q_f32(src));
+            for (k = 4; k < stride; k += 4) {
+                acc = vmlaq_f32(acc, vld1q_f32(coefs + k), vld1q_f32(src + k));
+            }
+            vst1q_f32(dst, acc);
+            RESAMPLER_NEXT_FRAME();
+        }
+        break;
+    case 8:
+        while (frames--) {
+            const float *coefs = bank->coefs + (phase * stride);
+            float32x4_t acc0 = vmulq_f32(vld1q_f32(coefs), vld1q_f32(src));
+            float32x4_t acc1 = vmulq_f32(vld1q_f32(coefs + 4), vld1q_f32(src + 4));
+            for (k = 8; k < stride; k += 8) {
+                acc0 = vmlaq_f32(acc0, vld1q_f32(coefs + k), vld1q_f32(src + k));
+                acc1 = vmlaq_f32(acc1, vld1q_f32(coefs + k + 4), vld1q_f32(src + k + 4));
+            }
+            vst1q_f32(dst, acc0);
+            vst1q_f32(dst + 4, acc1);
+            RESAMPLER_NEXT_FRAME();
+        }
+        break;
+    default:
+        SDL_assert(!"unsupported channel count");
+        break;
+    }
+}
+#endif
+
+#undef RESAMPLER_SPAN_LOCALS
+#undef RESAMPLER_NEXT_FRAME
+
+static SDL_ResampleSpanFunc SDL_ChooseResampleSpan(const int chans, const int taps)
+{
+    if (taps == 1) {
+        return SDL_ResampleSpan_ZeroOrderHold;
+    }
+    if (taps == 2) {
+        return SDL_ResampleSpan_Linear;
+    }
+    if ((chans != 1 && chans != 2 && chans != 4 && chans != 8) || (taps % 4) != 0) {
+        return SDL_ResampleSpan_Scalar;
+    }
+
+#ifdef HAVE_AVX2_INTRINSICS
+    if (chans != 1 && SDL_HasAVX2()) {
+        return SDL_ResampleSpan_AVX2;
+    }
+#endif
+#ifdef HAVE_SSE_INTRINSICS
+    if (SDL_HasSSE()) {
+        return SDL_ResampleSpan_SSE;
+    }
+#endif
+#ifdef HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return SDL_ResampleSpan_NEON;
+    }
+#endif
+    return SDL_ResampleSpan_Scalar;
+}
+
+/* Work out the filter taps for an output frame srcfraction / outrate of the
+   way from its source frame to the next input frame. The first tap applies
+   to the input frame ResampleKernels[quality].left_taps before the source frame. */
+static void SDL_GetResamplerTaps(const SDL_AudioResampleQuality quality, const Sint32 srcfraction, const int outrate, float *taps)
+{
+    const float t = ((float)srcfraction) / ((float)outrate);
+
+    switch (quality) {
+    case SDL_AUDIO_RESAMPLE_ZERO_ORDER_HOLD:
+        taps[0] = 1.0f;
+        break;
+    case SDL_AUDIO_RESAMPLE_LINEAR:
+        taps[0] = 1.0f - t;
+        taps[1] = t;
+        break;
+    case SDL_AUDIO_RESAMPLE_CUBIC:
+    {
+        /* Catmull-Rom spline through the four nearest input frames */
+        const float t2 = t * t;
+        const float t3 = t2 * t;
+        taps[0] = 0.5f * (-t3 + 2.0f * t2 - t);
+        taps[1] = 0.5f * (3.0f * t3 - 5.0f * t2 + 2.0f);
+        taps[2] = 0.5f * (-3.0f * t3 + 4.0f * t2 + t);
+        taps[3] = 0.5f * (t3 - t2);
+        break;
+    }
+    default:
+    {
+        /* These are the same taps SDL_ResampleAudio() works out for every
+           output frame, see there for the details. */
+        const float interpolation1 = t;
+        const int filterindex1 = srcfraction * RESAMPLER_SAMPLES_PER_ZERO_CROSSING / outrate;
+        const float interpolation2 = 1.0f - interpolation1;
+        const int filterindex2 = (outrate - srcfraction) * RESAMPLER_SAMPLES_PER_ZERO_CROSSING / outrate;
+        int j;
+
+        SDL_memset(taps, 0, RESAMPLER_TAPS * sizeof(float));
+        for (j = 0; (filterindex1 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)) < RESAMPLER_FILTER_SIZE; j++) {
+            const int filt_ind = filterindex1 + j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING;
+            taps[RESAMPLER_LEFT_TAPS - j] = ResamplerFilter[filt_ind] + (interpolation1 * ResamplerFilterDifference[filt_ind]);
+        }
+        for (j = 0; (filterindex2 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)) < RESAMPLER_FILTER_SIZE; j++) {
+            const int filt_ind = filterindex2 + j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING;
+            taps[RESAMPLER_LEFT_TAPS + 1 + j] = ResamplerFilter[filt_ind] + (interpolation2 * ResamplerFilterDifference[filt_ind]);
+        }
+        break;
+    }
+    }
+}
+
+/* Returns NULL without setting an error if the rates don't suit a filter bank */
+static SDL_ResamplerBank *SDL_CreateResamplerBank(const SDL_AudioResampleQuality quality, const int chans, const int inrate, const int outrate)
+{
+    const SDL_ResampleKernel *kernel = &ResampleKernels[quality];
+    SDL_ResamplerBank *bank;
+    int gcd = inrate, rem = outrate;
+    int phase, k, chan;
+
+    if (inrate <= 0 || outrate <= 0) {
+        return NULL;
+    }
+    while (rem) {
+        const int tmp = gcd % rem;
+        gcd = rem;
+        rem = tmp;
+    }
+    if ((outrate / gcd) > RESAMPLER_MAX_PHASES) {
+        return NULL;
+    }
+
+    bank = (SDL_ResamplerBank *)SDL_TaggedMalloc(SDL_MEMORY_TAG_AUDIO, sizeof(*bank));
+    if (!bank) {
+        return NULL;
+    }
+    bank->chans = chans;
+    bank->left_taps = kernel->left_taps;
+    bank->taps = kernel->taps;
+    bank->numerator = inrate / gcd;
+    bank->phases = outrate / gcd;
+    bank->step = bank->numerator / bank->phases;
+    bank->phase_step = bank->numerator % bank->phases;
+    bank->span = SDL_ChooseResampleSpan(chans, bank->taps);
+    bank->coefs = (float *)SDL_TaggedSIMDAlloc(SDL_MEMORY_TAG_AUDIO, (size_t)bank->phases * bank->taps * chans * sizeof(float));
+    if (!bank->coefs) {
+        SDL_free(bank);
+        return NULL;
+    }
+
+    /* Phase p is the output frame position p * gcd / outrate between two input frames. */
+    for (phase = 0; phase < bank->phases; phase++) {
+        float taps[RESAMPLER_TAPS];
+        float *coefs = bank->coefs + ((size_t)phase * bank->taps * chans);
+
+        SDL_GetResamplerTaps(quality, phase * gcd, outrate, taps);
+        for (k = 0; k < bank->taps; k++) {
+            for (chan = 0; chan < chans; chan++) {
+                *(coefs++) = taps[k];
+            }
+        }
+    }
+
+    return bank;
+}
+
+static void SDL_DestroyResamplerBank(SDL_ResamplerBank *bank)
+{
+    if (bank) {
+        SDL_SIMDFree(bank->coefs);
+        SDL_free(bank);
+    }
+}
+
+/* Resample one output frame whose window may reach into the padding.
+   taps[k * tapstride] is the tap for input frame srcindex - kernel->left_taps + k. */
+static void SDL_ResampleEdgeFrame(const int chans, const SDL_ResampleKernel *kernel,
+                                  const float *taps, const int tapstride,
+                                  const int paddinglen, const float *lpadding, const float *rpadding,
+                                  const float *inbuf, const int inframes,
+                                  const int srcindex, float *dst)
+{
+    int k, chan;
+
+    for (chan = 0; chan < chans; chan++) {
+        dst[chan] = 0.0f;
+    }
+
+    for (k = 0; k < kernel->taps; k++) {
+        const int srcframe = srcindex - kernel->left_taps + k;
+        const float *src;
+
+        if (srcframe < 0) {
+            src = lpadding + ((paddinglen + srcframe) * chans);
+        } else if (srcframe >= inframes) {
+            src = rpadding + ((srcframe - inframes) * chans);
+        } else {
+            src = inbuf + (srcframe * chans);
+        }
+
+        for (chan = 0; chan < chans; chan++) {
+            dst[chan] += taps[k * tapstride] * src[chan];
+        }
+    }
+}
+
+static void SDL_ResampleAudioPolyphase(const SDL_ResamplerBank *bank, const int paddinglen,
+                                       const float *lpadding, const float *rpadding,
+                                       const float *inbuf, const int inframes,
+                                       float *outbuf, const int outframes)
+{
+    const int chans = bank->chans;
+    const int righttaps = bank->taps - bank->left_taps - 1;
+    /* Output frames in [first, last) have their whole window inside inbuf */
+    const int first = (int)(((Sint64)bank->left_taps * bank->phases + bank->numerator - 1) / bank->numerator);
+    const int last = (inframes > righttaps) ? (int)SDL_min(((Sint64)(inframes - righttaps) * bank->phases + bank->numerator - 1) / bank->numerator, outframes) : 0;
+    SDL_ResampleKernel kernel;
+    float *dst = outbuf;
+    int srcindex = 0, phase = 0;
+    int i = 0;
+
+    kernel.left_taps = bank->left_taps;
+    kernel.taps = bank->taps;
+
+    while (i < outframes) {
+        if (i >= first && i < last) {
+            const Sint64 pos = (Sint64)last * bank->numerator;
+            bank->span(bank, inbuf, srcindex, phase, dst, last - i);
+            dst += (last - i) * chans;
+            i = last;
+            srcindex = (int)(pos / bank->phases);
+            phase = (int)(pos % bank->phases);
+            continue;
+        }
+
+        SDL_ResampleEdgeFrame(chans, &kernel, bank->coefs + ((size_t)phase * bank->taps * chans), chans,
+                              paddinglen, lpadding, rpadding, inbuf, inframes, srcindex, dst);
+        dst += chans;
+        i++;
+        srcindex += bank->step;
+        phase += bank->phase_step;
+        if (phase >= bank->phases) {
+            phase -= bank->phases;
+            srcindex++;
+        }
+    }
+}
+
+/* lpadding and rpadding are expected to be buffers of (ResamplePadding(quality, inrate, outrate) * chans * sizeof(float)) bytes.
+   bank is optional, without it the filter taps are worked out for every output frame. */
+static int SDL_ResampleAudio(const SDL_AudioResampleQuality quality,
+                             const int chans, const int inrate, const int outrate,
+                             const SDL_ResamplerBank *bank,
                              const float *lpadding, const float *rpadding,
                              const float *inbuf, const int inbuflen,
                              float *outbuf, const int outbuflen)
@@ -208,7 +728,7 @@ static int SDL_ResampleAudio(const int chans, const int inrate, const int outrat
      * assumed to be non-negative so that division rounds by truncation and
      * modulo is always non-negative. Note that the operator order is important
      * for these integer divisions. */
-    const int paddinglen = ResamplerPadding(inrate, outrate);
+    const int paddinglen = ResamplerPadding(quality, inrate, outrate);
     const int framelen = chans * (int)sizeof(float);
     const int inframes = inbuflen / framelen;
     /* outbuflen isn't total to write, it's total available. */
@@ -218,6 +738,27 @@ static int SDL_ResampleAudio(const int chans, const int inrate, const int outrat
     float *dst = outbuf;
     int i, j, chan;
 
+    if (bank) {
+        SDL_assert(bank->chans == chans);
+        SDL_ResampleAudioPolyphase(bank, paddinglen, lpadding, rpadding, inbuf, inframes, outbuf, outframes);
+        return outframes * chans * sizeof(float);
+    }
+
+    if (quality != SDL_AUDIO_RESAMPLE_HIGH) {
+        const SDL_ResampleKernel *kernel = &ResampleKernels[quality];
+        float taps[RESAMPLER_TAPS];
+
+        for (i = 0; i < outframes; i++) {
+            const int srcindex = (int)((Sint64)i * inrate / outrate);
+            const int srcfraction = ((Sint64)i) * inrate % outrate;
+
+            SDL_GetResamplerTaps(quality, srcfraction, outrate, taps);
+            SDL_ResampleEdgeFrame(chans, kernel, taps, 1, paddinglen, lpadding, rpadding, inbuf, inframes, srcindex, dst);
+            dst += chans;
+        }
+        return outframes * chans * sizeof(float);
+    }
+
     for (i = 0; i < outframes; i++) {
         const int srcindex = (int)((Sint64)i * inrate / outrate);
         /* Calculating the following way avoids subtraction or modulo of large
@@ -506,7 +1047,8 @@ static void SDL_ResampleCVT(SDL_AudioCVT *cvt, const int chans, const SDL_AudioF
     /* !!! FIXME: remove this if we can get the resampler to work in-place again. */
     float *dst = (float *)(cvt->buf + srclen);
     const int dstlen = (cvt->len * cvt->len_mult) - srclen;
-    const int requestedpadding = ResamplerPadding(inrate, outrate);
+    const int requestedpadding = ResamplerPadding(SDL_AUDIO_RESAMPLE_HIGH, inrate, outrate);
+    SDL_ResamplerBank *bank = NULL;
     int paddingsamples;
     float *padding;
 
@@ -518,14 +1060,20 @@ static void SDL_ResampleCVT(SDL_AudioCVT *cvt, const int chans, const SDL_AudioF
     SDL_assert(format == AUDIO_F32SYS);
 
     /* we keep no streaming state here, so pad with silence on both ends. */
-    padding = (float *)SDL_calloc(paddingsamples ? paddingsamples : 1, sizeof(float));
+    padding = (float *)SDL_TaggedCalloc(SDL_MEMORY_TAG_AUDIO, paddingsamples ? paddingsamples : 1, sizeof(float));
     if (!padding) {
         SDL_OutOfMemory();
         return;
     }
 
-    cvt->len_cvt = SDL_ResampleAudio(chans, inrate, outrate, padding, padding, src, srclen, dst, dstlen);
+    /* Building a filter bank only pays off if it's used for more output frames than it has phases */
+    if (((Sint64)srclen / (chans * (int)sizeof(float))) * outrate / inrate > RESAMPLER_MAX_PHASES) {
+        bank = SDL_CreateResamplerBank(SDL_AUDIO_RESAMPLE_HIGH, chans, inrate, outrate);
+    }
+
+    cvt->len_cvt = SDL_ResampleAudio(SDL_AUDIO_RESAMPLE_HIGH, chans, inrate, outrate, bank, padding, padding, src, srclen, dst, dstlen);
 
+    SDL_DestroyResamplerBank(bank);
     SDL_free(padding);
 
     SDL_memmove(cvt->buf, dst, cvt->len_cvt); /* !!! FIXME: remove this if we can get the resampler to work in-place again. */
@@ -863,9 +1411,11 @@ struct _SDL_AudioStream
     double rate_incr;
     Uint8 pre_resample_channels;
     int packetlen;
+    SDL_AudioResampleQuality resample_quality;
     int resampler_padding_samples;
     float *resampler_padding;
     void *resampler_state;
+    SDL_ResamplerBank *resampler_bank;
     SDL_ResampleAudioStreamFunc resampler_func;
     SDL_ResetAudioStreamResamplerFunc reset_resampler_func;
     SDL_CleanupAudioStreamResamplerFunc cleanup_resampler_func;
@@ -879,7 +1429,7 @@ static Uint8 *EnsureStreamBufferSize(SDL_AudioStream *stream, int newlen)
     if (stream->work_buffer_len >= newlen) {
         ptr = stream->work_buffer_base;
     } else {
-        ptr = (Uint8 *)SDL_realloc(stream->work_buffer_base, (size_t)newlen + 32);
+        ptr = (Uint8 *)SDL_TaggedRealloc(SDL_MEMORY_TAG_AUDIO, stream->work_buffer_base, (size_t)newlen + 32);
         if (!ptr) {
             SDL_OutOfMemory();
             return NULL;
@@ -988,7 +1538,7 @@ static int SDL_ResampleAudioStream(SDL_AudioStream *stream, const void *_inbuf,
 
     SDL_assert(inbuf != ((const float *)outbuf)); /* SDL_AudioStreamPut() shouldn't allow in-place resamples. */
 
-    retval = SDL_ResampleAudio(chans, inrate, outrate, lpadding, rpadding, inbuf, inbuflen, outbuf, outbuflen);
+    retval = SDL_ResampleAudio(stream->resample_quality, chans, inrate, outrate, stream->resampler_bank, lpadding, rpadding, inbuf, inbuflen, outbuf, outbuflen);
 
     /* update our left padding with end of current input, for next run. */
     SDL_memcpy((lpadding + paddingsamples) - (cpy / sizeof(float)), inbufend - cpy, cpy);
@@ -1004,7 +1554,77 @@ static void SDL_ResetAudioStreamResampler(SDL_AudioStream *stream)
 
 static void SDL_CleanupAudioStreamResampler(SDL_AudioStream *stream)
 {
+    SDL_DestroyResamplerBank(stream->resampler_bank);
+    stream->resampler_bank = NULL;
     SDL_free(stream->resampler_state);
+
+    stream->resampler_state = NULL;
+    stream->resampler_func = NULL;
+    stream->reset_resampler_func = NULL;
+    stream->cleanup_resampler_func = NULL;
+}
+
+/* Set up the padding, staging buffer and resampler for the stream's rates and
+   quality. Any input held back for the old resampler is dropped. The stream is
+   left as it was if this fails. */
+static int SDL_SetupAudioStreamResampler(SDL_AudioStream *stream, const SDL_AudioResampleQuality quality)
+{
+    const int chans = stream->pre_resample_channels;
+    const int paddingsamples = ResamplerPadding(quality, stream->src_rate, stream->dst_rate) * chans;
+    const int stagingsize = (paddingsamples / chans) * stream->src_sample_frame_size;
+    float *padding;
+    Uint8 *staging = NULL;
+    float *state = NULL;
+
+    padding = (float *)SDL_TaggedCalloc(SDL_MEMORY_TAG_AUDIO, paddingsamples ? paddingsamples : 1, sizeof(float));
+    if (stagingsize > 0) {
+        staging = (Uint8 *)SDL_TaggedMalloc(SDL_MEMORY_TAG_AUDIO, stagingsize);
+    }
+    if (stream->src_rate != stream->dst_rate) {
+        state = (float *)SDL_TaggedCalloc(SDL_MEMORY_TAG_AUDIO, paddingsamples, sizeof(float));
+    }
+    if (!padding || (stagingsize > 0 && !staging) || (stream->src_rate != stream->dst_rate && !state)) {
+        SDL_free(padding);
+        SDL_free(staging);
+        SDL_free(state);
+        return SDL_OutOfMemory();
+    }
+
+    if (stream->cleanup_resampler_func) {
+        stream->cleanup_resampler_func(stream);
+    }
+    SDL_free(stream->resampler_padding);
+    SDL_free(stream->staging_buffer);
+
+    stream->resample_quality = quality;
+    stream->resampler_padding_samples = paddingsamples;
+    stream->resampler_padding = padding;
+    stream->staging_buffer = staging;
+    stream->staging_buffer_size = stagingsize;
+    stream->staging_buffer_filled = 0;
+    stream->first_run = SDL_TRUE;
+
+    if (stream->src_rate == stream->dst_rate) {
+        return 0;
+    }
+
+#ifdef HAVE_LIBSAMPLERATE_H
+    /* libsamplerate replaces the built-in sinc filter, the cheaper filters are always ours */
+    if (quality == SDL_AUDIO_RESAMPLE_HIGH && SetupLibSampleRateResampling(stream)) {
+        SDL_free(state);
+        return 0;
+    }
+#endif
+
+    stream->resampler_state = state;
+
+    /* Without a filter bank we just take the slower path */
+    stream->resampler_bank = SDL_CreateResamplerBank(quality, chans, stream->src_rate, stream->dst_rate);
+
+    stream->resampler_func = SDL_ResampleAudioStream;
+    stream->reset_resampler_func = SDL_ResetAudioStreamResampler;
+    stream->cleanup_resampler_func = SDL_CleanupAudioStreamResampler;
+    return 0;
 }
 
 SDL_AudioStream *SDL_NewAudioStream(const SDL_AudioFormat src_format,
@@ -1028,7 +1648,7 @@ SDL_AudioStream *SDL_NewAudioStream(const SDL_AudioFormat src_format,
         return NULL;
     }
 
-    retval = (SDL_AudioStream *)SDL_calloc(1, sizeof(SDL_AudioStream));
+    retval = (SDL_AudioStream *)SDL_TaggedCalloc(SDL_MEMORY_TAG_AUDIO, 1, sizeof(SDL_AudioStream));
     if (!retval) {
         SDL_OutOfMemory();
         return NULL;
@@ -1052,25 +1672,12 @@ SDL_AudioStream *SDL_NewAudioStream(const SDL_AudioFormat src_format,
     retval->pre_resample_channels = pre_resample_channels;
     retval->packetlen = packetlen;
     retval->rate_incr = ((double)dst_rate) / ((double)src_rate);
-    retval->resampler_padding_samples = ResamplerPadding(retval->src_rate, retval->dst_rate) * pre_resample_channels;
-    retval->resampler_padding = (float *)SDL_calloc(retval->resampler_padding_samples ? retval->resampler_padding_samples : 1, sizeof(float));
 
-    if (!retval->resampler_padding) {
+    if (SDL_SetupAudioStreamResampler(retval, SDL_AUDIO_RESAMPLE_HIGH) < 0) {
         SDL_FreeAudioStream(retval);
-        SDL_OutOfMemory();
         return NULL;
     }
 
-    retval->staging_buffer_size = ((retval->resampler_padding_samples / retval->pre_resample_channels) * retval->src_sample_frame_size);
-    if (retval->staging_buffer_size > 0) {
-        retval->staging_buffer = (Uint8 *)SDL_malloc(retval->staging_buffer_size);
-        if (!retval->staging_buffer) {
-            SDL_FreeAudioStream(retval);
-            SDL_OutOfMemory();
-            return NULL;
-        }
-    }
-
     /* Not resampling? It's an easy conversion (and maybe not even that!) */
     if (src_rate == dst_rate) {
         retval->cvt_before_resampling.needed = SDL_FALSE;
@@ -1086,23 +1693,6 @@ SDL_AudioStream *SDL_NewAudioStream(const SDL_AudioFormat src_format,
             return NULL; /* SDL_BuildAudioCVT should have called SDL_SetError. */
         }
 
-#ifdef HAVE_LIBSAMPLERATE_H
-        SetupLibSampleRateResampling(retval);
-#endif
-
-        if (!retval->resampler_func) {
-            retval->resampler_state = SDL_calloc(retval->resampler_padding_samples, sizeof(float));
-            if (!retval->resampler_state) {
-                SDL_FreeAudioStream(retval);
-                SDL_OutOfMemory();
-                return NULL;
-            }
-
-            retval->resampler_func = SDL_ResampleAudioStream;
-            retval->reset_resampler_func = SDL_ResetAudioStreamResampler;
-            retval->cleanup_resampler_func = SDL_CleanupAudioStreamResampler;
-        }
-
         /* Convert us to the final format after resampling. */
         if (SDL_BuildAudioCVT(&retval->cvt_after_resampling, AUDIO_F32SYS, pre_resample_channels, dst_rate, dst_format, dst_channels, dst_rate) < 0) {
             SDL_FreeAudioStream(retval);
@@ -1411,6 +2001,25 @@ void SDL_AudioStreamClear(SDL_AudioStream *stream)
     }
 }
 
+int SDL_AudioStreamSetResampleQuality(SDL_AudioStream *stream, SDL_AudioResampleQuality quality)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    }
+    if ((int)quality < SDL_AUDIO_RESAMPLE_ZERO_ORDER_HOLD || quality > SDL_AUDIO_RESAMPLE_HIGH) {
+        return SDL_InvalidParamError("quality");
+    }
+    if (quality == stream->resample_quality) {
+        return 0;
+    }
+    return SDL_SetupAudioStreamResampler(stream, quality);
+}
+
+SDL_AudioResampleQuality SDL_AudioStreamGetResampleQuality(SDL_AudioStream *stream)
+{
+    return stream ? stream->resample_quality : SDL_AUDIO_RESAMPLE_HIGH;
+}
+
 /* dispose of a stream */
 void SDL_FreeAudioStream(SDL_AudioStream *stream)
 {
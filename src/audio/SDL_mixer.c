@@ -26,6 +26,15 @@
 #include "SDL_timer.h"
 #include "SDL_audio.h"
 #include "SDL_sysaudio.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
+
+#ifdef __ARM_NEON
+#define HAVE_NEON_INTRINSICS 1
+#endif
+
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
 
 /* This table is used to add two sound values together and pin
  * the value to avoid overflow.  (used with permission from ARDI)
@@ -85,13 +94,292 @@ static const Uint8 mix8[] = {
 #define ADJUST_VOLUME_U8(s, v)  (s = (((s - 128) * v) / SDL_MIX_MAXVOLUME) + 128)
 #define ADJUST_VOLUME_U16(s, v) (s = (((s - 32768) * v) / SDL_MIX_MAXVOLUME) + 32768)
 
+/* The SIMD mixers handle native endian S16, S32 and F32 with a volume of at
+   most SDL_MIX_MAXVOLUME, and give the same results as the scalar code below.
+   They return how many bytes they mixed, the scalar code does the rest. */
+typedef Uint32 (*SDL_MixFunc)(Uint8 *dst, const Uint8 *src, Uint32 len, int volume);
+
+#ifdef HAVE_SSE2_INTRINSICS
+static Uint32 SDL_MixS16_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    const Uint32 blocks = len / 16;
+    Uint32 i;
+
+    if (volume == SDL_MIX_MAXVOLUME) {
+        for (i = 0; i < blocks; i++) {
+            const __m128i a = _mm_loadu_si128((const __m128i *)(src + (i * 16)));
+            const __m128i b = _mm_loadu_si128((const __m128i *)(dst + (i * 16)));
+            _mm_storeu_si128((__m128i *)(dst + (i * 16)), _mm_adds_epi16(a, b));
+        }
+    } else {
+        const __m128i vol = _mm_set1_epi16((Sint16)volume);
+        const __m128i bias = _mm_set1_epi32(SDL_MIX_MAXVOLUME - 1);
+        for (i = 0; i < blocks; i++) {
+            const __m128i a = _mm_loadu_si128((const __m128i *)(src + (i * 16)));
+            const __m128i b = _mm_loadu_si128((const __m128i *)(dst + (i * 16)));
+            const __m128i lo = _mm_mullo_epi16(a, vol);
+            const __m128i hi = _mm_mulhi_epi16(a, vol);
+            __m128i p0 = _mm_unpacklo_epi16(lo, hi);
+            __m128i p1 = _mm_unpackhi_epi16(lo, hi);
+            /* Divide by SDL_MIX_MAXVOLUME rounding towards zero, like C does */
+            p0 = _mm_srai_epi32(_mm_add_epi32(p0, _mm_and_si128(_mm_srai_epi32(p0, 31), bias)), 7);
+            p1 = _mm_srai_epi32(_mm_add_epi32(p1, _mm_and_si128(_mm_srai_epi32(p1, 31), bias)), 7);
+            _mm_storeu_si128((__m128i *)(dst + (i * 16)), _mm_adds_epi16(_mm_packs_epi32(p0, p1), b));
+        }
+    }
+    return blocks * 16;
+}
+
+/* Two samples at a time; doubles hold the scaled sample and the sum exactly */
+static SDL_INLINE __m128i SDL_MixS32Pair_SSE2(__m128i a, __m128i b, __m128d vol, __m128d minval, __m128d maxval)
+{
+    const __m128i scaled = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtepi32_pd(a), vol));
+    const __m128d sum = _mm_add_pd(_mm_cvtepi32_pd(scaled), _mm_cvtepi32_pd(b));
+    return _mm_cvttpd_epi32(_mm_max_pd(_mm_min_pd(sum, maxval), minval));
+}
+
+static Uint32 SDL_MixS32_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    const Uint32 blocks = len / 16;
+    const __m128d vol = _mm_set1_pd((double)volume / SDL_MIX_MAXVOLUME);
+    const __m128d minval = _mm_set1_pd((double)SDL_MIN_SINT32);
+    const __m128d maxval = _mm_set1_pd((double)SDL_MAX_SINT32);
+    Uint32 i;
+
+    for (i = 0; i < blocks; i++) {
+        const __m128i a = _mm_loadu_si128((const __m128i *)(src + (i * 16)));
+        const __m128i b = _mm_loadu_si128((const __m128i *)(dst + (i * 16)));
+        const __m128i r0 = SDL_MixS32Pair_SSE2(a, b, vol, minval, maxval);
+        const __m128i r1 = SDL_MixS32Pair_SSE2(_mm_unpackhi_epi64(a, a), _mm_unpackhi_epi64(b, b), vol, minval, maxval);
+        _mm_storeu_si128((__m128i *)(dst + (i * 16)), _mm_unpacklo_epi64(r0, r1));
+    }
+    return blocks * 16;
+}
+
+static Uint32 SDL_MixF32_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    const Uint32 blocks = len / 16;
+    const __m128 fvolume = _mm_set1_ps((float)volume);
+    const __m128 fmaxvolume = _mm_set1_ps(1.0f / ((float)SDL_MIX_MAXVOLUME));
+    const __m128 minval = _mm_set1_ps(-3.402823466e+38F);
+    const __m128 maxval = _mm_set1_ps(3.402823466e+38F);
+    Uint32 i;
+
+    for (i = 0; i < blocks; i++) {
+        const __m128 a = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps((const float *)(src + (i * 16))), fvolume), fmaxvolume);
+        const __m128 sum = _mm_add_ps(a, _mm_loadu_ps((const float *)(dst + (i * 16))));
+        /* The limit goes first so NaNs pass through, as in the scalar code */
+        _mm_storeu_ps((float *)(dst + (i * 16)), _mm_max_ps(minval, _mm_min_ps(maxval, sum)));
+    }
+    return blocks * 16;
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#ifdef HAVE_AVX2_INTRINSICS
+static Uint32 SDL_TARGETING_AVX2 SDL_MixS16_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    const Uint32 blocks = len / 32;
+    Uint32 i;
+
+    if (volume == SDL_MIX_MAXVOLUME) {
+        for (i = 0; i < blocks; i++) {
+            const __m256i a = _mm256_loadu_si256((const __m256i *)(src + (i * 32)));
+            const __m256i b = _mm256_loadu_si256((const __m256i *)(dst + (i * 32)));
+            _mm256_storeu_si256((__m256i *)(dst + (i * 32)), _mm256_adds_epi16(a, b));
+        }
+    } else {
+        const __m256i vol = _mm256_set1_epi16((Sint16)volume);
+        const __m256i bias = _mm256_set1_epi32(SDL_MIX_MAXVOLUME - 1);
+        for (i = 0; i < blocks; i++) {
+            const __m256i a = _mm256_loadu_si256((const __m256i *)(src + (i * 32)));
+            const __m256i b = _mm256_loadu_si256((const __m256i *)(dst + (i * 32)));
+            const __m256i lo = _mm256_mullo_epi16(a, vol);
+            const __m256i hi = _mm256_mulhi_epi16(a, vol);
+            /* unpack and pack both work within 128-bit lanes, so the order comes out right */
+            __m256i p0 = _mm256_unpacklo_epi16(lo, hi);
+            __m256i p1 = _mm256_unpackhi_epi16(lo, hi);
+            p0 = _mm256_srai_epi32(_mm256_add_epi32(p0, _mm256_and_si256(_mm256_srai_epi32(p0, 31), bias)), 7);
+            p1 = _mm256_srai_epi32(_mm256_add_epi32(p1, _mm256_and_si256(_mm256_srai_epi32(p1, 31), bias)), 7);
+            _mm256_storeu_si256((__m256i *)(dst + (i * 32)), _mm256_adds_epi16(_mm256_packs_epi32(p0, p1), b));
+        }
+    }
+    return blocks * 32;
+}
+
+static Uint32 SDL_TARGETING_AVX2 SDL_MixS32_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    const Uint32 blocks = len / 16;
+    const __m256d vol = _mm256_set1_pd((double)volume / SDL_MIX_MAXVOLUME);
+    const __m256d minval = _mm256_set1_pd((double)SDL_MIN_SINT32);
+    const __m256d maxval = _mm256_set1_pd((double)SDL_MAX_SINT32);
+    Uint32 i;
+
+    for (i = 0; i < blocks; i++) {
+        const __m128i a = _mm_loadu_si128((const __m128i *)(src + (i * 16)));
+        const __m128i b = _mm_loadu_si128((const __m128i *)(dst + (i * 16)));
+        const __m128i scaled = _mm256_cvttpd_epi32(_mm256_mul_pd(_mm256_cvtepi32_pd(a), vol));
+        const __m256d sum = _mm256_add_pd(_mm256_cvtepi32_pd(scaled), _mm256_cvtepi32_pd(b));
+        _mm_storeu_si128((__m128i *)(dst + (i * 16)), _mm256_cvttpd_epi32(_mm256_max_pd(_mm256_min_pd(sum, maxval), minval)));
+    }
+    return blocks * 16;
+}
+
+static Uint32 SDL_TARGETING_AVX2 SDL_MixF32_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    const Uint32 blocks = len / 32;
+    const __m256 fvolume = _mm256_set1_ps((float)volume);
+    const __m256 fmaxvolume = _mm256_set1_ps(1.0f / ((float)SDL_MIX_MAXVOLUME));
+    const __m256 minval = _mm256_set1_ps(-3.402823466e+38F);
+    const __m256 maxval = _mm256_set1_ps(3.402823466e+38F);
+    Uint32 i;
+
+    for (i = 0; i < blocks; i++) {
+        const __m256 a = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps((const float *)(src + (i * 32))), fvolume), fmaxvolume);
+        const __m256 sum = _mm256_add_ps(a, _mm256_loadu_ps((const float *)(dst + (i * 32))));
+        _mm256_storeu_ps((float *)(dst + (i * 32)), _mm256_max_ps(minval, _mm256_min_ps(maxval, sum)));
+    }
+    return blocks * 32;
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#ifdef HAVE_NEON_INTRINSICS
+/* Divide by SDL_MIX_MAXVOLUME rounding towards zero: negative values get 127 added first */
+#define NEON_DIV_MAXVOLUME_S32(p) vshrq_n_s32(vaddq_s32(p, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(p, 31)), 25))), 7)
+#define NEON_DIV_MAXVOLUME_S64(p) vshrq_n_s64(vaddq_s64(p, vreinterpretq_s64_u64(vshrq_n_u64(vreinterpretq_u64_s64(vshrq_n_s64(p, 63)), 57))), 7)
+
+static Uint32 SDL_MixS16_NEON(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    const Uint32 blocks = len / 16;
+    const int16x4_t vol = vdup_n_s16((Sint16)volume);
+    Uint32 i;
+
+    for (i = 0; i < blocks; i++) {
+        const int16x8_t a = vld1q_s16((const Sint16 *)(src + (i * 16)));
+        const int16x8_t b = vld1q_s16((const Sint16 *)(dst + (i * 16)));
+        int16x8_t scaled;
+        if (volume == SDL_MIX_MAXVOLUME) {
+            scaled = a;
+        } else {
+            const int32x4_t p0 = vmull_s16(vget_low_s16(a), vol);
+            const int32x4_t p1 = vmull_s16(vget_high_s16(a), vol);
+            scaled = vcombine_s16(vqmovn_s32(NEON_DIV_MAXVOLUME_S32(p0)), vqmovn_s32(NEON_DIV_MAXVOLUME_S32(p1)));
+        }
+        vst1q_s16((Sint16 *)(dst + (i * 16)), vqaddq_s16(scaled, b));
+    }
+    return blocks * 16;
+}
+
+static Uint32 SDL_MixS32_NEON(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    const Uint32 blocks = len / 16;
+    const int32x2_t vol = vdup_n_s32(volume);
+    Uint32 i;
+
+    for (i = 0; i < blocks; i++) {
+        const int32x4_t a = vld1q_s32((const Sint32 *)(src + (i * 16)));
+        const int32x4_t b = vld1q_s32((const Sint32 *)(dst + (i * 16)));
+        const int64x2_t p0 = NEON_DIV_MAXVOLUME_S64(vmull_s32(vget_low_s32(a), vol));
+        const int64x2_t p1 = NEON_DIV_MAXVOLUME_S64(vmull_s32(vget_high_s32(a), vol));
+        const int64x2_t sum0 = vaddw_s32(p0, vget_low_s32(b));
+        const int64x2_t sum1 = vaddw_s32(p1, vget_high_s32(b));
+        vst1q_s32((Sint32 *)(dst + (i * 16)), vcombine_s32(vqmovn_s64(sum0), vqmovn_s64(sum1)));
+    }
+    return blocks * 16;
+}
+
+static Uint32 SDL_MixF32_NEON(Uint8 *dst, const Uint8 *src, Uint32 len, int volume)
+{
+    const Uint32 blocks = len / 16;
+    const float32x4_t fvolume = vdupq_n_f32((float)volume);
+    const float32x4_t fmaxvolume = vdupq_n_f32(1.0f / ((float)SDL_MIX_MAXVOLUME));
+    const float32x4_t minval = vdupq_n_f32(-3.402823466e+38F);
+    const float32x4_t maxval = vdupq_n_f32(3.402823466e+38F);
+    Uint32 i;
+
+    for (i = 0; i < blocks; i++) {
+        const float32x4_t a = vmulq_f32(vmulq_f32(vld1q_f32((const float *)(src + (i * 16))), fvolume), fmaxvolume);
+        const float32x4_t sum = vaddq_f32(a, vld1q_f32((const float *)(dst + (i * 16))));
+        /* vminq/vmaxq propagate NaNs, as in the scalar code */
+        vst1q_f32((float *)(dst + (i * 16)), vmaxq_f32(vminq_f32(sum, maxval), minval));
+    }
+    return blocks * 16;
+}
+
+#undef NEON_DIV_MAXVOLUME_S32
+#undef NEON_DIV_MAXVOLUME_S64
+#endif /* HAVE_NEON_INTRINSICS */
+
+static SDL_MixFunc SDL_MixS16_SIMD = NULL;
+static SDL_MixFunc SDL_MixS32_SIMD = NULL;
+static SDL_MixFunc SDL_MixF32_SIMD = NULL;
+
+static void SDL_ChooseMixers(void)
+{
+    static SDL_bool mixers_chosen = SDL_FALSE;
+
+    if (mixers_chosen) {
+        return;
+    }
+
+#define SET_MIXER_FUNCS(fntype)                 \
+    SDL_MixS16_SIMD = SDL_MixS16_##fntype;      \
+    SDL_MixS32_SIMD = SDL_MixS32_##fntype;      \
+    SDL_MixF32_SIMD = SDL_MixF32_##fntype;      \
+    mixers_chosen = SDL_TRUE
+
+#ifdef HAVE_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        SET_MIXER_FUNCS(AVX2);
+        return;
+    }
+#endif
+
+#ifdef HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        SET_MIXER_FUNCS(SSE2);
+        return;
+    }
+#endif
+
+#ifdef HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        SET_MIXER_FUNCS(NEON);
+        return;
+    }
+#endif
+
+#undef SET_MIXER_FUNCS
+
+    /* Everything goes through the scalar code */
+    mixers_chosen = SDL_TRUE;
+}
+
 void SDL_MixAudioFormat(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format,
                         Uint32 len, int volume)
 {
+    SDL_MixFunc simd = NULL;
+
     if (volume == 0) {
         return;
     }
 
+    SDL_ChooseMixers();
+    if (volume > 0 && volume <= SDL_MIX_MAXVOLUME) {
+        if (format == AUDIO_S16SYS) {
+            simd = SDL_MixS16_SIMD;
+        } else if (format == AUDIO_S32SYS) {
+            simd = SDL_MixS32_SIMD;
+        } else if (format == AUDIO_F32SYS) {
+            simd = SDL_MixF32_SIMD;
+        }
+    }
+    if (simd) {
+        const Uint32 mixed = simd(dst, src, len, volume);
+        dst += mixed;
+        src += mixed;
+        len -= mixed;
+    }
+
     switch (format) {
 
     case AUDIO_U8:
@@ -1178,6 +1178,11 @@ size_t SDL_SIMDGetAlignment(void)
 }
 
 void *SDL_SIMDAlloc(const size_t len)
+{
+    return SDL_TaggedSIMDAlloc(SDL_MEMORY_TAG_OTHER, len);
+}
+
+void *SDL_TaggedSIMDAlloc(SDL_MemoryTag tag, const size_t len)
 {
     const size_t alignment = SDL_SIMDGetAlignment();
     const size_t padding = (alignment - (len % alignment)) % alignment;
@@ -1191,7 +1196,7 @@ void *SDL_SIMDAlloc(const size_t len)
         return NULL;
     }
 
-    ptr = (Uint8 *)SDL_malloc(to_allocate);
+    ptr = (Uint8 *)SDL_TaggedMalloc(tag, to_allocate);
     if (ptr) {
         /* store the actual allocated pointer right before our aligned pointer. */
         retval = ptr + sizeof(void *);
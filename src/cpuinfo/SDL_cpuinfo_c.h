@@ -0,0 +1,60 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#ifndef SDL_cpuinfo_c_h_
+#define SDL_cpuinfo_c_h_
+
+#include "SDL_cpuinfo.h"
+
+/* SIMD code that is compiled for an instruction set the rest of SDL isn't
+   built for, and only called after checking SDL_HasSSE41() or SDL_HasAVX2().
+   Functions using these intrinsics need the matching SDL_TARGETING_* tag. */
+
+#if defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H)
+#define HAVE_SSE4_1_INTRINSICS 1
+#define HAVE_AVX2_INTRINSICS 1
+#endif
+#if defined __clang__
+#if (!__has_attribute(target))
+#undef HAVE_SSE4_1_INTRINSICS
+#undef HAVE_AVX2_INTRINSICS
+#endif
+#if (defined(_MSC_VER) || defined(__SCE__)) && !defined(__AVX2__)
+#undef HAVE_SSE4_1_INTRINSICS
+#undef HAVE_AVX2_INTRINSICS
+#endif
+#elif defined __GNUC__
+#if (__GNUC__ < 4) || (__GNUC__ == 4 && __GNUC_MINOR__ < 9)
+#undef HAVE_SSE4_1_INTRINSICS
+#undef HAVE_AVX2_INTRINSICS
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SDL_TARGETING_SSE4_1 __attribute__((target("sse4.1")))
+#define SDL_TARGETING_AVX2   __attribute__((target("avx2")))
+#else
+#define SDL_TARGETING_SSE4_1
+#define SDL_TARGETING_AVX2
+#endif
+
+#endif /* SDL_cpuinfo_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -898,3 +898,28 @@
 #define SDL_DestroyWindowSurface SDL_DestroyWindowSurface_REAL
 #define SDL_GDKGetDefaultUser SDL_GDKGetDefaultUser_REAL
 #define SDL_GameControllerGetSteamHandle SDL_GameControllerGetSteamHandle_REAL
+#define SDL_PollEvents SDL_PollEvents_REAL
+#define SDL_AddTimerNS SDL_AddTimerNS_REAL
+#define SDL_AudioStreamSetResampleQuality SDL_AudioStreamSetResampleQuality_REAL
+#define SDL_AudioStreamGetResampleQuality SDL_AudioStreamGetResampleQuality_REAL
+#define SDL_RenderGetStats SDL_RenderGetStats_REAL
+#define SDL_CreateTextureAtlas SDL_CreateTextureAtlas_REAL
+#define SDL_AddTextureAtlasImage SDL_AddTextureAtlasImage_REAL
+#define SDL_UpdateTextureAtlasImage SDL_UpdateTextureAtlasImage_REAL
+#define SDL_QueryTextureAtlasImage SDL_QueryTextureAtlasImage_REAL
+#define SDL_RemoveTextureAtlasImage SDL_RemoveTextureAtlasImage_REAL
+#define SDL_DestroyTextureAtlas SDL_DestroyTextureAtlas_REAL
+#define SDL_CreateJobCounter SDL_CreateJobCounter_REAL
+#define SDL_RunJob SDL_RunJob_REAL
+#define SDL_GetJobCounterValue SDL_GetJobCounterValue_REAL
+#define SDL_WaitJobCounter SDL_WaitJobCounter_REAL
+#define SDL_DestroyJobCounter SDL_DestroyJobCounter_REAL
+#define SDL_ParallelFor SDL_ParallelFor_REAL
+#define SDL_GetJobThreadCount SDL_GetJobThreadCount_REAL
+#define SDL_EnableMemoryTracking SDL_EnableMemoryTracking_REAL
+#define SDL_GetMemoryStats SDL_GetMemoryStats_REAL
+#define SDL_GetMemoryTagName SDL_GetMemoryTagName_REAL
+#define SDL_LogMemoryStats SDL_LogMemoryStats_REAL
+#define SDL_LogSetAsync SDL_LogSetAsync_REAL
+#define SDL_LogFlush SDL_LogFlush_REAL
+#define SDL_LogGetDroppedCount SDL_LogGetDroppedCount_REAL
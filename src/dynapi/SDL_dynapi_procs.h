@@ -985,3 +985,28 @@ SDL_DYNAPI_PROC(int,SDL_DestroyWindowSurface,(SDL_Window *a),(a),return)
 SDL_DYNAPI_PROC(int,SDL_GDKGetDefaultUser,(XUserHandle *a),(a),return)
 #endif
 SDL_DYNAPI_PROC(Uint64,SDL_GameControllerGetSteamHandle,(SDL_GameController *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_PollEvents,(SDL_Event *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_TimerID,SDL_AddTimerNS,(Uint64 a, SDL_NSTimerCallback b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_AudioStreamSetResampleQuality,(SDL_AudioStream *a, SDL_AudioResampleQuality b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_AudioResampleQuality,SDL_AudioStreamGetResampleQuality,(SDL_AudioStream *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_RenderGetStats,(SDL_Renderer *a, SDL_RenderStats *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_TextureAtlas*,SDL_CreateTextureAtlas,(SDL_Renderer *a, Uint32 b, int c, int d, int e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_AddTextureAtlasImage,(SDL_TextureAtlas *a, SDL_Surface *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_UpdateTextureAtlasImage,(SDL_TextureAtlas *a, int b, SDL_Surface *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_QueryTextureAtlasImage,(SDL_TextureAtlas *a, int b, SDL_Texture **c, SDL_Rect *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_RemoveTextureAtlasImage,(SDL_TextureAtlas *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyTextureAtlas,(SDL_TextureAtlas *a),(a),)
+SDL_DYNAPI_PROC(SDL_JobCounter*,SDL_CreateJobCounter,(void),(),return)
+SDL_DYNAPI_PROC(int,SDL_RunJob,(SDL_JobFunction a, void *b, SDL_JobCounter *c, SDL_JobCounter *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_GetJobCounterValue,(SDL_JobCounter *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_WaitJobCounter,(SDL_JobCounter *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_DestroyJobCounter,(SDL_JobCounter *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_ParallelFor,(SDL_ParallelForFunction a, void *b, int c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_GetJobThreadCount,(void),(),return)
+SDL_DYNAPI_PROC(int,SDL_EnableMemoryTracking,(void),(),return)
+SDL_DYNAPI_PROC(int,SDL_GetMemoryStats,(SDL_MemoryTag a, SDL_MemoryStats *b),(a,b),return)
+SDL_DYNAPI_PROC(const char*,SDL_GetMemoryTagName,(SDL_MemoryTag a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_LogMemoryStats,(void),(),)
+SDL_DYNAPI_PROC(int,SDL_LogSetAsync,(SDL_bool a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_LogFlush,(void),(),)
+SDL_DYNAPI_PROC(int,SDL_LogGetDroppedCount,(void),(),return)
@@ -27,6 +27,7 @@
 #include "SDL_thread.h"
 #include "SDL_events_c.h"
 #include "../SDL_hints_c.h"
+#include "../SDL_slab.h"
 #include "../timer/SDL_timer_c.h"
 #ifndef SDL_JOYSTICK_DISABLED
 #include "../joystick/SDL_joystick_c.h"
@@ -37,6 +38,9 @@
 /* An arbitrary limit so we don't have unbounded growth */
 #define SDL_MAX_QUEUED_EVENTS 65535
 
+/* Number of slots in the lock-free ring that producers push into, must be a power of two */
+#define SDL_EVENT_RING_SIZE 4096
+
 /* Determines how often we pump events if joystick or sensor subsystems are active */
 #define ENUMERATION_POLL_INTERVAL_MS 3000
 
@@ -81,18 +85,38 @@ typedef struct _SDL_SysWMEntry
     struct _SDL_SysWMEntry *next;
 } SDL_SysWMEntry;
 
+SDL_SLAB_SITE(SDL_event_entry_site, "event entries", SDL_MEMORY_TAG_EVENTS);
+SDL_SLAB_SITE(SDL_wmmsg_entry_site, "window manager messages", SDL_MEMORY_TAG_EVENTS);
+
+/* Events are pushed into a bounded multi-producer ring without taking the
+   queue lock. Whoever holds the queue lock is the single consumer: it moves
+   ring slots to the end of the linked list before looking at the queue, so
+   the list always holds the oldest events. The sequence number of a slot
+   tells producers and the consumer whose turn it is (see Dmitry Vyukov's
+   bounded MPMC queue).
+ */
+typedef struct
+{
+    SDL_atomic_t sequence;
+    SDL_Event event;
+} SDL_EventRingSlot;
+
 static struct
 {
     SDL_mutex *lock;
-    SDL_bool active;
+    SDL_atomic_t active;
+    SDL_atomic_t producers; /* threads adding events without the queue lock */
     SDL_atomic_t count;
-    int max_events_seen;
+    SDL_atomic_t max_events_seen;
     SDL_EventEntry *head;
     SDL_EventEntry *tail;
     SDL_EventEntry *free;
     SDL_SysWMEntry *wmmsg_used;
     SDL_SysWMEntry *wmmsg_free;
-} SDL_EventQ = { NULL, SDL_FALSE, { 0 }, 0, NULL, NULL, NULL, NULL, NULL };
+    SDL_EventRingSlot *ring;
+    SDL_atomic_t ring_head; /* next slot to fill, shared by the producers */
+    Uint32 ring_tail;       /* next slot to drain, protected by the queue lock */
+} SDL_EventQ = { NULL, { 0 }, { 0 }, { 0 }, { 0 }, NULL, NULL, NULL, NULL, NULL, NULL, { 0 }, 0 };
 
 #ifndef SDL_JOYSTICK_DISABLED
 
@@ -155,6 +179,14 @@ static void SDLCALL SDL_EventLoggingChanged(void *userdata, const char *name, co
     SDL_EventLoggingVerbosity = (hint && *hint) ? SDL_clamp(SDL_atoi(hint), 0, 3) : 0;
 }
 
+/* Whether SDL_HINT_EVENT_COALESCE_MOTION is set */
+static SDL_bool SDL_CoalesceMotion = SDL_FALSE;
+
+static void SDLCALL SDL_CoalesceMotionChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_CoalesceMotion = SDL_GetStringBoolean(hint, SDL_FALSE);
+}
+
 static void SDL_LogEvent(const SDL_Event *event)
 {
     char name[64];
@@ -545,44 +577,53 @@ void SDL_StopEventLoop(void)
     SDL_EventEntry *entry;
     SDL_SysWMEntry *wmmsg;
 
-    SDL_LockMutex(SDL_EventQ.lock);
+    /* Wait for the threads that are still adding events, the ring goes away below */
+    SDL_AtomicSet(&SDL_EventQ.active, 0);
+    while (SDL_AtomicGet(&SDL_EventQ.producers) > 0) {
+        SDL_Delay(0);
+    }
 
-    SDL_EventQ.active = SDL_FALSE;
+    SDL_LockMutex(SDL_EventQ.lock);
 
     if (report && SDL_atoi(report)) {
         SDL_Log("SDL EVENT QUEUE: Maximum events in-flight: %d\n",
-                SDL_EventQ.max_events_seen);
+                SDL_AtomicGet(&SDL_EventQ.max_events_seen));
     }
 
     /* Clean out EventQ */
     for (entry = SDL_EventQ.head; entry;) {
         SDL_EventEntry *next = entry->next;
-        SDL_free(entry);
+        SDL_SlabFree(&SDL_event_entry_site, entry, sizeof(*entry));
         entry = next;
     }
     for (entry = SDL_EventQ.free; entry;) {
         SDL_EventEntry *next = entry->next;
-        SDL_free(entry);
+        SDL_SlabFree(&SDL_event_entry_site, entry, sizeof(*entry));
         entry = next;
     }
     for (wmmsg = SDL_EventQ.wmmsg_used; wmmsg;) {
         SDL_SysWMEntry *next = wmmsg->next;
-        SDL_free(wmmsg);
+        SDL_SlabFree(&SDL_wmmsg_entry_site, wmmsg, sizeof(*wmmsg));
         wmmsg = next;
     }
     for (wmmsg = SDL_EventQ.wmmsg_free; wmmsg;) {
         SDL_SysWMEntry *next = wmmsg->next;
-        SDL_free(wmmsg);
+        SDL_SlabFree(&SDL_wmmsg_entry_site, wmmsg, sizeof(*wmmsg));
         wmmsg = next;
     }
 
+    SDL_free(SDL_EventQ.ring);
+
     SDL_AtomicSet(&SDL_EventQ.count, 0);
-    SDL_EventQ.max_events_seen = 0;
+    SDL_AtomicSet(&SDL_EventQ.max_events_seen, 0);
     SDL_EventQ.head = NULL;
     SDL_EventQ.tail = NULL;
     SDL_EventQ.free = NULL;
     SDL_EventQ.wmmsg_used = NULL;
     SDL_EventQ.wmmsg_free = NULL;
+    SDL_EventQ.ring = NULL;
+    SDL_AtomicSet(&SDL_EventQ.ring_head, 0);
+    SDL_EventQ.ring_tail = 0;
     SDL_AtomicSet(&SDL_sentinel_pending, 0);
 
     /* Clear disabled event state */
@@ -613,6 +654,8 @@ void SDL_StopEventLoop(void)
 /* This function (and associated calls) may be called more than once */
 int SDL_StartEventLoop(void)
 {
+    int i;
+
     /* We'll leave the event queue alone, since we might have gotten
        some important events at launch (like SDL_DROPFILE)
 
@@ -647,41 +690,40 @@ int SDL_StartEventLoop(void)
     (void)SDL_EventState(SDL_DROPTEXT, SDL_DISABLE);
 #endif
 
-    SDL_EventQ.active = SDL_TRUE;
+    /* If this fails we just go through the locked list for every event */
+    if (!SDL_EventQ.ring) {
+        SDL_EventQ.ring = (SDL_EventRingSlot *)SDL_TaggedMalloc(SDL_MEMORY_TAG_EVENTS, SDL_EVENT_RING_SIZE * sizeof(*SDL_EventQ.ring));
+        if (SDL_EventQ.ring) {
+            for (i = 0; i < SDL_EVENT_RING_SIZE; ++i) {
+                SDL_AtomicSet(&SDL_EventQ.ring[i].sequence, i);
+            }
+            SDL_AtomicSet(&SDL_EventQ.ring_head, 0);
+            SDL_EventQ.ring_tail = 0;
+        }
+    }
+
+    SDL_AtomicSet(&SDL_EventQ.active, 1);
     SDL_UnlockMutex(SDL_EventQ.lock);
     return 0;
 }
 
-/* Add an event to the event queue -- called with the queue locked */
-static int SDL_AddEvent(SDL_Event *event)
+/* Link an event at the end of the list -- called with the queue locked */
+static SDL_bool SDL_LinkEvent(const SDL_Event *event)
 {
     SDL_EventEntry *entry;
-    const int initial_count = SDL_AtomicGet(&SDL_EventQ.count);
-    int final_count;
-
-    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
-        SDL_SetError("Event queue is full (%d events)", initial_count);
-        return 0;
-    }
 
     if (SDL_EventQ.free == NULL) {
-        entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
+        entry = (SDL_EventEntry *)SDL_SlabAlloc(&SDL_event_entry_site, sizeof(*entry));
         if (entry == NULL) {
-            return 0;
+            return SDL_FALSE;
         }
     } else {
         entry = SDL_EventQ.free;
         SDL_EventQ.free = entry->next;
     }
 
-    if (SDL_EventLoggingVerbosity > 0) {
-        SDL_LogEvent(event);
-    }
-
     entry->event = *event;
-    if (event->type == SDL_POLLSENTINEL) {
-        SDL_AtomicAdd(&SDL_sentinel_pending, 1);
-    } else if (event->type == SDL_SYSWMEVENT) {
+    if (event->type == SDL_SYSWMEVENT) {
         entry->msg = *event->syswm.msg;
         entry->event.syswm.msg = &entry->msg;
     }
@@ -698,15 +740,262 @@ static int SDL_AddEvent(SDL_Event *event)
         entry->prev = NULL;
         entry->next = NULL;
     }
+    return SDL_TRUE;
+}
+
+/* Give back a queue slot taken by SDL_ReserveEvent() */
+static void SDL_ReleaseEvent(const SDL_Event *event)
+{
+    if (event->type == SDL_POLLSENTINEL) {
+        SDL_AtomicAdd(&SDL_sentinel_pending, -1);
+    }
+    SDL_assert(SDL_AtomicGet(&SDL_EventQ.count) > 0);
+    SDL_AtomicAdd(&SDL_EventQ.count, -1);
+}
+
+/* Account for a new event, failing if the queue is full -- safe to call without the queue lock */
+static SDL_bool SDL_ReserveEvent(const SDL_Event *event)
+{
+    const int final_count = SDL_AtomicAdd(&SDL_EventQ.count, 1) + 1;
+    int max_events_seen;
+
+    if (final_count > SDL_MAX_QUEUED_EVENTS) {
+        SDL_AtomicAdd(&SDL_EventQ.count, -1);
+        SDL_SetError("Event queue is full (%d events)", final_count - 1);
+        return SDL_FALSE;
+    }
+
+    do {
+        max_events_seen = SDL_AtomicGet(&SDL_EventQ.max_events_seen);
+    } while (final_count > max_events_seen &&
+             !SDL_AtomicCAS(&SDL_EventQ.max_events_seen, max_events_seen, final_count));
+
+    if (event->type == SDL_POLLSENTINEL) {
+        SDL_AtomicAdd(&SDL_sentinel_pending, 1);
+    }
+    return SDL_TRUE;
+}
+
+/* Try to put an event in the ring -- safe to call without the queue lock */
+static SDL_bool SDL_PushEventRing(const SDL_Event *event)
+{
+    SDL_EventRingSlot *slot;
+    Uint32 pos = (Uint32)SDL_AtomicGet(&SDL_EventQ.ring_head);
+
+    for (;;) {
+        int diff;
+
+        slot = &SDL_EventQ.ring[pos & (SDL_EVENT_RING_SIZE - 1)];
+        diff = (int)((Uint32)SDL_AtomicGet(&slot->sequence) - pos);
+        if (diff == 0) {
+            /* The slot is free, try to claim it */
+            if (SDL_AtomicCAS(&SDL_EventQ.ring_head, (int)pos, (int)(pos + 1))) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* The consumer hasn't drained this slot yet, the ring is full */
+            return SDL_FALSE;
+        }
+        pos = (Uint32)SDL_AtomicGet(&SDL_EventQ.ring_head);
+    }
+
+    slot->event = *event;
+    SDL_AtomicSet(&slot->sequence, (int)(pos + 1));
+    return SDL_TRUE;
+}
+
+/* Take the oldest event out of the ring -- called with the queue locked */
+static SDL_bool SDL_PopEventRing(SDL_Event *event)
+{
+    SDL_EventRingSlot *slot;
+    const Uint32 pos = SDL_EventQ.ring_tail;
+
+    if (!SDL_EventQ.ring) {
+        return SDL_FALSE;
+    }
+
+    slot = &SDL_EventQ.ring[pos & (SDL_EVENT_RING_SIZE - 1)];
+    if ((Uint32)SDL_AtomicGet(&slot->sequence) != pos + 1) {
+        /* Empty, or the producer is still writing it */
+        return SDL_FALSE;
+    }
+
+    *event = slot->event;
+    SDL_AtomicSet(&slot->sequence, (int)(pos + SDL_EVENT_RING_SIZE));
+    SDL_EventQ.ring_tail = pos + 1;
+    return SDL_TRUE;
+}
+
+/* Move everything in the ring to the end of the list -- called with the queue locked
+
+   This stops at a slot that was claimed but isn't filled yet and returns
+   SDL_FALSE, for a consumer that event just hasn't arrived.
+ */
+static SDL_bool SDL_DrainEventRing(void)
+{
+    const Uint32 head = (Uint32)SDL_AtomicGet(&SDL_EventQ.ring_head);
+    SDL_Event event;
+
+    if (!SDL_EventQ.ring) {
+        return SDL_TRUE;
+    }
+
+    while (SDL_EventQ.ring_tail != head) {
+        if (!SDL_PopEventRing(&event)) {
+            return SDL_FALSE;
+        }
+        if (!SDL_LinkEvent(&event)) {
+            SDL_ReleaseEvent(&event);
+        }
+    }
+    return SDL_TRUE;
+}
+
+/* Lock the queue with every slot claimed so far moved to the list
+
+   A producer that wants to link an event directly has to wait for those,
+   or its own earlier events could end up behind the new one. The slot
+   owners don't need the lock to finish, but we don't hold it while we wait.
+ */
+static void SDL_LockDrainedEventQueue(void)
+{
+    int spins = 0;
+
+    for (;;) {
+        SDL_LockMutex(SDL_EventQ.lock);
+        if (SDL_DrainEventRing()) {
+            return;
+        }
+        SDL_UnlockMutex(SDL_EventQ.lock);
+
+        if (++spins < 64) {
+            SDL_CPUPauseInstruction();
+        } else {
+            SDL_Delay(0);
+        }
+    }
+}
+
+static SDL_bool SDL_IsCoalescableEvent(Uint32 type)
+{
+    return (type == SDL_MOUSEMOTION || type == SDL_FINGERMOTION || type == SDL_CONTROLLERSENSORUPDATE);
+}
+
+/* Fold a motion event into the newest queued event if both come from the same
+   source, keeping the latest position and summing the relative motion.
+   Called with the queue locked. */
+static SDL_bool SDL_CoalesceEvent(SDL_Event *queued, const SDL_Event *event)
+{
+    if (queued->type != event->type) {
+        return SDL_FALSE;
+    }
 
-    final_count = SDL_AtomicAdd(&SDL_EventQ.count, 1) + 1;
-    if (final_count > SDL_EventQ.max_events_seen) {
-        SDL_EventQ.max_events_seen = final_count;
+    switch (event->type) {
+    case SDL_MOUSEMOTION:
+        if (queued->motion.windowID != event->motion.windowID ||
+            queued->motion.which != event->motion.which ||
+            queued->motion.state != event->motion.state) {
+            return SDL_FALSE;
+        }
+        queued->motion.timestamp = event->motion.timestamp;
+        queued->motion.x = event->motion.x;
+        queued->motion.y = event->motion.y;
+        queued->motion.xrel += event->motion.xrel;
+        queued->motion.yrel += event->motion.yrel;
+        return SDL_TRUE;
+
+    case SDL_FINGERMOTION:
+        if (queued->tfinger.touchId != event->tfinger.touchId ||
+            queued->tfinger.fingerId != event->tfinger.fingerId ||
+            queued->tfinger.windowID != event->tfinger.windowID) {
+            return SDL_FALSE;
+        }
+        queued->tfinger.timestamp = event->tfinger.timestamp;
+        queued->tfinger.x = event->tfinger.x;
+        queued->tfinger.y = event->tfinger.y;
+        queued->tfinger.dx += event->tfinger.dx;
+        queued->tfinger.dy += event->tfinger.dy;
+        queued->tfinger.pressure = event->tfinger.pressure;
+        return SDL_TRUE;
+
+    case SDL_CONTROLLERSENSORUPDATE:
+        if (queued->csensor.which != event->csensor.which ||
+            queued->csensor.sensor != event->csensor.sensor) {
+            return SDL_FALSE;
+        }
+        /* Sensor readings are absolute, only the latest one matters */
+        queued->csensor = event->csensor;
+        return SDL_TRUE;
+
+    default:
+        return SDL_FALSE;
+    }
+}
+
+/* Add an event to the event queue -- safe to call without the queue lock */
+static int SDL_AddEvent(SDL_Event *event)
+{
+    /* Coalescing needs to look at the newest queued event, so those go through the list */
+    const SDL_bool coalesce = (SDL_CoalesceMotion && SDL_IsCoalescableEvent(event->type));
+
+    if (coalesce) {
+        SDL_LockDrainedEventQueue();
+        if (SDL_EventQ.tail && SDL_CoalesceEvent(&SDL_EventQ.tail->event, event)) {
+            SDL_UnlockMutex(SDL_EventQ.lock);
+            if (SDL_EventLoggingVerbosity > 0) {
+                SDL_LogEvent(event);
+            }
+            return 1;
+        }
+        SDL_UnlockMutex(SDL_EventQ.lock);
+    }
+
+    if (!SDL_ReserveEvent(event)) {
+        return 0;
     }
 
+    if (SDL_EventLoggingVerbosity > 0) {
+        SDL_LogEvent(event);
+    }
+
+    /* SysWM messages point at data we need to copy, so they always take the locked path */
+    if (!coalesce && event->type != SDL_SYSWMEVENT && SDL_EventQ.ring && SDL_PushEventRing(event)) {
+        return 1;
+    }
+
+    SDL_LockDrainedEventQueue();
+    if (!SDL_LinkEvent(event)) {
+        SDL_UnlockMutex(SDL_EventQ.lock);
+        SDL_ReleaseEvent(event);
+        return 0;
+    }
+    SDL_UnlockMutex(SDL_EventQ.lock);
+
     return 1;
 }
 
+/* Fetch events straight from the ring -- called with the queue locked and the list empty */
+static int SDL_GetEventsFromRing(SDL_Event *events, int numevents, SDL_bool include_sentinel)
+{
+    int used = 0;
+
+    SDL_assert(!SDL_EventQ.head);
+
+    while (used < numevents && SDL_PopEventRing(&events[used])) {
+        SDL_ReleaseEvent(&events[used]);
+        if (events[used].type == SDL_POLLSENTINEL) {
+            /* Special handling for the sentinel event, see SDL_PeepEventsInternal() */
+            if (!include_sentinel || SDL_AtomicGet(&SDL_sentinel_pending) > 0) {
+                continue;
+            }
+            ++used;
+            break;
+        }
+        ++used;
+    }
+    return used;
+}
+
 /* Remove an event from the queue -- called with the queue locked */
 static void SDL_CutEvent(SDL_EventEntry *entry)
 {
@@ -726,14 +1015,10 @@ static void SDL_CutEvent(SDL_EventEntry *entry)
         SDL_EventQ.tail = entry->prev;
     }
 
-    if (entry->event.type == SDL_POLLSENTINEL) {
-        SDL_AtomicAdd(&SDL_sentinel_pending, -1);
-    }
+    SDL_ReleaseEvent(&entry->event);
 
     entry->next = SDL_EventQ.free;
     SDL_EventQ.free = entry;
-    SDL_assert(SDL_AtomicGet(&SDL_EventQ.count) > 0);
-    SDL_AtomicAdd(&SDL_EventQ.count, -1);
 }
 
 static int SDL_SendWakeupEvent(void)
@@ -762,14 +1047,35 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_eventact
                                   Uint32 minType, Uint32 maxType, SDL_bool include_sentinel)
 {
     int i, used, sentinels_expected = 0;
+    SDL_EventEntry *entry, *next;
+    SDL_SysWMEntry *wmmsg, *wmmsg_next;
+    Uint32 type;
 
-    /* Lock the event queue */
     used = 0;
 
+    /* Adding events doesn't need the queue lock, SDL_StopEventLoop() waits for us instead */
+    if (action == SDL_ADDEVENT) {
+        SDL_AtomicIncRef(&SDL_EventQ.producers);
+        if (!SDL_AtomicGet(&SDL_EventQ.active)) {
+            SDL_AtomicAdd(&SDL_EventQ.producers, -1);
+            return -1;
+        }
+        for (i = 0; i < numevents; ++i) {
+            used += SDL_AddEvent(&events[i]);
+        }
+        SDL_AtomicAdd(&SDL_EventQ.producers, -1);
+
+        if (used > 0) {
+            SDL_SendWakeupEvent();
+        }
+        return used;
+    }
+
+    /* Lock the event queue */
     SDL_LockMutex(SDL_EventQ.lock);
     {
         /* Don't look after we've quit */
-        if (!SDL_EventQ.active) {
+        if (!SDL_AtomicGet(&SDL_EventQ.active)) {
             /* We get a few spurious events at shutdown, so don't warn then */
             if (action == SDL_GETEVENT) {
                 SDL_SetError("The event system has been shut down");
@@ -777,79 +1083,80 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_eventact
             SDL_UnlockMutex(SDL_EventQ.lock);
             return -1;
         }
-        if (action == SDL_ADDEVENT) {
-            for (i = 0; i < numevents; ++i) {
-                used += SDL_AddEvent(&events[i]);
-            }
-        } else {
-            SDL_EventEntry *entry, *next;
-            SDL_SysWMEntry *wmmsg, *wmmsg_next;
-            Uint32 type;
 
-            if (action == SDL_GETEVENT) {
-                /* Clean out any used wmmsg data
-                   FIXME: Do we want to retain the data for some period of time?
-                 */
-                for (wmmsg = SDL_EventQ.wmmsg_used; wmmsg; wmmsg = wmmsg_next) {
-                    wmmsg_next = wmmsg->next;
-                    wmmsg->next = SDL_EventQ.wmmsg_free;
-                    SDL_EventQ.wmmsg_free = wmmsg;
-                }
-                SDL_EventQ.wmmsg_used = NULL;
+        if (action == SDL_GETEVENT) {
+            /* Clean out any used wmmsg data
+               FIXME: Do we want to retain the data for some period of time?
+             */
+            for (wmmsg = SDL_EventQ.wmmsg_used; wmmsg; wmmsg = wmmsg_next) {
+                wmmsg_next = wmmsg->next;
+                wmmsg->next = SDL_EventQ.wmmsg_free;
+                SDL_EventQ.wmmsg_free = wmmsg;
             }
+            SDL_EventQ.wmmsg_used = NULL;
+        }
 
-            for (entry = SDL_EventQ.head; entry && (events == NULL || used < numevents); entry = next) {
-                next = entry->next;
-                type = entry->event.type;
-                if (minType <= type && type <= maxType) {
-                    if (events) {
-                        events[used] = entry->event;
-                        if (entry->event.type == SDL_SYSWMEVENT) {
-                            /* We need to copy the wmmsg somewhere safe.
-                               For now we'll guarantee it's valid at least until
-                               the next call to SDL_PeepEvents()
-                             */
-                            if (SDL_EventQ.wmmsg_free) {
-                                wmmsg = SDL_EventQ.wmmsg_free;
-                                SDL_EventQ.wmmsg_free = wmmsg->next;
-                            } else {
-                                wmmsg = (SDL_SysWMEntry *)SDL_malloc(sizeof(*wmmsg));
-                            }
-                            wmmsg->msg = *entry->event.syswm.msg;
-                            wmmsg->next = SDL_EventQ.wmmsg_used;
-                            SDL_EventQ.wmmsg_used = wmmsg;
-                            events[used].syswm.msg = &wmmsg->msg;
-                        }
+        if (action == SDL_GETEVENT && events && !SDL_EventQ.head &&
+            minType == SDL_FIRSTEVENT && maxType == SDL_LASTEVENT) {
+            /* Fast path: nothing is waiting in the list, so there's no need to link and cut entries */
+            used = SDL_GetEventsFromRing(events, numevents, include_sentinel);
+            SDL_UnlockMutex(SDL_EventQ.lock);
+            return used;
+        }
 
-                        if (action == SDL_GETEVENT) {
-                            SDL_CutEvent(entry);
+        SDL_DrainEventRing();
+
+        for (entry = SDL_EventQ.head; entry && (events == NULL || used < numevents); entry = next) {
+            next = entry->next;
+            type = entry->event.type;
+            if (minType <= type && type <= maxType) {
+                if (events) {
+                    events[used] = entry->event;
+                    if (entry->event.type == SDL_SYSWMEVENT) {
+                        /* We need to copy the wmmsg somewhere safe.
+                           For now we'll guarantee it's valid at least until
+                           the next call to SDL_PeepEvents()
+                         */
+                        if (SDL_EventQ.wmmsg_free) {
+                            wmmsg = SDL_EventQ.wmmsg_free;
+                            SDL_EventQ.wmmsg_free = wmmsg->next;
+                        } else {
+                            wmmsg = (SDL_SysWMEntry *)SDL_SlabAlloc(&SDL_wmmsg_entry_site, sizeof(*wmmsg));
                         }
+                        wmmsg->msg = *entry->event.syswm.msg;
+                        wmmsg->next = SDL_EventQ.wmmsg_used;
+                        SDL_EventQ.wmmsg_used = wmmsg;
+                        events[used].syswm.msg = &wmmsg->msg;
                     }
-                    if (type == SDL_POLLSENTINEL) {
-                        /* Special handling for the sentinel event */
-                        if (!include_sentinel) {
-                            /* Skip it, we don't want to include it */
-                            continue;
-                        }
-                        if (events == NULL || action != SDL_GETEVENT) {
-                            ++sentinels_expected;
-                        }
-                        if (SDL_AtomicGet(&SDL_sentinel_pending) > sentinels_expected) {
-                            /* Skip it, there's another one pending */
-                            continue;
-                        }
+
+                    if (action == SDL_GETEVENT) {
+                        SDL_CutEvent(entry);
+                    }
+                }
+                if (type == SDL_POLLSENTINEL) {
+                    /* Special handling for the sentinel event */
+                    if (!include_sentinel) {
+                        /* Skip it, we don't want to include it */
+                        continue;
+                    }
+                    if (events == NULL || action != SDL_GETEVENT) {
+                        ++sentinels_expected;
+                    }
+                    if (SDL_AtomicGet(&SDL_sentinel_pending) > sentinels_expected) {
+                        /* Skip it, there's another one pending */
+                        continue;
                     }
+
+                    /* This is the end of the poll cycle, leave anything after it for the next one */
                     ++used;
+                    break;
                 }
+                ++used;
             }
         }
     }
     SDL_UnlockMutex(SDL_EventQ.lock);
 
-    if (used > 0 && action == SDL_ADDEVENT) {
-        SDL_SendWakeupEvent();
-    }
-
     return used;
 }
 int SDL_PeepEvents(SDL_Event *events, int numevents, SDL_eventaction action,
@@ -893,10 +1200,11 @@ void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
     SDL_LockMutex(SDL_EventQ.lock);
     {
         /* Don't look after we've quit */
-        if (!SDL_EventQ.active) {
+        if (!SDL_AtomicGet(&SDL_EventQ.active)) {
             SDL_UnlockMutex(SDL_EventQ.lock);
             return;
         }
+        SDL_DrainEventRing();
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             type = entry->event.type;
@@ -963,6 +1271,35 @@ int SDL_PollEvent(SDL_Event *event)
     return SDL_WaitEventTimeout(event, 0);
 }
 
+int SDL_PollEvents(SDL_Event *events, int numevents)
+{
+    SDL_Event sentinel;
+    int result;
+
+    if (!events) {
+        return SDL_InvalidParamError("events");
+    }
+    if (numevents <= 0) {
+        return SDL_InvalidParamError("numevents");
+    }
+
+    /* Pump events and put a sentinel at the end of the queue, so the batch
+       doesn't include events that are added while it's being taken */
+    SDL_PumpEventsInternal(SDL_TRUE);
+
+    result = SDL_PeepEventsInternal(events, numevents, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT, SDL_TRUE);
+    if (result <= 0) {
+        return 0;
+    }
+    if (events[result - 1].type == SDL_POLLSENTINEL) {
+        --result;
+    } else if (SDL_AtomicGet(&SDL_sentinel_pending) > 0) {
+        /* The batch is full, the sentinel belongs to this call only */
+        SDL_PeepEventsInternal(&sentinel, 1, SDL_GETEVENT, SDL_POLLSENTINEL, SDL_POLLSENTINEL, SDL_TRUE);
+    }
+    return result;
+}
+
 static Sint16 SDL_events_get_polling_interval(void)
 {
     Sint16 poll_interval = SDL_MAX_SINT16;
@@ -1256,7 +1593,7 @@ void SDL_AddEventWatch(SDL_EventFilter filter, void *userdata)
     {
         SDL_EventWatcher *event_watchers;
 
-        event_watchers = SDL_realloc(SDL_event_watchers, (SDL_event_watchers_count + 1) * sizeof(*event_watchers));
+        event_watchers = SDL_TaggedRealloc(SDL_MEMORY_TAG_EVENTS, SDL_event_watchers, (SDL_event_watchers_count + 1) * sizeof(*event_watchers));
         if (event_watchers) {
             SDL_EventWatcher *watcher;
 
@@ -1300,6 +1637,7 @@ void SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
     SDL_LockMutex(SDL_EventQ.lock);
     {
         SDL_EventEntry *entry, *next;
+        SDL_DrainEventRing();
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             if (!filter(userdata, &entry->event)) {
@@ -1328,7 +1666,7 @@ Uint8 SDL_EventState(Uint32 type, int state)
         if (state == SDL_DISABLE) {
             /* Disable this event type and discard pending events */
             if (!SDL_disabled_events[hi]) {
-                SDL_disabled_events[hi] = (SDL_DisabledEventBlock *)SDL_calloc(1, sizeof(SDL_DisabledEventBlock));
+                SDL_disabled_events[hi] = (SDL_DisabledEventBlock *)SDL_TaggedCalloc(SDL_MEMORY_TAG_EVENTS, 1, sizeof(SDL_DisabledEventBlock));
             }
             /* Out of memory, nothing we can do... */
             if (SDL_disabled_events[hi]) {
@@ -1418,7 +1756,9 @@ int SDL_EventsInit(void)
 #endif
     SDL_AddHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
     SDL_AddHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
     if (SDL_StartEventLoop() < 0) {
+        SDL_DelHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
         SDL_DelHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
         return -1;
     }
@@ -1432,6 +1772,7 @@ void SDL_EventsQuit(void)
 {
     SDL_QuitQuit();
     SDL_StopEventLoop();
+    SDL_DelHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
     SDL_DelHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
     SDL_DelHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
 #ifndef SDL_JOYSTICK_DISABLED
@@ -240,8 +240,81 @@ static SDL_INLINE void DebugLogRenderCommands(const SDL_RenderCommand *cmd)
 #endif
 }
 
+static void CountRenderCommands(SDL_Renderer *renderer, const SDL_RenderCommand *cmd)
+{
+    SDL_RenderStats *stats = &renderer->stats;
+    Uint32 count = 0;
+
+    while (cmd) {
+        switch (cmd->command) {
+        case SDL_RENDERCMD_SETVIEWPORT:
+            stats->set_viewport_commands++;
+            break;
+        case SDL_RENDERCMD_SETCLIPRECT:
+            stats->set_cliprect_commands++;
+            break;
+        case SDL_RENDERCMD_SETDRAWCOLOR:
+            stats->set_draw_color_commands++;
+            break;
+        case SDL_RENDERCMD_CLEAR:
+            stats->clear_commands++;
+            break;
+        case SDL_RENDERCMD_DRAW_POINTS:
+            stats->draw_points_commands++;
+            break;
+        case SDL_RENDERCMD_DRAW_LINES:
+            stats->draw_lines_commands++;
+            break;
+        case SDL_RENDERCMD_FILL_RECTS:
+            stats->fill_rects_commands++;
+            break;
+        case SDL_RENDERCMD_COPY:
+            stats->copy_commands++;
+            break;
+        case SDL_RENDERCMD_COPY_EX:
+            stats->copy_ex_commands++;
+            break;
+        case SDL_RENDERCMD_GEOMETRY:
+            stats->geometry_commands++;
+            break;
+        case SDL_RENDERCMD_NO_OP:
+            break;
+        }
+        if (cmd->command != SDL_RENDERCMD_NO_OP) {
+            ++count;
+        }
+        cmd = cmd->next;
+    }
+
+    stats->flushes++;
+    stats->commands += count;
+    stats->max_batch_commands = SDL_max(stats->max_batch_commands, count);
+    stats->vertex_bytes += renderer->vertex_data_used;
+    stats->max_batch_vertex_bytes = SDL_max(stats->max_batch_vertex_bytes, (Uint64)renderer->vertex_data_used);
+}
+
+static Uint64 GetTextureUploadBytes(Uint32 format, const SDL_Rect *rect)
+{
+    const Uint64 pixels = (Uint64)rect->w * rect->h;
+
+    switch (format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        return pixels + 2 * (Uint64)((rect->w + 1) / 2) * ((rect->h + 1) / 2);
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+        return pixels * 2;
+    default:
+        return pixels * SDL_BYTESPERPIXEL(format);
+    }
+}
+
 static int FlushRenderCommands(SDL_Renderer *renderer)
 {
+    Uint64 start, elapsed, frequency;
     int retval;
 
     SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
@@ -252,16 +325,26 @@ static int FlushRenderCommands(SDL_Renderer *renderer)
     }
 
     DebugLogRenderCommands(renderer->render_commands);
+    CountRenderCommands(renderer, renderer->render_commands);
 
+    start = SDL_GetPerformanceCounter();
     retval = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
+    elapsed = SDL_GetPerformanceCounter() - start;
+    frequency = SDL_GetPerformanceFrequency();
+    renderer->stats.flush_ns += (elapsed / frequency) * SDL_NS_PER_SECOND +
+                                ((elapsed % frequency) * SDL_NS_PER_SECOND) / frequency;
 
-    /* Move the whole render command queue to the unused pool so we can reuse them next time. */
-    if (renderer->render_commands_tail) {
-        renderer->render_commands_tail->next = renderer->render_commands_pool;
-        renderer->render_commands_pool = renderer->render_commands;
-        renderer->render_commands_tail = NULL;
-        renderer->render_commands = NULL;
+    /* Keep the command array and vertex data around for the next batch. */
+    if (renderer->render_commands_used > renderer->render_commands_high_water) {
+        renderer->render_commands_high_water = renderer->render_commands_used;
     }
+    if (renderer->vertex_data_used > renderer->vertex_data_high_water) {
+        renderer->vertex_data_high_water = renderer->vertex_data_used;
+    }
+    renderer->render_commands_tail = NULL;
+    renderer->render_commands = NULL;
+    renderer->render_commands_used = 0;
+    renderer->copy_batch = NULL;
     renderer->vertex_data_used = 0;
     renderer->render_command_generation++;
     renderer->color_queued = SDL_FALSE;
@@ -306,7 +389,7 @@ void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes,
             newsize *= 2;
         }
 
-        ptr = SDL_realloc(renderer->vertex_data, newsize);
+        ptr = SDL_TaggedRealloc(SDL_MEMORY_TAG_RENDER, renderer->vertex_data, newsize);
 
         if (!ptr) {
             SDL_OutOfMemory();
@@ -330,17 +413,31 @@ static SDL_RenderCommand *AllocateRenderCommand(SDL_Renderer *renderer)
     SDL_RenderCommand *retval = NULL;
 
     /* !!! FIXME: are there threading limitations in SDL's render API? If not, we need to mutex this. */
-    retval = renderer->render_commands_pool;
-    if (retval) {
-        renderer->render_commands_pool = retval->next;
-        retval->next = NULL;
-    } else {
-        retval = SDL_calloc(1, sizeof(*retval));
-        if (!retval) {
+    if (renderer->render_commands_used == renderer->render_commands_allocation) {
+        const size_t newsize = renderer->render_commands_allocation ? (renderer->render_commands_allocation * 2) : 64;
+        SDL_RenderCommand *ptr = (SDL_RenderCommand *)SDL_TaggedRealloc(SDL_MEMORY_TAG_RENDER, renderer->render_commands_array, newsize * sizeof(*ptr));
+        size_t i;
+
+        if (!ptr) {
             SDL_OutOfMemory();
             return NULL;
         }
+
+        /* The queued commands moved, link them up again */
+        for (i = 1; i < renderer->render_commands_used; ++i) {
+            ptr[i - 1].next = &ptr[i];
+        }
+        if (renderer->render_commands_used > 0) {
+            renderer->render_commands = ptr;
+            renderer->render_commands_tail = &ptr[renderer->render_commands_used - 1];
+        }
+        renderer->render_commands_array = ptr;
+        renderer->render_commands_allocation = newsize;
+        renderer->render_commands_grows++;
+        renderer->copy_batch = NULL;
     }
+    retval = &renderer->render_commands_array[renderer->render_commands_used++];
+    retval->next = NULL;
 
     SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
     if (renderer->render_commands_tail) {
@@ -646,6 +743,71 @@ static int QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
     return retval;
 }
 
+/* Queue the triangles of a texture copy, appending them to the previous
+   copy's geometry command when nothing else was queued in between and the
+   texture, blend mode and color match, so a run of sprites from the same
+   texture becomes a single draw call in every backend. */
+static int QueueCmdCopyGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
+                                const float *xy, int xy_stride,
+                                const SDL_Color *color, int color_stride,
+                                const float *uv, int uv_stride,
+                                int num_vertices,
+                                const void *indices, int num_indices, int size_indices,
+                                float scale_x, float scale_y)
+{
+    SDL_RenderCommand *batch = renderer->copy_batch;
+    int retval;
+
+    if (batch && batch == renderer->render_commands_tail &&
+        batch->data.draw.texture == texture &&
+        batch->data.draw.blend == texture->blendMode &&
+        batch->data.draw.r == color->r && batch->data.draw.g == color->g &&
+        batch->data.draw.b == color->b && batch->data.draw.a == color->a &&
+        renderer->vertex_data_used == renderer->copy_batch_end &&
+        renderer->viewport_queued && renderer->cliprect_queued) {
+        SDL_RenderCommand cmd = *batch;
+
+        cmd.data.draw.first = 0;
+        cmd.data.draw.count = 0;
+        retval = renderer->QueueGeometry(renderer, &cmd, texture,
+                                         xy, xy_stride, color, color_stride, uv, uv_stride,
+                                         num_vertices, indices, num_indices, size_indices,
+                                         scale_x, scale_y);
+        if (retval < 0) {
+            renderer->vertex_data_used = renderer->copy_batch_end;
+            return retval;
+        }
+        if (cmd.data.draw.first == renderer->copy_batch_end) {
+            batch->data.draw.count += cmd.data.draw.count;
+            renderer->copy_batch_end = renderer->vertex_data_used;
+            renderer->stats.merged_copies++;
+            return 0;
+        }
+
+        /* The backend padded the vertices, they need a command of their own */
+        batch = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_GEOMETRY, texture);
+        if (!batch) {
+            return -1;
+        }
+        batch->data.draw.first = cmd.data.draw.first;
+        batch->data.draw.count = cmd.data.draw.count;
+    } else {
+        retval = QueueCmdGeometry(renderer, texture,
+                                  xy, xy_stride, color, color_stride, uv, uv_stride,
+                                  num_vertices, indices, num_indices, size_indices,
+                                  scale_x, scale_y);
+        if (retval < 0) {
+            renderer->copy_batch = NULL;
+            return retval;
+        }
+        batch = renderer->render_commands_tail;
+    }
+
+    renderer->copy_batch = batch;
+    renderer->copy_batch_end = renderer->vertex_data_used;
+    return 0;
+}
+
 static int UpdateLogicalSize(SDL_Renderer *renderer, SDL_bool flush_viewport_cmd);
 
 int SDL_GetNumRenderDrivers(void)
@@ -982,7 +1144,7 @@ SDL_Renderer *SDL_CreateRenderer(SDL_Window *window, int index, Uint32 flags)
         goto error;
     }
 
-    renderer = (SDL_Renderer *)SDL_calloc(1, sizeof(*renderer));
+    renderer = (SDL_Renderer *)SDL_TaggedCalloc(SDL_MEMORY_TAG_RENDER, 1, sizeof(*renderer));
     if (!renderer) {
         SDL_OutOfMemory();
         goto error;
@@ -1149,7 +1311,7 @@ SDL_Renderer *SDL_CreateSoftwareRenderer(SDL_Surface *surface)
     SDL_Renderer *renderer;
     int rc;
 
-    renderer = (SDL_Renderer *)SDL_calloc(1, sizeof(*renderer));
+    renderer = (SDL_Renderer *)SDL_TaggedCalloc(SDL_MEMORY_TAG_RENDER, 1, sizeof(*renderer));
     if (!renderer) {
         SDL_OutOfMemory();
         return NULL;
@@ -1316,7 +1478,7 @@ SDL_Texture *SDL_CreateTexture(SDL_Renderer *renderer, Uint32 format, int access
         SDL_SetError("Texture dimensions are limited to %dx%d", renderer->info.max_texture_width, renderer->info.max_texture_height);
         return NULL;
     }
-    texture = (SDL_Texture *)SDL_calloc(1, sizeof(*texture));
+    texture = (SDL_Texture *)SDL_TaggedCalloc(SDL_MEMORY_TAG_RENDER, 1, sizeof(*texture));
     if (!texture) {
         SDL_OutOfMemory();
         return NULL;
@@ -1387,7 +1549,7 @@ SDL_Texture *SDL_CreateTexture(SDL_Renderer *renderer, Uint32 format, int access
         } else if (access == SDL_TEXTUREACCESS_STREAMING) {
             /* The pitch is 4 byte aligned */
             texture->pitch = (((w * SDL_BYTESPERPIXEL(format)) + 3) & ~3);
-            texture->pixels = SDL_calloc(1, (size_t)texture->pitch * h);
+            texture->pixels = SDL_TaggedCalloc(SDL_MEMORY_TAG_RENDER, 1, (size_t)texture->pitch * h);
             if (!texture->pixels) {
                 SDL_DestroyTexture(texture);
                 return NULL;
@@ -1734,7 +1896,7 @@ static int SDL_UpdateTextureYUV(SDL_Texture *texture, const SDL_Rect *rect,
         const int temp_pitch = (((rect->w * SDL_BYTESPERPIXEL(native->format)) + 3) & ~3);
         const size_t alloclen = (size_t)rect->h * temp_pitch;
         if (alloclen > 0) {
-            void *temp_pixels = SDL_malloc(alloclen);
+            void *temp_pixels = SDL_TaggedMalloc(SDL_MEMORY_TAG_RENDER, alloclen);
             if (!temp_pixels) {
                 return SDL_OutOfMemory();
             }
@@ -1774,7 +1936,7 @@ static int SDL_UpdateTextureNative(SDL_Texture *texture, const SDL_Rect *rect,
         const int temp_pitch = (((rect->w * SDL_BYTESPERPIXEL(native->format)) + 3) & ~3);
         const size_t alloclen = (size_t)rect->h * temp_pitch;
         if (alloclen > 0) {
-            void *temp_pixels = SDL_malloc(alloclen);
+            void *temp_pixels = SDL_TaggedMalloc(SDL_MEMORY_TAG_RENDER, alloclen);
             if (!temp_pixels) {
                 return SDL_OutOfMemory();
             }
@@ -1825,7 +1987,11 @@ int SDL_UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect,
         if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
             return -1;
         }
-        return renderer->UpdateTexture(renderer, texture, &real_rect, pixels, pitch);
+        if (renderer->UpdateTexture(renderer, texture, &real_rect, pixels, pitch) < 0) {
+            return -1;
+        }
+        renderer->stats.texture_upload_bytes += GetTextureUploadBytes(texture->format, &real_rect);
+        return 0;
     }
 }
 
@@ -1868,7 +2034,7 @@ static int SDL_UpdateTextureYUVPlanar(SDL_Texture *texture, const SDL_Rect *rect
         const int temp_pitch = (((rect->w * SDL_BYTESPERPIXEL(native->format)) + 3) & ~3);
         const size_t alloclen = (size_t)rect->h * temp_pitch;
         if (alloclen > 0) {
-            void *temp_pixels = SDL_malloc(alloclen);
+            void *temp_pixels = SDL_TaggedMalloc(SDL_MEMORY_TAG_RENDER, alloclen);
             if (!temp_pixels) {
                 return SDL_OutOfMemory();
             }
@@ -1918,7 +2084,7 @@ static int SDL_UpdateTextureNVPlanar(SDL_Texture *texture, const SDL_Rect *rect,
         const int temp_pitch = (((rect->w * SDL_BYTESPERPIXEL(native->format)) + 3) & ~3);
         const size_t alloclen = (size_t)rect->h * temp_pitch;
         if (alloclen > 0) {
-            void *temp_pixels = SDL_malloc(alloclen);
+            void *temp_pixels = SDL_TaggedMalloc(SDL_MEMORY_TAG_RENDER, alloclen);
             if (!temp_pixels) {
                 return SDL_OutOfMemory();
             }
@@ -1990,7 +2156,11 @@ int SDL_UpdateYUVTexture(SDL_Texture *texture, const SDL_Rect *rect,
             if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
                 return -1;
             }
-            return renderer->UpdateTextureYUV(renderer, texture, &real_rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
+            if (renderer->UpdateTextureYUV(renderer, texture, &real_rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch) < 0) {
+                return -1;
+            }
+            renderer->stats.texture_upload_bytes += GetTextureUploadBytes(texture->format, &real_rect);
+            return 0;
         } else {
             return SDL_Unsupported();
         }
@@ -2050,7 +2220,11 @@ int SDL_UpdateNVTexture(SDL_Texture *texture, const SDL_Rect *rect,
             if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
                 return -1;
             }
-            return renderer->UpdateTextureNV(renderer, texture, &real_rect, Yplane, Ypitch, UVplane, UVpitch);
+            if (renderer->UpdateTextureNV(renderer, texture, &real_rect, Yplane, Ypitch, UVplane, UVpitch) < 0) {
+                return -1;
+            }
+            renderer->stats.texture_upload_bytes += GetTextureUploadBytes(texture->format, &real_rect);
+            return 0;
         } else {
             return SDL_Unsupported();
         }
@@ -2114,6 +2288,7 @@ int SDL_LockTexture(SDL_Texture *texture, const SDL_Rect *rect,
         if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
             return -1;
         }
+        texture->locked_rect = *rect; /* counted as uploaded on unlock */
         return renderer->LockTexture(renderer, texture, rect, pixels, pitch);
     }
 }
@@ -2212,6 +2387,7 @@ void SDL_UnlockTexture(SDL_Texture *texture)
     } else {
         SDL_Renderer *renderer = texture->renderer;
         renderer->UnlockTexture(renderer, texture);
+        renderer->stats.texture_upload_bytes += GetTextureUploadBytes(texture->format, &texture->locked_rect);
     }
 
     SDL_FreeSurface(texture->locked_surface);
@@ -3526,11 +3702,11 @@ int SDL_RenderCopyF(SDL_Renderer *renderer, SDL_Texture *texture,
         xy[6] = minx;
         xy[7] = maxy;
 
-        retval = QueueCmdGeometry(renderer, texture,
-                                  xy, xy_stride, &texture->color, 0 /* color_stride */, uv, uv_stride,
-                                  num_vertices,
-                                  indices, num_indices, size_indices,
-                                  renderer->scale.x, renderer->scale.y);
+        retval = QueueCmdCopyGeometry(renderer, texture,
+                                      xy, xy_stride, &texture->color, 0 /* color_stride */, uv, uv_stride,
+                                      num_vertices,
+                                      indices, num_indices, size_indices,
+                                      renderer->scale.x, renderer->scale.y);
     } else {
 
         real_dstrect.x *= renderer->scale.x;
@@ -3709,11 +3885,11 @@ int SDL_RenderCopyExF(SDL_Renderer *renderer, SDL_Texture *texture,
         xy[6] = (c_minx - s_maxy) + centerx;
         xy[7] = (s_minx + c_maxy) + centery;
 
-        retval = QueueCmdGeometry(renderer, texture,
-                                  xy, xy_stride, &texture->color, 0 /* color_stride */, uv, uv_stride,
-                                  num_vertices,
-                                  indices, num_indices, size_indices,
-                                  renderer->scale.x, renderer->scale.y);
+        retval = QueueCmdCopyGeometry(renderer, texture,
+                                      xy, xy_stride, &texture->color, 0 /* color_stride */, uv, uv_stride,
+                                      num_vertices,
+                                      indices, num_indices, size_indices,
+                                      renderer->scale.x, renderer->scale.y);
     } else {
 
         retval = QueueCmdCopyEx(renderer, texture, &real_srcrect, &real_dstrect, angle, &real_center, flip, renderer->scale.x, renderer->scale.y);
@@ -4308,6 +4484,25 @@ void SDL_RenderPresent(SDL_Renderer *renderer)
         (!presented && renderer->wanted_vsync)) {
         SDL_RenderSimulateVSync(renderer);
     }
+
+    renderer->last_stats = renderer->stats;
+    SDL_zero(renderer->stats);
+}
+
+int SDL_RenderGetStats(SDL_Renderer *renderer, SDL_RenderStats *stats)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+    *stats = renderer->last_stats;
+    stats->command_pool_size = (Uint32)renderer->render_commands_allocation;
+    stats->command_pool_high_water = (Uint32)renderer->render_commands_high_water;
+    stats->command_pool_grows = (Uint32)renderer->render_commands_grows;
+    stats->vertex_pool_size = renderer->vertex_data_allocation;
+    stats->vertex_pool_high_water = renderer->vertex_data_high_water;
+    return 0;
 }
 
 void SDL_DestroyTexture(SDL_Texture *texture)
@@ -4354,8 +4549,6 @@ void SDL_DestroyTexture(SDL_Texture *texture)
 
 void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
 {
-    SDL_RenderCommand *cmd;
-
     SDL_assert(renderer != NULL);
     SDL_assert(!renderer->destroyed);
 
@@ -4363,22 +4556,18 @@ void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
 
     SDL_DelEventWatch(SDL_RendererEventWatch, renderer);
 
-    if (renderer->render_commands_tail) {
-        renderer->render_commands_tail->next = renderer->render_commands_pool;
-        cmd = renderer->render_commands;
-    } else {
-        cmd = renderer->render_commands_pool;
-    }
+    SDL_LogDebug(SDL_LOG_CATEGORY_RENDER, "Renderer %s queued at most %u commands (%u allocated) and %u vertex bytes (%u allocated) in a batch",
+                 renderer->info.name,
+                 (unsigned int)renderer->render_commands_high_water, (unsigned int)renderer->render_commands_allocation,
+                 (unsigned int)renderer->vertex_data_high_water, (unsigned int)renderer->vertex_data_allocation);
 
-    renderer->render_commands_pool = NULL;
+    SDL_free(renderer->render_commands_array);
+    renderer->render_commands_array = NULL;
     renderer->render_commands_tail = NULL;
     renderer->render_commands = NULL;
-
-    while (cmd) {
-        SDL_RenderCommand *next = cmd->next;
-        SDL_free(cmd);
-        cmd = next;
-    }
+    renderer->render_commands_used = 0;
+    renderer->render_commands_allocation = 0;
+    renderer->copy_batch = NULL;
 
     SDL_free(renderer->vertex_data);
 
@@ -4582,4 +4771,484 @@ int SDL_RenderSetVSync(SDL_Renderer *renderer, int vsync)
     return 0;
 }
 
+
+/* Texture atlases are packed in shelves: rows as tall as the image that
+ * started them, filled from left to right. Each image is surrounded by a
+ * copy of its edge pixels, so linear filtering never reads a neighbour.
+ * An image ID holds the index of the image plus one in the low bits and
+ * a generation above them, so IDs of removed or evicted images fail.
+ */
+#define ATLAS_BORDER           1
+#define ATLAS_INDEX_BITS       20
+#define ATLAS_INDEX_MASK       ((1 << ATLAS_INDEX_BITS) - 1)
+#define ATLAS_GENERATION_MASK  0x7FF
+
+typedef struct SDL_AtlasShelf
+{
+    int y;
+    int h;
+    int x; /* where the next image goes */
+} SDL_AtlasShelf;
+
+/* A hole left in a shelf by a removed image */
+typedef struct SDL_AtlasSlot
+{
+    int page;
+    int shelf;
+    int x;
+    int w;
+} SDL_AtlasSlot;
+
+typedef struct SDL_AtlasPage
+{
+    SDL_Texture *texture;
+    SDL_AtlasShelf *shelves;
+    int num_shelves;
+    int max_shelves;
+    int next_y; /* where the next shelf goes */
+    Uint32 last_used;
+} SDL_AtlasPage;
+
+typedef struct SDL_AtlasImage
+{
+    int page;  /* -1 if the entry is free */
+    int shelf; /* next free entry if the entry is free */
+    SDL_Rect rect;
+    int generation;
+} SDL_AtlasImage;
+
+struct SDL_TextureAtlas
+{
+    SDL_Renderer *renderer;
+    Uint32 format;
+    int page_w;
+    int page_h;
+    int max_pages;
+    SDL_AtlasPage *pages;
+    int num_pages;
+    int allocated_pages;
+    SDL_AtlasImage *images;
+    int num_images;
+    int allocated_images;
+    int first_free_image;
+    SDL_AtlasSlot *slots;
+    int num_slots;
+    int allocated_slots;
+    Uint32 clock;
+};
+
+/* Make room for one more element at the end of an array */
+static SDL_bool AtlasReserve(void **array, int *allocated, int count, size_t size)
+{
+    if (count == *allocated) {
+        const int newsize = *allocated ? (*allocated * 2) : 16;
+        void *ptr = SDL_TaggedRealloc(SDL_MEMORY_TAG_RENDER, *array, newsize * size);
+        if (!ptr) {
+            SDL_OutOfMemory();
+            return SDL_FALSE;
+        }
+        *array = ptr;
+        *allocated = newsize;
+    }
+    return SDL_TRUE;
+}
+
+static SDL_AtlasImage *AtlasGetImage(SDL_TextureAtlas *atlas, int id)
+{
+    const int index = (id & ATLAS_INDEX_MASK) - 1;
+    SDL_AtlasImage *image;
+
+    if (!atlas) {
+        SDL_InvalidParamError("atlas");
+        return NULL;
+    }
+    if (id <= 0 || index < 0 || index >= atlas->num_images) {
+        SDL_InvalidParamError("id");
+        return NULL;
+    }
+    image = &atlas->images[index];
+    if (image->page < 0 || image->generation != (id >> ATLAS_INDEX_BITS)) {
+        SDL_SetError("Atlas image was removed or evicted");
+        return NULL;
+    }
+    return image;
+}
+
+static void AtlasFreeImage(SDL_TextureAtlas *atlas, SDL_AtlasImage *image)
+{
+    image->page = -1;
+    image->shelf = atlas->first_free_image;
+    image->generation = (image->generation + 1) & ATLAS_GENERATION_MASK;
+    atlas->first_free_image = (int)(image - atlas->images);
+}
+
+/* Evict every image in a page and start packing it again */
+static void AtlasClearPage(SDL_TextureAtlas *atlas, int page)
+{
+    int i;
+
+    for (i = 0; i < atlas->num_images; ++i) {
+        if (atlas->images[i].page == page) {
+            AtlasFreeImage(atlas, &atlas->images[i]);
+        }
+    }
+    for (i = 0; i < atlas->num_slots;) {
+        if (atlas->slots[i].page == page) {
+            atlas->slots[i] = atlas->slots[--atlas->num_slots];
+        } else {
+            ++i;
+        }
+    }
+    atlas->pages[page].num_shelves = 0;
+    atlas->pages[page].next_y = 0;
+}
+
+static int AtlasAddShelf(SDL_TextureAtlas *atlas, int page, int w, int h)
+{
+    SDL_AtlasPage *p = &atlas->pages[page];
+    SDL_AtlasShelf *shelf;
+
+    if (!AtlasReserve((void **)&p->shelves, &p->max_shelves, p->num_shelves, sizeof(*p->shelves))) {
+        return -1;
+    }
+    shelf = &p->shelves[p->num_shelves++];
+    shelf->y = p->next_y;
+    shelf->h = h;
+    shelf->x = w;
+    p->next_y += h;
+    return p->num_shelves - 1;
+}
+
+/* Find room for a w x h rectangle, evicting the least recently used page
+   if the atlas has as many pages as it may have and they are all full. */
+static int AtlasFindSpace(SDL_TextureAtlas *atlas, int w, int h, int *page, int *shelf, int *x)
+{
+    int best_page = -1, best_shelf = -1, best_waste = 0;
+    int i, j;
+
+    /* A hole left by a removed image, in a shelf of about the same height */
+    for (i = 0; i < atlas->num_slots; ++i) {
+        const SDL_AtlasSlot *slot = &atlas->slots[i];
+        const int shelf_h = atlas->pages[slot->page].shelves[slot->shelf].h;
+        if (slot->w >= w && shelf_h >= h && shelf_h - h <= h / 2 &&
+            (best_shelf < 0 || slot->w < best_waste)) {
+            best_shelf = i;
+            best_waste = slot->w;
+        }
+    }
+    if (best_shelf >= 0) {
+        SDL_AtlasSlot *slot = &atlas->slots[best_shelf];
+        *page = slot->page;
+        *shelf = slot->shelf;
+        *x = slot->x;
+        slot->x += w;
+        slot->w -= w;
+        if (slot->w == 0) {
+            *slot = atlas->slots[--atlas->num_slots];
+        }
+        return 0;
+    }
+
+    /* The end of a shelf of about the same height, then a new shelf */
+    for (i = 0; i < atlas->num_pages; ++i) {
+        const SDL_AtlasPage *p = &atlas->pages[i];
+        for (j = 0; j < p->num_shelves; ++j) {
+            const SDL_AtlasShelf *s = &p->shelves[j];
+            if (s->h >= h && s->h - h <= h / 2 && atlas->page_w - s->x >= w &&
+                (best_shelf < 0 || s->h - h < best_waste)) {
+                best_page = i;
+                best_shelf = j;
+                best_waste = s->h - h;
+            }
+        }
+    }
+    if (best_shelf < 0) {
+        for (i = 0; i < atlas->num_pages; ++i) {
+            if (atlas->page_h - atlas->pages[i].next_y >= h) {
+                *page = i;
+                *shelf = AtlasAddShelf(atlas, i, w, h);
+                *x = 0;
+                return *shelf < 0 ? -1 : 0;
+            }
+        }
+    }
+
+    /* Any shelf tall enough */
+    if (best_shelf < 0) {
+        for (i = 0; i < atlas->num_pages; ++i) {
+            const SDL_AtlasPage *p = &atlas->pages[i];
+            for (j = 0; j < p->num_shelves; ++j) {
+                const SDL_AtlasShelf *s = &p->shelves[j];
+                if (s->h >= h && atlas->page_w - s->x >= w &&
+                    (best_shelf < 0 || s->h - h < best_waste)) {
+                    best_page = i;
+                    best_shelf = j;
+                    best_waste = s->h - h;
+                }
+            }
+        }
+    }
+    if (best_shelf >= 0) {
+        SDL_AtlasShelf *s = &atlas->pages[best_page].shelves[best_shelf];
+        *page = best_page;
+        *shelf = best_shelf;
+        *x = s->x;
+        s->x += w;
+        return 0;
+    }
+
+    /* A new page, or the page that was used the longest time ago */
+    if (!atlas->max_pages || atlas->num_pages < atlas->max_pages) {
+        SDL_AtlasPage *p;
+        SDL_Texture *texture = SDL_CreateTexture(atlas->renderer, atlas->format, SDL_TEXTUREACCESS_STATIC, atlas->page_w, atlas->page_h);
+        if (!texture) {
+            return -1;
+        }
+        if (!AtlasReserve((void **)&atlas->pages, &atlas->allocated_pages, atlas->num_pages, sizeof(*atlas->pages))) {
+            SDL_DestroyTexture(texture);
+            return -1;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        p = &atlas->pages[atlas->num_pages];
+        SDL_zerop(p);
+        p->texture = texture;
+        best_page = atlas->num_pages++;
+    } else {
+        best_page = 0;
+        for (i = 1; i < atlas->num_pages; ++i) {
+            if ((Sint32)(atlas->pages[i].last_used - atlas->pages[best_page].last_used) < 0) {
+                best_page = i;
+            }
+        }
+        AtlasClearPage(atlas, best_page);
+    }
+    *page = best_page;
+    *shelf = AtlasAddShelf(atlas, best_page, w, h);
+    *x = 0;
+    return *shelf < 0 ? -1 : 0;
+}
+
+/* Copy a surface into an image's place, with its edges repeated around it */
+static int AtlasUploadImage(SDL_TextureAtlas *atlas, const SDL_AtlasImage *image, SDL_Surface *surface)
+{
+    const int w = image->rect.w;
+    const int h = image->rect.h;
+    SDL_Surface *padded;
+    SDL_BlendMode blendMode;
+    Uint8 r, g, b, a;
+    SDL_Rect rect;
+    Uint8 *pixels;
+    int bpp, y;
+    int retval;
+
+    padded = SDL_CreateRGBSurfaceWithFormat(0, w + 2 * ATLAS_BORDER, h + 2 * ATLAS_BORDER, 0, atlas->format);
+    if (!padded) {
+        return -1;
+    }
+
+    /* The pixels are copied as they are, like SDL_CreateTextureFromSurface() */
+    SDL_GetSurfaceBlendMode(surface, &blendMode);
+    SDL_GetSurfaceColorMod(surface, &r, &g, &b);
+    SDL_GetSurfaceAlphaMod(surface, &a);
+    SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+    SDL_SetSurfaceColorMod(surface, 255, 255, 255);
+    SDL_SetSurfaceAlphaMod(surface, 255);
+    rect.x = ATLAS_BORDER;
+    rect.y = ATLAS_BORDER;
+    rect.w = w;
+    rect.h = h;
+    retval = SDL_BlitSurface(surface, NULL, padded, &rect);
+    SDL_SetSurfaceBlendMode(surface, blendMode);
+    SDL_SetSurfaceColorMod(surface, r, g, b);
+    SDL_SetSurfaceAlphaMod(surface, a);
+
+    if (retval == 0) {
+        bpp = padded->format->BytesPerPixel;
+        pixels = (Uint8 *)padded->pixels;
+        for (y = ATLAS_BORDER; y < h + ATLAS_BORDER; ++y) {
+            Uint8 *row = pixels + y * padded->pitch;
+            SDL_memcpy(row, row + ATLAS_BORDER * bpp, bpp);
+            SDL_memcpy(row + (w + ATLAS_BORDER) * bpp, row + (w + ATLAS_BORDER - 1) * bpp, bpp);
+        }
+        SDL_memcpy(pixels, pixels + ATLAS_BORDER * padded->pitch, (size_t)padded->w * bpp);
+        SDL_memcpy(pixels + (h + ATLAS_BORDER) * padded->pitch, pixels + (h + ATLAS_BORDER - 1) * padded->pitch, (size_t)padded->w * bpp);
+
+        rect.x = image->rect.x - ATLAS_BORDER;
+        rect.y = image->rect.y - ATLAS_BORDER;
+        rect.w = padded->w;
+        rect.h = padded->h;
+        retval = SDL_UpdateTexture(atlas->pages[image->page].texture, &rect, padded->pixels, padded->pitch);
+    }
+    SDL_FreeSurface(padded);
+    return retval;
+}
+
+SDL_TextureAtlas *SDL_CreateTextureAtlas(SDL_Renderer *renderer, Uint32 format, int page_width, int page_height, int max_pages)
+{
+    SDL_TextureAtlas *atlas;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    if (!format) {
+        format = SDL_PIXELFORMAT_ARGB8888;
+    }
+    if (SDL_ISPIXELFORMAT_FOURCC(format) || SDL_ISPIXELFORMAT_INDEXED(format) || SDL_BYTESPERPIXEL(format) == 0) {
+        SDL_SetError("Texture atlases need a packed or array pixel format");
+        return NULL;
+    }
+    if (page_width <= 2 * ATLAS_BORDER || page_height <= 2 * ATLAS_BORDER) {
+        SDL_InvalidParamError("page_width");
+        return NULL;
+    }
+    if (max_pages < 0) {
+        SDL_InvalidParamError("max_pages");
+        return NULL;
+    }
+
+    atlas = (SDL_TextureAtlas *)SDL_TaggedCalloc(SDL_MEMORY_TAG_RENDER, 1, sizeof(*atlas));
+    if (!atlas) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    atlas->renderer = renderer;
+    atlas->format = format;
+    atlas->page_w = page_width;
+    atlas->page_h = page_height;
+    atlas->max_pages = max_pages;
+    atlas->first_free_image = -1;
+    return atlas;
+}
+
+int SDL_AddTextureAtlasImage(SDL_TextureAtlas *atlas, SDL_Surface *surface)
+{
+    SDL_AtlasImage *image;
+    int index, page, shelf, x;
+
+    if (!atlas) {
+        return SDL_InvalidParamError("atlas");
+    }
+    if (!surface) {
+        return SDL_InvalidParamError("surface");
+    }
+    if (surface->w <= 0 || surface->h <= 0 ||
+        surface->w + 2 * ATLAS_BORDER > atlas->page_w ||
+        surface->h + 2 * ATLAS_BORDER > atlas->page_h) {
+        return SDL_SetError("Atlas images must be between 1x1 and %dx%d", atlas->page_w - 2 * ATLAS_BORDER, atlas->page_h - 2 * ATLAS_BORDER);
+    }
+
+    if (atlas->first_free_image < 0) {
+        if (atlas->num_images == ATLAS_INDEX_MASK) {
+            return SDL_SetError("Too many images in the atlas");
+        }
+        if (!AtlasReserve((void **)&atlas->images, &atlas->allocated_images, atlas->num_images, sizeof(*atlas->images))) {
+            return -1;
+        }
+        image = &atlas->images[atlas->num_images++];
+        image->generation = 0;
+        AtlasFreeImage(atlas, image);
+    }
+
+    if (AtlasFindSpace(atlas, surface->w + 2 * ATLAS_BORDER, surface->h + 2 * ATLAS_BORDER, &page, &shelf, &x) < 0) {
+        return -1;
+    }
+
+    /* Eviction may have freed images, take the free entry afterwards */
+    index = atlas->first_free_image;
+    image = &atlas->images[index];
+    atlas->first_free_image = image->shelf;
+    image->page = page;
+    image->shelf = shelf;
+    image->rect.x = x + ATLAS_BORDER;
+    image->rect.y = atlas->pages[page].shelves[shelf].y + ATLAS_BORDER;
+    image->rect.w = surface->w;
+    image->rect.h = surface->h;
+    atlas->pages[page].last_used = ++atlas->clock;
+
+    if (AtlasUploadImage(atlas, image, surface) < 0) {
+        SDL_RemoveTextureAtlasImage(atlas, ((image->generation << ATLAS_INDEX_BITS) | (index + 1)));
+        return -1;
+    }
+    return (image->generation << ATLAS_INDEX_BITS) | (index + 1);
+}
+
+int SDL_UpdateTextureAtlasImage(SDL_TextureAtlas *atlas, int id, SDL_Surface *surface)
+{
+    SDL_AtlasImage *image = AtlasGetImage(atlas, id);
+
+    if (!image) {
+        return -1;
+    }
+    if (!surface) {
+        return SDL_InvalidParamError("surface");
+    }
+    if (surface->w != image->rect.w || surface->h != image->rect.h) {
+        return SDL_SetError("Surface must be %dx%d like the atlas image", image->rect.w, image->rect.h);
+    }
+    atlas->pages[image->page].last_used = ++atlas->clock;
+    return AtlasUploadImage(atlas, image, surface);
+}
+
+int SDL_QueryTextureAtlasImage(SDL_TextureAtlas *atlas, int id, SDL_Texture **texture, SDL_Rect *rect)
+{
+    SDL_AtlasImage *image = AtlasGetImage(atlas, id);
+
+    if (!image) {
+        return -1;
+    }
+    atlas->pages[image->page].last_used = ++atlas->clock;
+    if (texture) {
+        *texture = atlas->pages[image->page].texture;
+    }
+    if (rect) {
+        *rect = image->rect;
+    }
+    return 0;
+}
+
+int SDL_RemoveTextureAtlasImage(SDL_TextureAtlas *atlas, int id)
+{
+    SDL_AtlasImage *image = AtlasGetImage(atlas, id);
+    SDL_AtlasShelf *shelf;
+    SDL_AtlasSlot *slot;
+    int x, w;
+
+    if (!image) {
+        return -1;
+    }
+
+    x = image->rect.x - ATLAS_BORDER;
+    w = image->rect.w + 2 * ATLAS_BORDER;
+    shelf = &atlas->pages[image->page].shelves[image->shelf];
+    if (x + w == shelf->x) {
+        /* the last image in the shelf, just give the space back */
+        shelf->x = x;
+    } else if (AtlasReserve((void **)&atlas->slots, &atlas->allocated_slots, atlas->num_slots, sizeof(*atlas->slots))) {
+        slot = &atlas->slots[atlas->num_slots++];
+        slot->page = image->page;
+        slot->shelf = image->shelf;
+        slot->x = x;
+        slot->w = w;
+    } /* else the space is lost until the page is evicted */
+
+    AtlasFreeImage(atlas, image);
+    return 0;
+}
+
+void SDL_DestroyTextureAtlas(SDL_TextureAtlas *atlas)
+{
+    int i;
+
+    if (!atlas) {
+        return;
+    }
+    for (i = 0; i < atlas->num_pages; ++i) {
+        SDL_DestroyTexture(atlas->pages[i].texture);
+        SDL_free(atlas->pages[i].shelves);
+    }
+    SDL_free(atlas->pages);
+    SDL_free(atlas->images);
+    SDL_free(atlas->slots);
+    SDL_free(atlas);
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
@@ -266,9 +266,13 @@ struct SDL_Renderer
 
     SDL_bool always_batch;
     SDL_bool batching;
+    /* The queued commands are stored in order in one array that is reused
+       for every batch, each one linked to the next for the backends. */
     SDL_RenderCommand *render_commands;
     SDL_RenderCommand *render_commands_tail;
-    SDL_RenderCommand *render_commands_pool;
+    SDL_RenderCommand *render_commands_array;
+    size_t render_commands_used;
+    size_t render_commands_allocation;
     Uint32 render_command_generation;
     Uint32 last_queued_color;
     SDL_DRect last_queued_viewport;
@@ -282,6 +286,22 @@ struct SDL_Renderer
     size_t vertex_data_used;
     size_t vertex_data_allocation;
 
+    /* Most commands and vertex bytes queued in one batch, and how often the
+       command array had to grow */
+    size_t render_commands_high_water;
+    size_t vertex_data_high_water;
+    size_t render_commands_grows;
+
+    /* The geometry command of the last texture copy, further copies with the
+       same state are appended to it while it is still the queue's tail. */
+    SDL_RenderCommand *copy_batch;
+    size_t copy_batch_end;
+
+    /* Counts for the frame in progress and the last presented one, the
+       backends add their draw calls, texture binds and program switches. */
+    SDL_RenderStats stats;
+    SDL_RenderStats last_stats;
+
     SDL_bool destroyed;   /* already destroyed by SDL_DestroyWindow; just free this struct in SDL_DestroyRenderer. */
 
     void *driverdata;
@@ -1135,8 +1135,9 @@ static int SetDrawState(GL_RenderData *data, const SDL_RenderCommand *cmd, const
     return 0;
 }
 
-static int SetCopyState(GL_RenderData *data, const SDL_RenderCommand *cmd)
+static int SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd)
 {
+    GL_RenderData *data = (GL_RenderData *)renderer->driverdata;
     SDL_Texture *texture = cmd->data.draw.texture;
     const GL_TextureData *texturedata = (GL_TextureData *)texture->driverdata;
 
@@ -1169,6 +1170,7 @@ static int SetCopyState(GL_RenderData *data, const SDL_RenderCommand *cmd)
         data->glBindTexture(textype, texturedata->texture);
 
         data->drawstate.texture = texture;
+        renderer->stats.texture_binds++;
     }
 
     return 0;
@@ -1290,6 +1292,7 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                 if (count > 2) {
                     /* joined lines cannot be grouped */
                     data->glDrawArrays(GL_LINE_STRIP, 0, (GLsizei)count);
+                    renderer->stats.draw_calls++;
                 } else {
                     /* let's group non joined lines */
                     SDL_RenderCommand *finalcmd = cmd;
@@ -1312,6 +1315,7 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                     }
 
                     data->glDrawArrays(GL_LINES, 0, (GLsizei)count);
+                    renderer->stats.draw_calls++;
                     cmd = finalcmd; /* skip any copy commands we just combined in here. */
                 }
             }
@@ -1344,7 +1348,7 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             }
 
             if (thistexture) {
-                ret = SetCopyState(data, cmd);
+                ret = SetCopyState(renderer, cmd);
             } else {
                 ret = SetDrawState(data, cmd, SHADER_SOLID);
             }
@@ -1372,6 +1376,7 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                 }
 
                 data->glDrawArrays(op, 0, (GLsizei)count);
+                renderer->stats.draw_calls++;
 
                 /* Restore previously set color when we're done. */
                 if (thiscmdtype != SDL_RENDERCMD_DRAW_POINTS) {
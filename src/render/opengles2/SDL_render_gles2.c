@@ -918,11 +918,12 @@ static int GLES2_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, S
     return 0;
 }
 
-static int SetDrawState(GLES2_RenderData *data, const SDL_RenderCommand *cmd, const GLES2_ImageSource imgsrc, void *vertices)
+static int SetDrawState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, const GLES2_ImageSource imgsrc, void *vertices)
 {
+    GLES2_RenderData *data = (GLES2_RenderData *)renderer->driverdata;
     SDL_Texture *texture = cmd->data.draw.texture;
     const SDL_BlendMode blend = cmd->data.draw.blend;
-    GLES2_ProgramCacheEntry *program;
+    GLES2_ProgramCacheEntry *program = data->drawstate.program;
     int stride;
 
     SDL_assert((texture != NULL) == (imgsrc != GLES2_IMAGESOURCE_SOLID));
@@ -983,6 +984,9 @@ static int SetDrawState(GLES2_RenderData *data, const SDL_RenderCommand *cmd, co
         return -1;
     }
 
+    if (program != data->drawstate.program) {
+        renderer->stats.program_switches++;
+    }
     program = data->drawstate.program;
 
     if (program->uniform_locations[GLES2_UNIFORM_PROJECTION] != -1) {
@@ -1132,7 +1136,7 @@ static int SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, vo
         }
     }
 
-    ret = SetDrawState(data, cmd, sourceType, vertices);
+    ret = SetDrawState(renderer, cmd, sourceType, vertices);
 
     if (texture != data->drawstate.texture) {
         GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
@@ -1154,6 +1158,7 @@ static int SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, vo
 #endif
         data->glBindTexture(tdata->texture_type, tdata->texture);
         data->drawstate.texture = texture;
+        renderer->stats.texture_binds++;
     }
 
     return ret;
@@ -1272,11 +1277,12 @@ static int GLES2_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
 
         case SDL_RENDERCMD_DRAW_LINES:
         {
-            if (SetDrawState(data, cmd, GLES2_IMAGESOURCE_SOLID, vertices) == 0) {
+            if (SetDrawState(renderer, cmd, GLES2_IMAGESOURCE_SOLID, vertices) == 0) {
                 size_t count = cmd->data.draw.count;
                 if (count > 2) {
                     /* joined lines cannot be grouped */
                     data->glDrawArrays(GL_LINE_STRIP, 0, (GLsizei)count);
+                    renderer->stats.draw_calls++;
                 } else {
                     /* let's group non joined lines */
                     SDL_RenderCommand *finalcmd = cmd;
@@ -1299,6 +1305,7 @@ static int GLES2_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
                     }
 
                     data->glDrawArrays(GL_LINES, 0, (GLsizei)count);
+                    renderer->stats.draw_calls++;
                     cmd = finalcmd; /* skip any copy commands we just combined in here. */
                 }
             }
@@ -1333,7 +1340,7 @@ static int GLES2_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
             if (thistexture) {
                 ret = SetCopyState(renderer, cmd, vertices);
             } else {
-                ret = SetDrawState(data, cmd, GLES2_IMAGESOURCE_SOLID, vertices);
+                ret = SetDrawState(renderer, cmd, GLES2_IMAGESOURCE_SOLID, vertices);
             }
 
             if (ret == 0) {
@@ -1342,6 +1349,7 @@ static int GLES2_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
                     op = GL_POINTS;
                 }
                 data->glDrawArrays(op, 0, (GLsizei)count);
+                renderer->stats.draw_calls++;
             }
 
             cmd = finalcmd; /* skip any copy commands we just combined in here. */
@@ -34,20 +34,72 @@
 #include "SDL_drawpoint.h"
 #include "SDL_rotate.h"
 #include "SDL_triangle.h"
+#include "../../video/SDL_RLEaccel_c.h"
+#include "../../thread/SDL_systhread.h"
 
 /* SDL surface based renderer implementation */
 
+/* Most threads SDL_HINT_RENDER_SOFTWARE_THREADS can ask for */
+#define SW_MAX_WORKERS 64
+
+/* Fewest rows a thread gets to render */
+#define SW_MIN_BAND_HEIGHT 16
+
+/* Per thread copies of the texture surfaces, so each thread has its own
+   blend state and blit map. Direct mapped on the texture pointer. */
+#define SW_TEXTURE_VIEWS 64
+
 typedef struct
 {
     const SDL_Rect *viewport;
     const SDL_Rect *cliprect;
+    const SDL_Rect *band;          /* rows this thread renders, NULL for the whole surface */
+    SDL_bool vertices_translated;  /* the viewport offset was already added to the vertices */
     SDL_bool surface_cliprect_dirty;
 } SW_DrawStateCache;
 
+/* What the threaded renderer knows about each command of a batch */
 typedef struct
+{
+    int y0, y1;       /* rows the command can touch */
+    SDL_bool serial;  /* can't be split into bands, render it on one thread */
+} SW_CommandInfo;
+
+typedef struct
+{
+    SDL_Texture *texture;
+    SDL_Surface *surface;
+} SW_TextureView;
+
+struct SW_RenderData;
+
+typedef struct
+{
+    struct SW_RenderData *data;
+    SDL_Thread *thread;            /* NULL for the calling thread */
+    SDL_sem *start;
+    SDL_Surface *surface;          /* shares the pixels of the render target */
+    SDL_Rect band;
+    SW_DrawStateCache drawstate;
+    SW_TextureView views[SW_TEXTURE_VIEWS];
+} SW_RenderWorker;
+
+typedef struct SW_RenderData
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+
+    /* threaded rendering, see SDL_HINT_RENDER_SOFTWARE_THREADS */
+    int num_workers;
+    SW_RenderWorker *workers[SW_MAX_WORKERS];
+    SDL_sem *done;
+    SDL_bool quit;
+    SW_CommandInfo *info;
+    size_t info_allocated;
+    SDL_RenderCommand *batch_first;
+    SDL_RenderCommand *batch_end;
+    const SW_CommandInfo *batch_info;
+    void *batch_vertices;
 } SW_RenderData;
 
 static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
@@ -309,11 +361,10 @@ static int Blit_to_Screen(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *surf
     return retval;
 }
 
-static int SW_RenderCopyEx(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Texture *texture,
+static int SW_RenderCopyEx(SDL_Surface *surface, SDL_Texture *texture, SDL_Surface *src,
                            const SDL_Rect *srcrect, const SDL_Rect *final_rect,
                            const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip, float scale_x, float scale_y)
 {
-    SDL_Surface *src = (SDL_Surface *)texture->driverdata;
     SDL_Rect tmp_rect;
     SDL_Surface *src_clone, *src_rotated, *src_scaled;
     SDL_Surface *mask = NULL, *mask_rotated = NULL;
@@ -328,6 +379,14 @@ static int SW_RenderCopyEx(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Tex
         return -1;
     }
 
+    /* Between 32-bit surfaces with a 8888 layout, the source is sampled straight onto the destination */
+    if (src->format->BitsPerPixel == 32 && SDL_PIXELLAYOUT(src->format->format) == SDL_PACKEDLAYOUT_8888 &&
+        surface->format->BitsPerPixel == 32 && SDL_PIXELLAYOUT(surface->format->format) == SDL_PACKEDLAYOUT_8888) {
+        return SDLgfx_rotateBlit(src, srcrect, surface, final_rect, angle, center,
+                                 flip & SDL_FLIP_HORIZONTAL, flip & SDL_FLIP_VERTICAL,
+                                 scale_x, scale_y, texture->scaleMode != SDL_ScaleModeNearest);
+    }
+
     tmp_rect.x = 0;
     tmp_rect.y = 0;
     tmp_rect.w = final_rect->w;
@@ -613,15 +672,13 @@ static int SW_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL_
     return 0;
 }
 
-static void PrepTextureForCopy(const SDL_RenderCommand *cmd)
+static void PrepTextureForCopy(const SDL_RenderCommand *cmd, SDL_Surface *surface)
 {
     const Uint8 r = cmd->data.draw.r;
     const Uint8 g = cmd->data.draw.g;
     const Uint8 b = cmd->data.draw.b;
     const Uint8 a = cmd->data.draw.a;
     const SDL_BlendMode blend = cmd->data.draw.blend;
-    SDL_Texture *texture = cmd->data.draw.texture;
-    SDL_Surface *surface = (SDL_Surface *)texture->driverdata;
     const SDL_bool colormod = ((r & g & b) != 0xFF);
     const SDL_bool alphamod = (a != 0xFF);
     const SDL_bool blending = ((blend == SDL_BLENDMODE_ADD) || (blend == SDL_BLENDMODE_MOD) || (blend == SDL_BLENDMODE_MUL));
@@ -641,290 +698,771 @@ static void SetDrawState(SDL_Surface *surface, SW_DrawStateCache *drawstate)
     if (drawstate->surface_cliprect_dirty) {
         const SDL_Rect *viewport = drawstate->viewport;
         const SDL_Rect *cliprect = drawstate->cliprect;
+        SDL_Rect clip_rect;
         SDL_assert_release(viewport != NULL); /* the higher level should have forced a SDL_RENDERCMD_SETVIEWPORT */
 
         if (cliprect) {
-            SDL_Rect clip_rect;
             clip_rect.x = cliprect->x + viewport->x;
             clip_rect.y = cliprect->y + viewport->y;
             clip_rect.w = cliprect->w;
             clip_rect.h = cliprect->h;
             SDL_IntersectRect(viewport, &clip_rect, &clip_rect);
-            SDL_SetClipRect(surface, &clip_rect);
         } else {
-            SDL_SetClipRect(surface, drawstate->viewport);
+            clip_rect = *viewport;
+        }
+        if (drawstate->band) {
+            SDL_IntersectRect(drawstate->band, &clip_rect, &clip_rect);
         }
+        SDL_SetClipRect(surface, &clip_rect);
         drawstate->surface_cliprect_dirty = SDL_FALSE;
     }
 }
 
-static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+/* Adds the viewport offset to the vertices of a draw command */
+static void SW_TranslateVertices(SDL_RenderCommand *cmd, void *vertices, const SDL_Rect *viewport)
 {
-    SDL_Surface *surface = SW_ActivateRenderer(renderer);
-    SW_DrawStateCache drawstate;
+    void *verts = ((Uint8 *)vertices) + cmd->data.draw.first;
+    const int count = (int)cmd->data.draw.count;
+    int i;
 
-    if (!surface) {
-        return -1;
+    if (!viewport || (!viewport->x && !viewport->y)) {
+        return;
     }
 
-    drawstate.viewport = NULL;
-    drawstate.cliprect = NULL;
-    drawstate.surface_cliprect_dirty = SDL_TRUE;
+    switch (cmd->command) {
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES: {
+            SDL_Point *points = (SDL_Point *)verts;
+            for (i = 0; i < count; i++) {
+                points[i].x += viewport->x;
+                points[i].y += viewport->y;
+            }
+            break;
+        }
 
-    while (cmd) {
-        switch (cmd->command) {
-            case SDL_RENDERCMD_SETDRAWCOLOR: {
-                break;  /* Not used in this backend. */
+        case SDL_RENDERCMD_FILL_RECTS: {
+            SDL_Rect *rects = (SDL_Rect *)verts;
+            for (i = 0; i < count; i++) {
+                rects[i].x += viewport->x;
+                rects[i].y += viewport->y;
             }
+            break;
+        }
 
-            case SDL_RENDERCMD_SETVIEWPORT: {
-                drawstate.viewport = &cmd->data.viewport.rect;
-                drawstate.surface_cliprect_dirty = SDL_TRUE;
-                break;
+        case SDL_RENDERCMD_COPY: {
+            SDL_Rect *dstrect = ((SDL_Rect *)verts) + 1;
+            dstrect->x += viewport->x;
+            dstrect->y += viewport->y;
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY_EX: {
+            CopyExData *copydata = (CopyExData *)verts;
+            copydata->dstrect.x += viewport->x;
+            copydata->dstrect.y += viewport->y;
+            break;
+        }
+
+        case SDL_RENDERCMD_GEOMETRY: {
+            SDL_Point vp;
+            vp.x = viewport->x;
+            vp.y = viewport->y;
+            trianglepoint_2_fixedpoint(&vp);
+            if (cmd->data.draw.texture) {
+                GeometryCopyData *ptr = (GeometryCopyData *)verts;
+                for (i = 0; i < count; i++) {
+                    ptr[i].dst.x += vp.x;
+                    ptr[i].dst.y += vp.y;
+                }
+            } else {
+                GeometryFillData *ptr = (GeometryFillData *)verts;
+                for (i = 0; i < count; i++) {
+                    ptr[i].dst.x += vp.x;
+                    ptr[i].dst.y += vp.y;
+                }
             }
+            break;
+        }
 
-            case SDL_RENDERCMD_SETCLIPRECT: {
-                drawstate.cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
-                drawstate.surface_cliprect_dirty = SDL_TRUE;
-                break;
+        default:
+            break;
+    }
+}
+
+static SDL_Surface *SW_CreateSurfaceView(SDL_Surface *surface)
+{
+    SDL_Surface *view = SDL_CreateRGBSurfaceWithFormatFrom(surface->pixels, surface->w, surface->h,
+                                                           surface->format->BitsPerPixel, surface->pitch,
+                                                           surface->format->format);
+
+    /* Indexed surfaces map colors through their palette, share it */
+    if (view && surface->format->palette && SDL_SetSurfacePalette(view, surface->format->palette) < 0) {
+        SDL_FreeSurface(view);
+        return NULL;
+    }
+    return view;
+}
+
+static SDL_bool SW_IsSurfaceView(const SDL_Surface *view, const SDL_Surface *surface)
+{
+    return view && view->pixels == surface->pixels &&
+           view->w == surface->w && view->h == surface->h && view->pitch == surface->pitch &&
+           view->format->format == surface->format->format &&
+           view->format->palette == surface->format->palette;
+}
+
+/* The surface to read a texture from. Render threads get their own view of
+   it, since blitting changes the blend state and blit map of the source. */
+static SDL_Surface *SW_GetTextureSurface(SW_RenderWorker *worker, SDL_Texture *texture)
+{
+    SDL_Surface *surface = (SDL_Surface *)texture->driverdata;
+    SW_TextureView *view;
+
+    if (!worker) {
+        return surface;
+    }
+
+    view = &worker->views[(((uintptr_t)texture) >> 4) % SW_TEXTURE_VIEWS];
+    if (view->texture != texture || !SW_IsSurfaceView(view->surface, surface)) {
+        SDL_FreeSurface(view->surface);
+        view->surface = SW_CreateSurfaceView(surface);
+        view->texture = view->surface ? texture : NULL;
+    }
+    return view->surface;
+}
+
+static void SW_RunCommand(SDL_Surface *surface, SW_DrawStateCache *drawstate, SDL_RenderCommand *cmd, void *vertices, SW_RenderWorker *worker)
+{
+    if (!drawstate->vertices_translated) {
+        SW_TranslateVertices(cmd, vertices, drawstate->viewport);
+    }
+
+    switch (cmd->command) {
+        case SDL_RENDERCMD_SETDRAWCOLOR: {
+            break;  /* Not used in this backend. */
+        }
+
+        case SDL_RENDERCMD_SETVIEWPORT: {
+            drawstate->viewport = &cmd->data.viewport.rect;
+            drawstate->surface_cliprect_dirty = SDL_TRUE;
+            break;
+        }
+
+        case SDL_RENDERCMD_SETCLIPRECT: {
+            drawstate->cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
+            drawstate->surface_cliprect_dirty = SDL_TRUE;
+            break;
+        }
+
+        case SDL_RENDERCMD_CLEAR: {
+            const Uint8 r = cmd->data.color.r;
+            const Uint8 g = cmd->data.color.g;
+            const Uint8 b = cmd->data.color.b;
+            const Uint8 a = cmd->data.color.a;
+            /* By definition the clear ignores the clip rect */
+            SDL_SetClipRect(surface, drawstate->band);
+            SDL_FillRect(surface, NULL, SDL_MapRGBA(surface->format, r, g, b, a));
+            drawstate->surface_cliprect_dirty = SDL_TRUE;
+            break;
+        }
+
+        case SDL_RENDERCMD_DRAW_POINTS: {
+            const Uint8 r = cmd->data.draw.r;
+            const Uint8 g = cmd->data.draw.g;
+            const Uint8 b = cmd->data.draw.b;
+            const Uint8 a = cmd->data.draw.a;
+            const int count = (int) cmd->data.draw.count;
+            SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            const SDL_BlendMode blend = cmd->data.draw.blend;
+            SetDrawState(surface, drawstate);
+
+            if (blend == SDL_BLENDMODE_NONE) {
+                SDL_DrawPoints(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+            } else {
+                SDL_BlendPoints(surface, verts, count, blend, r, g, b, a);
             }
+            break;
+        }
 
-            case SDL_RENDERCMD_CLEAR: {
-                const Uint8 r = cmd->data.color.r;
-                const Uint8 g = cmd->data.color.g;
-                const Uint8 b = cmd->data.color.b;
-                const Uint8 a = cmd->data.color.a;
-                /* By definition the clear ignores the clip rect */
-                SDL_SetClipRect(surface, NULL);
-                SDL_FillRect(surface, NULL, SDL_MapRGBA(surface->format, r, g, b, a));
-                drawstate.surface_cliprect_dirty = SDL_TRUE;
-                break;
+        case SDL_RENDERCMD_DRAW_LINES: {
+            const Uint8 r = cmd->data.draw.r;
+            const Uint8 g = cmd->data.draw.g;
+            const Uint8 b = cmd->data.draw.b;
+            const Uint8 a = cmd->data.draw.a;
+            const int count = (int) cmd->data.draw.count;
+            SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            const SDL_BlendMode blend = cmd->data.draw.blend;
+            SetDrawState(surface, drawstate);
+
+            if (blend == SDL_BLENDMODE_NONE) {
+                SDL_DrawLines(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+            } else {
+                SDL_BlendLines(surface, verts, count, blend, r, g, b, a);
             }
+            break;
+        }
 
-            case SDL_RENDERCMD_DRAW_POINTS: {
-                const Uint8 r = cmd->data.draw.r;
-                const Uint8 g = cmd->data.draw.g;
-                const Uint8 b = cmd->data.draw.b;
-                const Uint8 a = cmd->data.draw.a;
-                const int count = (int) cmd->data.draw.count;
-                SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_BlendMode blend = cmd->data.draw.blend;
-                SetDrawState(surface, &drawstate);
-
-                /* Apply viewport */
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    int i;
-                    for (i = 0; i < count; i++) {
-                        verts[i].x += drawstate.viewport->x;
-                        verts[i].y += drawstate.viewport->y;
-                    }
-                }
+        case SDL_RENDERCMD_FILL_RECTS: {
+            const Uint8 r = cmd->data.draw.r;
+            const Uint8 g = cmd->data.draw.g;
+            const Uint8 b = cmd->data.draw.b;
+            const Uint8 a = cmd->data.draw.a;
+            const int count = (int) cmd->data.draw.count;
+            SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            const SDL_BlendMode blend = cmd->data.draw.blend;
+            SetDrawState(surface, drawstate);
+
+            if (blend == SDL_BLENDMODE_NONE) {
+                SDL_FillRects(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+            } else {
+                SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
+            }
+            break;
+        }
 
-                if (blend == SDL_BLENDMODE_NONE) {
-                    SDL_DrawPoints(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
-                } else {
-                    SDL_BlendPoints(surface, verts, count, blend, r, g, b, a);
-                }
+        case SDL_RENDERCMD_COPY: {
+            SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            const SDL_Rect *srcrect = verts;
+            SDL_Rect dstrect = verts[1]; /* blitting clips it, and other threads need the original */
+            SDL_Texture *texture = cmd->data.draw.texture;
+            SDL_Surface *src = SW_GetTextureSurface(worker, texture);
+
+            if (!src) {
                 break;
             }
 
-            case SDL_RENDERCMD_DRAW_LINES: {
-                const Uint8 r = cmd->data.draw.r;
-                const Uint8 g = cmd->data.draw.g;
-                const Uint8 b = cmd->data.draw.b;
-                const Uint8 a = cmd->data.draw.a;
-                const int count = (int) cmd->data.draw.count;
-                SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_BlendMode blend = cmd->data.draw.blend;
-                SetDrawState(surface, &drawstate);
-
-                /* Apply viewport */
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    int i;
-                    for (i = 0; i < count; i++) {
-                        verts[i].x += drawstate.viewport->x;
-                        verts[i].y += drawstate.viewport->y;
+            SetDrawState(surface, drawstate);
+
+            PrepTextureForCopy(cmd, src);
+
+            if ( srcrect->w == dstrect.w && srcrect->h == dstrect.h ) {
+                SDL_BlitSurface(src, srcrect, surface, &dstrect);
+            } else {
+                /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
+                 * to avoid potentially frequent RLE encoding/decoding.
+                 */
+                SDL_SetSurfaceRLE(surface, 0);
+
+                /* Prevent to do scaling + clipping on viewport boundaries as it may lose proportion */
+                if (dstrect.x < 0 || dstrect.y < 0 || dstrect.x + dstrect.w > surface->w || dstrect.y + dstrect.h > surface->h) {
+                    SDL_Surface *tmp = SDL_CreateRGBSurfaceWithFormat(0, dstrect.w, dstrect.h, 0, src->format->format);
+                    /* Scale to an intermediate surface, then blit */
+                    if (tmp) {
+                        SDL_Rect r;
+                        SDL_BlendMode blendmode;
+                        Uint8 alphaMod, rMod, gMod, bMod;
+
+                        SDL_GetSurfaceBlendMode(src, &blendmode);
+                        SDL_GetSurfaceAlphaMod(src, &alphaMod);
+                        SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
+
+                        r.x = 0;
+                        r.y = 0;
+                        r.w = dstrect.w;
+                        r.h = dstrect.h;
+
+                        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+                        SDL_SetSurfaceColorMod(src, 255, 255, 255);
+                        SDL_SetSurfaceAlphaMod(src, 255);
+
+                        SDL_PrivateUpperBlitScaled(src, srcrect, tmp, &r, texture->scaleMode);
+
+                        SDL_SetSurfaceColorMod(tmp, rMod, gMod, bMod);
+                        SDL_SetSurfaceAlphaMod(tmp, alphaMod);
+                        SDL_SetSurfaceBlendMode(tmp, blendmode);
+
+                        SDL_BlitSurface(tmp, NULL, surface, &dstrect);
+                        SDL_FreeSurface(tmp);
+                        /* No need to set back r/g/b/a/blendmode to 'src' since it's done in PrepTextureForCopy() */
                     }
+                } else{
+                    SDL_PrivateUpperBlitScaled(src, srcrect, surface, &dstrect, texture->scaleMode);
                 }
+            }
+            break;
+        }
 
-                if (blend == SDL_BLENDMODE_NONE) {
-                    SDL_DrawLines(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
-                } else {
-                    SDL_BlendLines(surface, verts, count, blend, r, g, b, a);
-                }
+        case SDL_RENDERCMD_COPY_EX: {
+            CopyExData *copydata = (CopyExData *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            SDL_Surface *src = SW_GetTextureSurface(worker, cmd->data.draw.texture);
+
+            if (!src) {
                 break;
             }
 
-            case SDL_RENDERCMD_FILL_RECTS: {
-                const Uint8 r = cmd->data.draw.r;
-                const Uint8 g = cmd->data.draw.g;
-                const Uint8 b = cmd->data.draw.b;
-                const Uint8 a = cmd->data.draw.a;
-                const int count = (int) cmd->data.draw.count;
-                SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_BlendMode blend = cmd->data.draw.blend;
-                SetDrawState(surface, &drawstate);
-
-                /* Apply viewport */
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    int i;
-                    for (i = 0; i < count; i++) {
-                        verts[i].x += drawstate.viewport->x;
-                        verts[i].y += drawstate.viewport->y;
-                    }
+            SetDrawState(surface, drawstate);
+            PrepTextureForCopy(cmd, src);
+
+            SW_RenderCopyEx(surface, cmd->data.draw.texture, src, &copydata->srcrect,
+                            &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip,
+                            copydata->scale_x, copydata->scale_y);
+            break;
+        }
+
+        case SDL_RENDERCMD_GEOMETRY: {
+            int i;
+            SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
+            const int count = (int) cmd->data.draw.count;
+            SDL_Texture *texture = cmd->data.draw.texture;
+            const SDL_BlendMode blend = cmd->data.draw.blend;
+
+            SetDrawState(surface, drawstate);
+
+            if (texture) {
+                SDL_Surface *src = SW_GetTextureSurface(worker, texture);
+
+                GeometryCopyData *ptr = (GeometryCopyData *) verts;
+
+                if (!src) {
+                    break;
                 }
 
-                if (blend == SDL_BLENDMODE_NONE) {
-                    SDL_FillRects(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
-                } else {
-                    SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
+                PrepTextureForCopy(cmd, src);
+
+                for (i = 0; i < count; i += 3, ptr += 3) {
+                    /* SDL_SW_BlitTriangle adjusts the texture coordinates, keep the originals for other threads */
+                    SDL_Point s0 = ptr[0].src;
+                    SDL_Point s1 = ptr[1].src;
+                    SDL_Point s2 = ptr[2].src;
+                    SDL_SW_BlitTriangle(
+                            src,
+                            &s0, &s1, &s2,
+                            surface,
+                            &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst),
+                            ptr[0].color, ptr[1].color, ptr[2].color);
+                }
+            } else {
+                GeometryFillData *ptr = (GeometryFillData *) verts;
+
+                for (i = 0; i < count; i += 3, ptr += 3) {
+                    SDL_SW_FillTriangle(surface, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color);
                 }
-                break;
             }
+            break;
+        }
 
-            case SDL_RENDERCMD_COPY: {
-                SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_Rect *srcrect = verts;
-                SDL_Rect *dstrect = verts + 1;
-                SDL_Texture *texture = cmd->data.draw.texture;
-                SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+        case SDL_RENDERCMD_NO_OP:
+            break;
+    }
+}
 
-                SetDrawState(surface, &drawstate);
+/* Threaded rendering: every thread replays the batch clipped to its own
+   band of rows, through its own views of the target and the textures.
+   Commands whose result would change if they were cut at a band edge are
+   rendered by the calling thread over the whole surface while the others
+   wait. */
 
-                PrepTextureForCopy(cmd);
+static void SW_RunBand(SW_RenderWorker *worker)
+{
+    SW_RenderData *data = worker->data;
+    const SW_CommandInfo *info = data->batch_info;
+    const int y0 = worker->band.y;
+    const int y1 = worker->band.y + worker->band.h;
+    SDL_RenderCommand *cmd;
+
+    for (cmd = data->batch_first; cmd != data->batch_end; cmd = cmd->next, ++info) {
+        if (info->y0 < y1 && info->y1 > y0) {
+            SW_RunCommand(worker->surface, &worker->drawstate, cmd, data->batch_vertices, worker);
+        }
+    }
+}
 
-                /* Apply viewport */
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    dstrect->x += drawstate.viewport->x;
-                    dstrect->y += drawstate.viewport->y;
-                }
+static int SDLCALL SW_RenderThread(void *arg)
+{
+    SW_RenderWorker *worker = (SW_RenderWorker *)arg;
+    SW_RenderData *data = worker->data;
 
-                if ( srcrect->w == dstrect->w && srcrect->h == dstrect->h ) {
-                    SDL_BlitSurface(src, srcrect, surface, dstrect);
-                } else {
-                    /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
-                     * to avoid potentially frequent RLE encoding/decoding.
-                     */
-                    SDL_SetSurfaceRLE(surface, 0);
-
-                    /* Prevent to do scaling + clipping on viewport boundaries as it may lose proportion */
-                    if (dstrect->x < 0 || dstrect->y < 0 || dstrect->x + dstrect->w > surface->w || dstrect->y + dstrect->h > surface->h) {
-                        SDL_Surface *tmp = SDL_CreateRGBSurfaceWithFormat(0, dstrect->w, dstrect->h, 0, src->format->format);
-                        /* Scale to an intermediate surface, then blit */
-                        if (tmp) {
-                            SDL_Rect r;
-                            SDL_BlendMode blendmode;
-                            Uint8 alphaMod, rMod, gMod, bMod;
-
-                            SDL_GetSurfaceBlendMode(src, &blendmode);
-                            SDL_GetSurfaceAlphaMod(src, &alphaMod);
-                            SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
-
-                            r.x = 0;
-                            r.y = 0;
-                            r.w = dstrect->w;
-                            r.h = dstrect->h;
-
-                            SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
-                            SDL_SetSurfaceColorMod(src, 255, 255, 255);
-                            SDL_SetSurfaceAlphaMod(src, 255);
-
-                            SDL_PrivateUpperBlitScaled(src, srcrect, tmp, &r, texture->scaleMode);
-
-                            SDL_SetSurfaceColorMod(tmp, rMod, gMod, bMod);
-                            SDL_SetSurfaceAlphaMod(tmp, alphaMod);
-                            SDL_SetSurfaceBlendMode(tmp, blendmode);
-
-                            SDL_BlitSurface(tmp, NULL, surface, dstrect);
-                            SDL_FreeSurface(tmp);
-                            /* No need to set back r/g/b/a/blendmode to 'src' since it's done in PrepTextureForCopy() */
-                        }
-                    } else{
-                        SDL_PrivateUpperBlitScaled(src, srcrect, surface, dstrect, texture->scaleMode);
-                    }
-                }
-                break;
+    for (;;) {
+        SDL_SemWait(worker->start);
+        if (data->quit) {
+            break;
+        }
+        SW_RunBand(worker);
+        SDL_SemPost(data->done);
+    }
+    return 0;
+}
+
+static void SW_DestroyWorker(SW_RenderWorker *worker)
+{
+    int i;
+
+    if (worker->thread) {
+        SDL_SemPost(worker->start);
+        SDL_WaitThread(worker->thread, NULL);
+    }
+    if (worker->start) {
+        SDL_DestroySemaphore(worker->start);
+    }
+    SDL_FreeSurface(worker->surface);
+    for (i = 0; i < SW_TEXTURE_VIEWS; i++) {
+        SDL_FreeSurface(worker->views[i].surface);
+    }
+    SDL_free(worker);
+}
+
+static void SW_DestroyWorkers(SW_RenderData *data)
+{
+    int i;
+
+    data->quit = SDL_TRUE;
+    for (i = 0; i < data->num_workers; i++) {
+        SW_DestroyWorker(data->workers[i]);
+        data->workers[i] = NULL;
+    }
+    data->num_workers = 0;
+    data->quit = SDL_FALSE;
+
+    if (data->done) {
+        SDL_DestroySemaphore(data->done);
+        data->done = NULL;
+    }
+    SDL_free(data->info);
+    data->info = NULL;
+    data->info_allocated = 0;
+}
+
+static int SW_CreateWorkers(SW_RenderData *data, int num_workers)
+{
+    if (!data->done) {
+        data->done = SDL_CreateSemaphore(0);
+        if (!data->done) {
+            return -1;
+        }
+    }
+
+    while (data->num_workers < num_workers) {
+        SW_RenderWorker *worker = (SW_RenderWorker *)SDL_calloc(1, sizeof(*worker));
+        if (!worker) {
+            return SDL_OutOfMemory();
+        }
+        worker->data = data;
+
+        /* The first worker is the thread running the command queue */
+        if (data->num_workers > 0) {
+            worker->start = SDL_CreateSemaphore(0);
+            if (worker->start) {
+                worker->thread = SDL_CreateThreadInternal(SW_RenderThread, "SDLSWRender", 0, worker);
             }
+            if (!worker->thread) {
+                SW_DestroyWorker(worker);
+                return -1;
+            }
+        }
+        data->workers[data->num_workers++] = worker;
+    }
+    return 0;
+}
 
-            case SDL_RENDERCMD_COPY_EX: {
-                CopyExData *copydata = (CopyExData *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                SetDrawState(surface, &drawstate);
-                PrepTextureForCopy(cmd);
+/* Which of num_bands equal bands of a surface h rows high contains row y */
+static int SW_GetBand(int y, int h, int num_bands)
+{
+    return (int)((((Sint64)y + 1) * num_bands - 1) / h);
+}
 
-                /* Apply viewport */
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    copydata->dstrect.x += drawstate.viewport->x;
-                    copydata->dstrect.y += drawstate.viewport->y;
-                }
+/* Rows a draw command can touch, before clipping */
+static void SW_GetCommandRows(const SDL_RenderCommand *cmd, void *vertices, int *y0, int *y1)
+{
+    const void *verts = ((Uint8 *)vertices) + cmd->data.draw.first;
+    const int count = (int)cmd->data.draw.count;
+    int miny = SDL_MAX_SINT32, maxy = SDL_MIN_SINT32;
+    int i;
 
-                SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
-                                &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip,
-                                copydata->scale_x, copydata->scale_y);
-                break;
+    switch (cmd->command) {
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES: {
+            const SDL_Point *points = (const SDL_Point *)verts;
+            for (i = 0; i < count; i++) {
+                miny = SDL_min(miny, points[i].y);
+                maxy = SDL_max(maxy, points[i].y + 1);
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_FILL_RECTS: {
+            const SDL_Rect *rects = (const SDL_Rect *)verts;
+            for (i = 0; i < count; i++) {
+                miny = SDL_min(miny, rects[i].y);
+                maxy = SDL_max(maxy, rects[i].y + rects[i].h);
             }
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY: {
+            const SDL_Rect *dstrect = ((const SDL_Rect *)verts) + 1;
+            miny = dstrect->y;
+            maxy = dstrect->y + dstrect->h;
+            break;
+        }
 
+        case SDL_RENDERCMD_GEOMETRY: {
+            const size_t stride = cmd->data.draw.texture ? sizeof(GeometryCopyData) : sizeof(GeometryFillData);
+            const size_t offset = cmd->data.draw.texture ? offsetof(GeometryCopyData, dst) : offsetof(GeometryFillData, dst);
+            for (i = 0; i < count; i++) {
+                SDL_Point p = *(const SDL_Point *)(((const Uint8 *)verts) + i * stride + offset);
+                fixedpoint_2_trianglepoint(&p);
+                miny = SDL_min(miny, p.y);
+                maxy = SDL_max(maxy, p.y + 2);
+            }
+            break;
+        }
+
+        default:
+            /* Rotated copies can go anywhere */
+            miny = SDL_MIN_SINT32;
+            maxy = SDL_MAX_SINT32;
+            break;
+    }
+
+    *y0 = miny;
+    *y1 = maxy;
+}
+
+/* Whether a command gives the same result when it's cut into bands */
+static SDL_bool SW_CanSplitCommand(const SDL_RenderCommand *cmd, void *vertices)
+{
+    switch (cmd->command) {
+        case SDL_RENDERCMD_DRAW_LINES:
+            return SDL_FALSE; /* clipping moves the line endpoints */
+
+        case SDL_RENDERCMD_COPY: {
+            const SDL_Rect *verts = (const SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+            return (verts[0].w == verts[1].w && verts[0].h == verts[1].h); /* clipping changes the scaling steps */
+        }
+
+        case SDL_RENDERCMD_COPY_EX:
+            return SDL_FALSE; /* rotating once is cheaper than once per band */
+
+        default:
+            return SDL_TRUE;
+    }
+}
+
+/* Adds the viewport offsets to the vertices once for all the threads and
+   works out which rows every command touches and whether it can be split. */
+static SDL_bool SW_PrepareCommands(SW_RenderData *data, SDL_Surface *surface, SDL_RenderCommand *cmd, void *vertices, int num_bands)
+{
+    const SDL_Rect *viewport = NULL;
+    const SDL_Rect *cliprect = NULL;
+    SW_CommandInfo *info;
+    SDL_RenderCommand *it;
+    size_t count = 0;
+
+    for (it = cmd; it; it = it->next) {
+        count++;
+    }
+    if (count > data->info_allocated) {
+        info = (SW_CommandInfo *)SDL_realloc(data->info, count * sizeof(*info));
+        if (!info) {
+            SDL_OutOfMemory();
+            return SDL_FALSE;
+        }
+        data->info = info;
+        data->info_allocated = count;
+    }
+
+    for (it = cmd, info = data->info; it; it = it->next, info++) {
+        info->y0 = 0;
+        info->y1 = surface->h;
+        info->serial = SDL_FALSE;
+
+        switch (it->command) {
+            case SDL_RENDERCMD_SETVIEWPORT:
+                viewport = &it->data.viewport.rect;
+                break;
+
+            case SDL_RENDERCMD_SETCLIPRECT:
+                cliprect = it->data.cliprect.enabled ? &it->data.cliprect.rect : NULL;
+                break;
+
+            case SDL_RENDERCMD_DRAW_POINTS:
+            case SDL_RENDERCMD_DRAW_LINES:
+            case SDL_RENDERCMD_FILL_RECTS:
+            case SDL_RENDERCMD_COPY:
+            case SDL_RENDERCMD_COPY_EX:
             case SDL_RENDERCMD_GEOMETRY: {
-                int i;
-                SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const int count = (int) cmd->data.draw.count;
-                SDL_Texture *texture = cmd->data.draw.texture;
-                const SDL_BlendMode blend = cmd->data.draw.blend;
-
-                SetDrawState(surface, &drawstate);
-
-                if (texture) {
-                    SDL_Surface *src = (SDL_Surface *) texture->driverdata;
-
-                    GeometryCopyData *ptr = (GeometryCopyData *) verts;
-
-                    PrepTextureForCopy(cmd);
-
-                    /* Apply viewport */
-                    if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                        SDL_Point vp;
-                        vp.x = drawstate.viewport->x;
-                        vp.y = drawstate.viewport->y;
-                        trianglepoint_2_fixedpoint(&vp);
-                        for (i = 0; i < count; i++) {
-                            ptr[i].dst.x += vp.x;
-                            ptr[i].dst.y += vp.y;
-                        }
+                int y0, y1;
+
+                SW_TranslateVertices(it, vertices, viewport);
+                SW_GetCommandRows(it, vertices, &y0, &y1);
+                if (viewport) {
+                    y0 = SDL_max(y0, viewport->y);
+                    y1 = SDL_min(y1, viewport->y + viewport->h);
+                    if (cliprect) {
+                        y0 = SDL_max(y0, viewport->y + cliprect->y);
+                        y1 = SDL_min(y1, viewport->y + cliprect->y + cliprect->h);
                     }
+                }
+                info->y0 = SDL_max(y0, 0);
+                info->y1 = SDL_min(y1, surface->h);
 
-                    for (i = 0; i < count; i += 3, ptr += 3) {
-                        SDL_SW_BlitTriangle(
-                                src,
-                                &(ptr[0].src), &(ptr[1].src), &(ptr[2].src),
-                                surface,
-                                &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst),
-                                ptr[0].color, ptr[1].color, ptr[2].color);
-                    }
-                } else {
-                    GeometryFillData *ptr = (GeometryFillData *) verts;
-
-                    /* Apply viewport */
-                    if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                        SDL_Point vp;
-                        vp.x = drawstate.viewport->x;
-                        vp.y = drawstate.viewport->y;
-                        trianglepoint_2_fixedpoint(&vp);
-                        for (i = 0; i < count; i++) {
-                            ptr[i].dst.x += vp.x;
-                            ptr[i].dst.y += vp.y;
-                        }
-                    }
+                if (info->y0 < info->y1 && !SW_CanSplitCommand(it, vertices)) {
+                    info->serial = (SW_GetBand(info->y0, surface->h, num_bands) != SW_GetBand(info->y1 - 1, surface->h, num_bands));
+                }
 
-                    for (i = 0; i < count; i += 3, ptr += 3) {
-                        SDL_SW_FillTriangle(surface, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color);
+#if SDL_HAVE_RLE
+                /* The threads read the texture pixels directly */
+                if (it->data.draw.texture) {
+                    SDL_Surface *src = (SDL_Surface *)it->data.draw.texture->driverdata;
+                    if (src->flags & SDL_RLEACCEL) {
+                        SDL_SetSurfaceRLE(src, 0);
+                        SDL_UnRLESurface(src, 1);
                     }
                 }
+#endif
                 break;
             }
 
-            case SDL_RENDERCMD_NO_OP:
+            default:
                 break;
         }
+    }
+    return SDL_TRUE;
+}
+
+/* How many bands to split the surface into, 1 to render on this thread */
+static int SW_GetNumBands(SDL_Surface *surface)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+    int num_bands = hint ? SDL_atoi(hint) : 1;
+
+    if (SDL_MUSTLOCK(surface)) {
+        return 1;
+    }
+    num_bands = SDL_min(num_bands, SW_MAX_WORKERS);
+    num_bands = SDL_min(num_bands, surface->h / SW_MIN_BAND_HEIGHT);
+    return SDL_max(num_bands, 1);
+}
+
+static SDL_bool SW_PrepareWorkers(SW_RenderData *data, SDL_Surface *surface, int num_bands)
+{
+    int i;
+
+    if (SW_CreateWorkers(data, num_bands) < 0) {
+        return SDL_FALSE;
+    }
+
+    for (i = 0; i < num_bands; i++) {
+        SW_RenderWorker *worker = data->workers[i];
+
+        if (!SW_IsSurfaceView(worker->surface, surface)) {
+            SDL_FreeSurface(worker->surface);
+            worker->surface = SW_CreateSurfaceView(surface);
+            if (!worker->surface) {
+                return SDL_FALSE;
+            }
+        }
 
+        worker->band.x = 0;
+        worker->band.y = (int)(((Sint64)surface->h * i) / num_bands);
+        worker->band.w = surface->w;
+        worker->band.h = (int)(((Sint64)surface->h * (i + 1)) / num_bands) - worker->band.y;
+
+        worker->drawstate.viewport = NULL;
+        worker->drawstate.cliprect = NULL;
+        worker->drawstate.band = &worker->band;
+        worker->drawstate.vertices_translated = SDL_TRUE;
+        worker->drawstate.surface_cliprect_dirty = SDL_TRUE;
+    }
+    return SDL_TRUE;
+}
+
+static void SW_RunCommandQueueThreaded(SW_RenderData *data, SDL_RenderCommand *cmd, void *vertices, int num_bands)
+{
+    SW_RenderWorker *self = data->workers[0];
+    const SW_CommandInfo *info = data->info;
+    int i;
+
+    data->batch_vertices = vertices;
+
+    while (cmd) {
+        SDL_RenderCommand *end = cmd;
+        const SW_CommandInfo *end_info = info;
+
+        while (end && !end_info->serial) {
+            end = end->next;
+            end_info++;
+        }
+
+        if (end != cmd) {
+            data->batch_first = cmd;
+            data->batch_end = end;
+            data->batch_info = info;
+            for (i = 1; i < num_bands; i++) {
+                SDL_SemPost(data->workers[i]->start);
+            }
+            SW_RunBand(self);
+            for (i = 1; i < num_bands; i++) {
+                SDL_SemWait(data->done);
+            }
+        }
+
+        if (end) {
+            /* The other threads are waiting, render over the whole surface */
+            self->drawstate.band = NULL;
+            self->drawstate.surface_cliprect_dirty = SDL_TRUE;
+            while (end && end_info->serial) {
+                SW_RunCommand(self->surface, &self->drawstate, end, vertices, self);
+                end = end->next;
+                end_info++;
+            }
+            self->drawstate.band = &self->band;
+            self->drawstate.surface_cliprect_dirty = SDL_TRUE;
+        }
+
+        cmd = end;
+        info = end_info;
+    }
+}
+
+/* Every drawing command is one draw call, however many bands run it */
+static void SW_CountDrawCalls(SDL_Renderer *renderer, const SDL_RenderCommand *cmd)
+{
+    while (cmd) {
+        switch (cmd->command) {
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+        case SDL_RENDERCMD_FILL_RECTS:
+        case SDL_RENDERCMD_COPY:
+        case SDL_RENDERCMD_COPY_EX:
+        case SDL_RENDERCMD_GEOMETRY:
+            renderer->stats.draw_calls++;
+            break;
+        default:
+            break;
+        }
+        cmd = cmd->next;
+    }
+}
+
+static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+{
+    SW_RenderData *data = (SW_RenderData *)renderer->driverdata;
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    SW_DrawStateCache drawstate;
+    int num_bands;
+
+    if (!surface) {
+        return -1;
+    }
+
+    SW_CountDrawCalls(renderer, cmd);
+
+    num_bands = SW_GetNumBands(surface);
+    if (num_bands > 1 && SW_PrepareWorkers(data, surface, num_bands) &&
+        SW_PrepareCommands(data, surface, cmd, vertices, num_bands)) {
+        SW_RunCommandQueueThreaded(data, cmd, vertices, num_bands);
+        return 0;
+    }
+
+    drawstate.viewport = NULL;
+    drawstate.cliprect = NULL;
+    drawstate.band = NULL;
+    drawstate.vertices_translated = SDL_FALSE;
+    drawstate.surface_cliprect_dirty = SDL_TRUE;
+
+    while (cmd) {
+        SW_RunCommand(surface, &drawstate, cmd, vertices, NULL);
         cmd = cmd->next;
     }
 
@@ -986,6 +1524,9 @@ static void SW_DestroyRenderer(SDL_Renderer *renderer)
     if (window) {
         SDL_DestroyWindowSurface(window);
     }
+    if (data) {
+        SW_DestroyWorkers(data);
+    }
     SDL_free(data);
 }
 
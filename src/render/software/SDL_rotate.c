@@ -617,4 +617,379 @@ SDL_Surface *SDLgfx_rotateSurface(SDL_Surface *src, double angle, int smooth, in
     return rz_dst;
 }
 
+/* !
+\brief Narrows the span [*first, *end) to the pixels i where (start + i * step) is in [lo, hi).
+
+The bounds are computed in floating point and widened by a pixel, the caller trims the ends exactly.
+*/
+static void clipSpan(double start, double step, double lo, double hi, int *first, int *end)
+{
+    double i0 = *first, i1 = *end;
+
+    if (step > 0.0) {
+        i0 = SDL_max(i0, SDL_floor((lo - start) / step) - 1.0);
+        i1 = SDL_min(i1, SDL_ceil((hi - start) / step) + 1.0);
+    } else if (step < 0.0) {
+        i0 = SDL_max(i0, SDL_floor((hi - start) / step) - 1.0);
+        i1 = SDL_min(i1, SDL_ceil((lo - start) / step) + 1.0);
+    } else if (start < lo || start >= hi) {
+        i1 = i0;
+    }
+    i0 = SDL_min(i0, *end);
+    *first = (int)i0;
+    *end = (int)SDL_max(i0, i1);
+}
+
+/* !
+\brief Interpolates the four 8-bit channels of two pixels, f is the weight of p1 out of 256.
+*/
+static SDL_INLINE Uint32 lerpRGBA(Uint32 p0, Uint32 p1, Uint32 f)
+{
+    const Uint32 rb = (((p0 & 0x00ff00ff) * (256 - f) + (p1 & 0x00ff00ff) * f) >> 8) & 0x00ff00ff;
+    const Uint32 ag = (((p0 >> 8) & 0x00ff00ff) * (256 - f) + ((p1 >> 8) & 0x00ff00ff) * f) & 0xff00ff00;
+    return rb | ag;
+}
+
+/* Pixels sampled at once before they are blended */
+#define ROTATE_SPAN 256
+
+/* !
+\brief Channel layouts and modulation used to blend rotated spans onto the destination.
+*/
+typedef struct
+{
+    int sRshift, sGshift, sBshift, sAshift, src_alpha;
+    int dRshift, dGshift, dBshift, dAshift, dst_alpha;
+    Uint32 dAmask;
+    Uint32 modR, modG, modB, modA;
+    int colormod, alphamod;
+    SDL_BlendMode blendmode;
+    int packed;
+} tRotateBlend;
+
+/* !
+\brief Blends 'n' sampled source pixels onto a destination span, like SDL_blit_slow.c does.
+*/
+static void blendSpan(const tRotateBlend *info, const Uint32 *sp, Uint32 *dp, int n)
+{
+    const tRotateBlend b = *info; /* Copied, the pixel stores could otherwise alias it */
+    int i;
+
+    for (i = 0; i < n; i++) {
+        const Uint32 spixel = sp[i];
+        const Uint32 dpixel = dp[i];
+        Uint32 srcR, srcG, srcB, srcA, dstR, dstG, dstB, dstA;
+
+        srcR = (spixel >> b.sRshift) & 0xff;
+        srcG = (spixel >> b.sGshift) & 0xff;
+        srcB = (spixel >> b.sBshift) & 0xff;
+        srcA = b.src_alpha ? (spixel >> b.sAshift) & 0xff : 0xff;
+        if (b.colormod) {
+            srcR = (srcR * b.modR) / 255;
+            srcG = (srcG * b.modG) / 255;
+            srcB = (srcB * b.modB) / 255;
+        }
+        if (b.alphamod) {
+            srcA = (srcA * b.modA) / 255;
+        }
+        if (b.blendmode == SDL_BLENDMODE_BLEND || b.blendmode == SDL_BLENDMODE_ADD) {
+            /* This goes away if we ever use premultiplied alpha */
+            if (srcA < 255) {
+                srcR = (srcR * srcA) / 255;
+                srcG = (srcG * srcA) / 255;
+                srcB = (srcB * srcA) / 255;
+            }
+        }
+
+        dstR = (dpixel >> b.dRshift) & 0xff;
+        dstG = (dpixel >> b.dGshift) & 0xff;
+        dstB = (dpixel >> b.dBshift) & 0xff;
+        dstA = b.dst_alpha ? (dpixel >> b.dAshift) & 0xff : 0xff;
+        switch (b.blendmode) {
+        case SDL_BLENDMODE_BLEND:
+            dstR = srcR + ((255 - srcA) * dstR) / 255;
+            dstG = srcG + ((255 - srcA) * dstG) / 255;
+            dstB = srcB + ((255 - srcA) * dstB) / 255;
+            dstA = srcA + ((255 - srcA) * dstA) / 255;
+            break;
+        case SDL_BLENDMODE_ADD:
+            dstR = SDL_min(srcR + dstR, 255);
+            dstG = SDL_min(srcG + dstG, 255);
+            dstB = SDL_min(srcB + dstB, 255);
+            break;
+        case SDL_BLENDMODE_MOD:
+            dstR = (srcR * dstR) / 255;
+            dstG = (srcG * dstG) / 255;
+            dstB = (srcB * dstB) / 255;
+            break;
+        case SDL_BLENDMODE_MUL:
+            dstR = SDL_min(((srcR * dstR) + (dstR * (255 - srcA))) / 255, 255);
+            dstG = SDL_min(((srcG * dstG) + (dstG * (255 - srcA))) / 255, 255);
+            dstB = SDL_min(((srcB * dstB) + (dstB * (255 - srcA))) / 255, 255);
+            break;
+        default:
+            dstR = srcR;
+            dstG = srcG;
+            dstB = srcB;
+            dstA = srcA;
+            break;
+        }
+        dp[i] = (dstR << b.dRshift) | (dstG << b.dGshift) | (dstB << b.dBshift) | ((dstA << b.dAshift) & b.dAmask);
+    }
+}
+
+/* !
+\brief Alpha blends 'n' sampled pixels with the alpha in the top byte onto a span of the same RGB layout.
+
+Uses the same arithmetic as BlitRGBtoRGBPixelAlpha() in SDL_blit_A.c, two channels at a time.
+*/
+static void blendSpanPacked(const tRotateBlend *info, const Uint32 *sp, Uint32 *dp, int n)
+{
+    const Uint32 modA = info->modA;
+    const int alphamod = info->alphamod;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        Uint32 s = sp[i];
+        Uint32 alpha = s >> 24;
+        if (alphamod) {
+            alpha = (alpha * modA) / 255;
+        }
+        if (alpha == SDL_ALPHA_OPAQUE) {
+            dp[i] = s;
+        } else if (alpha) {
+            Uint32 d = dp[i];
+            Uint32 dalpha = d >> 24;
+            Uint32 s1 = s & 0xff00ff;
+            Uint32 d1 = d & 0xff00ff;
+            d1 = (d1 + ((s1 - d1) * alpha >> 8)) & 0xff00ff;
+            s &= 0xff00;
+            d &= 0xff00;
+            d = (d + ((s - d) * alpha >> 8)) & 0xff00;
+            dalpha = alpha + (dalpha * (alpha ^ 0xFF) >> 8);
+            dp[i] = d1 | d | (dalpha << 24);
+        }
+    }
+}
+
+/* !
+\brief Rotates, flips and scales a part of a 32-bit surface straight onto a 32-bit surface.
+
+Both surfaces must have a 8888 layout, in any order and with or without alpha. Destination pixel
+centers are mapped back to 'srcrect' and sampled there, so no intermediate surface is needed.
+The color and alpha modulation and the blend mode of 'src' are applied like SDL_BlitSurface()
+does, and the clip rectangle of 'dst' is honored.
+
+\param src The surface to read from.
+\param srcrect The part of 'src' to draw.
+\param dst The surface to draw onto.
+\param dstrect Where 'srcrect' is drawn before the rotation and the scaling.
+\param angle The angle to rotate clockwise, in degrees.
+\param center The center of rotation, relative to 'dstrect'.
+\param flipx Set to 1 to flip the image horizontally.
+\param flipy Set to 1 to flip the image vertically.
+\param scale_x The horizontal scale applied to the rotated destination.
+\param scale_y The vertical scale applied to the rotated destination.
+\param smooth Set to 1 to sample bilinearly instead of picking the nearest pixel.
+\return 0 on success or a negative error code on failure.
+*/
+int SDLgfx_rotateBlit(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect,
+                      double angle, const SDL_FPoint *center, int flipx, int flipy,
+                      float scale_x, float scale_y, int smooth)
+{
+    /* Copied to locals, the pixel stores could otherwise alias them */
+    const Uint8 *src_pixels = (const Uint8 *)src->pixels;
+    const int src_pitch = src->pitch;
+    const int sx0 = srcrect->x, sy0 = srcrect->y;
+    const int sx1 = srcrect->x + srcrect->w, sy1 = srcrect->y + srcrect->h;
+    double radangle, sinangle, cosangle;
+    double kx, ky;
+    double fx_dx, fx_dy, fy_dx, fy_dy, fx_00, fy_00;
+    double minx, maxx, miny, maxy;
+    Sint64 step_x, step_y;
+    SDL_Rect bounds;
+    tRotateBlend blend;
+    Uint8 modR, modG, modB, modA;
+    Uint32 span[ROTATE_SPAN];
+    int copy;
+    int i, y;
+
+    if (srcrect->w <= 0 || srcrect->h <= 0 || dstrect->w <= 0 || dstrect->h <= 0 || scale_x <= 0.0f || scale_y <= 0.0f) {
+        return 0;
+    }
+    if (sx0 < 0 || sy0 < 0 || sx1 > src->w || sy1 > src->h) {
+        return SDL_SetError("Source rect out of bounds");
+    }
+
+    SDL_GetSurfaceBlendMode(src, &blend.blendmode);
+    SDL_GetSurfaceColorMod(src, &modR, &modG, &modB);
+    SDL_GetSurfaceAlphaMod(src, &modA);
+    blend.sRshift = src->format->Rshift;
+    blend.sGshift = src->format->Gshift;
+    blend.sBshift = src->format->Bshift;
+    blend.sAshift = src->format->Ashift;
+    blend.src_alpha = src->format->Amask != 0;
+    blend.dRshift = dst->format->Rshift;
+    blend.dGshift = dst->format->Gshift;
+    blend.dBshift = dst->format->Bshift;
+    blend.dAshift = dst->format->Ashift;
+    blend.dst_alpha = dst->format->Amask != 0;
+    blend.dAmask = dst->format->Amask;
+    blend.modR = modR;
+    blend.modG = modG;
+    blend.modB = modB;
+    blend.modA = modA;
+    blend.colormod = (modR & modG & modB) != 255;
+    blend.alphamod = modA != 255;
+    blend.packed = blend.blendmode == SDL_BLENDMODE_BLEND && !blend.colormod && blend.src_alpha &&
+                   blend.sAshift == 24 && (blend.dAshift == 24 || !blend.dst_alpha) &&
+                   blend.sRshift == blend.dRshift && blend.sGshift == blend.dGshift && blend.sBshift == blend.dBshift;
+    copy = blend.blendmode == SDL_BLENDMODE_NONE && !blend.colormod && !blend.alphamod &&
+           src->format->format == dst->format->format;
+
+    /* Use exact values for multiples of 90 degrees, so the pixels map one to one */
+    radangle = angle * (M_PI / 180.0);
+    sinangle = SDL_sin(radangle);
+    cosangle = SDL_cos(radangle);
+    if ((int)(angle / 90) == angle / 90) {
+        int angle90 = (int)(angle / 90) % 4;
+        if (angle90 < 0) {
+            angle90 += 4;
+        }
+        sinangle = (angle90 == 1) ? 1.0 : (angle90 == 3) ? -1.0 : 0.0;
+        cosangle = (angle90 == 0) ? 1.0 : (angle90 == 2) ? -1.0 : 0.0;
+    }
+
+    /* Bounding box of the rotated and scaled rect, on the destination */
+    {
+        const double cx = dstrect->x + center->x, cy = dstrect->y + center->y;
+        minx = miny = SDL_MAX_SINT32;
+        maxx = maxy = SDL_MIN_SINT32;
+        for (i = 0; i < 4; i++) {
+            const double u = ((i & 1) ? dstrect->w : 0) - center->x;
+            const double v = ((i & 2) ? dstrect->h : 0) - center->y;
+            const double px = (cosangle * u - sinangle * v + cx) * scale_x;
+            const double py = (sinangle * u + cosangle * v + cy) * scale_y;
+            minx = SDL_min(minx, px);
+            maxx = SDL_max(maxx, px);
+            miny = SDL_min(miny, py);
+            maxy = SDL_max(maxy, py);
+        }
+        minx = SDL_max(minx, dst->clip_rect.x);
+        miny = SDL_max(miny, dst->clip_rect.y);
+        maxx = SDL_min(maxx, dst->clip_rect.x + dst->clip_rect.w);
+        maxy = SDL_min(maxy, dst->clip_rect.y + dst->clip_rect.h);
+        if (minx >= maxx || miny >= maxy) {
+            return 0;
+        }
+        bounds.x = (int)SDL_floor(minx);
+        bounds.y = (int)SDL_floor(miny);
+        bounds.w = (int)SDL_ceil(maxx) - bounds.x;
+        bounds.h = (int)SDL_ceil(maxy) - bounds.y;
+    }
+
+    /* The source position of a destination pixel center is linear:
+       fx = fx_00 + x * fx_dx + y * fx_dy, and the same for fy */
+    kx = (double)srcrect->w / dstrect->w;
+    ky = (double)srcrect->h / dstrect->h;
+    fx_dx = kx * cosangle / scale_x;
+    fx_dy = kx * sinangle / scale_y;
+    fy_dx = -ky * sinangle / scale_x;
+    fy_dy = ky * cosangle / scale_y;
+    {
+        const double px = 0.5 / scale_x - (dstrect->x + center->x);
+        const double py = 0.5 / scale_y - (dstrect->y + center->y);
+        const double u = cosangle * px + sinangle * py + center->x;
+        const double v = -sinangle * px + cosangle * py + center->y;
+        fx_00 = sx0 + u * kx;
+        fy_00 = sy0 + v * ky;
+    }
+    if (flipx) {
+        fx_00 = sx0 + sx1 - fx_00;
+        fx_dx = -fx_dx;
+        fx_dy = -fx_dy;
+    }
+    if (flipy) {
+        fy_00 = sy0 + sy1 - fy_00;
+        fy_dx = -fy_dx;
+        fy_dy = -fy_dy;
+    }
+
+    /* Positions are stepped in 16.16 fixed point along a row */
+    step_x = (Sint64)(fx_dx * 65536.0);
+    step_y = (Sint64)(fy_dx * 65536.0);
+
+    if (SDL_MUSTLOCK(src)) {
+        SDL_LockSurface(src);
+    }
+    if (SDL_MUSTLOCK(dst)) {
+        SDL_LockSurface(dst);
+    }
+
+    for (y = bounds.y; y < bounds.y + bounds.h; y++) {
+        const double fx_row = fx_00 + bounds.x * fx_dx + y * fx_dy;
+        const double fy_row = fy_00 + bounds.x * fy_dx + y * fy_dy;
+        const Sint64 lo_x = (Sint64)sx0 << 16, hi_x = (Sint64)sx1 << 16;
+        const Sint64 lo_y = (Sint64)sy0 << 16, hi_y = (Sint64)sy1 << 16;
+        Uint32 *dp = (Uint32 *)((Uint8 *)dst->pixels + y * dst->pitch) + bounds.x;
+        int first = 0, end = bounds.w;
+        Sint64 fx, fy;
+
+        clipSpan(fx_row, fx_dx, sx0, sx1, &first, &end);
+        clipSpan(fy_row, fy_dx, sy0, sy1, &first, &end);
+
+        /* The positions inside srcrect are contiguous, so trimming both ends leaves only those */
+        fx = (Sint64)((fx_row + first * fx_dx) * 65536.0);
+        fy = (Sint64)((fy_row + first * fy_dx) * 65536.0);
+        while (first < end && (fx < lo_x || fx >= hi_x || fy < lo_y || fy >= hi_y)) {
+            first++;
+            fx += step_x;
+            fy += step_y;
+        }
+        while (first < end) {
+            const Sint64 ex = fx + (end - 1 - first) * step_x, ey = fy + (end - 1 - first) * step_y;
+            if (ex >= lo_x && ex < hi_x && ey >= lo_y && ey < hi_y) {
+                break;
+            }
+            end--;
+        }
+
+        while (first < end) {
+            const int n = SDL_min(end - first, ROTATE_SPAN);
+            Uint32 *out = copy ? dp + first : span;
+
+            if (smooth) {
+                for (i = 0; i < n; i++, fx += step_x, fy += step_y) {
+                    /* Sample around the pixel center, without reading outside of srcrect */
+                    const Sint64 bx = fx + 32768, by = fy + 32768; /* - 0.5 + 1, to stay positive */
+                    const int ix = (int)(bx >> 16) - 1, iy = (int)(by >> 16) - 1;
+                    const Uint32 *row0 = (const Uint32 *)(src_pixels + SDL_max(iy, sy0) * src_pitch);
+                    const Uint32 *row1 = (const Uint32 *)(src_pixels + SDL_min(iy + 1, sy1 - 1) * src_pitch);
+                    const int ix0 = SDL_max(ix, sx0), ix1 = SDL_min(ix + 1, sx1 - 1);
+                    const Uint32 wx = (Uint32)(bx & 0xffff) >> 8, wy = (Uint32)(by & 0xffff) >> 8;
+                    out[i] = lerpRGBA(lerpRGBA(row0[ix0], row0[ix1], wx), lerpRGBA(row1[ix0], row1[ix1], wx), wy);
+                }
+            } else {
+                for (i = 0; i < n; i++, fx += step_x, fy += step_y) {
+                    out[i] = ((const Uint32 *)(src_pixels + (int)(fy >> 16) * src_pitch))[(int)(fx >> 16)];
+                }
+            }
+            if (blend.packed) {
+                blendSpanPacked(&blend, span, dp + first, n);
+            } else if (!copy) {
+                blendSpan(&blend, span, dp + first, n);
+            }
+            first += n;
+        }
+    }
+
+    if (SDL_MUSTLOCK(dst)) {
+        SDL_UnlockSurface(dst);
+    }
+    if (SDL_MUSTLOCK(src)) {
+        SDL_UnlockSurface(src);
+    }
+    return 0;
+}
+
 #endif /* SDL_VIDEO_RENDER_SW */
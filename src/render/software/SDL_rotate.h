@@ -26,5 +26,8 @@ extern SDL_Surface *SDLgfx_rotateSurface(SDL_Surface *src, double angle, int smo
                                          const SDL_Rect *rect_dest, double cangle, double sangle, const SDL_FPoint *center);
 extern void SDLgfx_rotozoomSurfaceSizeTrig(int width, int height, double angle, const SDL_FPoint *center,
                                            SDL_Rect *rect_dest, double *cangle, double *sangle);
+extern int SDLgfx_rotateBlit(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect,
+                             double angle, const SDL_FPoint *center, int flipx, int flipy,
+                             float scale_x, float scale_y, int smooth);
 
 #endif /* SDL_rotate_h_ */
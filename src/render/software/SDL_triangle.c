@@ -134,6 +134,13 @@ void trianglepoint_2_fixedpoint(SDL_Point *a)
     PRECOMP(a->y, a->y);
 }
 
+/* rounds down to the pixel containing the point */
+void fixedpoint_2_trianglepoint(SDL_Point *a)
+{
+    a->x >>= FP_BITS;
+    a->y >>= FP_BITS;
+}
+
 /* bounding rect of three points (in fixed point) */
 static void bounding_rect_fixedpoint(const SDL_Point *a, const SDL_Point *b, const SDL_Point *c, SDL_Rect *r)
 {
@@ -214,6 +221,409 @@ static void bounding_rect(const SDL_Point *a, const SDL_Point *b, const SDL_Poin
     }                     \
     }
 
+/* Block rasterizer, used for the 32 bits destinations
+ *
+ * The rect is walked in TRIANGLE_BLOCK x TRIANGLE_BLOCK blocks. The edge functions are linear,
+ * so their values at the corners of a block tell whether it is outside the triangle, inside it,
+ * or crossed by an edge. Only the pixels of crossed blocks are tested, a row of them at a time.
+ * The covered pixels are passed to a span function, with runs of inside blocks merged.
+ *
+ * Coverage uses the same edge functions and biases as TRIANGLE_BEGIN_LOOP, and the interpolated
+ * values match the divisions of TRIANGLE_GET_TEXTCOORD and TRIANGLE_GET_COLOR, so the pixels
+ * don't depend on which loop drew them.
+ */
+#define TRIANGLE_BLOCK      8
+#define TRIANGLE_BLOCK_FULL 0xFF /* mask of a span whose pixels are all covered, of any width */
+#define TRIANGLE_CHUNK      64   /* blocks classified before their rows are drawn */
+
+#if defined(__SSE2__)
+#define HAVE_SSE2_INTRINSICS
+
+static SDL_INLINE int hasSSE2(void)
+{
+    static int val = -1;
+    if (val != -1) {
+        return val;
+    }
+    val = SDL_HasSSE2();
+    return val;
+}
+#endif
+
+typedef struct
+{
+    Sint64 w_row[3];  /* edge functions at the top left pixel of the rect */
+    Sint64 step_x[3]; /* x += 1 */
+    Sint64 step_y[3]; /* y += 1 */
+    int bias[3];
+} TriangleEdges;
+
+/* (w0 * k0 + w1 * k1 + w2 * k2 + k) / area, stepped along a span with a quotient and a remainder.
+ * It rounds down, so it only matches the truncating division where the numerator isn't negative,
+ * which holds for the pixels inside the triangle as long as the vertex values aren't. */
+typedef struct
+{
+    Sint64 n_row; /* numerator at the top left pixel of the rect */
+    Sint64 n_step_x;
+    Sint64 n_step_y;
+    Sint64 q_step; /* n_step_x == q_step * area + r_step, with 0 <= r_step < area */
+    Sint64 r_step;
+} TriangleInterp;
+
+#define TRIANGLE_INTERP_SRCX 0
+#define TRIANGLE_INTERP_SRCY 1
+#define TRIANGLE_INTERP_R    2
+#define TRIANGLE_INTERP_G    3
+#define TRIANGLE_INTERP_B    4
+#define TRIANGLE_INTERP_A    5
+#define TRIANGLE_INTERP_MAX  6
+
+typedef struct
+{
+    Sint64 area;
+    Uint8 *dst_ptr; /* top left pixel of the rect */
+    int dst_pitch;
+    const Uint8 *src_ptr;
+    int src_pitch;
+    SDL_PixelFormat *format;
+    Uint32 color;
+    int flags; /* SDL_COPY_* */
+    int src_has_alpha;
+    int dst_has_alpha;
+    SDL_Color modulate;
+    int num_interp;
+    TriangleInterp interp[TRIANGLE_INTERP_MAX];
+} TriangleSpanData;
+
+/* Draws the pixels x to x + w - 1 of row y of the rect whose bit is set in mask */
+typedef void (*TriangleSpanFunc)(const TriangleSpanData *data, int x, int y, int w, Uint8 mask);
+
+static void triangle_edges_init(TriangleEdges *e, Sint64 w0_row, Sint64 w1_row, Sint64 w2_row,
+                                int d2d1_y, int d1d2_x, int d0d2_y, int d2d0_x, int d1d0_y, int d0d1_x,
+                                int bias_w0, int bias_w1, int bias_w2)
+{
+    e->w_row[0] = w0_row;
+    e->w_row[1] = w1_row;
+    e->w_row[2] = w2_row;
+    e->step_x[0] = d2d1_y;
+    e->step_x[1] = d0d2_y;
+    e->step_x[2] = d1d0_y;
+    e->step_y[0] = d1d2_x;
+    e->step_y[1] = d2d0_x;
+    e->step_y[2] = d0d1_x;
+    e->bias[0] = bias_w0;
+    e->bias[1] = bias_w1;
+    e->bias[2] = bias_w2;
+}
+
+/* Rounds towards negative infinity, d > 0 */
+static SDL_INLINE Sint64 floor_div64(Sint64 n, Sint64 d, Sint64 *rem)
+{
+    Sint64 q = n / d;
+    Sint64 r = n - q * d;
+    if (r < 0) {
+        q--;
+        r += d;
+    }
+    *rem = r;
+    return q;
+}
+
+static void triangle_interp_init(TriangleSpanData *data, const TriangleEdges *e, Sint64 k0, Sint64 k1, Sint64 k2, Sint64 k)
+{
+    TriangleInterp *v = &data->interp[data->num_interp++];
+    v->n_row = e->w_row[0] * k0 + e->w_row[1] * k1 + e->w_row[2] * k2 + k;
+    v->n_step_x = e->step_x[0] * k0 + e->step_x[1] * k1 + e->step_x[2] * k2;
+    v->n_step_y = e->step_y[0] * k0 + e->step_y[1] * k1 + e->step_y[2] * k2;
+    v->q_step = floor_div64(v->n_step_x, data->area, &v->r_step);
+}
+
+/* Values first .. end - 1 at pixel (x, y) of the rect */
+static SDL_INLINE void triangle_interp_start(const TriangleSpanData *data, int x, int y, Sint64 *q, Sint64 *r, int first, int end)
+{
+    int i;
+    for (i = first; i < end; i++) {
+        const TriangleInterp *v = &data->interp[i];
+        q[i] = floor_div64(v->n_row + x * v->n_step_x + y * v->n_step_y, data->area, &r[i]);
+    }
+}
+
+/* x += 1, without branches as the carries don't follow a pattern */
+static SDL_INLINE void triangle_interp_step(const TriangleSpanData *data, Sint64 *q, Sint64 *r, int first, int end)
+{
+    const Sint64 area = data->area;
+    int i;
+    for (i = first; i < end; i++) {
+        Sint64 carry;
+        r[i] += data->interp[i].r_step;
+        carry = -(Sint64)(r[i] >= area);
+        r[i] -= area & carry;
+        q[i] += data->interp[i].q_step - carry;
+    }
+}
+
+#define TRIANGLE_SPAN_COVERED(i) (mask == TRIANGLE_BLOCK_FULL || (mask & (1 << (i))))
+
+/* Coverage masks of the rows of a block, the pixels at bx .. bx + bw - 1 and by .. by + bh - 1 */
+static void triangle_block_masks(const TriangleEdges *e, int bx, int by, int bw, int bh, Uint8 *masks, int masks_pitch)
+{
+    const Uint8 valid = (Uint8)((1 << bw) - 1);
+    Sint64 w[3]; /* at the top left pixel of the block, with the bias */
+    int inside = 1;
+    int fits_32 = 1;
+    int i, y;
+
+    for (i = 0; i < 3; i++) {
+        const Sint64 dx = (bw - 1) * e->step_x[i];
+        const Sint64 dy = (bh - 1) * e->step_y[i];
+        Sint64 lo, hi;
+
+        w[i] = e->w_row[i] + bx * e->step_x[i] + by * e->step_y[i] + e->bias[i];
+        lo = w[i] + SDL_min(dx, 0) + SDL_min(dy, 0);
+        hi = w[i] + SDL_max(dx, 0) + SDL_max(dy, 0);
+        if (hi < 0) {
+            /* Outside of this edge */
+            for (y = 0; y < bh; y++) {
+                masks[y * masks_pitch] = 0;
+            }
+            return;
+        }
+        if (lo < 0) {
+            inside = 0;
+        }
+        if (lo < INT_MIN || hi > INT_MAX) {
+            fits_32 = 0;
+        }
+    }
+
+    if (inside) {
+        for (y = 0; y < bh; y++) {
+            masks[y * masks_pitch] = TRIANGLE_BLOCK_FULL;
+        }
+        return;
+    }
+
+#if defined(HAVE_SSE2_INTRINSICS)
+    if (fits_32 && hasSSE2()) {
+        /* Every value of the block fits, test a row of 8 pixels at once.
+           Lanes past the block width repeat its last column. */
+        __m128i lo[3], hi[3], step_y[3];
+        for (i = 0; i < 3; i++) {
+#define LANE(j) (int)(w[i] + SDL_min(j, bw - 1) * e->step_x[i])
+            lo[i] = _mm_setr_epi32(LANE(0), LANE(1), LANE(2), LANE(3));
+            hi[i] = _mm_setr_epi32(LANE(4), LANE(5), LANE(6), LANE(7));
+#undef LANE
+            step_y[i] = _mm_set1_epi32((int)e->step_y[i]);
+        }
+        for (y = 0; y < bh; y++) {
+            const __m128i lo_any = _mm_or_si128(_mm_or_si128(lo[0], lo[1]), lo[2]);
+            const __m128i hi_any = _mm_or_si128(_mm_or_si128(hi[0], hi[1]), hi[2]);
+            const int outside = _mm_movemask_ps(_mm_castsi128_ps(lo_any)) |
+                                (_mm_movemask_ps(_mm_castsi128_ps(hi_any)) << 4);
+            Uint8 mask = (Uint8)(~outside & valid);
+            masks[y * masks_pitch] = (mask == valid) ? TRIANGLE_BLOCK_FULL : mask;
+            for (i = 0; i < 3; i++) {
+                lo[i] = _mm_add_epi32(lo[i], step_y[i]);
+                hi[i] = _mm_add_epi32(hi[i], step_y[i]);
+            }
+        }
+        return;
+    }
+#else
+    (void)fits_32;
+#endif
+
+    for (y = 0; y < bh; y++) {
+        Sint64 w0 = w[0] + y * e->step_y[0];
+        Sint64 w1 = w[1] + y * e->step_y[1];
+        Sint64 w2 = w[2] + y * e->step_y[2];
+        Uint8 mask = 0;
+        int x;
+        for (x = 0; x < bw; x++) {
+            if (w0 >= 0 && w1 >= 0 && w2 >= 0) {
+                mask |= (1 << x);
+            }
+            w0 += e->step_x[0];
+            w1 += e->step_x[1];
+            w2 += e->step_x[2];
+        }
+        masks[y * masks_pitch] = (mask == valid) ? TRIANGLE_BLOCK_FULL : mask;
+    }
+}
+
+static void triangle_rasterize(const TriangleEdges *e, int w, int h, TriangleSpanFunc span, const TriangleSpanData *data)
+{
+    Uint8 masks[TRIANGLE_BLOCK][TRIANGLE_CHUNK];
+    int by, cx;
+
+    for (by = 0; by < h; by += TRIANGLE_BLOCK) {
+        const int bh = SDL_min(TRIANGLE_BLOCK, h - by);
+        for (cx = 0; cx < w; cx += TRIANGLE_BLOCK * TRIANGLE_CHUNK) {
+            const int num_blocks = (SDL_min(TRIANGLE_BLOCK * TRIANGLE_CHUNK, w - cx) + TRIANGLE_BLOCK - 1) / TRIANGLE_BLOCK;
+            int b, y;
+
+            for (b = 0; b < num_blocks; b++) {
+                const int bx = cx + b * TRIANGLE_BLOCK;
+                triangle_block_masks(e, bx, by, SDL_min(TRIANGLE_BLOCK, w - bx), bh, &masks[0][b], TRIANGLE_CHUNK);
+            }
+
+            for (y = 0; y < bh; y++) {
+                const Uint8 *row = masks[y];
+                b = 0;
+                while (b < num_blocks) {
+                    const int bx = cx + b * TRIANGLE_BLOCK;
+                    if (row[b] == TRIANGLE_BLOCK_FULL) {
+                        int end = b + 1;
+                        while (end < num_blocks && row[end] == TRIANGLE_BLOCK_FULL) {
+                            end++;
+                        }
+                        span(data, bx, by + y, SDL_min(cx + end * TRIANGLE_BLOCK, w) - bx, TRIANGLE_BLOCK_FULL);
+                        b = end;
+                    } else {
+                        if (row[b]) {
+                            span(data, bx, by + y, SDL_min(TRIANGLE_BLOCK, w - bx), row[b]);
+                        }
+                        b++;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void triangle_span_fill32(const TriangleSpanData *data, int x, int y, int w, Uint8 mask)
+{
+    Uint32 *dst = (Uint32 *)(data->dst_ptr + y * data->dst_pitch) + x;
+    int i;
+
+    if (mask == TRIANGLE_BLOCK_FULL) {
+        SDL_memset4(dst, data->color, w);
+        return;
+    }
+    for (i = 0; i < w; i++) {
+        if (mask & (1 << i)) {
+            dst[i] = data->color;
+        }
+    }
+}
+
+/* The same as SDL_MapRGBA() for the formats accepted by triangle_is_rgba32() */
+static void triangle_span_fill_color32(const TriangleSpanData *data, int x, int y, int w, Uint8 mask)
+{
+    const SDL_PixelFormat *fmt = data->format;
+    Uint32 *dst = (Uint32 *)(data->dst_ptr + y * data->dst_pitch) + x;
+    Sint64 q[TRIANGLE_INTERP_MAX], r[TRIANGLE_INTERP_MAX];
+    int i;
+
+    triangle_interp_start(data, x, y, q, r, TRIANGLE_INTERP_R, TRIANGLE_INTERP_MAX);
+    for (i = 0; i < w; i++) {
+        if (TRIANGLE_SPAN_COVERED(i)) {
+            dst[i] = ((Uint32)q[TRIANGLE_INTERP_R] << fmt->Rshift) |
+                     ((Uint32)q[TRIANGLE_INTERP_G] << fmt->Gshift) |
+                     ((Uint32)q[TRIANGLE_INTERP_B] << fmt->Bshift) |
+                     (((Uint32)q[TRIANGLE_INTERP_A] >> fmt->Aloss) << fmt->Ashift);
+        }
+        triangle_interp_step(data, q, r, TRIANGLE_INTERP_R, TRIANGLE_INTERP_MAX);
+    }
+}
+
+static void triangle_span_copy32(const TriangleSpanData *data, int x, int y, int w, Uint8 mask)
+{
+    Uint32 *dst = (Uint32 *)(data->dst_ptr + y * data->dst_pitch) + x;
+    Sint64 q[TRIANGLE_INTERP_MAX], r[TRIANGLE_INTERP_MAX];
+    int i;
+
+    triangle_interp_start(data, x, y, q, r, TRIANGLE_INTERP_SRCX, TRIANGLE_INTERP_R);
+    for (i = 0; i < w; i++) {
+        if (TRIANGLE_SPAN_COVERED(i)) {
+            const Uint32 *src = (const Uint32 *)(data->src_ptr + (int)q[TRIANGLE_INTERP_SRCY] * data->src_pitch);
+            dst[i] = src[(int)q[TRIANGLE_INTERP_SRCX]];
+        }
+        triangle_interp_step(data, q, r, TRIANGLE_INTERP_SRCX, TRIANGLE_INTERP_R);
+    }
+}
+
+/* SDL_BlitTriangle_Slow() for [AX]RGB8888 to [AX]RGB8888, without color key and with SDL_COPY_BLEND as the only blending */
+static void triangle_span_blit_rgb32(const TriangleSpanData *data, int x, int y, int w, Uint8 mask)
+{
+    const int flags = data->flags;
+    Uint32 *dst = (Uint32 *)(data->dst_ptr + y * data->dst_pitch) + x;
+    Sint64 q[TRIANGLE_INTERP_MAX], r[TRIANGLE_INTERP_MAX];
+    Uint32 modulateR = data->modulate.r;
+    Uint32 modulateG = data->modulate.g;
+    Uint32 modulateB = data->modulate.b;
+    Uint32 modulateA = data->modulate.a;
+    const int num_interp = data->num_interp;
+    int i;
+
+    triangle_interp_start(data, x, y, q, r, TRIANGLE_INTERP_SRCX, num_interp);
+    for (i = 0; i < w; i++) {
+        if (TRIANGLE_SPAN_COVERED(i)) {
+            const Uint32 *src = (const Uint32 *)(data->src_ptr + (int)q[TRIANGLE_INTERP_SRCY] * data->src_pitch);
+            const Uint32 srcpixel = src[(int)q[TRIANGLE_INTERP_SRCX]];
+            Uint32 srcR = (srcpixel >> 16) & 0xFF;
+            Uint32 srcG = (srcpixel >> 8) & 0xFF;
+            Uint32 srcB = srcpixel & 0xFF;
+            Uint32 srcA = data->src_has_alpha ? (srcpixel >> 24) : 0xFF;
+            Uint32 dstR, dstG, dstB, dstA;
+
+            if (num_interp > TRIANGLE_INTERP_R) {
+                modulateR = (Uint32)q[TRIANGLE_INTERP_R];
+                modulateG = (Uint32)q[TRIANGLE_INTERP_G];
+                modulateB = (Uint32)q[TRIANGLE_INTERP_B];
+                modulateA = (Uint32)q[TRIANGLE_INTERP_A];
+            }
+            if (flags & SDL_COPY_MODULATE_COLOR) {
+                srcR = (srcR * modulateR) / 255;
+                srcG = (srcG * modulateG) / 255;
+                srcB = (srcB * modulateB) / 255;
+            }
+            if (flags & SDL_COPY_MODULATE_ALPHA) {
+                srcA = (srcA * modulateA) / 255;
+            }
+            if (flags & SDL_COPY_BLEND) {
+                const Uint32 dstpixel = dst[i];
+                if (srcA < 255) {
+                    srcR = (srcR * srcA) / 255;
+                    srcG = (srcG * srcA) / 255;
+                    srcB = (srcB * srcA) / 255;
+                }
+                dstR = (dstpixel >> 16) & 0xFF;
+                dstG = (dstpixel >> 8) & 0xFF;
+                dstB = dstpixel & 0xFF;
+                dstA = data->dst_has_alpha ? (dstpixel >> 24) : 0xFF;
+                dstR = srcR + ((255 - srcA) * dstR) / 255;
+                dstG = srcG + ((255 - srcA) * dstG) / 255;
+                dstB = srcB + ((255 - srcA) * dstB) / 255;
+                dstA = srcA + ((255 - srcA) * dstA) / 255;
+            } else {
+                dstR = srcR;
+                dstG = srcG;
+                dstB = srcB;
+                dstA = srcA;
+            }
+            if (data->dst_has_alpha) {
+                dst[i] = (dstA << 24) | (dstR << 16) | (dstG << 8) | dstB;
+            } else {
+                dst[i] = (dstR << 16) | (dstG << 8) | dstB;
+            }
+        }
+        if (num_interp > TRIANGLE_INTERP_R) {
+            triangle_interp_step(data, q, r, TRIANGLE_INTERP_SRCX, TRIANGLE_INTERP_MAX);
+        } else {
+            triangle_interp_step(data, q, r, TRIANGLE_INTERP_SRCX, TRIANGLE_INTERP_R);
+        }
+    }
+}
+
+/* 32 bits formats with 8 bits color channels, which triangle_span_fill_color32() can map */
+static int triangle_is_rgba32(const SDL_PixelFormat *fmt)
+{
+    return fmt->BytesPerPixel == 4 && !fmt->palette &&
+           fmt->Rloss == 0 && fmt->Gloss == 0 && fmt->Bloss == 0 &&
+           (fmt->Aloss == 0 || fmt->Aloss == 8);
+}
+
 int SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Point *d2, SDL_BlendMode blend, SDL_Color c0, SDL_Color c1, SDL_Color c2)
 {
     int ret = 0;
@@ -357,7 +767,30 @@ int SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poin
     bias_w1 = (is_top_left(d2, d0, is_clockwise) ? 0 : -1);
     bias_w2 = (is_top_left(d0, d1, is_clockwise) ? 0 : -1);
 
-    if (is_uniform) {
+    if (dstbpp == 4 && (is_uniform || triangle_is_rgba32(tmp ? tmp->format : dst->format))) {
+        TriangleEdges edges;
+        TriangleSpanData data;
+
+        triangle_edges_init(&edges, w0_row, w1_row, w2_row, d2d1_y, d1d2_x, d0d2_y, d2d0_x, d1d0_y, d0d1_x,
+                            bias_w0, bias_w1, bias_w2);
+        SDL_zero(data);
+        data.area = area;
+        data.dst_ptr = dst_ptr;
+        data.dst_pitch = dst_pitch;
+        data.format = tmp ? tmp->format : dst->format;
+
+        if (is_uniform) {
+            data.color = SDL_MapRGBA(data.format, c0.r, c0.g, c0.b, c0.a);
+            triangle_rasterize(&edges, dstrect.w, dstrect.h, triangle_span_fill32, &data);
+        } else {
+            data.num_interp = TRIANGLE_INTERP_R;
+            triangle_interp_init(&data, &edges, c0.r, c1.r, c2.r, 0);
+            triangle_interp_init(&data, &edges, c0.g, c1.g, c2.g, 0);
+            triangle_interp_init(&data, &edges, c0.b, c1.b, c2.b, 0);
+            triangle_interp_init(&data, &edges, c0.a, c1.a, c2.a, 0);
+            triangle_rasterize(&edges, dstrect.w, dstrect.h, triangle_span_fill_color32, &data);
+        }
+    } else if (is_uniform) {
         Uint32 color;
         if (tmp) {
             color = SDL_MapRGBA(tmp->format, c0.r, c0.g, c0.b, c0.a);
@@ -365,13 +798,7 @@ int SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poin
             color = SDL_MapRGBA(dst->format, c0.r, c0.g, c0.b, c0.a);
         }
 
-        if (dstbpp == 4) {
-            TRIANGLE_BEGIN_LOOP
-            {
-                *(Uint32 *)dptr = color;
-            }
-            TRIANGLE_END_LOOP
-        } else if (dstbpp == 3) {
+        if (dstbpp == 3) {
             TRIANGLE_BEGIN_LOOP
             {
                 Uint8 *s = (Uint8 *)&color;
@@ -481,6 +908,7 @@ int SDL_SW_BlitTriangle(
     int is_uniform;
 
     int has_modulation;
+    int has_positive_texcoords;
 
     if (!src) {
         return SDL_InvalidParamError("src");
@@ -602,6 +1030,9 @@ int SDL_SW_BlitTriangle(
         PRECOMP(d0d1_x, d1->x - d0->x)
     }
 
+    /* The block rasterizer rounds texture coordinates down instead of towards zero */
+    has_positive_texcoords = s0->x >= 0 && s1->x >= 0 && s2->x >= 0 && s0->y >= 0 && s1->y >= 0 && s2->y >= 0;
+
     s2s0_x = s0->x - s2->x;
     s2s1_x = s1->x - s2->x;
     s2s0_y = s0->y - s2->y;
@@ -707,15 +1138,61 @@ int SDL_SW_BlitTriangle(
         CHECK_INT_RANGE(w0_row);
         CHECK_INT_RANGE(w1_row);
         CHECK_INT_RANGE(w2_row);
-        SDL_BlitTriangle_Slow(&tmp_info, s2_x_area, dstrect, (int)area, bias_w0, bias_w1, bias_w2,
-                              d2d1_y, d1d2_x, d0d2_y, d2d0_x, d1d0_y, d0d1_x,
-                              s2s0_x, s2s1_x, s2s0_y, s2s1_y, (int)w0_row, (int)w1_row, (int)w2_row,
-                              c0, c1, c2, is_uniform);
+
+        if (has_positive_texcoords &&
+            (src->format->format == SDL_PIXELFORMAT_ARGB8888 || src->format->format == SDL_PIXELFORMAT_XRGB8888) &&
+            (dst->format->format == SDL_PIXELFORMAT_ARGB8888 || dst->format->format == SDL_PIXELFORMAT_XRGB8888) &&
+            !(tmp_info.flags & (SDL_COPY_COLORKEY | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL))) {
+            TriangleEdges edges;
+            TriangleSpanData data;
+
+            triangle_edges_init(&edges, w0_row, w1_row, w2_row, d2d1_y, d1d2_x, d0d2_y, d2d0_x, d1d0_y, d0d1_x,
+                                bias_w0, bias_w1, bias_w2);
+            SDL_zero(data);
+            data.area = area;
+            data.dst_ptr = dst_ptr;
+            data.dst_pitch = dst_pitch;
+            data.src_ptr = (const Uint8 *)src_ptr;
+            data.src_pitch = src_pitch;
+            data.flags = tmp_info.flags;
+            data.src_has_alpha = (src->format->Amask != 0);
+            data.dst_has_alpha = (dst->format->Amask != 0);
+            data.modulate = c0;
+            triangle_interp_init(&data, &edges, s2s0_x, s2s1_x, 0, s2_x_area.x);
+            triangle_interp_init(&data, &edges, s2s0_y, s2s1_y, 0, s2_x_area.y);
+            if (!is_uniform) {
+                triangle_interp_init(&data, &edges, c0.r, c1.r, c2.r, 0);
+                triangle_interp_init(&data, &edges, c0.g, c1.g, c2.g, 0);
+                triangle_interp_init(&data, &edges, c0.b, c1.b, c2.b, 0);
+                triangle_interp_init(&data, &edges, c0.a, c1.a, c2.a, 0);
+            }
+            triangle_rasterize(&edges, dstrect.w, dstrect.h, triangle_span_blit_rgb32, &data);
+        } else {
+            SDL_BlitTriangle_Slow(&tmp_info, s2_x_area, dstrect, (int)area, bias_w0, bias_w1, bias_w2,
+                                  d2d1_y, d1d2_x, d0d2_y, d2d0_x, d1d0_y, d0d1_x,
+                                  s2s0_x, s2s1_x, s2s0_y, s2s1_y, (int)w0_row, (int)w1_row, (int)w2_row,
+                                  c0, c1, c2, is_uniform);
+        }
 
         goto end;
     }
 
-    if (dstbpp == 4) {
+    if (dstbpp == 4 && has_positive_texcoords) {
+        TriangleEdges edges;
+        TriangleSpanData data;
+
+        triangle_edges_init(&edges, w0_row, w1_row, w2_row, d2d1_y, d1d2_x, d0d2_y, d2d0_x, d1d0_y, d0d1_x,
+                            bias_w0, bias_w1, bias_w2);
+        SDL_zero(data);
+        data.area = area;
+        data.dst_ptr = dst_ptr;
+        data.dst_pitch = dst_pitch;
+        data.src_ptr = (const Uint8 *)src_ptr;
+        data.src_pitch = src_pitch;
+        triangle_interp_init(&data, &edges, s2s0_x, s2s1_x, 0, s2_x_area.x);
+        triangle_interp_init(&data, &edges, s2s0_y, s2s1_y, 0, s2_x_area.y);
+        triangle_rasterize(&edges, dstrect.w, dstrect.h, triangle_span_copy32, &data);
+    } else if (dstbpp == 4) {
         TRIANGLE_BEGIN_LOOP
         {
             TRIANGLE_GET_TEXTCOORD
@@ -5212,10 +5212,33 @@ static struct
     SDL_realloc_func realloc_func;
     SDL_free_func free_func;
     SDL_atomic_t num_allocations;
+    SDL_bool tracking;
 } s_mem = {
-    real_malloc, real_calloc, real_realloc, real_free, { 0 }
+    real_malloc, real_calloc, real_realloc, real_free, { 0 }, SDL_FALSE
 };
 
+/* With memory tracking on, every block starts with its size and tag. The
+   header keeps the memory after it as aligned as the allocator made it. */
+typedef union SDL_MemoryHeader
+{
+    struct
+    {
+        size_t size;
+        SDL_MemoryTag tag;
+    } info;
+    Uint8 padding[16];
+} SDL_MemoryHeader;
+
+static const char *s_memory_tag_names[SDL_NUM_MEMORY_TAGS] = {
+    "other", "events", "video", "render", "audio"
+};
+
+static struct
+{
+    SDL_SpinLock lock;
+    SDL_MemoryStats stats;
+} s_memory_tags[SDL_NUM_MEMORY_TAGS];
+
 void SDL_GetOriginalMemoryFunctions(SDL_malloc_func *malloc_func,
                                     SDL_calloc_func *calloc_func,
                                     SDL_realloc_func *realloc_func,
@@ -5284,7 +5307,89 @@ int SDL_GetNumAllocations(void)
     return SDL_AtomicGet(&s_mem.num_allocations);
 }
 
-void *SDL_malloc(size_t size)
+static void SDL_UpdateMemoryStats(SDL_MemoryTag tag, size_t added, size_t removed, int count)
+{
+    SDL_MemoryStats *stats = &s_memory_tags[tag].stats;
+
+    SDL_AtomicLock(&s_memory_tags[tag].lock);
+    stats->live_bytes = stats->live_bytes + added - removed;
+    if (stats->live_bytes > stats->peak_bytes) {
+        stats->peak_bytes = stats->live_bytes;
+    }
+    stats->live_allocations += count;
+    if (count > 0) {
+        stats->total_allocations += count;
+    }
+    SDL_AtomicUnlock(&s_memory_tags[tag].lock);
+}
+
+static void *SDL_TrackedAlloc(SDL_MemoryTag tag, size_t size, SDL_bool zero)
+{
+    SDL_MemoryHeader *header;
+    size_t total;
+
+    if (SDL_size_add_overflow(size, sizeof(*header), &total)) {
+        return NULL;
+    }
+    if (zero) {
+        header = (SDL_MemoryHeader *)s_mem.calloc_func(1, total);
+    } else {
+        header = (SDL_MemoryHeader *)s_mem.malloc_func(total);
+    }
+    if (!header) {
+        return NULL;
+    }
+    header->info.size = size;
+    header->info.tag = tag;
+    SDL_UpdateMemoryStats(tag, size, 0, 1);
+    SDL_AtomicIncRef(&s_mem.num_allocations);
+    return header + 1;
+}
+
+/* A reallocated block keeps its tag unless a subsystem claims it */
+static void *SDL_TrackedRealloc(SDL_MemoryTag tag, SDL_bool retag, void *ptr, size_t size)
+{
+    SDL_MemoryHeader *header;
+    SDL_MemoryTag oldtag;
+    size_t oldsize, total;
+
+    if (!ptr) {
+        return SDL_TrackedAlloc(tag, size, SDL_FALSE);
+    }
+    if (SDL_size_add_overflow(size, sizeof(*header), &total)) {
+        return NULL;
+    }
+
+    header = (SDL_MemoryHeader *)ptr - 1;
+    oldsize = header->info.size;
+    oldtag = header->info.tag;
+    header = (SDL_MemoryHeader *)s_mem.realloc_func(header, total);
+    if (!header) {
+        return NULL;
+    }
+    if (!retag) {
+        tag = oldtag;
+    }
+    header->info.size = size;
+    header->info.tag = tag;
+    if (tag == oldtag) {
+        SDL_UpdateMemoryStats(tag, size, oldsize, 0);
+    } else {
+        SDL_UpdateMemoryStats(oldtag, 0, oldsize, -1);
+        SDL_UpdateMemoryStats(tag, size, 0, 1);
+    }
+    return header + 1;
+}
+
+static void SDL_TrackedFree(void *ptr)
+{
+    SDL_MemoryHeader *header = (SDL_MemoryHeader *)ptr - 1;
+
+    SDL_UpdateMemoryStats(header->info.tag, 0, header->info.size, -1);
+    s_mem.free_func(header);
+}
+
+void *SDL_TaggedMalloc(SDL_MemoryTag tag, size_t size)
 {
     void *mem;
 
@@ -5292,6 +5397,10 @@ void *SDL_malloc(size_t size)
         size = 1;
     }
 
+    if (s_mem.tracking) {
+        return SDL_TrackedAlloc(tag, size, SDL_FALSE);
+    }
+
     mem = s_mem.malloc_func(size);
     if (mem) {
         SDL_AtomicIncRef(&s_mem.num_allocations);
@@ -5299,7 +5408,7 @@ void *SDL_malloc(size_t size)
     return mem;
 }
 
-void *SDL_calloc(size_t nmemb, size_t size)
+void *SDL_TaggedCalloc(SDL_MemoryTag tag, size_t nmemb, size_t size)
 {
     void *mem;
 
@@ -5308,6 +5417,15 @@ void *SDL_calloc(size_t nmemb, size_t size)
         size = 1;
     }
 
+    if (s_mem.tracking) {
+        size_t total;
+
+        if (SDL_size_mul_overflow(nmemb, size, &total)) {
+            return NULL;
+        }
+        return SDL_TrackedAlloc(tag, total, SDL_TRUE);
+    }
+
     mem = s_mem.calloc_func(nmemb, size);
     if (mem) {
         SDL_AtomicIncRef(&s_mem.num_allocations);
@@ -5315,6 +5433,35 @@ void *SDL_calloc(size_t nmemb, size_t size)
     return mem;
 }
 
+void *SDL_TaggedRealloc(SDL_MemoryTag tag, void *ptr, size_t size)
+{
+    void *mem;
+
+    if (!ptr && !size) {
+        size = 1;
+    }
+
+    if (s_mem.tracking) {
+        return SDL_TrackedRealloc(tag, SDL_TRUE, ptr, size);
+    }
+
+    mem = s_mem.realloc_func(ptr, size);
+    if (mem && !ptr) {
+        SDL_AtomicIncRef(&s_mem.num_allocations);
+    }
+    return mem;
+}
+
+void *SDL_malloc(size_t size)
+{
+    return SDL_TaggedMalloc(SDL_MEMORY_TAG_OTHER, size);
+}
+
+void *SDL_calloc(size_t nmemb, size_t size)
+{
+    return SDL_TaggedCalloc(SDL_MEMORY_TAG_OTHER, nmemb, size);
+}
+
 void *SDL_realloc(void *ptr, size_t size)
 {
     void *mem;
@@ -5323,6 +5470,10 @@ void *SDL_realloc(void *ptr, size_t size)
         size = 1;
     }
 
+    if (s_mem.tracking) {
+        return SDL_TrackedRealloc(SDL_MEMORY_TAG_OTHER, SDL_FALSE, ptr, size);
+    }
+
     mem = s_mem.realloc_func(ptr, size);
     if (mem && !ptr) {
         SDL_AtomicIncRef(&s_mem.num_allocations);
@@ -5336,8 +5487,72 @@ void SDL_free(void *ptr)
         return;
     }
 
-    s_mem.free_func(ptr);
+    if (s_mem.tracking) {
+        SDL_TrackedFree(ptr);
+    } else {
+        s_mem.free_func(ptr);
+    }
     (void)SDL_AtomicDecRef(&s_mem.num_allocations);
 }
 
+int SDL_EnableMemoryTracking(void)
+{
+    if (s_mem.tracking) {
+        return 0;
+    }
+
+    /* Blocks allocated before don't have a header */
+    if (SDL_GetNumAllocations() != 0) {
+        return SDL_SetError("Memory tracking has to be enabled before SDL allocates memory");
+    }
+    s_mem.tracking = SDL_TRUE;
+    return 0;
+}
+
+int SDL_GetMemoryStats(SDL_MemoryTag tag, SDL_MemoryStats *stats)
+{
+    if ((int)tag < 0 || tag >= SDL_NUM_MEMORY_TAGS) {
+        return SDL_InvalidParamError("tag");
+    }
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+    if (!s_mem.tracking) {
+        return SDL_SetError("Memory tracking isn't enabled");
+    }
+
+    SDL_AtomicLock(&s_memory_tags[tag].lock);
+    *stats = s_memory_tags[tag].stats;
+    SDL_AtomicUnlock(&s_memory_tags[tag].lock);
+    return 0;
+}
+
+const char *SDL_GetMemoryTagName(SDL_MemoryTag tag)
+{
+    if ((int)tag < 0 || tag >= SDL_NUM_MEMORY_TAGS) {
+        return NULL;
+    }
+    return s_memory_tag_names[tag];
+}
+
+void SDL_LogMemoryStats(void)
+{
+    SDL_MemoryStats stats;
+    int i;
+
+    if (!s_mem.tracking) {
+        SDL_Log("SDL MEMORY: %d allocations, tracking isn't enabled\n", SDL_GetNumAllocations());
+        return;
+    }
+
+    for (i = 0; i < SDL_NUM_MEMORY_TAGS; ++i) {
+        SDL_AtomicLock(&s_memory_tags[i].lock);
+        stats = s_memory_tags[i].stats;
+        SDL_AtomicUnlock(&s_memory_tags[i].lock);
+        SDL_Log("SDL MEMORY: %-8s %12" SDL_PRIu64 " bytes in %8d allocations, peak %12" SDL_PRIu64 " bytes, %" SDL_PRIu64 " allocations in total\n",
+                s_memory_tag_names[i], (Uint64)stats.live_bytes, stats.live_allocations,
+                (Uint64)stats.peak_bytes, stats.total_allocations);
+    }
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
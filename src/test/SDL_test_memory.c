@@ -83,6 +83,7 @@ static SDL_calloc_func SDL_calloc_orig = NULL;
 static SDL_realloc_func SDL_realloc_orig = NULL;
 static SDL_free_func SDL_free_orig = NULL;
 static int s_previous_allocations = 0;
+static SDL_bool s_memory_tracking = SDL_FALSE;
 static SDL_tracked_allocation *s_tracked_allocations[256];
 static SDL_atomic_t s_lock;
 
@@ -276,6 +277,9 @@ int SDLTest_TrackAllocations(void)
     s_previous_allocations = SDL_GetNumAllocations();
     if (s_previous_allocations != 0) {
         SDL_Log("SDLTest_TrackAllocations(): There are %d previous allocations, disabling free() validation", s_previous_allocations);
+    } else {
+        /* The sizes we see include the header SDL adds to every block */
+        s_memory_tracking = (SDL_EnableMemoryTracking() == 0);
     }
 #ifdef SDLTEST_UNWIND_NO_PROC_NAME_BY_IP
     do {
@@ -416,6 +420,17 @@ void SDLTest_LogAllocations(void)
     }
     (void)SDL_snprintf(line, sizeof(line), "Total: %.2f Kb in %d allocations\n", total_allocated / 1024.0, count);
     ADD_LINE();
+
+    /* SDL knows which subsystems the allocations belong to */
+    for (index = 0; s_memory_tracking && index < SDL_NUM_MEMORY_TAGS; ++index) {
+        SDL_MemoryStats stats;
+
+        if (SDL_GetMemoryStats((SDL_MemoryTag)index, &stats) == 0 && stats.live_allocations) {
+            (void)SDL_snprintf(line, sizeof(line), "\t%s: %.2f Kb in %d allocations\n",
+                               SDL_GetMemoryTagName((SDL_MemoryTag)index), stats.live_bytes / 1024.0, stats.live_allocations);
+            ADD_LINE();
+        }
+    }
 #undef ADD_LINE
 
     SDL_Log("%s", message);
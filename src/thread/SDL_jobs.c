@@ -0,0 +1,636 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* A pool of job threads with work stealing, shared by the whole process */
+
+#include "SDL_thread.h"
+#include "SDL_thread_c.h"
+#include "SDL_systhread.h"
+#include "SDL_hints.h"
+#include "SDL_cpuinfo.h"
+
+/* Jobs a thread can keep in its own queue, must be a power of two */
+#define SDL_JOB_DEQUE_SIZE 256
+
+/* Most job threads SDL_HINT_JOB_THREADS can ask for */
+#define SDL_MAX_JOB_THREADS 256
+
+/* Times an idle thread looks for work before it goes to sleep */
+#define SDL_JOB_SPIN_COUNT 64
+
+typedef struct SDL_Job
+{
+    SDL_JobFunction fn;
+    void *userdata;
+    SDL_JobCounter *counter;
+    struct SDL_Job *next;
+} SDL_Job;
+
+struct SDL_JobCounter
+{
+    SDL_atomic_t value;
+    SDL_SpinLock lock;
+    SDL_Job *waiting; /* jobs started when the value drops to zero */
+};
+
+/* A Chase-Lev deque: the owning thread pushes and pops at the bottom,
+   the other threads steal from the top */
+typedef struct SDL_JobWorker
+{
+    SDL_atomic_t top;
+    Uint8 padding[64 - sizeof(SDL_atomic_t)]; /* keep thieves off the owner's cache line */
+    SDL_atomic_t bottom;
+    SDL_Job *slots[SDL_JOB_DEQUE_SIZE];
+    struct SDL_JobPool *pool;
+    SDL_Thread *thread;
+    Uint32 seed; /* picks the first thread to steal from */
+} SDL_JobWorker;
+
+typedef struct SDL_JobPool
+{
+    SDL_JobWorker *workers;
+    int num_workers;
+    SDL_ThreadPriority priority;
+    SDL_TLSID worker_tls;
+
+    /* Jobs queued by threads that aren't job threads */
+    SDL_SpinLock queue_lock;
+    SDL_Job *queue_head;
+    SDL_Job *queue_tail;
+
+    SDL_SpinLock free_lock;
+    SDL_Job *free_jobs;
+
+    SDL_atomic_t pending;  /* jobs that can be taken right now */
+    SDL_atomic_t sleepers; /* threads waiting on 'wakeup' */
+    SDL_mutex *lock;
+    SDL_cond *wakeup;
+    SDL_bool quit;
+} SDL_JobPool;
+
+static SDL_SpinLock SDL_job_pool_lock;
+static SDL_JobPool *SDL_job_pool;
+
+/* The ends only grow and wrap around, so they are compared by their difference */
+static SDL_bool SDL_PushWorkerJob(SDL_JobWorker *worker, SDL_Job *job)
+{
+    const Uint32 bottom = (Uint32)SDL_AtomicGet(&worker->bottom);
+    const Uint32 top = (Uint32)SDL_AtomicGet(&worker->top);
+
+    if ((Sint32)(bottom - top) >= SDL_JOB_DEQUE_SIZE) {
+        return SDL_FALSE;
+    }
+    worker->slots[bottom & (SDL_JOB_DEQUE_SIZE - 1)] = job;
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&worker->bottom, (int)(bottom + 1));
+    return SDL_TRUE;
+}
+
+static SDL_Job *SDL_PopWorkerJob(SDL_JobWorker *worker)
+{
+    /* The add is a full barrier, thieves see the new bottom before we read the top */
+    const Uint32 bottom = (Uint32)SDL_AtomicAdd(&worker->bottom, -1) - 1;
+    const Uint32 top = (Uint32)SDL_AtomicGet(&worker->top);
+    SDL_Job *job;
+
+    if ((Sint32)(bottom - top) < 0) {
+        SDL_AtomicSet(&worker->bottom, (int)(bottom + 1));
+        return NULL;
+    }
+    job = worker->slots[bottom & (SDL_JOB_DEQUE_SIZE - 1)];
+    if (bottom == top) {
+        /* The last job, race the thieves for it */
+        if (!SDL_AtomicCAS(&worker->top, (int)top, (int)(top + 1))) {
+            job = NULL;
+        }
+        SDL_AtomicSet(&worker->bottom, (int)(bottom + 1));
+    }
+    return job;
+}
+
+static SDL_Job *SDL_StealWorkerJob(SDL_JobWorker *worker)
+{
+    const Uint32 top = (Uint32)SDL_AtomicGet(&worker->top);
+    const Uint32 bottom = (Uint32)SDL_AtomicGet(&worker->bottom);
+    SDL_Job *job;
+
+    if ((Sint32)(bottom - top) <= 0) {
+        return NULL;
+    }
+    job = worker->slots[top & (SDL_JOB_DEQUE_SIZE - 1)];
+    if (!SDL_AtomicCAS(&worker->top, (int)top, (int)(top + 1))) {
+        return NULL;
+    }
+    return job;
+}
+
+static void SDL_PushJob(SDL_JobPool *pool, SDL_Job *job)
+{
+    SDL_JobWorker *worker = (SDL_JobWorker *)SDL_TLSGet(pool->worker_tls);
+
+    SDL_AtomicIncRef(&pool->pending);
+    if (!worker || !SDL_PushWorkerJob(worker, job)) {
+        job->next = NULL;
+        SDL_AtomicLock(&pool->queue_lock);
+        if (pool->queue_tail) {
+            pool->queue_tail->next = job;
+        } else {
+            pool->queue_head = job;
+        }
+        pool->queue_tail = job;
+        SDL_AtomicUnlock(&pool->queue_lock);
+    }
+
+    /* Sleepers count themselves before checking 'pending', one of us sees the other */
+    if (SDL_AtomicGet(&pool->sleepers) > 0) {
+        SDL_LockMutex(pool->lock);
+        SDL_CondSignal(pool->wakeup);
+        SDL_UnlockMutex(pool->lock);
+    }
+}
+
+/* Takes a job from the thread's own queue, the shared queue or another thread */
+static SDL_Job *SDL_TakeJob(SDL_JobPool *pool, SDL_JobWorker *worker)
+{
+    SDL_Job *job = NULL;
+    int i, first;
+
+    if (SDL_AtomicGet(&pool->pending) <= 0) {
+        return NULL;
+    }
+
+    if (worker) {
+        job = SDL_PopWorkerJob(worker);
+    }
+    if (!job && pool->queue_head) {
+        SDL_AtomicLock(&pool->queue_lock);
+        job = pool->queue_head;
+        if (job) {
+            pool->queue_head = job->next;
+            if (!pool->queue_head) {
+                pool->queue_tail = NULL;
+            }
+        }
+        SDL_AtomicUnlock(&pool->queue_lock);
+    }
+    if (!job && pool->num_workers > 0) {
+        if (worker) {
+            worker->seed = worker->seed * 1103515245 + 12345;
+            first = (int)((worker->seed >> 16) % pool->num_workers);
+        } else {
+            first = 0;
+        }
+        for (i = 0; i < pool->num_workers && !job; i++) {
+            SDL_JobWorker *victim = &pool->workers[(first + i) % pool->num_workers];
+            if (victim != worker) {
+                job = SDL_StealWorkerJob(victim);
+            }
+        }
+    }
+
+    if (job) {
+        SDL_AtomicAdd(&pool->pending, -1);
+    }
+    return job;
+}
+
+static SDL_Job *SDL_AllocJob(SDL_JobPool *pool)
+{
+    SDL_Job *job;
+
+    SDL_AtomicLock(&pool->free_lock);
+    job = pool->free_jobs;
+    if (job) {
+        pool->free_jobs = job->next;
+    }
+    SDL_AtomicUnlock(&pool->free_lock);
+
+    if (!job) {
+        job = (SDL_Job *)SDL_malloc(sizeof(*job));
+    }
+    return job;
+}
+
+static void SDL_FreeJob(SDL_JobPool *pool, SDL_Job *job)
+{
+    SDL_AtomicLock(&pool->free_lock);
+    job->next = pool->free_jobs;
+    pool->free_jobs = job;
+    SDL_AtomicUnlock(&pool->free_lock);
+}
+
+static void SDL_StartJob(SDL_JobPool *pool, SDL_Job *job);
+
+/* Wait for a SDL_FinishJobCounter() that took the counter to zero to let go
+   of it, after that the counter's owner may free it */
+static void SDL_ReleaseJobCounter(SDL_JobCounter *counter)
+{
+    SDL_AtomicLock(&counter->lock);
+    SDL_AtomicUnlock(&counter->lock);
+}
+
+static void SDL_FinishJobCounter(SDL_JobPool *pool, SDL_JobCounter *counter)
+{
+    SDL_Job *waiting = NULL, *next;
+    int value;
+
+    /* Only the last job needs the lock */
+    for (;;) {
+        value = SDL_AtomicGet(&counter->value);
+        if (value <= 1) {
+            break;
+        }
+        if (SDL_AtomicCAS(&counter->value, value, value - 1)) {
+            return;
+        }
+    }
+
+    /* Drop to zero and detach the waiting jobs in one step, the counter
+       isn't touched after the unlock since a waiter may free it then */
+    SDL_AtomicLock(&counter->lock);
+    if (SDL_AtomicDecRef(&counter->value)) {
+        waiting = counter->waiting;
+        counter->waiting = NULL;
+    }
+    SDL_AtomicUnlock(&counter->lock);
+
+    for (; waiting; waiting = next) {
+        next = waiting->next;
+        SDL_StartJob(pool, waiting);
+    }
+
+    /* Wake up anything waiting for the counter */
+    if (SDL_AtomicGet(&pool->sleepers) > 0) {
+        SDL_LockMutex(pool->lock);
+        SDL_CondBroadcast(pool->wakeup);
+        SDL_UnlockMutex(pool->lock);
+    }
+}
+
+static void SDL_ExecuteJob(SDL_JobPool *pool, SDL_Job *job)
+{
+    SDL_JobCounter *counter = job->counter;
+
+    job->fn(job->userdata);
+    SDL_FreeJob(pool, job);
+    if (counter) {
+        SDL_FinishJobCounter(pool, counter);
+    }
+}
+
+static void SDL_StartJob(SDL_JobPool *pool, SDL_Job *job)
+{
+    if (pool->num_workers == 0) {
+        SDL_ExecuteJob(pool, job);
+    } else {
+        SDL_PushJob(pool, job);
+    }
+}
+
+static int SDLCALL SDL_JobThread(void *arg)
+{
+    SDL_JobWorker *worker = (SDL_JobWorker *)arg;
+    SDL_JobPool *pool = worker->pool;
+    int spins = 0;
+
+    SDL_TLSSet(pool->worker_tls, worker, NULL);
+    if (pool->priority != SDL_THREAD_PRIORITY_NORMAL) {
+        SDL_SetThreadPriority(pool->priority);
+    }
+
+    for (;;) {
+        SDL_bool done;
+        SDL_Job *job = SDL_TakeJob(pool, worker);
+
+        if (job) {
+            SDL_ExecuteJob(pool, job);
+            spins = 0;
+            continue;
+        }
+        if (++spins < SDL_JOB_SPIN_COUNT) {
+            SDL_CPUPauseInstruction();
+            continue;
+        }
+        spins = 0;
+
+        SDL_LockMutex(pool->lock);
+        SDL_AtomicIncRef(&pool->sleepers);
+        while (SDL_AtomicGet(&pool->pending) <= 0 && !pool->quit) {
+            SDL_CondWait(pool->wakeup, pool->lock);
+        }
+        SDL_AtomicAdd(&pool->sleepers, -1);
+        done = pool->quit && SDL_AtomicGet(&pool->pending) <= 0;
+        SDL_UnlockMutex(pool->lock);
+        if (done) {
+            break;
+        }
+    }
+    return 0;
+}
+
+static SDL_ThreadPriority SDL_GetJobThreadPriority(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_JOB_THREAD_PRIORITY);
+
+    if (hint) {
+        if (SDL_strcasecmp(hint, "low") == 0) {
+            return SDL_THREAD_PRIORITY_LOW;
+        } else if (SDL_strcasecmp(hint, "high") == 0) {
+            return SDL_THREAD_PRIORITY_HIGH;
+        } else if (SDL_strcasecmp(hint, "time_critical") == 0) {
+            return SDL_THREAD_PRIORITY_TIME_CRITICAL;
+        }
+    }
+    return SDL_THREAD_PRIORITY_NORMAL;
+}
+
+static SDL_JobPool *SDL_CreateJobPool(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_JOB_THREADS);
+    SDL_JobPool *pool;
+    int i, num_workers;
+
+    if (hint && *hint) {
+        num_workers = SDL_clamp(SDL_atoi(hint), 0, SDL_MAX_JOB_THREADS);
+    } else {
+        num_workers = SDL_min(SDL_GetCPUCount() - 1, SDL_MAX_JOB_THREADS);
+    }
+#ifdef SDL_THREADS_DISABLED
+    num_workers = 0;
+#endif
+
+    pool = (SDL_JobPool *)SDL_calloc(1, sizeof(*pool));
+    if (!pool) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    pool->worker_tls = SDL_TLSCreate();
+    pool->priority = SDL_GetJobThreadPriority();
+    pool->lock = SDL_CreateMutex();
+    pool->wakeup = SDL_CreateCond();
+    if (num_workers > 0) {
+        pool->workers = (SDL_JobWorker *)SDL_calloc(num_workers, sizeof(*pool->workers));
+    }
+    if (!pool->lock || !pool->wakeup || (num_workers > 0 && !pool->workers)) {
+        SDL_DestroyCond(pool->wakeup);
+        SDL_DestroyMutex(pool->lock);
+        SDL_free(pool->workers);
+        SDL_free(pool);
+        return NULL;
+    }
+
+    for (i = 0; i < num_workers; i++) {
+        SDL_JobWorker *worker = &pool->workers[i];
+
+        worker->pool = pool;
+        worker->seed = (Uint32)i;
+        worker->thread = SDL_CreateThreadInternal(SDL_JobThread, "SDLJob", 0, worker);
+        if (!worker->thread) {
+            break;
+        }
+        pool->num_workers = i + 1;
+    }
+    return pool;
+}
+
+static SDL_JobPool *SDL_GetJobPool(void)
+{
+    SDL_JobPool *pool = (SDL_JobPool *)SDL_AtomicGetPtr((void **)&SDL_job_pool);
+
+    if (!pool) {
+        SDL_AtomicLock(&SDL_job_pool_lock);
+        pool = SDL_job_pool;
+        if (!pool) {
+            pool = SDL_CreateJobPool();
+            SDL_AtomicSetPtr((void **)&SDL_job_pool, pool);
+        }
+        SDL_AtomicUnlock(&SDL_job_pool_lock);
+    }
+    return pool;
+}
+
+SDL_JobCounter *SDL_CreateJobCounter(void)
+{
+    SDL_JobCounter *counter = (SDL_JobCounter *)SDL_calloc(1, sizeof(*counter));
+
+    if (!counter) {
+        SDL_OutOfMemory();
+    }
+    return counter;
+}
+
+int SDL_RunJob(SDL_JobFunction fn, void *userdata, SDL_JobCounter *counter, SDL_JobCounter *after)
+{
+    SDL_JobPool *pool;
+    SDL_Job *job;
+
+    if (!fn) {
+        return SDL_InvalidParamError("fn");
+    }
+    pool = SDL_GetJobPool();
+    if (!pool) {
+        return -1;
+    }
+    job = SDL_AllocJob(pool);
+    if (!job) {
+        return SDL_OutOfMemory();
+    }
+    job->fn = fn;
+    job->userdata = userdata;
+    job->counter = counter;
+    job->next = NULL;
+    if (counter) {
+        SDL_AtomicIncRef(&counter->value);
+    }
+
+    if (after) {
+        /* The counter takes the list under the lock after dropping to zero,
+           so either it sees this job or this sees the zero */
+        SDL_AtomicLock(&after->lock);
+        if (SDL_AtomicGet(&after->value) > 0) {
+            job->next = after->waiting;
+            after->waiting = job;
+            job = NULL;
+        }
+        SDL_AtomicUnlock(&after->lock);
+        if (!job) {
+            return 0;
+        }
+    }
+    SDL_StartJob(pool, job);
+    return 0;
+}
+
+int SDL_GetJobCounterValue(SDL_JobCounter *counter)
+{
+    if (!counter) {
+        return SDL_InvalidParamError("counter");
+    }
+    return SDL_AtomicGet(&counter->value);
+}
+
+void SDL_WaitJobCounter(SDL_JobCounter *counter)
+{
+    SDL_JobPool *pool;
+    SDL_JobWorker *worker;
+
+    if (!counter) {
+        return;
+    }
+    if (SDL_AtomicGet(&counter->value) <= 0) {
+        SDL_ReleaseJobCounter(counter);
+        return;
+    }
+    pool = SDL_job_pool; /* set up by the SDL_RunJob() that raised the counter */
+    worker = (SDL_JobWorker *)SDL_TLSGet(pool->worker_tls);
+
+    while (SDL_AtomicGet(&counter->value) > 0) {
+        SDL_Job *job = SDL_TakeJob(pool, worker);
+        if (job) {
+            SDL_ExecuteJob(pool, job);
+            continue;
+        }
+
+        SDL_LockMutex(pool->lock);
+        SDL_AtomicIncRef(&pool->sleepers);
+        while (SDL_AtomicGet(&counter->value) > 0 && SDL_AtomicGet(&pool->pending) <= 0) {
+            SDL_CondWait(pool->wakeup, pool->lock);
+        }
+        SDL_AtomicAdd(&pool->sleepers, -1);
+        SDL_UnlockMutex(pool->lock);
+    }
+    SDL_ReleaseJobCounter(counter);
+}
+
+void SDL_DestroyJobCounter(SDL_JobCounter *counter)
+{
+    if (counter) {
+        SDL_ReleaseJobCounter(counter);
+        SDL_free(counter);
+    }
+}
+
+typedef struct
+{
+    SDL_ParallelForFunction fn;
+    void *userdata;
+    int count;
+    int grain;
+    int num_parts;
+    SDL_atomic_t next_part;
+} SDL_ParallelForData;
+
+static void SDLCALL SDL_ParallelForJob(void *arg)
+{
+    SDL_ParallelForData *data = (SDL_ParallelForData *)arg;
+    int part;
+
+    while ((part = SDL_AtomicAdd(&data->next_part, 1)) < data->num_parts) {
+        const int first = part * data->grain;
+        data->fn(data->userdata, first, SDL_min(data->count - first, data->grain) + first);
+    }
+}
+
+int SDL_ParallelFor(SDL_ParallelForFunction fn, void *userdata, int count, int grain)
+{
+    SDL_ParallelForData data;
+    SDL_JobCounter counter;
+    SDL_JobPool *pool;
+    int i, helpers;
+
+    if (!fn) {
+        return SDL_InvalidParamError("fn");
+    }
+    if (count <= 0) {
+        return 0;
+    }
+    pool = SDL_GetJobPool();
+    if (!pool) {
+        return -1;
+    }
+    if (grain <= 0) {
+        /* A few parts per thread, so threads that start late still get some */
+        grain = SDL_max(count / ((pool->num_workers + 1) * 4), 1);
+    }
+
+    data.fn = fn;
+    data.userdata = userdata;
+    data.count = count;
+    data.grain = grain;
+    data.num_parts = count / grain + (count % grain != 0);
+    SDL_AtomicSet(&data.next_part, 0);
+
+    helpers = SDL_min(pool->num_workers, data.num_parts - 1);
+    if (helpers <= 0) {
+        fn(userdata, 0, count);
+        return 0;
+    }
+
+    SDL_zero(counter);
+    for (i = 0; i < helpers; i++) {
+        if (SDL_RunJob(SDL_ParallelForJob, &data, &counter, NULL) < 0) {
+            break; /* the parts are shared, this thread does the rest */
+        }
+    }
+    SDL_ParallelForJob(&data);
+    SDL_WaitJobCounter(&counter);
+    return 0;
+}
+
+int SDL_GetJobThreadCount(void)
+{
+    SDL_JobPool *pool = SDL_GetJobPool();
+
+    return pool ? pool->num_workers : 0;
+}
+
+void SDL_QuitJobs(void)
+{
+    SDL_JobPool *pool = SDL_job_pool;
+    SDL_Job *job;
+    int i;
+
+    if (!pool) {
+        return;
+    }
+
+    /* The threads run what is left in the queues before they stop */
+    SDL_LockMutex(pool->lock);
+    pool->quit = SDL_TRUE;
+    SDL_CondBroadcast(pool->wakeup);
+    SDL_UnlockMutex(pool->lock);
+    for (i = 0; i < pool->num_workers; i++) {
+        SDL_WaitThread(pool->workers[i].thread, NULL);
+    }
+
+    while ((job = pool->free_jobs) != NULL) {
+        pool->free_jobs = job->next;
+        SDL_free(job);
+    }
+    SDL_DestroyCond(pool->wakeup);
+    SDL_DestroyMutex(pool->lock);
+    SDL_free(pool->workers);
+    SDL_free(pool);
+    SDL_job_pool = NULL;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -105,6 +105,9 @@ extern SDL_TLSData *SDL_Generic_GetTLSData(void);
 extern int SDL_Generic_SetTLSData(SDL_TLSData *data);
 extern void SDL_Generic_QuitTLSData(void);
 
+/* Stops the job threads of SDL_RunJob() */
+extern void SDL_QuitJobs(void);
+
 #endif /* SDL_thread_c_h_ */
 
 /* vi: set ts=4 sw=4 expandtab: */
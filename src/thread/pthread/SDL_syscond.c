@@ -29,6 +29,107 @@
 #include "SDL_thread.h"
 #include "SDL_sysmutex_c.h"
 
+#ifdef SDL_THREAD_PTHREAD_FUTEX
+
+struct SDL_cond
+{
+    SDL_atomic_t sequence; /* changes on every signal, the waiters sleep on it */
+    SDL_atomic_t waiters;
+};
+
+/* Create a condition variable */
+SDL_cond *SDL_CreateCond(void)
+{
+    SDL_cond *cond = (SDL_cond *)SDL_calloc(1, sizeof(SDL_cond));
+
+    if (!cond) {
+        SDL_OutOfMemory();
+    }
+    return cond;
+}
+
+/* Destroy a condition variable */
+void SDL_DestroyCond(SDL_cond *cond)
+{
+    SDL_free(cond);
+}
+
+/* Restart one of the threads that are waiting on the condition variable */
+int SDL_CondSignal(SDL_cond *cond)
+{
+    if (!cond) {
+        return SDL_InvalidParamError("cond");
+    }
+
+    if (SDL_FutexGet(&cond->waiters) > 0) {
+        SDL_AtomicIncRef(&cond->sequence);
+        SDL_FutexWake(&cond->sequence, 1);
+    }
+    return 0;
+}
+
+/* Restart all threads that are waiting on the condition variable */
+int SDL_CondBroadcast(SDL_cond *cond)
+{
+    if (!cond) {
+        return SDL_InvalidParamError("cond");
+    }
+
+    if (SDL_FutexGet(&cond->waiters) > 0) {
+        SDL_AtomicIncRef(&cond->sequence);
+        SDL_FutexWake(&cond->sequence, INT_MAX);
+    }
+    return 0;
+}
+
+int SDL_CondWaitTimeout(SDL_cond *cond, SDL_mutex *mutex, Uint32 ms)
+{
+    struct timespec timeout;
+    int sequence, recursive;
+    int retval = 0;
+
+    if (!cond) {
+        return SDL_InvalidParamError("cond");
+    }
+    if (!mutex) {
+        return SDL_InvalidParamError("mutex");
+    }
+
+    /* Read under the mutex, so a signal sent after the caller checked its
+       condition changes the sequence before we sleep on it */
+    sequence = SDL_FutexGet(&cond->sequence);
+    SDL_AtomicIncRef(&cond->waiters);
+
+    /* Release the mutex completely, even if it is locked recursively */
+    recursive = mutex->recursive;
+    mutex->recursive = 0;
+    SDL_UnlockMutex(mutex);
+
+    if (ms == SDL_MUTEX_MAXWAIT) {
+        SDL_FutexWait(&cond->sequence, sequence, NULL);
+    } else {
+        SDL_FutexTimeout(ms, &timeout);
+        if (SDL_FutexWait(&cond->sequence, sequence, &timeout) < 0 && errno == ETIMEDOUT) {
+            retval = SDL_MUTEX_TIMEDOUT;
+        }
+    }
+
+    SDL_AtomicAdd(&cond->waiters, -1);
+    SDL_LockMutex(mutex);
+    mutex->recursive = recursive;
+    return retval;
+}
+
+/* Wait on the condition variable, unlocking the provided mutex.
+   The mutex must be locked before entering this function!
+ */
+int SDL_CondWait(SDL_cond *cond, SDL_mutex *mutex)
+{
+    return SDL_CondWaitTimeout(cond, mutex, SDL_MUTEX_MAXWAIT);
+}
+
+#else
+
 struct SDL_cond
 {
     pthread_cond_t cond;
@@ -149,4 +250,6 @@ int SDL_CondWait(SDL_cond *cond, SDL_mutex *mutex)
     return 0;
 }
 
+#endif /* SDL_THREAD_PTHREAD_FUTEX */
+
 /* vi: set ts=4 sw=4 expandtab: */
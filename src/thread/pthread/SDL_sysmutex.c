@@ -24,20 +24,127 @@
 #include <pthread.h>
 
 #include "SDL_thread.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_sysmutex_c.h"
 
-#if !(defined(SDL_THREAD_PTHREAD_RECURSIVE_MUTEX) || \
-    defined(SDL_THREAD_PTHREAD_RECURSIVE_MUTEX_NP))
-#define FAKE_RECURSIVE_MUTEX
-#endif
+#ifdef SDL_THREAD_PTHREAD_FUTEX
 
-struct SDL_mutex
+int SDL_GetFutexSpinLimit(void)
 {
-    pthread_mutex_t id;
-#ifdef FAKE_RECURSIVE_MUTEX
-    int recursive;
-    pthread_t owner;
-#endif
-};
+    static int spin_limit = -1;
+
+    if (spin_limit < 0) {
+        /* Spinning only helps when the owner runs on another core */
+        spin_limit = (SDL_GetCPUCount() > 1) ? SDL_FUTEX_MAX_SPINS : 0;
+    }
+    return spin_limit;
+}
+
+SDL_mutex *SDL_CreateMutex(void)
+{
+    SDL_mutex *mutex = (SDL_mutex *)SDL_calloc(1, sizeof(*mutex));
+
+    if (!mutex) {
+        SDL_OutOfMemory();
+    }
+    return mutex;
+}
+
+void SDL_DestroyMutex(SDL_mutex *mutex)
+{
+    SDL_free(mutex);
+}
+
+/* The lock is busy: retry for about as long as it took recently, then sleep */
+static void SDL_LockMutexContended(SDL_mutex *mutex)
+{
+    const int limit = SDL_min(SDL_GetFutexSpinLimit(), mutex->spins * 2 + 10);
+    int spins;
+
+    for (spins = 0; spins < limit; ++spins) {
+        SDL_CPUPauseInstruction();
+        if (SDL_FutexGet(&mutex->state) == 0 && SDL_FutexCAS(&mutex->state, 0, 1)) {
+            break;
+        }
+    }
+    if (spins == limit) {
+        /* Mark the lock as having sleepers, so the owner wakes one up when done */
+        while (SDL_AtomicSet(&mutex->state, 2) != 0) {
+            SDL_FutexWait(&mutex->state, 2, NULL);
+        }
+    }
+
+    /* Only the owner updates the average */
+    mutex->spins += (spins - mutex->spins) / 8;
+}
+
+/* Lock the mutex */
+int SDL_LockMutex(SDL_mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS /* clang doesn't know about NULL mutexes */
+{
+    pthread_t this_thread;
+
+    if (mutex == NULL) {
+        return 0;
+    }
+
+    this_thread = pthread_self();
+    if (mutex->owner == this_thread) {
+        ++mutex->recursive;
+        return 0;
+    }
+    if (!SDL_FutexCAS(&mutex->state, 0, 1)) {
+        SDL_LockMutexContended(mutex);
+    }
+    mutex->owner = this_thread;
+    mutex->recursive = 0;
+    return 0;
+}
+
+int SDL_TryLockMutex(SDL_mutex *mutex)
+{
+    pthread_t this_thread;
+
+    if (!mutex) {
+        return 0;
+    }
+
+    this_thread = pthread_self();
+    if (mutex->owner == this_thread) {
+        ++mutex->recursive;
+        return 0;
+    }
+    if (!SDL_FutexCAS(&mutex->state, 0, 1)) {
+        return SDL_MUTEX_TIMEDOUT;
+    }
+    mutex->owner = this_thread;
+    mutex->recursive = 0;
+    return 0;
+}
+
+int SDL_UnlockMutex(SDL_mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS /* clang doesn't know about NULL mutexes */
+{
+    if (mutex == NULL) {
+        return 0;
+    }
+
+    /* We can only unlock the mutex if we own it */
+    if (mutex->owner != pthread_self()) {
+        return SDL_SetError("mutex not owned by this thread");
+    }
+    if (mutex->recursive) {
+        --mutex->recursive;
+        return 0;
+    }
+
+    mutex->owner = 0;
+    if (SDL_FutexRelease(&mutex->state, 0) == 2) {
+        /* Somebody is sleeping on the lock */
+        SDL_FutexWake(&mutex->state, 1);
+    }
+    return 0;
+}
+
+#else
 
 SDL_mutex *SDL_CreateMutex(void)
 {
@@ -187,4 +294,6 @@ int SDL_UnlockMutex(SDL_mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS /* clang doe
     return 0;
 }
 
+#endif /* SDL_THREAD_PTHREAD_FUTEX */
+
 /* vi: set ts=4 sw=4 expandtab: */
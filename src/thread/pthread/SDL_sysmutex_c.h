@@ -23,10 +23,79 @@
 #ifndef SDL_mutex_c_h_
 #define SDL_mutex_c_h_
 
+/* On Linux the mutexes, semaphores and condition variables are built
+   directly on futexes, so they never enter the kernel when uncontended */
+#if defined(__LINUX__) && !defined(SDL_THREAD_PTHREAD_NO_FUTEX)
+#include <sys/syscall.h>
+#ifdef SYS_futex
+#define SDL_THREAD_PTHREAD_FUTEX 1
+#endif
+#endif
+
+#ifdef SDL_THREAD_PTHREAD_FUTEX
+
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+
+#include "SDL_atomic.h"
+
+/* Most times a thread retries a busy lock before it sleeps */
+#define SDL_FUTEX_MAX_SPINS 100
+
+struct SDL_mutex
+{
+    SDL_atomic_t state; /* 0 unlocked, 1 locked, 2 locked with sleeping threads */
+    pthread_t owner;
+    int recursive;
+    int spins; /* running average of the retries it took to get the lock */
+};
+
+/* Inlined on the uncontended paths, the SDL_Atomic functions are calls */
+#define SDL_FutexCAS(a, oldval, newval) __sync_bool_compare_and_swap(&(a)->value, oldval, newval)
+#define SDL_FutexAdd(a, v)              __sync_fetch_and_add(&(a)->value, v)
+#define SDL_FutexGet(a)                 __atomic_load_n(&(a)->value, __ATOMIC_SEQ_CST)
+#define SDL_FutexRelease(a, v)          __atomic_exchange_n(&(a)->value, v, __ATOMIC_RELEASE)
+
+/* Sleeps while 'addr' holds 'value', returns 0 or -1 with errno set */
+static SDL_INLINE int SDL_FutexWait(SDL_atomic_t *addr, int value, const struct timespec *timeout)
+{
+    return (int)syscall(SYS_futex, &addr->value, FUTEX_WAIT_PRIVATE, value, timeout, NULL, 0);
+}
+
+static SDL_INLINE void SDL_FutexWake(SDL_atomic_t *addr, int count)
+{
+    syscall(SYS_futex, &addr->value, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+
+static SDL_INLINE void SDL_FutexTimeout(Uint32 ms, struct timespec *timeout)
+{
+    timeout->tv_sec = ms / 1000;
+    timeout->tv_nsec = (long)(ms % 1000) * 1000000;
+}
+
+/* How many times to retry before sleeping, nothing on a single core */
+extern int SDL_GetFutexSpinLimit(void);
+
+#else
+
+#if !(defined(SDL_THREAD_PTHREAD_RECURSIVE_MUTEX) || \
+    defined(SDL_THREAD_PTHREAD_RECURSIVE_MUTEX_NP))
+#define FAKE_RECURSIVE_MUTEX
+#endif
+
 struct SDL_mutex
 {
     pthread_mutex_t id;
+#ifdef FAKE_RECURSIVE_MUTEX
+    int recursive;
+    pthread_t owner;
+#endif
 };
 
+#endif /* SDL_THREAD_PTHREAD_FUTEX */
+
 #endif /* SDL_mutex_c_h_ */
 /* vi: set ts=4 sw=4 expandtab: */
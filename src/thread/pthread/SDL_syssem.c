@@ -28,12 +28,135 @@
 
 #include "SDL_thread.h"
 #include "SDL_timer.h"
+#include "SDL_sysmutex_c.h"
 
 /* Wrapper around POSIX 1003.1b semaphores */
 
 #if defined(__MACOSX__) || defined(__IPHONEOS__)
 /* Mac OS X doesn't support sem_getvalue() as of version 10.4 */
 #include "../generic/SDL_syssem.c"
+#elif defined(SDL_THREAD_PTHREAD_FUTEX)
+
+struct SDL_semaphore
+{
+    SDL_atomic_t count;
+    SDL_atomic_t waiters;
+};
+
+/* Create a semaphore, initialized with value */
+SDL_sem *SDL_CreateSemaphore(Uint32 initial_value)
+{
+    SDL_sem *sem = (SDL_sem *)SDL_calloc(1, sizeof(SDL_sem));
+    if (sem) {
+        SDL_AtomicSet(&sem->count, (int)initial_value);
+    } else {
+        SDL_OutOfMemory();
+    }
+    return sem;
+}
+
+void SDL_DestroySemaphore(SDL_sem *sem)
+{
+    SDL_free(sem);
+}
+
+int SDL_SemTryWait(SDL_sem *sem)
+{
+    int count;
+
+    if (!sem) {
+        return SDL_InvalidParamError("sem");
+    }
+
+    count = SDL_FutexGet(&sem->count);
+    while (count > 0) {
+        if (SDL_FutexCAS(&sem->count, count, count - 1)) {
+            return 0;
+        }
+        count = SDL_FutexGet(&sem->count);
+    }
+    return SDL_MUTEX_TIMEDOUT;
+}
+
+int SDL_SemWaitTimeout(SDL_sem *sem, Uint32 timeout)
+{
+    const int spin_limit = SDL_GetFutexSpinLimit();
+    struct timespec ts_timeout;
+    Uint64 deadline = 0;
+    int i, retval;
+
+    if (!sem) {
+        return SDL_InvalidParamError("sem");
+    }
+
+    /* Try the easy cases first */
+    if (SDL_SemTryWait(sem) == 0) {
+        return 0;
+    }
+    if (timeout == 0) {
+        return SDL_MUTEX_TIMEDOUT;
+    }
+    for (i = 0; i < spin_limit; ++i) {
+        SDL_CPUPauseInstruction();
+        if (SDL_FutexGet(&sem->count) > 0 && SDL_SemTryWait(sem) == 0) {
+            return 0;
+        }
+    }
+
+    if (timeout != SDL_MUTEX_MAXWAIT) {
+        deadline = SDL_GetTicks64() + timeout;
+    }
+
+    /* Posting checks for waiters after raising the count, and we check the
+       count after counting ourselves, so one of us sees the other */
+    SDL_AtomicIncRef(&sem->waiters);
+    for (;;) {
+        retval = SDL_SemTryWait(sem);
+        if (retval == 0) {
+            break;
+        }
+        if (timeout == SDL_MUTEX_MAXWAIT) {
+            SDL_FutexWait(&sem->count, 0, NULL);
+        } else {
+            const Uint64 now = SDL_GetTicks64();
+            if (now >= deadline) {
+                break;
+            }
+            SDL_FutexTimeout((Uint32)(deadline - now), &ts_timeout);
+            SDL_FutexWait(&sem->count, 0, &ts_timeout);
+        }
+    }
+    SDL_AtomicAdd(&sem->waiters, -1);
+    return retval;
+}
+
+int SDL_SemWait(SDL_sem *sem)
+{
+    return SDL_SemWaitTimeout(sem, SDL_MUTEX_MAXWAIT);
+}
+
+Uint32 SDL_SemValue(SDL_sem *sem)
+{
+    if (!sem) {
+        SDL_InvalidParamError("sem");
+        return 0;
+    }
+    return (Uint32)SDL_max(SDL_FutexGet(&sem->count), 0);
+}
+
+int SDL_SemPost(SDL_sem *sem)
+{
+    if (!sem) {
+        return SDL_InvalidParamError("sem");
+    }
+
+    SDL_FutexAdd(&sem->count, 1);
+    if (SDL_FutexGet(&sem->waiters) > 0) {
+        SDL_FutexWake(&sem->count, 1);
+    }
+    return 0;
+}
+
 #else
 
 struct SDL_semaphore
@@ -25,36 +25,65 @@
 #include "SDL_atomic.h"
 #include "SDL_cpuinfo.h"
 #include "../thread/SDL_systhread.h"
+#include "../SDL_slab.h"
 
 /* #define DEBUG_TIMERS */
 
+/* The performance counter converted to nanoseconds, without overflowing
+   the intermediate product for any realistic counter frequency */
+static Uint64 SDL_GetTimerTicksNS(void)
+{
+    const Uint64 counter = SDL_GetPerformanceCounter();
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+
+    return (counter / frequency) * SDL_NS_PER_SECOND + ((counter % frequency) * SDL_NS_PER_SECOND) / frequency;
+}
+
 #if !defined(__EMSCRIPTEN__) || !defined(SDL_THREADS_DISABLED)
 
 typedef struct _SDL_Timer
 {
     int timerID;
-    SDL_TimerCallback callback;
+    SDL_TimerCallback callback;       /* millisecond timer, or ... */
+    SDL_NSTimerCallback callback_ns; /* ... nanosecond timer */
     void *param;
-    Uint32 interval;
-    Uint32 scheduled;
+    Uint64 interval;  /* in the units of the callback */
+    Uint64 scheduled; /* in nanoseconds */
     SDL_atomic_t canceled;
-    struct _SDL_Timer *next;
+    struct _SDL_Timer *next;    /* pending or freelist link */
+    struct _SDL_Timer *mapnext; /* timer map bucket chain */
 } SDL_Timer;
 
-typedef struct _SDL_TimerMap
+SDL_SLAB_SITE(SDL_timer_site, "timers", SDL_MEMORY_TAG_OTHER);
+
+/* A heap slot keeps the sort key next to the timer, so sifting doesn't
+   have to touch the timers themselves */
+typedef struct
 {
-    int timerID;
+    Uint64 scheduled;
+    Uint32 order;
     SDL_Timer *timer;
-    struct _SDL_TimerMap *next;
-} SDL_TimerMap;
+} SDL_TimerHeapEntry;
 
-/* The timers are kept in a sorted list */
+/* Number of children of each heap node, a wider heap is shallower and
+   its children share cache lines */
+#define SDL_TIMER_HEAP_ARITY 4
+
+/* Initial number of timer map buckets, always a power of two */
+#define SDL_TIMERMAP_MIN_SIZE 64
+
+/* Canceled timers are left in the heap until enough of them pile up */
+#define SDL_TIMER_PRUNE_THRESHOLD 64
+
+/* The timers are kept in a min-heap ordered by scheduling time */
 typedef struct
 {
     /* Data used by the main thread */
     SDL_Thread *thread;
     SDL_atomic_t nextID;
-    SDL_TimerMap *timermap;
+    SDL_Timer **timermap;
+    Uint32 timermap_size;
+    Uint32 timermap_count;
     SDL_mutex *timermap_lock;
 
     /* Padding to separate cache lines between threads */
@@ -66,9 +95,13 @@ typedef struct
     SDL_Timer *pending;
     SDL_Timer *freelist;
     SDL_atomic_t active;
+    SDL_atomic_t canceled; /* timers canceled by SDL_RemoveTimer() but still queued */
 
-    /* List of timers - this is only touched by the timer thread */
-    SDL_Timer *timers;
+    /* Heap of timers - this is only touched by the timer thread */
+    SDL_TimerHeapEntry *heap;
+    int heap_count;
+    int heap_size;
+    Uint32 heap_order;
 } SDL_TimerData;
 
 static SDL_TimerData SDL_timer_data;
@@ -76,27 +109,167 @@ static SDL_TimerData SDL_timer_data;
 /* The idea here is that any thread might add a timer, but a single
  * thread manages the active timer queue, sorted by scheduling time.
  *
- * Timers are removed by simply setting a canceled flag
+ * Timers are removed by simply setting a canceled flag; the timer thread
+ * drops them when they reach the top of the heap, or all at once when a
+ * large share of the heap has been canceled.
  */
 
-static void SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+static SDL_bool SDL_TimerHeapLess(const SDL_TimerHeapEntry *a, const SDL_TimerHeapEntry *b)
+{
+    /* Timers scheduled for the same time fire in the order they were queued */
+    if (a->scheduled != b->scheduled) {
+        return (a->scheduled < b->scheduled);
+    }
+    return ((Sint32)(a->order - b->order) < 0);
+}
+
+static void SDL_SiftTimerUp(SDL_TimerHeapEntry *heap, int i)
 {
-    SDL_Timer *prev, *curr;
+    const SDL_TimerHeapEntry entry = heap[i];
 
-    prev = NULL;
-    for (curr = data->timers; curr; prev = curr, curr = curr->next) {
-        if ((Sint32)(timer->scheduled - curr->scheduled) < 0) {
+    while (i > 0) {
+        const int parent = (i - 1) / SDL_TIMER_HEAP_ARITY;
+        if (!SDL_TimerHeapLess(&entry, &heap[parent])) {
             break;
         }
+        heap[i] = heap[parent];
+        i = parent;
     }
+    heap[i] = entry;
+}
 
-    /* Insert the timer here! */
-    if (prev) {
-        prev->next = timer;
+static void SDL_SiftTimerDown(SDL_TimerHeapEntry *heap, int count, int i)
+{
+    const SDL_TimerHeapEntry entry = heap[i];
+
+    for (;;) {
+        const int first = i * SDL_TIMER_HEAP_ARITY + 1;
+        const int last = SDL_min(first + SDL_TIMER_HEAP_ARITY, count);
+        int child, best = -1;
+
+        for (child = first; child < last; ++child) {
+            if (best < 0 || SDL_TimerHeapLess(&heap[child], &heap[best])) {
+                best = child;
+            }
+        }
+        if (best < 0 || !SDL_TimerHeapLess(&heap[best], &entry)) {
+            break;
+        }
+        heap[i] = heap[best];
+        i = best;
+    }
+    heap[i] = entry;
+}
+
+static SDL_bool SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+{
+    SDL_TimerHeapEntry *entry;
+
+    if (data->heap_count == data->heap_size) {
+        const int size = data->heap_size ? (data->heap_size * 2) : 256;
+        SDL_TimerHeapEntry *heap = (SDL_TimerHeapEntry *)SDL_realloc(data->heap, size * sizeof(*heap));
+        if (!heap) {
+            return SDL_FALSE;
+        }
+        data->heap = heap;
+        data->heap_size = size;
+    }
+
+    entry = &data->heap[data->heap_count];
+    entry->scheduled = timer->scheduled;
+    entry->order = data->heap_order++;
+    entry->timer = timer;
+    SDL_SiftTimerUp(data->heap, data->heap_count++);
+    return SDL_TRUE;
+}
+
+/* Move the timer at the top of the heap to its new scheduling time */
+static void SDL_RescheduleFirstTimer(SDL_TimerData *data)
+{
+    SDL_TimerHeapEntry *entry = &data->heap[0];
+
+    entry->scheduled = entry->timer->scheduled;
+    entry->order = data->heap_order++;
+    SDL_SiftTimerDown(data->heap, data->heap_count, 0);
+}
+
+static void SDL_RemoveFirstTimer(SDL_TimerData *data)
+{
+    if (--data->heap_count > 0) {
+        data->heap[0] = data->heap[data->heap_count];
+        SDL_SiftTimerDown(data->heap, data->heap_count, 0);
+    }
+}
+
+/* Mark a timer as finished and queue it for reuse */
+static void SDL_RetireTimer(SDL_TimerData *data, SDL_Timer *timer, SDL_Timer **freelist_head, SDL_Timer **freelist_tail)
+{
+    if (!SDL_AtomicCAS(&timer->canceled, 0, 1)) {
+        /* It was canceled by SDL_RemoveTimer() while still queued */
+        SDL_AtomicAdd(&data->canceled, -1);
+    }
+
+    timer->next = NULL;
+    if (!*freelist_head) {
+        *freelist_head = timer;
+    }
+    if (*freelist_tail) {
+        (*freelist_tail)->next = timer;
+    }
+    *freelist_tail = timer;
+}
+
+/* Drop all the canceled timers from the heap in one pass */
+static void SDL_PruneCanceledTimers(SDL_TimerData *data, SDL_Timer **freelist_head, SDL_Timer **freelist_tail)
+{
+    int i, count = 0;
+
+    for (i = 0; i < data->heap_count; ++i) {
+        SDL_Timer *timer = data->heap[i].timer;
+        if (SDL_AtomicGet(&timer->canceled)) {
+            SDL_RetireTimer(data, timer, freelist_head, freelist_tail);
+        } else {
+            data->heap[count++] = data->heap[i];
+        }
+    }
+    data->heap_count = count;
+
+    for (i = (count - 2) / SDL_TIMER_HEAP_ARITY; i >= 0; --i) {
+        SDL_SiftTimerDown(data->heap, count, i);
+    }
+}
+
+/* Work out the next deadline of a timer that just ran at 'tick' */
+static void SDL_ScheduleNextTimer(SDL_Timer *timer, Uint64 interval, Uint64 tick)
+{
+    timer->interval = interval;
+    if (timer->callback_ns) {
+        /* Count from the previous deadline so periodic timers don't drift,
+           skipping any whole intervals we've fallen behind by */
+        timer->scheduled += interval;
+        if (tick > timer->scheduled) {
+            timer->scheduled += ((tick - timer->scheduled) / interval) * interval;
+        }
     } else {
-        data->timers = timer;
+        timer->scheduled = tick + interval * SDL_NS_PER_MS;
+    }
+}
+
+/* Sleep for up to 'delay' nanoseconds or until a timer is added */
+static void SDL_WaitTimerThread(SDL_TimerData *data, Uint64 delay, SDL_bool precise)
+{
+    if (delay == SDL_MAX_UINT64) {
+        SDL_SemWaitTimeout(data->sem, SDL_MUTEX_MAXWAIT);
+    } else if (!precise) {
+        /* Millisecond timers never fire early */
+        SDL_SemWaitTimeout(data->sem, (Uint32)SDL_min((delay + SDL_NS_PER_MS - 1) / SDL_NS_PER_MS, SDL_MUTEX_MAXWAIT - 1));
+    } else if (delay >= SDL_NS_PER_MS) {
+        /* Wake up a bit early and close the remaining gap below */
+        SDL_SemWaitTimeout(data->sem, (Uint32)SDL_min(delay / SDL_NS_PER_MS, SDL_MUTEX_MAXWAIT - 1));
+    } else if (SDL_SemTryWait(data->sem) != 0) {
+        /* Less than the OS can reliably sleep, just give up our timeslice */
+        SDL_Delay(0);
     }
-    timer->next = curr;
 }
 
 static int SDLCALL SDL_TimerThread(void *_data)
@@ -104,9 +277,11 @@ static int SDLCALL SDL_TimerThread(void *_data)
     SDL_TimerData *data = (SDL_TimerData *)_data;
     SDL_Timer *pending;
     SDL_Timer *current;
+    SDL_Timer *deferred;
     SDL_Timer *freelist_head = NULL;
     SDL_Timer *freelist_tail = NULL;
-    Uint32 tick, now, interval, delay;
+    Uint64 tick, now, interval, delay;
+    SDL_bool precise;
 
     /* Threaded timer loop:
      *  1. Queue timers added by other threads
@@ -129,11 +304,16 @@ static int SDLCALL SDL_TimerThread(void *_data)
         }
         SDL_AtomicUnlock(&data->lock);
 
-        /* Sort the pending timers into our list */
+        /* Add the pending timers to our heap */
+        deferred = NULL;
         while (pending) {
             current = pending;
             pending = pending->next;
-            SDL_AddTimerInternal(data, current);
+            if (!SDL_AddTimerInternal(data, current)) {
+                /* Out of memory, try again on the next cycle */
+                current->next = deferred;
+                deferred = current;
+            }
         }
         freelist_head = NULL;
         freelist_tail = NULL;
@@ -143,55 +323,67 @@ static int SDLCALL SDL_TimerThread(void *_data)
             break;
         }
 
+        /* Clean up after mass cancellation so the heap doesn't fill up with dead timers */
+        if (data->heap_count >= SDL_TIMER_PRUNE_THRESHOLD &&
+            SDL_AtomicGet(&data->canceled) > data->heap_count / 2) {
+            SDL_PruneCanceledTimers(data, &freelist_head, &freelist_tail);
+        }
+
         /* Initial delay if there are no timers */
-        delay = SDL_MUTEX_MAXWAIT;
+        delay = deferred ? SDL_NS_PER_MS : SDL_MAX_UINT64;
+        precise = SDL_FALSE;
 
-        tick = SDL_GetTicks();
+        tick = SDL_GetTimerTicksNS();
 
         /* Process all the pending timers for this tick */
-        while (data->timers) {
-            current = data->timers;
+        while (data->heap_count > 0) {
+            current = data->heap[0].timer;
 
-            if ((Sint32)(tick - current->scheduled) < 0) {
+            if (tick < data->heap[0].scheduled) {
                 /* Scheduled for the future, wait a bit */
-                delay = (current->scheduled - tick);
+                delay = SDL_min(delay, data->heap[0].scheduled - tick);
+                precise = (current->callback_ns != NULL);
                 break;
             }
 
-            /* We're going to do something with this timer */
-            data->timers = current->next;
-
             if (SDL_AtomicGet(&current->canceled)) {
                 interval = 0;
+            } else if (current->callback_ns) {
+                interval = current->callback_ns(current->interval, current->param);
             } else {
-                interval = current->callback(current->interval, current->param);
+                interval = current->callback((Uint32)current->interval, current->param);
             }
 
             if (interval > 0) {
                 /* Reschedule this timer */
-                current->interval = interval;
-                current->scheduled = tick + interval;
-                SDL_AddTimerInternal(data, current);
+                SDL_ScheduleNextTimer(current, interval, tick);
+                SDL_RescheduleFirstTimer(data);
             } else {
-                if (!freelist_head) {
-                    freelist_head = current;
-                }
-                if (freelist_tail) {
-                    freelist_tail->next = current;
-                }
-                freelist_tail = current;
+                SDL_RemoveFirstTimer(data);
+                SDL_RetireTimer(data, current, &freelist_head, &freelist_tail);
+            }
+        }
 
-                SDL_AtomicSet(&current->canceled, 1);
+        if (deferred) {
+            SDL_AtomicLock(&data->lock);
+            while (deferred) {
+                current = deferred;
+                deferred = deferred->next;
+                current->next = data->pending;
+                data->pending = current;
             }
+            SDL_AtomicUnlock(&data->lock);
         }
 
         /* Adjust the delay based on processing time */
-        now = SDL_GetTicks();
-        interval = (now - tick);
-        if (interval > delay) {
-            delay = 0;
-        } else {
-            delay -= interval;
+        if (delay != SDL_MAX_UINT64) {
+            now = SDL_GetTimerTicksNS();
+            interval = (now - tick);
+            if (interval > delay) {
+                delay = 0;
+            } else {
+                delay -= interval;
+            }
         }
 
         /* Note that each time a timer is added, this will return
@@ -199,11 +391,71 @@ static int SDLCALL SDL_TimerThread(void *_data)
            That's okay, it just means we run through the loop a few
            extra times.
          */
-        SDL_SemWaitTimeout(data->sem, delay);
+        SDL_WaitTimerThread(data, delay, precise);
     }
     return 0;
 }
 
+/* Timer IDs are handed out sequentially, so the low bits spread them
+   evenly over the buckets */
+#define SDL_TIMERMAP_BUCKET(data, id) ((Uint32)(id) & ((data)->timermap_size - 1))
+
+/* Add a timer to the ID lookup table, called with timermap_lock held */
+static int SDL_MapTimer(SDL_TimerData *data, SDL_Timer *timer)
+{
+    Uint32 bucket;
+
+    if (data->timermap_count >= data->timermap_size) {
+        const Uint32 size = data->timermap_size ? (data->timermap_size * 2) : SDL_TIMERMAP_MIN_SIZE;
+        SDL_Timer **timermap = (SDL_Timer **)SDL_calloc(size, sizeof(*timermap));
+        if (timermap) {
+            Uint32 i;
+
+            for (i = 0; i < data->timermap_size; ++i) {
+                while (data->timermap[i]) {
+                    SDL_Timer *entry = data->timermap[i];
+                    data->timermap[i] = entry->mapnext;
+                    entry->mapnext = timermap[(Uint32)entry->timerID & (size - 1)];
+                    timermap[(Uint32)entry->timerID & (size - 1)] = entry;
+                }
+            }
+            SDL_free(data->timermap);
+            data->timermap = timermap;
+            data->timermap_size = size;
+        } else if (!data->timermap) {
+            return SDL_OutOfMemory();
+        }
+        /* Otherwise we just live with longer bucket chains */
+    }
+
+    bucket = SDL_TIMERMAP_BUCKET(data, timer->timerID);
+    timer->mapnext = data->timermap[bucket];
+    data->timermap[bucket] = timer;
+    ++data->timermap_count;
+    return 0;
+}
+
+/* Remove a timer from the ID lookup table, called with timermap_lock held */
+static SDL_Timer *SDL_UnmapTimer(SDL_TimerData *data, int timerID)
+{
+    SDL_Timer **link;
+
+    if (!data->timermap) {
+        return NULL;
+    }
+
+    for (link = &data->timermap[SDL_TIMERMAP_BUCKET(data, timerID)]; *link; link = &(*link)->mapnext) {
+        SDL_Timer *timer = *link;
+        if (timer->timerID == timerID) {
+            *link = timer->mapnext;
+            timer->mapnext = NULL;
+            --data->timermap_count;
+            return timer;
+        }
+    }
+    return NULL;
+}
+
 int SDL_TimerInit(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
@@ -239,7 +491,7 @@ void SDL_TimerQuit(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    int i;
 
     if (SDL_AtomicCAS(&data->active, 1, 0)) { /* active? Move to inactive. */
         /* Shutdown the timer thread */
@@ -253,32 +505,41 @@ void SDL_TimerQuit(void)
         data->sem = NULL;
 
         /* Clean up the timer entries */
-        while (data->timers) {
-            timer = data->timers;
-            data->timers = timer->next;
-            SDL_free(timer);
+        for (i = 0; i < data->heap_count; ++i) {
+            SDL_SlabFree(&SDL_timer_site, data->heap[i].timer, sizeof(SDL_Timer));
+        }
+        SDL_free(data->heap);
+        data->heap = NULL;
+        data->heap_count = 0;
+        data->heap_size = 0;
+        while (data->pending) {
+            timer = data->pending;
+            data->pending = timer->next;
+            SDL_SlabFree(&SDL_timer_site, timer, sizeof(*timer));
         }
         while (data->freelist) {
             timer = data->freelist;
             data->freelist = timer->next;
-            SDL_free(timer);
-        }
-        while (data->timermap) {
-            entry = data->timermap;
-            data->timermap = entry->next;
-            SDL_free(entry);
+            SDL_SlabFree(&SDL_timer_site, timer, sizeof(*timer));
         }
+        SDL_AtomicSet(&data->canceled, 0);
+
+        /* The map only points at the timers freed above */
+        SDL_free(data->timermap);
+        data->timermap = NULL;
+        data->timermap_size = 0;
+        data->timermap_count = 0;
 
         SDL_DestroyMutex(data->timermap_lock);
         data->timermap_lock = NULL;
     }
 }
 
-SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback, SDL_NSTimerCallback callback_ns, void *param)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    SDL_bool reused;
 
     SDL_AtomicLock(&data->lock);
     if (!SDL_AtomicGet(&data->active)) {
@@ -294,34 +555,32 @@ SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *para
     }
     SDL_AtomicUnlock(&data->lock);
 
-    if (timer) {
-        SDL_RemoveTimer(timer->timerID);
-    } else {
-        timer = (SDL_Timer *)SDL_malloc(sizeof(*timer));
+    reused = timer ? SDL_TRUE : SDL_FALSE;
+    if (!timer) {
+        timer = (SDL_Timer *)SDL_SlabAlloc(&SDL_timer_site, sizeof(*timer));
         if (!timer) {
             SDL_OutOfMemory();
             return 0;
         }
     }
+
+    SDL_LockMutex(data->timermap_lock);
+    if (reused) {
+        /* Finished timers stay mapped until their structure is reused */
+        SDL_UnmapTimer(data, timer->timerID);
+    }
     timer->timerID = SDL_AtomicIncRef(&data->nextID);
     timer->callback = callback;
+    timer->callback_ns = callback_ns;
     timer->param = param;
     timer->interval = interval;
-    timer->scheduled = SDL_GetTicks() + interval;
+    timer->scheduled = SDL_GetTimerTicksNS() + (callback_ns ? interval : interval * SDL_NS_PER_MS);
     SDL_AtomicSet(&timer->canceled, 0);
-
-    entry = (SDL_TimerMap *)SDL_malloc(sizeof(*entry));
-    if (!entry) {
-        SDL_free(timer);
-        SDL_OutOfMemory();
+    if (SDL_MapTimer(data, timer) < 0) {
+        SDL_UnlockMutex(data->timermap_lock);
+        SDL_SlabFree(&SDL_timer_site, timer, sizeof(*timer));
         return 0;
     }
-    entry->timer = timer;
-    entry->timerID = timer->timerID;
-
-    SDL_LockMutex(data->timermap_lock);
-    entry->next = data->timermap;
-    data->timermap = entry;
     SDL_UnlockMutex(data->timermap_lock);
 
     /* Add the timer to the pending list for the timer thread */
@@ -333,37 +592,35 @@ SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *para
     /* Wake up the timer thread if necessary */
     SDL_SemPost(data->sem);
 
-    return entry->timerID;
+    return timer->timerID;
+}
+
+SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+{
+    return SDL_CreateTimer(interval, callback, NULL, param);
+}
+
+SDL_TimerID SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *param)
+{
+    return SDL_CreateTimer(interval, NULL, callback, param);
 }
 
 SDL_bool SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
-    SDL_TimerMap *prev, *entry;
+    SDL_Timer *timer;
     SDL_bool canceled = SDL_FALSE;
 
-    /* Find the timer */
+    /* Find the timer, the canceled flag has to be set before the structure
+       can be handed out again by SDL_AddTimer() */
     SDL_LockMutex(data->timermap_lock);
-    prev = NULL;
-    for (entry = data->timermap; entry; prev = entry, entry = entry->next) {
-        if (entry->timerID == id) {
-            if (prev) {
-                prev->next = entry->next;
-            } else {
-                data->timermap = entry->next;
-            }
-            break;
-        }
+    timer = SDL_UnmapTimer(data, id);
+    if (timer && SDL_AtomicCAS(&timer->canceled, 0, 1)) {
+        SDL_AtomicIncRef(&data->canceled);
+        canceled = SDL_TRUE;
     }
     SDL_UnlockMutex(data->timermap_lock);
 
-    if (entry) {
-        if (!SDL_AtomicGet(&entry->timer->canceled)) {
-            SDL_AtomicSet(&entry->timer->canceled, 1);
-            canceled = SDL_TRUE;
-        }
-        SDL_free(entry);
-    }
     return canceled;
 }
 
@@ -376,12 +633,16 @@ typedef struct _SDL_TimerMap
 {
     int timerID;
     int timeoutID;
-    Uint32 interval;
+    Uint64 interval;
+    Uint64 scheduled; /* nanosecond timers only */
     SDL_TimerCallback callback;
+    SDL_NSTimerCallback callback_ns;
     void *param;
     struct _SDL_TimerMap *next;
 } SDL_TimerMap;
 
+SDL_SLAB_SITE(SDL_timermap_site, "timers", SDL_MEMORY_TAG_OTHER);
+
 typedef struct
 {
     int nextID;
@@ -393,12 +654,32 @@ static SDL_TimerData SDL_timer_data;
 static void SDL_Emscripten_TimerHelper(void *userdata)
 {
     SDL_TimerMap *entry = (SDL_TimerMap *)userdata;
-    entry->interval = entry->callback(entry->interval, entry->param);
-    if (entry->interval > 0) {
-        entry->timeoutID = emscripten_set_timeout(&SDL_Emscripten_TimerHelper,
-                                                  entry->interval,
-                                                  entry);
+    double timeout;
+
+    if (entry->callback_ns) {
+        const Uint64 tick = SDL_GetTimerTicksNS();
+
+        entry->interval = entry->callback_ns(entry->interval, entry->param);
+        if (entry->interval == 0) {
+            return;
+        }
+
+        /* Count from the previous deadline so periodic timers don't drift */
+        entry->scheduled += entry->interval;
+        if (tick > entry->scheduled) {
+            entry->scheduled += ((tick - entry->scheduled) / entry->interval) * entry->interval;
+        }
+        timeout = (double)(Sint64)(entry->scheduled - tick) / SDL_NS_PER_MS;
+    } else {
+        entry->interval = entry->callback((Uint32)entry->interval, entry->param);
+        if (entry->interval == 0) {
+            return;
+        }
+        timeout = (double)entry->interval;
     }
+    entry->timeoutID = emscripten_set_timeout(&SDL_Emscripten_TimerHelper,
+                                              SDL_max(timeout, 0.0),
+                                              entry);
 }
 
 int SDL_TimerInit(void)
@@ -414,27 +695,29 @@ void SDL_TimerQuit(void)
     while (data->timermap) {
         entry = data->timermap;
         data->timermap = entry->next;
-        SDL_free(entry);
+        SDL_SlabFree(&SDL_timermap_site, entry, sizeof(*entry));
     }
 }
 
-SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback, SDL_NSTimerCallback callback_ns, void *param)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_TimerMap *entry;
 
-    entry = (SDL_TimerMap *)SDL_malloc(sizeof(*entry));
+    entry = (SDL_TimerMap *)SDL_SlabAlloc(&SDL_timermap_site, sizeof(*entry));
     if (!entry) {
         SDL_OutOfMemory();
         return 0;
     }
     entry->timerID = ++data->nextID;
     entry->callback = callback;
+    entry->callback_ns = callback_ns;
     entry->param = param;
     entry->interval = interval;
+    entry->scheduled = SDL_GetTimerTicksNS() + interval;
 
     entry->timeoutID = emscripten_set_timeout(&SDL_Emscripten_TimerHelper,
-                                              entry->interval,
+                                              callback_ns ? ((double)interval / SDL_NS_PER_MS) : (double)interval,
                                               entry);
 
     entry->next = data->timermap;
@@ -443,6 +726,16 @@ SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *para
     return entry->timerID;
 }
 
+SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+{
+    return SDL_CreateTimer(interval, callback, NULL, param);
+}
+
+SDL_TimerID SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *param)
+{
+    return SDL_CreateTimer(interval, NULL, callback, param);
+}
+
 SDL_bool SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
@@ -463,7 +756,7 @@ SDL_bool SDL_RemoveTimer(SDL_TimerID id)
 
     if (entry) {
         emscripten_clear_timeout(entry->timeoutID);
-        SDL_free(entry);
+        SDL_SlabFree(&SDL_timermap_site, entry, sizeof(*entry));
 
         return SDL_TRUE;
     }
@@ -21,6 +21,7 @@
 #include "../SDL_internal.h"
 
 #include "SDL_video.h"
+#include "SDL_hints.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
 #include "SDL_blit_auto.h"
@@ -28,6 +29,51 @@
 #include "SDL_blit_slow.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
+#include "../thread/SDL_systhread.h"
+
+/* Most threads SDL_HINT_SURFACE_CONVERT_THREADS can ask for */
+#define SDL_MAX_ROW_BANDS 16
+
+/* Smallest images and bands worth splitting across threads */
+#define SDL_MIN_ROW_BAND_PIXELS (256 * 256)
+#define SDL_MIN_ROW_BAND_ROWS   16
+
+typedef struct
+{
+    SDL_Thread *thread;
+    SDL_sem *start;
+    SDL_RowBandFunc func; /* NULL tells the thread to quit */
+    void *userdata;
+    int y, h;
+} SDL_RowBandWorker;
+
+static SDL_SpinLock row_band_lock;
+static SDL_mutex *row_band_mutex;
+static SDL_sem *row_band_done;
+static SDL_bool row_band_busy;
+static int row_band_num_workers;
+static SDL_RowBandWorker row_band_workers[SDL_MAX_ROW_BANDS - 1];
+
+static void SDL_SetupBlitInfo(SDL_BlitInfo *info, SDL_Surface *src, SDL_Rect *srcrect,
+                              SDL_Surface *dst, SDL_Rect *dstrect)
+{
+    info->src = (Uint8 *)src->pixels +
+                (Uint16)srcrect->y * src->pitch +
+                (Uint16)srcrect->x * info->src_fmt->BytesPerPixel;
+    info->src_w = srcrect->w;
+    info->src_h = srcrect->h;
+    info->src_pitch = src->pitch;
+    info->src_skip =
+        info->src_pitch - info->src_w * info->src_fmt->BytesPerPixel;
+    info->dst =
+        (Uint8 *)dst->pixels + (Uint16)dstrect->y * dst->pitch +
+        (Uint16)dstrect->x * info->dst_fmt->BytesPerPixel;
+    info->dst_w = dstrect->w;
+    info->dst_h = dstrect->h;
+    info->dst_pitch = dst->pitch;
+    info->dst_skip =
+        info->dst_pitch - info->dst_w * info->dst_fmt->BytesPerPixel;
+}
 
 /* The general purpose software blit routine */
 static int SDLCALL SDL_SoftBlit(SDL_Surface *src, SDL_Rect *srcrect,
@@ -65,22 +111,7 @@ static int SDLCALL SDL_SoftBlit(SDL_Surface *src, SDL_Rect *srcrect,
         SDL_BlitInfo *info = &src->map->info;
 
         /* Set up the blit information */
-        info->src = (Uint8 *)src->pixels +
-                    (Uint16)srcrect->y * src->pitch +
-                    (Uint16)srcrect->x * info->src_fmt->BytesPerPixel;
-        info->src_w = srcrect->w;
-        info->src_h = srcrect->h;
-        info->src_pitch = src->pitch;
-        info->src_skip =
-            info->src_pitch - info->src_w * info->src_fmt->BytesPerPixel;
-        info->dst =
-            (Uint8 *)dst->pixels + (Uint16)dstrect->y * dst->pitch +
-            (Uint16)dstrect->x * info->dst_fmt->BytesPerPixel;
-        info->dst_w = dstrect->w;
-        info->dst_h = dstrect->h;
-        info->dst_pitch = dst->pitch;
-        info->dst_skip =
-            info->dst_pitch - info->dst_w * info->dst_fmt->BytesPerPixel;
+        SDL_SetupBlitInfo(info, src, srcrect, dst, dstrect);
         RunBlit = (SDL_BlitFunc)src->map->data;
 
         /* Run the actual software blit */
@@ -98,7 +129,191 @@ static int SDLCALL SDL_SoftBlit(SDL_Surface *src, SDL_Rect *srcrect,
     return okay ? 0 : -1;
 }
 
-#if SDL_HAVE_BLIT_AUTO
+int SDL_GetRowBandCount(int width, int height)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_SURFACE_CONVERT_THREADS);
+    int bands;
+
+    if (!hint || ((Sint64)width * height) < SDL_MIN_ROW_BAND_PIXELS) {
+        return 1;
+    }
+    bands = SDL_atoi(hint);
+    bands = SDL_min(bands, height / SDL_MIN_ROW_BAND_ROWS);
+    bands = SDL_min(bands, SDL_MAX_ROW_BANDS);
+    return SDL_max(bands, 1);
+}
+
+static int SDLCALL SDL_RowBandThread(void *arg)
+{
+    SDL_RowBandWorker *worker = (SDL_RowBandWorker *)arg;
+
+    for (;;) {
+        SDL_SemWait(worker->start);
+        if (!worker->func) {
+            break;
+        }
+        worker->func(worker->userdata, worker->y, worker->h);
+        SDL_SemPost(row_band_done);
+    }
+    return 0;
+}
+
+/* Make sure there are threads for the bands after the first, returns how many bands can run */
+static int SDL_CreateRowBandWorkers(int bands)
+{
+    if (!row_band_done) {
+        row_band_done = SDL_CreateSemaphore(0);
+        if (!row_band_done) {
+            return 1;
+        }
+    }
+    while (row_band_num_workers < (bands - 1)) {
+        SDL_RowBandWorker *worker = &row_band_workers[row_band_num_workers];
+
+        worker->start = SDL_CreateSemaphore(0);
+        if (!worker->start) {
+            break;
+        }
+        worker->func = NULL;
+        worker->thread = SDL_CreateThreadInternal(SDL_RowBandThread, "SDLRowBand", 0, worker);
+        if (!worker->thread) {
+            SDL_DestroySemaphore(worker->start);
+            worker->start = NULL;
+            break;
+        }
+        ++row_band_num_workers;
+    }
+    return SDL_min(bands, row_band_num_workers + 1);
+}
+
+void SDL_RunRowBands(SDL_RowBandFunc func, void *userdata, int height, int bands, int align)
+{
+    int i, y, first;
+
+    if (bands > 1 && !row_band_mutex) {
+        SDL_AtomicLock(&row_band_lock);
+        if (!row_band_mutex) {
+            row_band_mutex = SDL_CreateMutex();
+        }
+        SDL_AtomicUnlock(&row_band_lock);
+    }
+
+    /* The threads are shared, conversions that can't get them run here */
+    if (bands <= 1 || !row_band_mutex || SDL_TryLockMutex(row_band_mutex) != 0) {
+        func(userdata, 0, height);
+        return;
+    }
+    if (row_band_busy) {
+        /* A band function converting something itself */
+        SDL_UnlockMutex(row_band_mutex);
+        func(userdata, 0, height);
+        return;
+    }
+    row_band_busy = SDL_TRUE;
+
+    bands = SDL_CreateRowBandWorkers(bands);
+
+    /* The calling thread converts the first band */
+    first = (int)((Sint64)height / bands);
+    first -= first % align;
+    y = first;
+    for (i = 1; i < bands; i++) {
+        SDL_RowBandWorker *worker = &row_band_workers[i - 1];
+        int end = (i + 1 < bands) ? (int)(((Sint64)height * (i + 1)) / bands) : height;
+
+        if (end < height) {
+            end -= end % align;
+        }
+        worker->func = func;
+        worker->userdata = userdata;
+        worker->y = y;
+        worker->h = end - y;
+        SDL_SemPost(worker->start);
+        y = end;
+    }
+    func(userdata, 0, first);
+
+    for (i = 1; i < bands; i++) {
+        SDL_SemWait(row_band_done);
+    }
+
+    row_band_busy = SDL_FALSE;
+    SDL_UnlockMutex(row_band_mutex);
+}
+
+void SDL_QuitRowBands(void)
+{
+    int i;
+
+    if (!row_band_mutex) {
+        return;
+    }
+
+    SDL_LockMutex(row_band_mutex);
+    for (i = 0; i < row_band_num_workers; i++) {
+        SDL_RowBandWorker *worker = &row_band_workers[i];
+
+        worker->func = NULL;
+        SDL_SemPost(worker->start);
+        SDL_WaitThread(worker->thread, NULL);
+        SDL_DestroySemaphore(worker->start);
+        worker->thread = NULL;
+        worker->start = NULL;
+    }
+    row_band_num_workers = 0;
+    if (row_band_done) {
+        SDL_DestroySemaphore(row_band_done);
+        row_band_done = NULL;
+    }
+    SDL_UnlockMutex(row_band_mutex);
+
+    SDL_DestroyMutex(row_band_mutex);
+    row_band_mutex = NULL;
+}
+
+typedef struct
+{
+    SDL_BlitFunc blit;
+    const SDL_BlitInfo *info;
+} SDL_BlitRowBandData;
+
+static void SDL_BlitRowBand(void *userdata, int y, int h)
+{
+    const SDL_BlitRowBandData *data = (const SDL_BlitRowBandData *)userdata;
+    SDL_BlitInfo info = *data->info;
+
+    info.src += y * info.src_pitch;
+    info.dst += y * info.dst_pitch;
+    info.src_h = h;
+    info.dst_h = h;
+    data->blit(&info);
+}
+
+int SDL_SoftBlitRowBands(SDL_Surface *src, SDL_Rect *srcrect,
+                         SDL_Surface *dst, SDL_Rect *dstrect, int bands)
+{
+    SDL_BlitRowBandData data;
+    SDL_BlitInfo info;
+
+    /* Only unscaled blits of plain memory can be split, RLE blits can't */
+    if (bands <= 1 || src->map->blit != SDL_SoftBlit ||
+        SDL_MUSTLOCK(src) || SDL_MUSTLOCK(dst) ||
+        (src->map->info.flags & SDL_COPY_NEAREST) ||
+        srcrect->w != dstrect->w || srcrect->h != dstrect->h) {
+        return src->map->blit(src, srcrect, dst, dstrect);
+    }
+    if (SDL_RectEmpty(srcrect)) {
+        return 0;
+    }
+
+    /* Each band blits with its own copy of the blit information */
+    info = src->map->info;
+    SDL_SetupBlitInfo(&info, src, srcrect, dst, dstrect);
+    data.blit = (SDL_BlitFunc)src->map->data;
+    data.info = &info;
+    SDL_RunRowBands(SDL_BlitRowBand, &data, srcrect->h, bands, 1);
+    return 0;
+}
 
 #ifdef __MACOSX__
 #include <sys/sysctl.h>
@@ -123,43 +338,61 @@ static SDL_bool SDL_UseAltivecPrefetch(void)
 }
 #endif /* __MACOSX__ */
 
-static SDL_BlitFunc SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
-                                       SDL_BlitFuncEntry *entries)
+int SDL_GetBlitCPUFeatures(void)
 {
-    int i, flagcheck = (flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_COLORKEY | SDL_COPY_NEAREST));
     static int features = 0x7fffffff;
 
+    /* Allow an override for testing, an empty value restores detection .. */
+    const char *override = SDL_getenv("SDL_BLIT_CPU_FEATURES");
+    if (override && *override) {
+        int value = SDL_CPU_ANY;
+        (void)SDL_sscanf(override, "%u", &value);
+        return value;
+    }
+
     /* Get the available CPU features */
     if (features == 0x7fffffff) {
-        const char *override = SDL_getenv("SDL_BLIT_CPU_FEATURES");
-
         features = SDL_CPU_ANY;
 
-        /* Allow an override for testing .. */
-        if (override) {
-            (void)SDL_sscanf(override, "%u", &features);
-        } else {
-            if (SDL_HasMMX()) {
-                features |= SDL_CPU_MMX;
-            }
-            if (SDL_Has3DNow()) {
-                features |= SDL_CPU_3DNOW;
-            }
-            if (SDL_HasSSE()) {
-                features |= SDL_CPU_SSE;
-            }
-            if (SDL_HasSSE2()) {
-                features |= SDL_CPU_SSE2;
-            }
-            if (SDL_HasAltiVec()) {
-                if (SDL_UseAltivecPrefetch()) {
-                    features |= SDL_CPU_ALTIVEC_PREFETCH;
-                } else {
-                    features |= SDL_CPU_ALTIVEC_NOPREFETCH;
-                }
+        if (SDL_HasMMX()) {
+            features |= SDL_CPU_MMX;
+        }
+        if (SDL_Has3DNow()) {
+            features |= SDL_CPU_3DNOW;
+        }
+        if (SDL_HasSSE()) {
+            features |= SDL_CPU_SSE;
+        }
+        if (SDL_HasSSE2()) {
+            features |= SDL_CPU_SSE2;
+        }
+        if (SDL_HasAltiVec()) {
+            if (SDL_UseAltivecPrefetch()) {
+                features |= SDL_CPU_ALTIVEC_PREFETCH;
+            } else {
+                features |= SDL_CPU_ALTIVEC_NOPREFETCH;
             }
         }
+        if (SDL_HasAVX2()) {
+            features |= SDL_CPU_AVX2;
+        }
+        if (SDL_HasNEON()) {
+            features |= SDL_CPU_NEON;
+        }
+        if (SDL_HasSSE41()) {
+            features |= SDL_CPU_SSE41;
+        }
     }
+    return features;
+}
+
+#if SDL_HAVE_BLIT_AUTO
+
+static SDL_BlitFunc SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
+                                       SDL_BlitFuncEntry *entries)
+{
+    int i, flagcheck = (flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_COLORKEY | SDL_COPY_NEAREST));
+    const int features = SDL_GetBlitCPUFeatures();
 
     for (i = 0; entries[i].func; ++i) {
         /* Check for matching pixel formats */
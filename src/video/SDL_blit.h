@@ -58,6 +58,9 @@ extern Uint8 *SDL_expand_byte[9];
 #define SDL_CPU_SSE2               0x00000008
 #define SDL_CPU_ALTIVEC_PREFETCH   0x00000010
 #define SDL_CPU_ALTIVEC_NOPREFETCH 0x00000020
+#define SDL_CPU_AVX2               0x00000040
+#define SDL_CPU_NEON               0x00000080
+#define SDL_CPU_SSE41              0x00000100
 
 typedef struct
 {
@@ -106,6 +109,17 @@ struct SDL_BlitMap
 
 /* Functions found in SDL_blit.c */
 extern int SDL_CalculateBlit(SDL_Surface *surface);
+extern int SDL_GetBlitCPUFeatures(void);
+
+/* Splitting large conversions into bands of rows on several threads,
+   see SDL_HINT_SURFACE_CONVERT_THREADS. Each band starts on a multiple of
+   align rows, the calling thread converts the first one. */
+typedef void (*SDL_RowBandFunc)(void *userdata, int y, int h);
+extern int SDL_GetRowBandCount(int width, int height);
+extern void SDL_RunRowBands(SDL_RowBandFunc func, void *userdata, int height, int bands, int align);
+extern void SDL_QuitRowBands(void);
+extern int SDL_SoftBlitRowBands(SDL_Surface *src, SDL_Rect *srcrect,
+                                SDL_Surface *dst, SDL_Rect *dstrect, int bands);
 
 /* Functions found in SDL_blit_*.c */
 extern SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface *surface);
@@ -25,6 +25,14 @@
 #include "SDL_video.h"
 #include "SDL_blit.h"
 
+#include "../cpuinfo/SDL_cpuinfo_c.h"
+
+/* The SIMD blitters assume little endian pixel layouts */
+#if SDL_BYTEORDER != SDL_LIL_ENDIAN
+#undef HAVE_SSE4_1_INTRINSICS
+#undef HAVE_AVX2_INTRINSICS
+#endif
+
 /* Functions to perform alpha blended blitting */
 
 /* N->1 blending with per-surface alpha */
@@ -1413,10 +1421,311 @@ static void BlitNtoNPixelAlpha(SDL_BlitInfo *info)
     }
 }
 
+#if defined(HAVE_SSE4_1_INTRINSICS) || defined(HAVE_AVX2_INTRINSICS)
+
+/* Vector versions of the 32-bit alpha blitters above. They do the same
+ * integer math on 32-bit lanes, so the results match the scalar blitters
+ * exactly. Short runs at the end of a row go through a buffer.
+ */
+#define BLIT_RGB_TO_RGB_PIXEL_ALPHA   0
+#define BLIT_RGB_TO_BGR_PIXEL_ALPHA   1
+#define BLIT_ARGB_TO_565_PIXEL_ALPHA  2
+#define BLIT_RGB_TO_RGB_SURFACE_ALPHA 3
+#define BLIT_RGB_TO_RGB_SURFACE_ALPHA_128 4
+
+#endif /* HAVE_SSE4_1_INTRINSICS || HAVE_AVX2_INTRINSICS */
+
+#ifdef HAVE_SSE4_1_INTRINSICS
+
+/* d + ((s - d) * alpha >> shift), masked, four pixels at a time */
+SDL_FORCE_INLINE __m128i SDL_TARGETING_SSE4_1 BlendChannels_SSE4_1(__m128i s, __m128i d, __m128i alpha, __m128i mask, const int shift)
+{
+    d = _mm_and_si128(d, mask);
+    s = _mm_and_si128(s, mask);
+    return _mm_and_si128(_mm_add_epi32(d, _mm_srli_epi32(_mm_mullo_epi32(_mm_sub_epi32(s, d), alpha), shift)), mask);
+}
+
+SDL_FORCE_INLINE __m128i SDL_TARGETING_SSE4_1 BlitAlphaPixels_SSE4_1(__m128i s, __m128i d, __m128i surface_alpha, const int blit)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rb_mask = _mm_set1_epi32(0x00ff00ff);
+    const __m128i g_mask = _mm_set1_epi32(0x0000ff00);
+    __m128i alpha, result;
+
+    switch (blit) {
+    case BLIT_RGB_TO_RGB_PIXEL_ALPHA:
+    case BLIT_RGB_TO_BGR_PIXEL_ALPHA:
+        alpha = _mm_srli_epi32(s, 24);
+        if (blit == BLIT_RGB_TO_BGR_PIXEL_ALPHA) {
+            /* swap red and blue, the opaque pixels are copied like this too */
+            const __m128i rb = _mm_and_si128(s, rb_mask);
+            s = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(rb, 16), _mm_slli_epi32(rb, 16)), _mm_and_si128(s, g_mask));
+            s = _mm_or_si128(s, _mm_set1_epi32((int)0xff000000));
+        }
+        result = _mm_or_si128(BlendChannels_SSE4_1(s, d, alpha, rb_mask, 8), BlendChannels_SSE4_1(s, d, alpha, g_mask, 8));
+        result = _mm_or_si128(result, _mm_slli_epi32(_mm_add_epi32(alpha, _mm_srli_epi32(_mm_mullo_epi32(_mm_srli_epi32(d, 24), _mm_xor_si128(alpha, _mm_set1_epi32(0xff))), 8)), 24));
+        result = _mm_blendv_epi8(result, s, _mm_cmpeq_epi32(alpha, _mm_set1_epi32(0xff)));
+        return _mm_blendv_epi8(result, d, _mm_cmpeq_epi32(alpha, zero));
+
+    case BLIT_ARGB_TO_565_PIXEL_ALPHA:
+    {
+        const __m128i mask = _mm_set1_epi32(0x07e0f81f);
+        const __m128i opaque = _mm_add_epi32(_mm_add_epi32(_mm_and_si128(_mm_srli_epi32(s, 8), _mm_set1_epi32(0xf800)),
+                                                           _mm_and_si128(_mm_srli_epi32(s, 5), _mm_set1_epi32(0x7e0))),
+                                             _mm_and_si128(_mm_srli_epi32(s, 3), _mm_set1_epi32(0x1f)));
+        alpha = _mm_srli_epi32(s, 27);
+        /* convert source and destination to G0RAB65565 and blend all components at the same time */
+        s = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(_mm_and_si128(s, _mm_set1_epi32(0xfc00)), 11),
+                                        _mm_and_si128(_mm_srli_epi32(s, 8), _mm_set1_epi32(0xf800))),
+                          _mm_and_si128(_mm_srli_epi32(s, 3), _mm_set1_epi32(0x1f)));
+        result = BlendChannels_SSE4_1(s, _mm_or_si128(d, _mm_slli_epi32(d, 16)), alpha, mask, 5);
+        result = _mm_and_si128(_mm_or_si128(result, _mm_srli_epi32(result, 16)), _mm_set1_epi32(0xffff));
+        result = _mm_blendv_epi8(result, opaque, _mm_cmpeq_epi32(alpha, _mm_set1_epi32(0x1f)));
+        return _mm_blendv_epi8(result, d, _mm_cmpeq_epi32(alpha, zero));
+    }
+
+    case BLIT_RGB_TO_RGB_SURFACE_ALPHA:
+        result = _mm_or_si128(BlendChannels_SSE4_1(s, d, surface_alpha, rb_mask, 8), BlendChannels_SSE4_1(s, d, surface_alpha, g_mask, 8));
+        return _mm_or_si128(result, _mm_set1_epi32((int)0xff000000));
+
+    case BLIT_RGB_TO_RGB_SURFACE_ALPHA_128:
+    default:
+        result = _mm_srli_epi32(_mm_add_epi32(_mm_and_si128(s, _mm_set1_epi32(0x00fefefe)), _mm_and_si128(d, _mm_set1_epi32(0x00fefefe))), 1);
+        result = _mm_add_epi32(result, _mm_and_si128(_mm_and_si128(s, d), _mm_set1_epi32(0x00010101)));
+        return _mm_or_si128(result, _mm_set1_epi32((int)0xff000000));
+    }
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING_SSE4_1 BlitAlpha_SSE4_1(SDL_BlitInfo *info, const int blit)
+{
+    const int dstbpp = (blit == BLIT_ARGB_TO_565_PIXEL_ALPHA) ? 2 : 4;
+    const __m128i surface_alpha = _mm_set1_epi32(info->a);
+    int height = info->dst_h;
+    Uint8 *srcp = info->src;
+    Uint8 *dstp = info->dst;
+    Uint32 src_buffer[4];
+    Uint32 dst_buffer[4];
+
+    while (height--) {
+        const Uint32 *src = (const Uint32 *)srcp;
+        Uint8 *dst = dstp;
+        int n = info->dst_w;
+
+        while (n > 0) {
+            const int count = SDL_min(n, 4);
+            __m128i s, d;
+
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                SDL_memcpy(src_buffer, src, count * sizeof(Uint32));
+                s = _mm_loadu_si128((const __m128i *)src_buffer);
+            }
+            if (count == 4) {
+                d = (dstbpp == 2) ? _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)dst)) : _mm_loadu_si128((const __m128i *)dst);
+            } else {
+                SDL_memcpy(dst_buffer, dst, count * dstbpp);
+                d = (dstbpp == 2) ? _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)dst_buffer)) : _mm_loadu_si128((const __m128i *)dst_buffer);
+            }
+
+            d = BlitAlphaPixels_SSE4_1(s, d, surface_alpha, blit);
+
+            if (dstbpp == 2) {
+                d = _mm_packus_epi32(d, d);
+            }
+            if (count == 4) {
+                if (dstbpp == 2) {
+                    _mm_storel_epi64((__m128i *)dst, d);
+                } else {
+                    _mm_storeu_si128((__m128i *)dst, d);
+                }
+            } else {
+                _mm_storeu_si128((__m128i *)dst_buffer, d);
+                SDL_memcpy(dst, dst_buffer, count * dstbpp);
+            }
+            src += count;
+            dst += count * dstbpp;
+            n -= count;
+        }
+        srcp += info->src_pitch;
+        dstp += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING_SSE4_1 BlitRGBtoRGBPixelAlphaSSE4_1(SDL_BlitInfo *info)
+{
+    BlitAlpha_SSE4_1(info, BLIT_RGB_TO_RGB_PIXEL_ALPHA);
+}
+
+static void SDL_TARGETING_SSE4_1 BlitRGBtoBGRPixelAlphaSSE4_1(SDL_BlitInfo *info)
+{
+    BlitAlpha_SSE4_1(info, BLIT_RGB_TO_BGR_PIXEL_ALPHA);
+}
+
+static void SDL_TARGETING_SSE4_1 BlitARGBto565PixelAlphaSSE4_1(SDL_BlitInfo *info)
+{
+    BlitAlpha_SSE4_1(info, BLIT_ARGB_TO_565_PIXEL_ALPHA);
+}
+
+static void SDL_TARGETING_SSE4_1 BlitRGBtoRGBSurfaceAlphaSSE4_1(SDL_BlitInfo *info)
+{
+    if (info->a == 128) {
+        BlitAlpha_SSE4_1(info, BLIT_RGB_TO_RGB_SURFACE_ALPHA_128);
+    } else {
+        BlitAlpha_SSE4_1(info, BLIT_RGB_TO_RGB_SURFACE_ALPHA);
+    }
+}
+
+#endif /* HAVE_SSE4_1_INTRINSICS */
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+/* d + ((s - d) * alpha >> shift), masked, eight pixels at a time */
+SDL_FORCE_INLINE __m256i SDL_TARGETING_AVX2 BlendChannels_AVX2(__m256i s, __m256i d, __m256i alpha, __m256i mask, const int shift)
+{
+    d = _mm256_and_si256(d, mask);
+    s = _mm256_and_si256(s, mask);
+    return _mm256_and_si256(_mm256_add_epi32(d, _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(s, d), alpha), shift)), mask);
+}
+
+SDL_FORCE_INLINE __m256i SDL_TARGETING_AVX2 BlitAlphaPixels_AVX2(__m256i s, __m256i d, __m256i surface_alpha, const int blit)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i rb_mask = _mm256_set1_epi32(0x00ff00ff);
+    const __m256i g_mask = _mm256_set1_epi32(0x0000ff00);
+    __m256i alpha, result;
+
+    switch (blit) {
+    case BLIT_RGB_TO_RGB_PIXEL_ALPHA:
+    case BLIT_RGB_TO_BGR_PIXEL_ALPHA:
+        alpha = _mm256_srli_epi32(s, 24);
+        if (blit == BLIT_RGB_TO_BGR_PIXEL_ALPHA) {
+            /* swap red and blue, the opaque pixels are copied like this too */
+            const __m256i rb = _mm256_and_si256(s, rb_mask);
+            s = _mm256_or_si256(_mm256_or_si256(_mm256_srli_epi32(rb, 16), _mm256_slli_epi32(rb, 16)), _mm256_and_si256(s, g_mask));
+            s = _mm256_or_si256(s, _mm256_set1_epi32((int)0xff000000));
+        }
+        result = _mm256_or_si256(BlendChannels_AVX2(s, d, alpha, rb_mask, 8), BlendChannels_AVX2(s, d, alpha, g_mask, 8));
+        result = _mm256_or_si256(result, _mm256_slli_epi32(_mm256_add_epi32(alpha, _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_srli_epi32(d, 24), _mm256_xor_si256(alpha, _mm256_set1_epi32(0xff))), 8)), 24));
+        result = _mm256_blendv_epi8(result, s, _mm256_cmpeq_epi32(alpha, _mm256_set1_epi32(0xff)));
+        return _mm256_blendv_epi8(result, d, _mm256_cmpeq_epi32(alpha, zero));
+
+    case BLIT_ARGB_TO_565_PIXEL_ALPHA:
+    {
+        const __m256i mask = _mm256_set1_epi32(0x07e0f81f);
+        const __m256i opaque = _mm256_add_epi32(_mm256_add_epi32(_mm256_and_si256(_mm256_srli_epi32(s, 8), _mm256_set1_epi32(0xf800)),
+                                                           _mm256_and_si256(_mm256_srli_epi32(s, 5), _mm256_set1_epi32(0x7e0))),
+                                             _mm256_and_si256(_mm256_srli_epi32(s, 3), _mm256_set1_epi32(0x1f)));
+        alpha = _mm256_srli_epi32(s, 27);
+        /* convert source and destination to G0RAB65565 and blend all components at the same time */
+        s = _mm256_add_epi32(_mm256_add_epi32(_mm256_slli_epi32(_mm256_and_si256(s, _mm256_set1_epi32(0xfc00)), 11),
+                                        _mm256_and_si256(_mm256_srli_epi32(s, 8), _mm256_set1_epi32(0xf800))),
+                          _mm256_and_si256(_mm256_srli_epi32(s, 3), _mm256_set1_epi32(0x1f)));
+        result = BlendChannels_AVX2(s, _mm256_or_si256(d, _mm256_slli_epi32(d, 16)), alpha, mask, 5);
+        result = _mm256_and_si256(_mm256_or_si256(result, _mm256_srli_epi32(result, 16)), _mm256_set1_epi32(0xffff));
+        result = _mm256_blendv_epi8(result, opaque, _mm256_cmpeq_epi32(alpha, _mm256_set1_epi32(0x1f)));
+        return _mm256_blendv_epi8(result, d, _mm256_cmpeq_epi32(alpha, zero));
+    }
+
+    case BLIT_RGB_TO_RGB_SURFACE_ALPHA:
+        result = _mm256_or_si256(BlendChannels_AVX2(s, d, surface_alpha, rb_mask, 8), BlendChannels_AVX2(s, d, surface_alpha, g_mask, 8));
+        return _mm256_or_si256(result, _mm256_set1_epi32((int)0xff000000));
+
+    case BLIT_RGB_TO_RGB_SURFACE_ALPHA_128:
+    default:
+        result = _mm256_srli_epi32(_mm256_add_epi32(_mm256_and_si256(s, _mm256_set1_epi32(0x00fefefe)), _mm256_and_si256(d, _mm256_set1_epi32(0x00fefefe))), 1);
+        result = _mm256_add_epi32(result, _mm256_and_si256(_mm256_and_si256(s, d), _mm256_set1_epi32(0x00010101)));
+        return _mm256_or_si256(result, _mm256_set1_epi32((int)0xff000000));
+    }
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING_AVX2 BlitAlpha_AVX2(SDL_BlitInfo *info, const int blit)
+{
+    const int dstbpp = (blit == BLIT_ARGB_TO_565_PIXEL_ALPHA) ? 2 : 4;
+    const __m256i surface_alpha = _mm256_set1_epi32(info->a);
+    int height = info->dst_h;
+    Uint8 *srcp = info->src;
+    Uint8 *dstp = info->dst;
+    Uint32 src_buffer[8];
+    Uint32 dst_buffer[8];
+
+    while (height--) {
+        const Uint32 *src = (const Uint32 *)srcp;
+        Uint8 *dst = dstp;
+        int n = info->dst_w;
+
+        while (n > 0) {
+            const int count = SDL_min(n, 8);
+            __m256i s, d;
+
+            if (count == 8) {
+                s = _mm256_loadu_si256((const __m256i *)src);
+            } else {
+                SDL_memcpy(src_buffer, src, count * sizeof(Uint32));
+                s = _mm256_loadu_si256((const __m256i *)src_buffer);
+            }
+            if (count == 8) {
+                d = (dstbpp == 2) ? _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)dst)) : _mm256_loadu_si256((const __m256i *)dst);
+            } else {
+                SDL_memcpy(dst_buffer, dst, count * dstbpp);
+                d = (dstbpp == 2) ? _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)dst_buffer)) : _mm256_loadu_si256((const __m256i *)dst_buffer);
+            }
+
+            d = BlitAlphaPixels_AVX2(s, d, surface_alpha, blit);
+
+            if (dstbpp == 2) {
+                d = _mm256_permute4x64_epi64(_mm256_packus_epi32(d, d), _MM_SHUFFLE(3, 1, 2, 0));
+            }
+            if (count == 8) {
+                if (dstbpp == 2) {
+                    _mm_storeu_si128((__m128i *)dst, _mm256_castsi256_si128(d));
+                } else {
+                    _mm256_storeu_si256((__m256i *)dst, d);
+                }
+            } else {
+                _mm256_storeu_si256((__m256i *)dst_buffer, d);
+                SDL_memcpy(dst, dst_buffer, count * dstbpp);
+            }
+            src += count;
+            dst += count * dstbpp;
+            n -= count;
+        }
+        srcp += info->src_pitch;
+        dstp += info->dst_pitch;
+    }
+}
+
+static void SDL_TARGETING_AVX2 BlitRGBtoRGBPixelAlphaAVX2(SDL_BlitInfo *info)
+{
+    BlitAlpha_AVX2(info, BLIT_RGB_TO_RGB_PIXEL_ALPHA);
+}
+
+static void SDL_TARGETING_AVX2 BlitRGBtoBGRPixelAlphaAVX2(SDL_BlitInfo *info)
+{
+    BlitAlpha_AVX2(info, BLIT_RGB_TO_BGR_PIXEL_ALPHA);
+}
+
+static void SDL_TARGETING_AVX2 BlitARGBto565PixelAlphaAVX2(SDL_BlitInfo *info)
+{
+    BlitAlpha_AVX2(info, BLIT_ARGB_TO_565_PIXEL_ALPHA);
+}
+
+static void SDL_TARGETING_AVX2 BlitRGBtoRGBSurfaceAlphaAVX2(SDL_BlitInfo *info)
+{
+    if (info->a == 128) {
+        BlitAlpha_AVX2(info, BLIT_RGB_TO_RGB_SURFACE_ALPHA_128);
+    } else {
+        BlitAlpha_AVX2(info, BLIT_RGB_TO_RGB_SURFACE_ALPHA);
+    }
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
 {
     SDL_PixelFormat *sf = surface->format;
     SDL_PixelFormat *df = surface->map->dst->format;
+    const int features = SDL_GetBlitCPUFeatures();
 
     switch (surface->map->info.flags & ~SDL_COPY_RLE_MASK) {
     case SDL_COPY_BLEND:
@@ -1434,7 +1743,7 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
 #if defined(SDL_ARM_NEON_BLITTERS) || defined(SDL_ARM_SIMD_BLITTERS)
             if (sf->BytesPerPixel == 4 && sf->Amask == 0xff000000 && sf->Gmask == 0xff00 && df->Gmask == 0x7e0 && ((sf->Rmask == 0xff && df->Rmask == 0x1f) || (sf->Bmask == 0xff && df->Bmask == 0x1f))) {
 #ifdef SDL_ARM_NEON_BLITTERS
-                if (SDL_HasNEON()) {
+                if (features & SDL_CPU_NEON) {
                     return BlitARGBto565PixelAlphaARMNEON;
                 }
 #endif
@@ -1447,6 +1756,16 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
 #endif
             if (sf->BytesPerPixel == 4 && sf->Amask == 0xff000000 && sf->Gmask == 0xff00 && ((sf->Rmask == 0xff && df->Rmask == 0x1f) || (sf->Bmask == 0xff && df->Bmask == 0x1f))) {
                 if (df->Gmask == 0x7e0) {
+#ifdef HAVE_AVX2_INTRINSICS
+                    if (features & SDL_CPU_AVX2) {
+                        return BlitARGBto565PixelAlphaAVX2;
+                    }
+#endif
+#ifdef HAVE_SSE4_1_INTRINSICS
+                    if (features & SDL_CPU_SSE41) {
+                        return BlitARGBto565PixelAlphaSSE4_1;
+                    }
+#endif
                     return BlitARGBto565PixelAlpha;
                 } else if (df->Gmask == 0x3e0 && !df->Amask) {
                     return BlitARGBto555PixelAlpha;
@@ -1456,15 +1775,27 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
 
         case 4:
             if (sf->Rmask == df->Rmask && sf->Gmask == df->Gmask && sf->Bmask == df->Bmask && sf->BytesPerPixel == 4) {
+                if (sf->Amask == 0xff000000) {
+#ifdef HAVE_AVX2_INTRINSICS
+                    if (features & SDL_CPU_AVX2) {
+                        return BlitRGBtoRGBPixelAlphaAVX2;
+                    }
+#endif
+#ifdef HAVE_SSE4_1_INTRINSICS
+                    if (features & SDL_CPU_SSE41) {
+                        return BlitRGBtoRGBPixelAlphaSSE4_1;
+                    }
+#endif
+                }
 #if defined(__MMX__) || defined(__3dNOW__)
                 if (sf->Rshift % 8 == 0 && sf->Gshift % 8 == 0 && sf->Bshift % 8 == 0 && sf->Ashift % 8 == 0 && sf->Aloss == 0) {
 #ifdef __3dNOW__
-                    if (SDL_Has3DNow()) {
+                    if (features & SDL_CPU_3DNOW) {
                         return BlitRGBtoRGBPixelAlphaMMX3DNOW;
                     }
 #endif
 #ifdef __MMX__
-                    if (SDL_HasMMX()) {
+                    if (features & SDL_CPU_MMX) {
                         return BlitRGBtoRGBPixelAlphaMMX;
                     }
 #endif
@@ -1472,7 +1803,7 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
 #endif /* __MMX__ || __3dNOW__ */
                 if (sf->Amask == 0xff000000) {
 #ifdef SDL_ARM_NEON_BLITTERS
-                    if (SDL_HasNEON()) {
+                    if (features & SDL_CPU_NEON) {
                         return BlitRGBtoRGBPixelAlphaARMNEON;
                     }
 #endif
@@ -1485,6 +1816,16 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
                 }
             } else if (sf->Rmask == df->Bmask && sf->Gmask == df->Gmask && sf->Bmask == df->Rmask && sf->BytesPerPixel == 4) {
                 if (sf->Amask == 0xff000000) {
+#ifdef HAVE_AVX2_INTRINSICS
+                    if (features & SDL_CPU_AVX2) {
+                        return BlitRGBtoBGRPixelAlphaAVX2;
+                    }
+#endif
+#ifdef HAVE_SSE4_1_INTRINSICS
+                    if (features & SDL_CPU_SSE41) {
+                        return BlitRGBtoBGRPixelAlphaSSE4_1;
+                    }
+#endif
                     return BlitRGBtoBGRPixelAlpha;
                 }
             }
@@ -1512,7 +1853,7 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
                 if (surface->map->identity) {
                     if (df->Gmask == 0x7e0) {
 #ifdef __MMX__
-                        if (SDL_HasMMX()) {
+                        if (features & SDL_CPU_MMX) {
                             return Blit565to565SurfaceAlphaMMX;
                         } else
 #endif
@@ -1521,7 +1862,7 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
                         }
                     } else if (df->Gmask == 0x3e0) {
 #ifdef __MMX__
-                        if (SDL_HasMMX()) {
+                        if (features & SDL_CPU_MMX) {
                             return Blit555to555SurfaceAlphaMMX;
                         } else
 #endif
@@ -1534,8 +1875,20 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
 
             case 4:
                 if (sf->Rmask == df->Rmask && sf->Gmask == df->Gmask && sf->Bmask == df->Bmask && sf->BytesPerPixel == 4) {
+                    if ((sf->Rmask | sf->Gmask | sf->Bmask) == 0xffffff) {
+#ifdef HAVE_AVX2_INTRINSICS
+                        if (features & SDL_CPU_AVX2) {
+                            return BlitRGBtoRGBSurfaceAlphaAVX2;
+                        }
+#endif
+#ifdef HAVE_SSE4_1_INTRINSICS
+                        if (features & SDL_CPU_SSE41) {
+                            return BlitRGBtoRGBSurfaceAlphaSSE4_1;
+                        }
+#endif
+                    }
 #ifdef __MMX__
-                    if (sf->Rshift % 8 == 0 && sf->Gshift % 8 == 0 && sf->Bshift % 8 == 0 && SDL_HasMMX()) {
+                    if (sf->Rshift % 8 == 0 && sf->Gshift % 8 == 0 && sf->Bshift % 8 == 0 && (features & SDL_CPU_MMX)) {
                         return BlitRGBtoRGBSurfaceAlphaMMX;
                     }
 #endif
@@ -28,6 +28,278 @@
 #include "SDL_video.h"
 #include "SDL_blit.h"
 #include "SDL_blit_auto.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
+
+/* Vector versions of the blitters for the 32-bit formats.
+ *
+ * Pixels are shuffled into ARGB8888 byte order, widened to 16 bits per
+ * channel, and put through the same integer math as the scalar blitters,
+ * so the output is identical. x / 255 is computed exactly as
+ * (x + 1 + (x >> 8)) >> 8, which holds for every product of two channels.
+ */
+#if SDL_BYTEORDER != SDL_LIL_ENDIAN
+#undef HAVE_AVX2_INTRINSICS
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+/* How to get from the source and destination formats to ARGB8888 and back.
+   Each mask covers four pixels, 0x80 zeroes the byte. */
+typedef struct
+{
+    Uint8 src[16];
+    Uint8 dst[16];
+    Uint8 dst_in[16];
+    Uint32 src_alpha; /* alpha of sources without an alpha channel */
+} SDL_BlitVectorFormat;
+
+/* Keeps the bytes as they are, for scaling without conversion */
+static const SDL_BlitVectorFormat SDL_Blit_Vector_Copy = {
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    0
+};
+
+/* The blitters take one of these as the mode, SDL_BLIT_VECTOR_MODES to
+   write back the destination as it is, or 0 to not blend at all. */
+#define SDL_BLIT_VECTOR_MODES (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)
+
+SDL_FORCE_INLINE __m256i SDL_TARGETING_AVX2 SDL_Div255_AVX2(__m256i x)
+{
+    return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(x, _mm256_set1_epi16(1)), _mm256_srli_epi16(x, 8)), 8);
+}
+
+/* Blends one half of the pixels, 16 bits per channel */
+SDL_FORCE_INLINE __m256i SDL_TARGETING_AVX2 SDL_BlendPixels_AVX2(__m256i s, __m256i d, const int mode)
+{
+    const __m256i v255 = _mm256_set1_epi16(255);
+    const __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    __m256i t, m;
+
+    switch (mode) {
+    case SDL_COPY_BLEND:
+    case SDL_COPY_ADD:
+        /* Premultiply the color, alpha stays as it is */
+        s = SDL_Div255_AVX2(_mm256_mullo_epi16(s, _mm256_blend_epi16(alpha, v255, 0x88)));
+        if (mode == SDL_COPY_BLEND) {
+            return _mm256_add_epi16(s, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(v255, alpha), d)));
+        }
+        return _mm256_blend_epi16(_mm256_add_epi16(s, d), d, 0x88);
+    case SDL_COPY_MOD:
+        return _mm256_blend_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(s, d)), d, 0x88);
+    case SDL_COPY_MUL:
+        /* d * (s + 255 - alpha) / 255, split so the product fits in 16 bits */
+        t = _mm256_sub_epi16(_mm256_add_epi16(s, v255), alpha);
+        m = _mm256_cmpgt_epi16(t, _mm256_set1_epi16(254));
+        t = _mm256_sub_epi16(t, _mm256_and_si256(m, v255));
+        t = _mm256_add_epi16(_mm256_and_si256(m, d), SDL_Div255_AVX2(_mm256_mullo_epi16(d, t)));
+        return _mm256_blend_epi16(t, d, 0x88);
+    default:
+        return d;
+    }
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING_AVX2 SDL_BlitPixels_AVX2(SDL_BlitInfo *info, const SDL_BlitVectorFormat *format, const int modulate, const int mode, const int scale)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src_shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)format->src));
+    const __m256i dst_shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)format->dst));
+    const __m256i dst_in_shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)format->dst_in));
+    const __m256i src_alpha = _mm256_set1_epi32((int)format->src_alpha);
+    const __m256i modulation = _mm256_set1_epi64x((Sint64)(((Uint64)((info->flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255) << 48) |
+                                                           ((Uint64)((info->flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255) << 32) |
+                                                           ((Uint64)((info->flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255) << 16) |
+                                                           ((Uint64)((info->flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255))));
+    __m256i pixels;
+    Uint32 src_buffer[8];
+    Uint32 dst_buffer[8];
+    Uint64 srcy = 0, posy = 0, posx = 0, incy = 0, incx = 0;
+
+    if (scale) {
+        incy = ((Uint64)info->src_h << 16) / info->dst_h;
+        incx = ((Uint64)info->src_w << 16) / info->dst_w;
+        posy = incy / 2;
+    }
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+
+        if (scale) {
+            srcy = posy >> 16;
+            posx = incx / 2;
+        }
+        while (n > 0) {
+            /* Short runs go through the buffers, so every step is eight pixels */
+            const int count = SDL_min(n, 8);
+            Uint32 *d = dst;
+            int i;
+
+            if (scale) {
+                const Uint32 *row = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+                if (count == 8) {
+                    /* Loading straight into the vector avoids a store forwarding stall */
+                    pixels = _mm256_setr_epi32((int)row[posx >> 16], (int)row[(posx + incx) >> 16],
+                                               (int)row[(posx + 2 * incx) >> 16], (int)row[(posx + 3 * incx) >> 16],
+                                               (int)row[(posx + 4 * incx) >> 16], (int)row[(posx + 5 * incx) >> 16],
+                                               (int)row[(posx + 6 * incx) >> 16], (int)row[(posx + 7 * incx) >> 16]);
+                    posx += 8 * incx;
+                } else {
+                    for (i = 0; i < count; i++) {
+                        src_buffer[i] = row[posx >> 16];
+                        posx += incx;
+                    }
+                    pixels = _mm256_loadu_si256((const __m256i *)src_buffer);
+                }
+            } else if (count == 8) {
+                pixels = _mm256_loadu_si256((const __m256i *)src);
+            } else {
+                SDL_memcpy(src_buffer, src, count * sizeof(Uint32));
+                pixels = _mm256_loadu_si256((const __m256i *)src_buffer);
+            }
+            if (count < 8) {
+                SDL_memcpy(dst_buffer, dst, count * sizeof(Uint32));
+                d = dst_buffer;
+            }
+
+            pixels = _mm256_or_si256(_mm256_shuffle_epi8(pixels, src_shuffle), src_alpha);
+            if (modulate || mode) {
+                __m256i lo = _mm256_unpacklo_epi8(pixels, zero);
+                __m256i hi = _mm256_unpackhi_epi8(pixels, zero);
+                if (modulate) {
+                    lo = SDL_Div255_AVX2(_mm256_mullo_epi16(lo, modulation));
+                    hi = SDL_Div255_AVX2(_mm256_mullo_epi16(hi, modulation));
+                }
+                if (mode) {
+                    const __m256i dpixels = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)d), dst_in_shuffle);
+                    lo = SDL_BlendPixels_AVX2(lo, _mm256_unpacklo_epi8(dpixels, zero), mode);
+                    hi = SDL_BlendPixels_AVX2(hi, _mm256_unpackhi_epi8(dpixels, zero), mode);
+                }
+                pixels = _mm256_packus_epi16(lo, hi);
+            }
+            _mm256_storeu_si256((__m256i *)d, _mm256_shuffle_epi8(pixels, dst_shuffle));
+            if (count < 8) {
+                SDL_memcpy(dst, dst_buffer, count * sizeof(Uint32));
+            }
+            src += count;
+            dst += count;
+            n -= count;
+        }
+        if (scale) {
+            posy += incy;
+        } else {
+            info->src += info->src_pitch;
+        }
+        info->dst += info->dst_pitch;
+    }
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_Vector_Scale_AVX2(SDL_BlitInfo *info, const SDL_BlitVectorFormat *format)
+{
+    SDL_BlitPixels_AVX2(info, format, 0, 0, 1);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_Vector_Blend_AVX2(SDL_BlitInfo *info, const SDL_BlitVectorFormat *format)
+{
+    switch (info->flags & SDL_BLIT_VECTOR_MODES) {
+    case SDL_COPY_BLEND:
+        SDL_BlitPixels_AVX2(info, format, 0, SDL_COPY_BLEND, 0);
+        break;
+    case SDL_COPY_ADD:
+        SDL_BlitPixels_AVX2(info, format, 0, SDL_COPY_ADD, 0);
+        break;
+    case SDL_COPY_MOD:
+        SDL_BlitPixels_AVX2(info, format, 0, SDL_COPY_MOD, 0);
+        break;
+    case SDL_COPY_MUL:
+        SDL_BlitPixels_AVX2(info, format, 0, SDL_COPY_MUL, 0);
+        break;
+    default:
+        SDL_BlitPixels_AVX2(info, format, 0, SDL_BLIT_VECTOR_MODES, 0);
+        break;
+    }
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_Vector_Blend_Scale_AVX2(SDL_BlitInfo *info, const SDL_BlitVectorFormat *format)
+{
+    switch (info->flags & SDL_BLIT_VECTOR_MODES) {
+    case SDL_COPY_BLEND:
+        SDL_BlitPixels_AVX2(info, format, 0, SDL_COPY_BLEND, 1);
+        break;
+    case SDL_COPY_ADD:
+        SDL_BlitPixels_AVX2(info, format, 0, SDL_COPY_ADD, 1);
+        break;
+    case SDL_COPY_MOD:
+        SDL_BlitPixels_AVX2(info, format, 0, SDL_COPY_MOD, 1);
+        break;
+    case SDL_COPY_MUL:
+        SDL_BlitPixels_AVX2(info, format, 0, SDL_COPY_MUL, 1);
+        break;
+    default:
+        SDL_BlitPixels_AVX2(info, format, 0, SDL_BLIT_VECTOR_MODES, 1);
+        break;
+    }
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_Vector_Modulate_AVX2(SDL_BlitInfo *info, const SDL_BlitVectorFormat *format)
+{
+    SDL_BlitPixels_AVX2(info, format, 1, 0, 0);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_Vector_Modulate_Scale_AVX2(SDL_BlitInfo *info, const SDL_BlitVectorFormat *format)
+{
+    SDL_BlitPixels_AVX2(info, format, 1, 0, 1);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_Vector_Modulate_Blend_AVX2(SDL_BlitInfo *info, const SDL_BlitVectorFormat *format)
+{
+    switch (info->flags & SDL_BLIT_VECTOR_MODES) {
+    case SDL_COPY_BLEND:
+        SDL_BlitPixels_AVX2(info, format, 1, SDL_COPY_BLEND, 0);
+        break;
+    case SDL_COPY_ADD:
+        SDL_BlitPixels_AVX2(info, format, 1, SDL_COPY_ADD, 0);
+        break;
+    case SDL_COPY_MOD:
+        SDL_BlitPixels_AVX2(info, format, 1, SDL_COPY_MOD, 0);
+        break;
+    case SDL_COPY_MUL:
+        SDL_BlitPixels_AVX2(info, format, 1, SDL_COPY_MUL, 0);
+        break;
+    default:
+        SDL_BlitPixels_AVX2(info, format, 1, SDL_BLIT_VECTOR_MODES, 0);
+        break;
+    }
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info, const SDL_BlitVectorFormat *format)
+{
+    switch (info->flags & SDL_BLIT_VECTOR_MODES) {
+    case SDL_COPY_BLEND:
+        SDL_BlitPixels_AVX2(info, format, 1, SDL_COPY_BLEND, 1);
+        break;
+    case SDL_COPY_ADD:
+        SDL_BlitPixels_AVX2(info, format, 1, SDL_COPY_ADD, 1);
+        break;
+    case SDL_COPY_MOD:
+        SDL_BlitPixels_AVX2(info, format, 1, SDL_COPY_MOD, 1);
+        break;
+    case SDL_COPY_MUL:
+        SDL_BlitPixels_AVX2(info, format, 1, SDL_COPY_MUL, 1);
+        break;
+    default:
+        SDL_BlitPixels_AVX2(info, format, 1, SDL_BLIT_VECTOR_MODES, 1);
+        break;
+    }
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
 
 static void SDL_Blit_RGB888_RGB888_Scale(SDL_BlitInfo *info)
 {
@@ -388,6 +660,56 @@ static void SDL_Blit_RGB888_RGB888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_RGB888_RGB888_Vector = {
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 12, 13, 14, 0x80 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 12, 13, 14, 0x80 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 12, 13, 14, 0x80 },
+    0xFF000000
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_RGB888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_Vector_Copy);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_RGB888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_RGB888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_RGB888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_RGB888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_RGB888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_RGB888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_RGB888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_RGB888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_RGB888_RGB888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void SDL_Blit_RGB888_BGR888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -752,6 +1074,56 @@ static void SDL_Blit_RGB888_BGR888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_RGB888_BGR888_Vector = {
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 12, 13, 14, 0x80 },
+    { 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12, 0x80 },
+    { 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12, 0x80 },
+    0xFF000000
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_BGR888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_RGB888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_RGB888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_BGR888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_RGB888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_RGB888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_BGR888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_RGB888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_RGB888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_BGR888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_RGB888_BGR888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void SDL_Blit_RGB888_ARGB8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -1123,6 +1495,56 @@ static void SDL_Blit_RGB888_ARGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_RGB888_ARGB8888_Vector = {
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 12, 13, 14, 0x80 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    0xFF000000
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_ARGB8888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_RGB888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_RGB888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_ARGB8888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_RGB888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_RGB888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_ARGB8888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_RGB888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_RGB888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGB888_ARGB8888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_RGB888_ARGB8888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void SDL_Blit_BGR888_RGB888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -1487,6 +1909,56 @@ static void SDL_Blit_BGR888_RGB888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_BGR888_RGB888_Vector = {
+    { 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12, 0x80 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 12, 13, 14, 0x80 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 12, 13, 14, 0x80 },
+    0xFF000000
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_RGB888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_BGR888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_BGR888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_RGB888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_BGR888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_BGR888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_RGB888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_BGR888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_BGR888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_RGB888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_BGR888_RGB888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void SDL_Blit_BGR888_BGR888_Scale(SDL_BlitInfo *info)
 {
     Uint64 srcy, srcx;
@@ -1846,6 +2318,56 @@ static void SDL_Blit_BGR888_BGR888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_BGR888_BGR888_Vector = {
+    { 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12, 0x80 },
+    { 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12, 0x80 },
+    { 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12, 0x80 },
+    0xFF000000
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_BGR888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_Vector_Copy);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_BGR888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_BGR888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_BGR888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_BGR888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_BGR888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_BGR888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_BGR888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_BGR888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_BGR888_BGR888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void SDL_Blit_BGR888_ARGB8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -2219,6 +2741,56 @@ static void SDL_Blit_BGR888_ARGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_BGR888_ARGB8888_Vector = {
+    { 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12, 0x80 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    0xFF000000
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_ARGB8888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_BGR888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_BGR888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_ARGB8888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_BGR888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_BGR888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_ARGB8888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_BGR888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_BGR888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGR888_ARGB8888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_BGR888_ARGB8888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void SDL_Blit_ARGB8888_RGB888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -2601,6 +3173,56 @@ static void SDL_Blit_ARGB8888_RGB888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_ARGB8888_RGB888_Vector = {
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 12, 13, 14, 0x80 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 12, 13, 14, 0x80 },
+    0
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_RGB888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_ARGB8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_ARGB8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_RGB888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_ARGB8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_ARGB8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_RGB888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_ARGB8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_ARGB8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_RGB888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_ARGB8888_RGB888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void SDL_Blit_ARGB8888_BGR888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -2985,6 +3607,56 @@ static void SDL_Blit_ARGB8888_BGR888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_ARGB8888_BGR888_Vector = {
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12, 0x80 },
+    { 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12, 0x80 },
+    0
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_BGR888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_ARGB8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_ARGB8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_BGR888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_ARGB8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_ARGB8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_BGR888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_ARGB8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_ARGB8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_BGR888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_ARGB8888_BGR888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void SDL_Blit_ARGB8888_ARGB8888_Scale(SDL_BlitInfo *info)
 {
     Uint64 srcy, srcx;
@@ -3376,6 +4048,56 @@ static void SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_ARGB8888_ARGB8888_Vector = {
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    0
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_ARGB8888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_Vector_Copy);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_ARGB8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_ARGB8888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_ARGB8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_ARGB8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_ARGB8888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_ARGB8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_ARGB8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_ARGB8888_ARGB8888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void SDL_Blit_RGBA8888_RGB888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -3758,6 +4480,56 @@ static void SDL_Blit_RGBA8888_RGB888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_RGBA8888_RGB888_Vector = {
+    { 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 12, 13, 14, 0x80 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 12, 13, 14, 0x80 },
+    0
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_RGB888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_RGBA8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_RGBA8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_RGB888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_RGBA8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_RGBA8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_RGB888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_RGBA8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_RGBA8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_RGB888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_RGBA8888_RGB888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void SDL_Blit_RGBA8888_BGR888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -4142,6 +4914,56 @@ static void SDL_Blit_RGBA8888_BGR888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_RGBA8888_BGR888_Vector = {
+    { 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12 },
+    { 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12, 0x80 },
+    { 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12, 0x80 },
+    0
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_BGR888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_RGBA8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_RGBA8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_BGR888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_RGBA8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_RGBA8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_BGR888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_RGBA8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_RGBA8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_BGR888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_RGBA8888_BGR888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void SDL_Blit_RGBA8888_ARGB8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -4536,6 +5358,56 @@ static void SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_RGBA8888_ARGB8888_Vector = {
+    { 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    0
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_ARGB8888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_RGBA8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_RGBA8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_ARGB8888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_RGBA8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_RGBA8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_ARGB8888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_RGBA8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_RGBA8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_RGBA8888_ARGB8888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void SDL_Blit_ABGR8888_RGB888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -4920,6 +5792,56 @@ static void SDL_Blit_ABGR8888_RGB888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_ABGR8888_RGB888_Vector = {
+    { 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 12, 13, 14, 0x80 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 12, 13, 14, 0x80 },
+    0
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_RGB888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_ABGR8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_ABGR8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_RGB888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_ABGR8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_ABGR8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_RGB888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_ABGR8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_ABGR8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_RGB888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_ABGR8888_RGB888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void SDL_Blit_ABGR8888_BGR888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -5302,6 +6224,56 @@ static void SDL_Blit_ABGR8888_BGR888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_ABGR8888_BGR888_Vector = {
+    { 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15 },
+    { 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12, 0x80 },
+    { 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12, 0x80 },
+    0
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_BGR888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_ABGR8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_ABGR8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_BGR888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_ABGR8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_ABGR8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_BGR888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_ABGR8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_ABGR8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_BGR888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_ABGR8888_BGR888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void SDL_Blit_ABGR8888_ARGB8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -5698,6 +6670,56 @@ static void SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_ABGR8888_ARGB8888_Vector = {
+    { 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    0
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_ARGB8888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_ABGR8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_ABGR8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_ARGB8888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_ABGR8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_ABGR8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_ARGB8888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_ABGR8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_ABGR8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_ABGR8888_ARGB8888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void SDL_Blit_BGRA8888_RGB888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -6082,6 +7104,56 @@ static void SDL_Blit_BGRA8888_RGB888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_BGRA8888_RGB888_Vector = {
+    { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 12, 13, 14, 0x80 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 12, 13, 14, 0x80 },
+    0
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_RGB888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_BGRA8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_RGB888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_BGRA8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_RGB888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_BGRA8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_RGB888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_BGRA8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_RGB888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_BGRA8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_RGB888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_BGRA8888_RGB888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_RGB888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_BGRA8888_RGB888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void SDL_Blit_BGRA8888_BGR888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -6464,6 +7536,56 @@ static void SDL_Blit_BGRA8888_BGR888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_BGRA8888_BGR888_Vector = {
+    { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 },
+    { 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12, 0x80 },
+    { 2, 1, 0, 0x80, 6, 5, 4, 0x80, 10, 9, 8, 0x80, 14, 13, 12, 0x80 },
+    0
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_BGR888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_BGRA8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_BGR888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_BGRA8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_BGR888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_BGRA8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_BGR888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_BGRA8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_BGR888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_BGRA8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_BGR888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_BGRA8888_BGR888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_BGR888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_BGRA8888_BGR888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void SDL_Blit_BGRA8888_ARGB8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -6860,132 +7982,560 @@ static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+static const SDL_BlitVectorFormat SDL_Blit_BGRA8888_ARGB8888_Vector = {
+    { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    0
+};
+
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_ARGB8888_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Scale_AVX2(info, &SDL_Blit_BGRA8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_ARGB8888_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_AVX2(info, &SDL_Blit_BGRA8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_ARGB8888_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Blend_Scale_AVX2(info, &SDL_Blit_BGRA8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_ARGB8888_Modulate_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_AVX2(info, &SDL_Blit_BGRA8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_ARGB8888_Modulate_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Scale_AVX2(info, &SDL_Blit_BGRA8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_AVX2(info, &SDL_Blit_BGRA8888_ARGB8888_Vector);
+}
+
+static void SDL_TARGETING_AVX2 SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale_AVX2(SDL_BlitInfo *info)
+{
+    SDL_Blit_Vector_Modulate_Blend_Scale_AVX2(info, &SDL_Blit_BGRA8888_ARGB8888_Vector);
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_RGB888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Modulate_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_BGR888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_BGR888_Modulate_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGB888_ARGB8888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_ARGB8888_Modulate_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_RGB888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_RGB888_Modulate_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_BGR888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_BGR888_Modulate_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGR888_ARGB8888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGR888_ARGB8888_Modulate_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_RGB888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_RGB888_Modulate_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_BGR888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_BGR888_Modulate_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_RGB888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_RGB888_Modulate_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_BGR888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_BGR888_Modulate_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_RGB888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_RGB888_Modulate_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_BGR888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_BGR888_Modulate_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_RGB888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_RGB888_Modulate_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_BGR888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_BGR888_Modulate_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Blend_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Modulate_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Modulate },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Modulate_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Modulate_Scale },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend },
+#ifdef HAVE_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale_AVX2 },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale },
     { 0, 0, 0, 0, NULL }
 };
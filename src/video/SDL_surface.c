@@ -153,7 +153,7 @@ SDL_Surface *SDL_CreateRGBSurfaceWithFormat(Uint32 flags, int width, int height,
             return NULL;
         }
 
-        surface->pixels = SDL_SIMDAlloc(size);
+        surface->pixels = SDL_TaggedSIMDAlloc(SDL_MEMORY_TAG_VIDEO, size);
         if (!surface->pixels) {
             SDL_FreeSurface(surface);
             SDL_OutOfMemory();
@@ -677,8 +677,7 @@ void SDL_GetClipRect(SDL_Surface *surface, SDL_Rect *rect)
  * you know exactly what you are doing, you can optimize your code
  * by calling the one(s) you need.
  */
-int SDL_LowerBlit(SDL_Surface *src, SDL_Rect *srcrect,
-                  SDL_Surface *dst, SDL_Rect *dstrect)
+static int SDL_ValidateMap(SDL_Surface *src, SDL_Surface *dst)
 {
     /* Check to make sure the blit mapping is valid */
     if ((src->map->dst != dst) ||
@@ -695,9 +694,27 @@ int SDL_LowerBlit(SDL_Surface *src, SDL_Rect *srcrect,
         /*              src, dst->flags, src->map->info.flags, dst, dst->flags, */
         /*              dst->map->info.flags, src->map->blit); */
     }
+    return 0;
+}
+
+int SDL_LowerBlit(SDL_Surface *src, SDL_Rect *srcrect,
+                  SDL_Surface *dst, SDL_Rect *dstrect)
+{
+    if (SDL_ValidateMap(src, dst) < 0) {
+        return -1;
+    }
     return src->map->blit(src, srcrect, dst, dstrect);
 }
 
+/* Blit a whole image for a conversion, large ones may be split across threads */
+static int SDL_ConvertBlit(SDL_Surface *src, SDL_Rect *rect, SDL_Surface *dst)
+{
+    if (SDL_ValidateMap(src, dst) < 0) {
+        return -1;
+    }
+    return SDL_SoftBlitRowBands(src, rect, dst, rect, SDL_GetRowBandCount(rect->w, rect->h));
+}
+
 int SDL_UpperBlit(SDL_Surface *src, const SDL_Rect *srcrect,
                   SDL_Surface *dst, SDL_Rect *dstrect)
 {
@@ -1226,7 +1243,7 @@ SDL_Surface *SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * f
         }
     }
 
-    ret = SDL_LowerBlit(surface, &bounds, convert, &bounds);
+    ret = SDL_ConvertBlit(surface, &bounds, convert);
 
     /* Restore colorkey alpha value */
     if (palette_ck_transform) {
@@ -1466,7 +1483,7 @@ int SDL_ConvertPixels(int width, int height,
     rect.y = 0;
     rect.w = width;
     rect.h = height;
-    ret = SDL_LowerBlit(&src_surface, &rect, &dst_surface, &rect);
+    ret = SDL_ConvertBlit(&src_surface, &rect, &dst_surface);
 
     /* Free blitmap reference, after blitting between stack'ed surfaces */
     SDL_InvalidateMap(src_surface.map);
@@ -1474,6 +1491,49 @@ int SDL_ConvertPixels(int width, int height,
     return ret;
 }
 
+typedef struct
+{
+    int width;
+    const Uint8 *src;
+    int src_pitch;
+    Uint8 *dst;
+    int dst_pitch;
+} SDL_PremultiplyAlphaData;
+
+static void SDL_PremultiplyAlphaRows(void *userdata, int y, int height)
+{
+    const SDL_PremultiplyAlphaData *data = (const SDL_PremultiplyAlphaData *)userdata;
+    const Uint8 *src = data->src + y * data->src_pitch;
+    Uint8 *dst = data->dst + y * data->dst_pitch;
+    int c;
+    Uint32 srcpixel;
+    Uint32 srcR, srcG, srcB, srcA;
+    Uint32 dstpixel;
+    Uint32 dstR, dstG, dstB, dstA;
+
+    while (height--) {
+        const Uint32 *src_px = (const Uint32 *)src;
+        Uint32 *dst_px = (Uint32 *)dst;
+        for (c = data->width; c; --c) {
+            /* Component bytes extraction. */
+            srcpixel = *src_px++;
+            RGBA_FROM_ARGB8888(srcpixel, srcR, srcG, srcB, srcA);
+
+            /* Alpha pre-multiplication of each component. */
+            dstA = srcA;
+            dstR = (srcA * srcR) / 255;
+            dstG = (srcA * srcG) / 255;
+            dstB = (srcA * srcB) / 255;
+
+            /* ARGB8888 pixel recomposition. */
+            ARGB8888_FROM_RGBA(dstpixel, dstR, dstG, dstB, dstA);
+            *dst_px++ = dstpixel;
+        }
+        src += data->src_pitch;
+        dst += data->dst_pitch;
+    }
+}
+
 /*
  * Premultiply the alpha on a block of pixels
  *
@@ -1487,11 +1547,7 @@ int SDL_PremultiplyAlpha(int width, int height,
                          Uint32 src_format, const void *src, int src_pitch,
                          Uint32 dst_format, void *dst, int dst_pitch)
 {
-    int c;
-    Uint32 srcpixel;
-    Uint32 srcR, srcG, srcB, srcA;
-    Uint32 dstpixel;
-    Uint32 dstR, dstG, dstB, dstA;
+    SDL_PremultiplyAlphaData data;
 
     if (!src) {
         return SDL_InvalidParamError("src");
@@ -1512,27 +1568,12 @@ int SDL_PremultiplyAlpha(int width, int height,
         return SDL_InvalidParamError("dst_format");
     }
 
-    while (height--) {
-        const Uint32 *src_px = (const Uint32 *)src;
-        Uint32 *dst_px = (Uint32 *)dst;
-        for (c = width; c; --c) {
-            /* Component bytes extraction. */
-            srcpixel = *src_px++;
-            RGBA_FROM_ARGB8888(srcpixel, srcR, srcG, srcB, srcA);
-
-            /* Alpha pre-multiplication of each component. */
-            dstA = srcA;
-            dstR = (srcA * srcR) / 255;
-            dstG = (srcA * srcG) / 255;
-            dstB = (srcA * srcB) / 255;
-
-            /* ARGB8888 pixel recomposition. */
-            ARGB8888_FROM_RGBA(dstpixel, dstR, dstG, dstB, dstA);
-            *dst_px++ = dstpixel;
-        }
-        src = (const Uint8 *)src + src_pitch;
-        dst = (Uint8 *)dst + dst_pitch;
-    }
+    data.width = width;
+    data.src = (const Uint8 *)src;
+    data.src_pitch = src_pitch;
+    data.dst = (Uint8 *)dst;
+    data.dst_pitch = dst_pitch;
+    SDL_RunRowBands(SDL_PremultiplyAlphaRows, &data, height, SDL_GetRowBandCount(width, height), 1);
     return 0;
 }
 
@@ -2701,6 +2701,11 @@ static SDL_bool ShouldAttemptTextureFramebuffer(void)
 #endif
 #if defined(__EMSCRIPTEN__)
         attempt_texture_framebuffer = SDL_FALSE;
+#endif
+#ifdef SDL_VIDEO_DRIVER_WEBROGUE /* The webrogue framebuffer only uploads dirty rects, which beats re-uploading a whole streaming texture. */
+        if (_this->CreateWindowFramebuffer && (SDL_strcmp(_this->name, "webrogue") == 0)) {
+            attempt_texture_framebuffer = SDL_FALSE;
+        }
 #endif
     }
     return attempt_texture_framebuffer;
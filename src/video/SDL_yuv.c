@@ -20,6 +20,7 @@
 */
 #include "../SDL_internal.h"
 
+#include "SDL_atomic.h"
 #include "SDL_endian.h"
 #include "SDL_video.h"
 #include "SDL_pixels_c.h"
@@ -559,34 +560,100 @@ static SDL_bool yuv_rgb_std(
     return SDL_FALSE;
 }
 
+typedef struct
+{
+    Uint32 src_format;
+    Uint32 dst_format;
+    Uint32 width;
+    int height;
+    const Uint8 *y;
+    const Uint8 *u;
+    const Uint8 *v;
+    Uint32 y_stride;
+    Uint32 uv_stride;
+    Uint8 *rgb;
+    Uint32 rgb_stride;
+    YCbCrType yuv_type;
+    SDL_atomic_t unsupported;
+} YUVToRGBData;
+
+static SDL_bool yuv_rgb(
+    Uint32 src_format, Uint32 dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    return yuv_rgb_sse(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type) ||
+           yuv_rgb_lsx(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type) ||
+           yuv_rgb_std(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+}
+
+/* Convert rows [row, row + height) of the image, row is even for the planar formats */
+static void yuv_rgb_rows(void *userdata, int row, int height)
+{
+    YUVToRGBData *data = (YUVToRGBData *)userdata;
+    const Uint32 uv_row = IsPlanar2x2Format(data->src_format) ? (row / 2) : row;
+    const Uint8 *y = data->y + row * data->y_stride;
+    const Uint8 *u = data->u + uv_row * data->uv_stride;
+    const Uint8 *v = data->v + uv_row * data->uv_stride;
+    Uint8 *rgb = data->rgb + row * data->rgb_stride;
+
+    if (!yuv_rgb(data->src_format, data->dst_format, data->width, height, y, u, v, data->y_stride, data->uv_stride, rgb, data->rgb_stride, data->yuv_type)) {
+        /* Every band gets here, nothing was converted */
+        SDL_AtomicSet(&data->unsupported, 1);
+        return;
+    }
+
+    /* The SIMD converters for packed formats handle the last row of the
+       image differently, so redo the last row of a band that isn't
+       together with the row after it, like a single conversion would. */
+    if (!IsPlanar2x2Format(data->src_format) && height > 0 && (row + height) < data->height) {
+        const Uint32 rgb_size = data->width * SDL_BYTESPERPIXEL(data->dst_format);
+        Uint8 *tmp = (Uint8 *)SDL_malloc(rgb_size * 2);
+
+        if (tmp) {
+            const Uint32 last = (Uint32)height - 1;
+
+            yuv_rgb(data->src_format, data->dst_format, data->width, 2,
+                    y + last * data->y_stride, u + last * data->uv_stride, v + last * data->uv_stride,
+                    data->y_stride, data->uv_stride, tmp, rgb_size, data->yuv_type);
+            SDL_memcpy(rgb + last * data->rgb_stride, tmp, rgb_size);
+            SDL_free(tmp);
+        }
+    }
+}
+
 int SDL_ConvertPixels_YUV_to_RGB(int width, int height,
                                  Uint32 src_format, const void *src, int src_pitch,
                                  Uint32 dst_format, void *dst, int dst_pitch)
 {
-    const Uint8 *y = NULL;
-    const Uint8 *u = NULL;
-    const Uint8 *v = NULL;
-    Uint32 y_stride = 0;
-    Uint32 uv_stride = 0;
-    YCbCrType yuv_type = YCBCR_601;
-
-    if (GetYUVPlanes(width, height, src_format, src, src_pitch, &y, &u, &v, &y_stride, &uv_stride) < 0) {
+    YUVToRGBData data;
+
+    data.src_format = src_format;
+    data.dst_format = dst_format;
+    data.width = width;
+    data.height = height;
+    data.y = NULL;
+    data.u = NULL;
+    data.v = NULL;
+    data.y_stride = 0;
+    data.uv_stride = 0;
+    data.rgb = (Uint8 *)dst;
+    data.rgb_stride = dst_pitch;
+    data.yuv_type = YCBCR_601;
+    SDL_AtomicSet(&data.unsupported, 0);
+
+    if (GetYUVPlanes(width, height, src_format, src, src_pitch, &data.y, &data.u, &data.v, &data.y_stride, &data.uv_stride) < 0) {
         return -1;
     }
 
-    if (GetYUVConversionType(width, height, &yuv_type) < 0) {
+    if (GetYUVConversionType(width, height, &data.yuv_type) < 0) {
         return -1;
     }
 
-    if (yuv_rgb_sse(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
-        return 0;
-    }
-
-    if (yuv_rgb_lsx(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
-        return 0;
-    }
-
-    if (yuv_rgb_std(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
+    SDL_RunRowBands(yuv_rgb_rows, &data, height, SDL_GetRowBandCount(width, height), IsPlanar2x2Format(src_format) ? 2 : 1);
+    if (!SDL_AtomicGet(&data.unsupported)) {
         return 0;
     }
 
@@ -625,40 +692,61 @@ struct RGB2YUVFactors
     float v[3]; /* Rfactor, Gfactor, Bfactor */
 };
 
-static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int src_pitch, Uint32 dst_format, void *dst, int dst_pitch)
+static const struct RGB2YUVFactors RGB2YUVFactorTables[SDL_YUV_CONVERSION_BT709 + 1] = {
+    /* ITU-T T.871 (JPEG) */
+    {
+        0,
+        { 0.2990f, 0.5870f, 0.1140f },
+        { -0.1687f, -0.3313f, 0.5000f },
+        { 0.5000f, -0.4187f, -0.0813f },
+    },
+    /* ITU-R BT.601-7 */
+    {
+        16,
+        { 0.2568f, 0.5041f, 0.0979f },
+        { -0.1482f, -0.2910f, 0.4392f },
+        { 0.4392f, -0.3678f, -0.0714f },
+    },
+    /* ITU-R BT.709-6 */
+    {
+        16,
+        { 0.1826f, 0.6142f, 0.0620f },
+        { -0.1006f, -0.3386f, 0.4392f },
+        { 0.4392f, -0.3989f, -0.0403f },
+    },
+};
+
+typedef struct
+{
+    const struct RGB2YUVFactors *cvt;
+    int width;
+    const Uint8 *src;
+    int src_pitch;
+    Uint32 dst_format;
+    Uint8 *plane_y; /* the packed plane for packed formats */
+    Uint8 *plane_u;
+    Uint8 *plane_v;
+    Uint8 *plane_interleaved_uv;
+    Uint32 y_stride;
+    Uint32 uv_stride;
+} ARGB8888ToYUVData;
+
+/* Convert rows [row, row + height) of the image, row is even for the planar formats */
+static void SDL_ConvertPixels_ARGB8888_to_YUV_Rows(void *userdata, int row, int height)
 {
+    const ARGB8888ToYUVData *data = (const ARGB8888ToYUVData *)userdata;
+    const struct RGB2YUVFactors *cvt = data->cvt;
+    const int width = data->width;
+    const int src_pitch = data->src_pitch;
+    const Uint32 dst_format = data->dst_format;
     const int src_pitch_x_2 = src_pitch * 2;
     const int height_half = height / 2;
     const int height_remainder = (height & 0x1);
     const int width_half = width / 2;
     const int width_remainder = (width & 0x1);
+    const Uint8 *src = data->src + row * src_pitch;
     int i, j;
 
-    static struct RGB2YUVFactors RGB2YUVFactorTables[SDL_YUV_CONVERSION_BT709 + 1] = {
-        /* ITU-T T.871 (JPEG) */
-        {
-            0,
-            { 0.2990f, 0.5870f, 0.1140f },
-            { -0.1687f, -0.3313f, 0.5000f },
-            { 0.5000f, -0.4187f, -0.0813f },
-        },
-        /* ITU-R BT.601-7 */
-        {
-            16,
-            { 0.2568f, 0.5041f, 0.0979f },
-            { -0.1482f, -0.2910f, 0.4392f },
-            { 0.4392f, -0.3678f, -0.0714f },
-        },
-        /* ITU-R BT.709-6 */
-        {
-            16,
-            { 0.1826f, 0.6142f, 0.0620f },
-            { -0.1006f, -0.3386f, 0.4392f },
-            { 0.4392f, -0.3989f, -0.0403f },
-        },
-    };
-    const struct RGB2YUVFactors *cvt = &RGB2YUVFactorTables[SDL_GetYUVConversionModeForResolution(width, height)];
-
 #define MAKE_Y(r, g, b) (Uint8)((int)(cvt->y[0] * (r) + cvt->y[1] * (g) + cvt->y[2] * (b) + 0.5f) + cvt->y_offset)
 #define MAKE_U(r, g, b) (Uint8)((int)(cvt->u[0] * (r) + cvt->u[1] * (g) + cvt->u[2] * (b) + 0.5f) + 128)
 #define MAKE_V(r, g, b) (Uint8)((int)(cvt->v[0] * (r) + cvt->v[1] * (g) + cvt->v[2] * (b) + 0.5f) + 128)
@@ -715,19 +803,14 @@ static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *
     {
         const Uint8 *curr_row, *next_row;
 
-        Uint8 *plane_y;
-        Uint8 *plane_u;
-        Uint8 *plane_v;
-        Uint8 *plane_interleaved_uv;
-        Uint32 y_stride, uv_stride, y_skip, uv_skip;
+        const Uint32 y_stride = data->y_stride;
+        const Uint32 uv_stride = data->uv_stride;
+        Uint8 *plane_y = data->plane_y + row * y_stride;
+        Uint8 *plane_u = data->plane_u + (row / 2) * uv_stride;
+        Uint8 *plane_v = data->plane_v + (row / 2) * uv_stride;
+        Uint8 *plane_interleaved_uv = data->plane_interleaved_uv + (row / 2) * uv_stride;
+        Uint32 y_skip, uv_skip;
 
-        if (GetYUVPlanes(width, height, dst_format, dst, dst_pitch,
-                         (const Uint8 **)&plane_y, (const Uint8 **)&plane_u, (const Uint8 **)&plane_v,
-                         &y_stride, &uv_stride) != 0) {
-            return -1;
-        }
-
-        plane_interleaved_uv = (plane_y + height * y_stride);
         y_skip = (y_stride - width);
 
         curr_row = (const Uint8 *)src;
@@ -848,14 +931,9 @@ static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *
     case SDL_PIXELFORMAT_YVYU:
     {
         const Uint8 *curr_row = (const Uint8 *)src;
-        Uint8 *plane = (Uint8 *)dst;
+        Uint8 *plane = data->plane_y + row * data->y_stride;
         const int row_size = (4 * ((width + 1) / 2));
-        int plane_skip;
-
-        if (dst_pitch < row_size) {
-            return SDL_SetError("Destination pitch is too small, expected at least %d\n", row_size);
-        }
-        plane_skip = (dst_pitch - row_size);
+        const int plane_skip = (data->y_stride - row_size);
 
         /* Write YUV plane, packed */
         if (dst_format == SDL_PIXELFORMAT_YUY2) {
@@ -925,7 +1003,7 @@ static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *
     } break;
 
     default:
-        return SDL_SetError("Unsupported YUV destination format: %s", SDL_GetPixelFormatName(dst_format));
+        break;
     }
 #undef MAKE_Y
 #undef MAKE_U
@@ -936,6 +1014,53 @@ static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *
 #undef READ_1x1_PIXEL
 #undef READ_TWO_RGB_PIXELS
 #undef READ_ONE_RGB_PIXEL
+}
+
+static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int src_pitch, Uint32 dst_format, void *dst, int dst_pitch)
+{
+    ARGB8888ToYUVData data;
+    int align = 1;
+
+    data.cvt = &RGB2YUVFactorTables[SDL_GetYUVConversionModeForResolution(width, height)];
+    data.width = width;
+    data.src = (const Uint8 *)src;
+    data.src_pitch = src_pitch;
+    data.dst_format = dst_format;
+
+    switch (dst_format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        if (GetYUVPlanes(width, height, dst_format, dst, dst_pitch,
+                         (const Uint8 **)&data.plane_y, (const Uint8 **)&data.plane_u, (const Uint8 **)&data.plane_v,
+                         &data.y_stride, &data.uv_stride) != 0) {
+            return -1;
+        }
+        data.plane_interleaved_uv = (data.plane_y + height * data.y_stride);
+        align = 2;
+        break;
+
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+    {
+        const int row_size = (4 * ((width + 1) / 2));
+
+        if (dst_pitch < row_size) {
+            return SDL_SetError("Destination pitch is too small, expected at least %d\n", row_size);
+        }
+        data.plane_y = (Uint8 *)dst;
+        data.plane_u = data.plane_v = data.plane_interleaved_uv = NULL;
+        data.y_stride = dst_pitch;
+        data.uv_stride = 0;
+    } break;
+
+    default:
+        return SDL_SetError("Unsupported YUV destination format: %s", SDL_GetPixelFormatName(dst_format));
+    }
+
+    SDL_RunRowBands(SDL_ConvertPixels_ARGB8888_to_YUV_Rows, &data, height, SDL_GetRowBandCount(width, height), align);
     return 0;
 }
 
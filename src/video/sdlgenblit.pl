@@ -58,6 +58,21 @@ my %format_type = (
     "BGRA8888" => "Uint32",
 );
 
+# Where the channels are in the pixel bytes, on little endian
+my %format_bytes = (
+    "RGB888" => { "R" => 2, "G" => 1, "B" => 0 },
+    "BGR888" => { "B" => 2, "G" => 1, "R" => 0 },
+    "ARGB8888" => { "A" => 3, "R" => 2, "G" => 1, "B" => 0 },
+    "RGBA8888" => { "R" => 3, "G" => 2, "B" => 1, "A" => 0 },
+    "ABGR8888" => { "A" => 3, "B" => 2, "G" => 1, "R" => 0 },
+    "BGRA8888" => { "B" => 3, "G" => 2, "R" => 1, "A" => 0 },
+);
+
+# The vector blitters we're creating, with the macro that enables them
+my @vector_cpus = (
+    "AVX2",
+);
+
 my %get_rgba_string_ignore_alpha = (
     "RGB888" => "_R = (Uint8)(_pixel >> 16); _G = (Uint8)(_pixel >> 8); _B = (Uint8)_pixel;",
     "BGR888" => "_B = (Uint8)(_pixel >> 16); _G = (Uint8)(_pixel >> 8); _R = (Uint8)_pixel;",
@@ -405,6 +420,162 @@ __EOF__
     }
 }
 
+sub output_vectorfuncname
+{
+    my $prefix = shift;
+    my $modulate = shift;
+    my $blend = shift;
+    my $scale = shift;
+    my $cpu = shift;
+
+    my $name = "$prefix SDL_Blit_Vector";
+    if ( $modulate ) {
+        $name = "${name}_Modulate";
+    }
+    if ( $blend ) {
+        $name = "${name}_Blend";
+    }
+    if ( $scale ) {
+        $name = "${name}_Scale";
+    }
+    return "${name}_$cpu";
+}
+
+sub output_vectorkernel
+{
+    my $modulate = shift;
+    my $blend = shift;
+    my $scale = shift;
+    my $cpu = shift;
+    my $target = " SDL_TARGETING_$cpu";
+    my $name = output_vectorfuncname("static void$target", $modulate, $blend, $scale, $cpu);
+
+    print FILE <<__EOF__;
+$name(SDL_BlitInfo *info, const SDL_BlitVectorFormat *format)
+{
+__EOF__
+    if ( $blend ) {
+        print FILE <<__EOF__;
+    switch (info->flags & SDL_BLIT_VECTOR_MODES) {
+__EOF__
+        foreach my $mode ("SDL_COPY_BLEND", "SDL_COPY_ADD", "SDL_COPY_MOD", "SDL_COPY_MUL") {
+            print FILE <<__EOF__;
+    case $mode:
+        SDL_BlitPixels_$cpu(info, format, $modulate, $mode, $scale);
+        break;
+__EOF__
+        }
+        print FILE <<__EOF__;
+    default:
+        SDL_BlitPixels_$cpu(info, format, $modulate, SDL_BLIT_VECTOR_MODES, $scale);
+        break;
+    }
+__EOF__
+    } else {
+        print FILE <<__EOF__;
+    SDL_BlitPixels_$cpu(info, format, $modulate, 0, $scale);
+__EOF__
+    }
+    print FILE <<__EOF__;
+}
+
+__EOF__
+}
+
+sub output_vectorkernels
+{
+    foreach my $cpu (@vector_cpus) {
+        print FILE <<__EOF__;
+#ifdef HAVE_${cpu}_INTRINSICS
+
+__EOF__
+        for (my $modulate = 0; $modulate <= 1; ++$modulate) {
+            for (my $blend = 0; $blend <= 1; ++$blend) {
+                for (my $scale = 0; $scale <= 1; ++$scale) {
+                    if ( $modulate || $blend || $scale ) {
+                        output_vectorkernel($modulate, $blend, $scale, $cpu);
+                    }
+                }
+            }
+        }
+        print FILE <<__EOF__;
+#endif /* HAVE_${cpu}_INTRINSICS */
+
+__EOF__
+    }
+}
+
+sub vector_mask
+{
+    my @channels = @_;
+    my @mask;
+
+    for (my $pixel = 0; $pixel < 4; ++$pixel) {
+        foreach my $byte (@channels) {
+            if ( $byte < 0 ) {
+                push(@mask, "0x80");
+            } else {
+                push(@mask, $pixel * 4 + $byte);
+            }
+        }
+    }
+    return "{ " . join(", ", @mask) . " }";
+}
+
+sub output_vectorformat
+{
+    my $src = shift;
+    my $dst = shift;
+    my @argb = ("B", "G", "R", "A");
+    my (@src, @dst, @dst_in);
+
+    foreach my $channel (@argb) {
+        push(@src, exists $format_bytes{$src}{$channel} ? $format_bytes{$src}{$channel} : -1);
+        push(@dst_in, exists $format_bytes{$dst}{$channel} ? $format_bytes{$dst}{$channel} : -1);
+    }
+    for (my $byte = 0; $byte < 4; ++$byte) {
+        my $index = -1;
+        for (my $i = 0; $i < 4; ++$i) {
+            if ( exists $format_bytes{$dst}{$argb[$i]} && $format_bytes{$dst}{$argb[$i]} == $byte ) {
+                $index = $i;
+            }
+        }
+        push(@dst, $index);
+    }
+    my $src_alpha = exists $format_bytes{$src}{"A"} ? "0" : "0xFF000000";
+
+    print FILE "static const SDL_BlitVectorFormat SDL_Blit_${src}_${dst}_Vector = {\n";
+    print FILE "    " . vector_mask(@src) . ",\n";
+    print FILE "    " . vector_mask(@dst) . ",\n";
+    print FILE "    " . vector_mask(@dst_in) . ",\n";
+    print FILE "    $src_alpha\n";
+    print FILE "};\n\n";
+}
+
+sub output_vectorfunc
+{
+    my $src = shift;
+    my $dst = shift;
+    my $modulate = shift;
+    my $blend = shift;
+    my $scale = shift;
+    my $cpu = shift;
+    my $target = " SDL_TARGETING_$cpu";
+    my $kernel = output_vectorfuncname("", $modulate, $blend, $scale, $cpu);
+    my $format = "SDL_Blit_${src}_${dst}_Vector";
+
+    if ( !$modulate && !$blend && $src eq $dst ) {
+        $format = "SDL_Blit_Vector_Copy";
+    }
+    output_copyfuncname("static void$target", $src, $dst, $modulate, $blend, $scale, 0, "_$cpu(SDL_BlitInfo *info)\n");
+    print FILE <<__EOF__;
+{
+   $kernel(info, &$format);
+}
+
+__EOF__
+}
+
 sub output_copyfunc
 {
     my $src = shift;
@@ -586,6 +757,181 @@ sub output_copyinc
 #include "SDL_video.h"
 #include "SDL_blit.h"
 #include "SDL_blit_auto.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
+
+__EOF__
+}
+
+sub output_vectorinc
+{
+    print FILE <<'__EOF__';
+/* Vector versions of the blitters for the 32-bit formats.
+ *
+ * Pixels are shuffled into ARGB8888 byte order, widened to 16 bits per
+ * channel, and put through the same integer math as the scalar blitters,
+ * so the output is identical. x / 255 is computed exactly as
+ * (x + 1 + (x >> 8)) >> 8, which holds for every product of two channels.
+ */
+#if SDL_BYTEORDER != SDL_LIL_ENDIAN
+#undef HAVE_AVX2_INTRINSICS
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+
+/* How to get from the source and destination formats to ARGB8888 and back.
+   Each mask covers four pixels, 0x80 zeroes the byte. */
+typedef struct
+{
+    Uint8 src[16];
+    Uint8 dst[16];
+    Uint8 dst_in[16];
+    Uint32 src_alpha; /* alpha of sources without an alpha channel */
+} SDL_BlitVectorFormat;
+
+/* Keeps the bytes as they are, for scaling without conversion */
+static const SDL_BlitVectorFormat SDL_Blit_Vector_Copy = {
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    0
+};
+
+/* The blitters take one of these as the mode, SDL_BLIT_VECTOR_MODES to
+   write back the destination as it is, or 0 to not blend at all. */
+#define SDL_BLIT_VECTOR_MODES (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)
+
+SDL_FORCE_INLINE __m256i SDL_TARGETING_AVX2 SDL_Div255_AVX2(__m256i x)
+{
+    return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(x, _mm256_set1_epi16(1)), _mm256_srli_epi16(x, 8)), 8);
+}
+
+/* Blends one half of the pixels, 16 bits per channel */
+SDL_FORCE_INLINE __m256i SDL_TARGETING_AVX2 SDL_BlendPixels_AVX2(__m256i s, __m256i d, const int mode)
+{
+    const __m256i v255 = _mm256_set1_epi16(255);
+    const __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    __m256i t, m;
+
+    switch (mode) {
+    case SDL_COPY_BLEND:
+    case SDL_COPY_ADD:
+        /* Premultiply the color, alpha stays as it is */
+        s = SDL_Div255_AVX2(_mm256_mullo_epi16(s, _mm256_blend_epi16(alpha, v255, 0x88)));
+        if (mode == SDL_COPY_BLEND) {
+            return _mm256_add_epi16(s, SDL_Div255_AVX2(_mm256_mullo_epi16(_mm256_sub_epi16(v255, alpha), d)));
+        }
+        return _mm256_blend_epi16(_mm256_add_epi16(s, d), d, 0x88);
+    case SDL_COPY_MOD:
+        return _mm256_blend_epi16(SDL_Div255_AVX2(_mm256_mullo_epi16(s, d)), d, 0x88);
+    case SDL_COPY_MUL:
+        /* d * (s + 255 - alpha) / 255, split so the product fits in 16 bits */
+        t = _mm256_sub_epi16(_mm256_add_epi16(s, v255), alpha);
+        m = _mm256_cmpgt_epi16(t, _mm256_set1_epi16(254));
+        t = _mm256_sub_epi16(t, _mm256_and_si256(m, v255));
+        t = _mm256_add_epi16(_mm256_and_si256(m, d), SDL_Div255_AVX2(_mm256_mullo_epi16(d, t)));
+        return _mm256_blend_epi16(t, d, 0x88);
+    default:
+        return d;
+    }
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING_AVX2 SDL_BlitPixels_AVX2(SDL_BlitInfo *info, const SDL_BlitVectorFormat *format, const int modulate, const int mode, const int scale)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i src_shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)format->src));
+    const __m256i dst_shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)format->dst));
+    const __m256i dst_in_shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)format->dst_in));
+    const __m256i src_alpha = _mm256_set1_epi32((int)format->src_alpha);
+    const __m256i modulation = _mm256_set1_epi64x((Sint64)(((Uint64)((info->flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255) << 48) |
+                                                           ((Uint64)((info->flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255) << 32) |
+                                                           ((Uint64)((info->flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255) << 16) |
+                                                           ((Uint64)((info->flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255))));
+    __m256i pixels;
+    Uint32 src_buffer[8];
+    Uint32 dst_buffer[8];
+    Uint64 srcy = 0, posy = 0, posx = 0, incy = 0, incx = 0;
+
+    if (scale) {
+        incy = ((Uint64)info->src_h << 16) / info->dst_h;
+        incx = ((Uint64)info->src_w << 16) / info->dst_w;
+        posy = incy / 2;
+    }
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+
+        if (scale) {
+            srcy = posy >> 16;
+            posx = incx / 2;
+        }
+        while (n > 0) {
+            /* Short runs go through the buffers, so every step is eight pixels */
+            const int count = SDL_min(n, 8);
+            Uint32 *d = dst;
+            int i;
+
+            if (scale) {
+                const Uint32 *row = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+                if (count == 8) {
+                    /* Loading straight into the vector avoids a store forwarding stall */
+                    pixels = _mm256_setr_epi32((int)row[posx >> 16], (int)row[(posx + incx) >> 16],
+                                               (int)row[(posx + 2 * incx) >> 16], (int)row[(posx + 3 * incx) >> 16],
+                                               (int)row[(posx + 4 * incx) >> 16], (int)row[(posx + 5 * incx) >> 16],
+                                               (int)row[(posx + 6 * incx) >> 16], (int)row[(posx + 7 * incx) >> 16]);
+                    posx += 8 * incx;
+                } else {
+                    for (i = 0; i < count; i++) {
+                        src_buffer[i] = row[posx >> 16];
+                        posx += incx;
+                    }
+                    pixels = _mm256_loadu_si256((const __m256i *)src_buffer);
+                }
+            } else if (count == 8) {
+                pixels = _mm256_loadu_si256((const __m256i *)src);
+            } else {
+                SDL_memcpy(src_buffer, src, count * sizeof(Uint32));
+                pixels = _mm256_loadu_si256((const __m256i *)src_buffer);
+            }
+            if (count < 8) {
+                SDL_memcpy(dst_buffer, dst, count * sizeof(Uint32));
+                d = dst_buffer;
+            }
+
+            pixels = _mm256_or_si256(_mm256_shuffle_epi8(pixels, src_shuffle), src_alpha);
+            if (modulate || mode) {
+                __m256i lo = _mm256_unpacklo_epi8(pixels, zero);
+                __m256i hi = _mm256_unpackhi_epi8(pixels, zero);
+                if (modulate) {
+                    lo = SDL_Div255_AVX2(_mm256_mullo_epi16(lo, modulation));
+                    hi = SDL_Div255_AVX2(_mm256_mullo_epi16(hi, modulation));
+                }
+                if (mode) {
+                    const __m256i dpixels = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)d), dst_in_shuffle);
+                    lo = SDL_BlendPixels_AVX2(lo, _mm256_unpacklo_epi8(dpixels, zero), mode);
+                    hi = SDL_BlendPixels_AVX2(hi, _mm256_unpackhi_epi8(dpixels, zero), mode);
+                }
+                pixels = _mm256_packus_epi16(lo, hi);
+            }
+            _mm256_storeu_si256((__m256i *)d, _mm256_shuffle_epi8(pixels, dst_shuffle));
+            if (count < 8) {
+                SDL_memcpy(dst, dst_buffer, count * sizeof(Uint32));
+            }
+            src += count;
+            dst += count;
+            n -= count;
+        }
+        if (scale) {
+            posy += incy;
+        } else {
+            info->src += info->src_pitch;
+        }
+        info->dst += info->dst_pitch;
+    }
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
 
 __EOF__
 }
@@ -603,7 +949,6 @@ __EOF__
                 for (my $blend = 0; $blend <= 1; ++$blend) {
                     for (my $scale = 0; $scale <= 1; ++$scale) {
                         if ( $modulate || $blend || $scale ) {
-                            print FILE "    { SDL_PIXELFORMAT_$src, SDL_PIXELFORMAT_$dst, ";
                             my $flags = "";
                             my $flag = "";
                             if ( $modulate ) {
@@ -633,6 +978,13 @@ __EOF__
                             if ( $flags eq "" ) {
                                 $flags = "0";
                             }
+                            foreach my $cpu (@vector_cpus) {
+                                print FILE "#ifdef HAVE_${cpu}_INTRINSICS\n";
+                                print FILE "    { SDL_PIXELFORMAT_$src, SDL_PIXELFORMAT_$dst, ($flags), SDL_CPU_$cpu,";
+                                output_copyfuncname("", $src_formats[$i], $dst_formats[$j], $modulate, $blend, $scale, 0, "_$cpu },\n");
+                                print FILE "#endif\n";
+                            }
+                            print FILE "    { SDL_PIXELFORMAT_$src, SDL_PIXELFORMAT_$dst, ";
                             print FILE "($flags), SDL_CPU_ANY,";
                             output_copyfuncname("", $src_formats[$i], $dst_formats[$j], $modulate, $blend, $scale, 0, " },\n");
                         }
@@ -662,6 +1014,35 @@ sub output_copyfunc_c
             }
         }
     }
+
+    print FILE <<__EOF__;
+#ifdef HAVE_AVX2_INTRINSICS
+
+__EOF__
+    output_vectorformat($src, $dst);
+    print FILE <<__EOF__;
+#endif
+
+__EOF__
+    foreach my $cpu (@vector_cpus) {
+        print FILE <<__EOF__;
+#ifdef HAVE_${cpu}_INTRINSICS
+
+__EOF__
+        for (my $modulate = 0; $modulate <= 1; ++$modulate) {
+            for (my $blend = 0; $blend <= 1; ++$blend) {
+                for (my $scale = 0; $scale <= 1; ++$scale) {
+                    if ( $modulate || $blend || $scale ) {
+                        output_vectorfunc($src, $dst, $modulate, $blend, $scale, $cpu);
+                    }
+                }
+            }
+        }
+        print FILE <<__EOF__;
+#endif /* HAVE_${cpu}_INTRINSICS */
+
+__EOF__
+    }
 }
 
 open_file("SDL_blit_auto.h");
@@ -676,6 +1057,8 @@ close_file("SDL_blit_auto.h");
 
 open_file("SDL_blit_auto.c");
 output_copyinc();
+output_vectorinc();
+output_vectorkernels();
 for (my $i = 0; $i <= $#src_formats; ++$i) {
     for (my $j = 0; $j <= $#dst_formats; ++$j) {
         output_copyfunc_c($src_formats[$i], $dst_formats[$j]);
@@ -22,154 +22,212 @@
 
 #ifdef SDL_VIDEO_DRIVER_WEBROGUE
 
-#include "SDL_webrogue_unimplemented.h"
+#include <webrogue_gfx/webrogue_gfx.h>
+#include "SDL_opengles2.h"
 
 #include "../SDL_sysvideo.h"
 #include "SDL_webrogueframebuffer_c.h"
-// #include "SDL_n3dsvideo.h"
 
 #define WEBROGUE_SURFACE "_SDL_WEBROGUESurface"
 
-// typedef struct
-// {
-//     int width, height;
-// } Dimensions;
-
-// SDL_FORCE_INLINE void CopyFramebuffertoN3DS_16(u16 *dest, const Dimensions dest_dim, const u16 *source, const Dimensions source_dim);
-// SDL_FORCE_INLINE void CopyFramebuffertoN3DS_24(u8  *dest, const Dimensions dest_dim, const u8  *source, const Dimensions source_dim);
-// SDL_FORCE_INLINE void CopyFramebuffertoN3DS_32(u32 *dest, const Dimensions dest_dim, const u32 *source, const Dimensions source_dim);
-// SDL_FORCE_INLINE int GetDestOffset(int x, int y, int dest_width);
-// SDL_FORCE_INLINE int GetSourceOffset(int x, int y, int source_width);
-// SDL_FORCE_INLINE void FlushN3DSBuffer(const void *buffer, u32 bufsize, gfxScreen_t screen);
+/* These are GLES 3.0 core, but SDL only ships the GLES 2.0 headers */
+#ifndef GL_READ_FRAMEBUFFER
+#define GL_READ_FRAMEBUFFER 0x8CA8
+#endif
+#ifndef GL_DRAW_FRAMEBUFFER
+#define GL_DRAW_FRAMEBUFFER 0x8CA9
+#endif
+#ifndef GL_UNPACK_ROW_LENGTH
+#define GL_UNPACK_ROW_LENGTH 0x0CF2
+#endif
+
+/* The window surface is kept in a texture attached to a framebuffer object.
+   UpdateWindowFramebuffer() only uploads the dirty rectangles into that
+   texture and then lets the GPU blit the whole texture to the window, so the
+   CPU side cost scales with the changed area instead of the window size. */
+typedef struct
+{
+    SDL_Surface *surface;
+    GLuint texture;
+    GLuint fbo;
+} WEBROGUE_Framebuffer;
 
-int SDL_WEBROGUE_CreateWindowFramebuffer(_THIS, SDL_Window *window, Uint32 *format, void **pixels, int *pitch)
+static struct
+{
+    SDL_bool loaded;
+    GLenum (GL_APIENTRY *glGetError)(void);
+    void (GL_APIENTRY *glPixelStorei)(GLenum, GLint);
+    void (GL_APIENTRY *glGenTextures)(GLsizei, GLuint *);
+    void (GL_APIENTRY *glDeleteTextures)(GLsizei, const GLuint *);
+    void (GL_APIENTRY *glBindTexture)(GLenum, GLuint);
+    void (GL_APIENTRY *glTexParameteri)(GLenum, GLenum, GLint);
+    void (GL_APIENTRY *glTexImage2D)(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void *);
+    void (GL_APIENTRY *glTexSubImage2D)(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const void *);
+    void (GL_APIENTRY *glGenFramebuffers)(GLsizei, GLuint *);
+    void (GL_APIENTRY *glDeleteFramebuffers)(GLsizei, const GLuint *);
+    void (GL_APIENTRY *glBindFramebuffer)(GLenum, GLuint);
+    void (GL_APIENTRY *glFramebufferTexture2D)(GLenum, GLenum, GLenum, GLuint, GLint);
+    GLenum (GL_APIENTRY *glCheckFramebufferStatus)(GLenum);
+    void (GL_APIENTRY *glBlitFramebuffer)(GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLbitfield, GLenum);
+} gl;
+
+static int WEBROGUE_LoadFramebufferFunctions(void)
 {
-    WR_NOT_IMPLEMENTED;
+    if (gl.loaded) {
+        return 0;
+    }
+
+    webrogue_gfx_init_ptrs();
+
+#define WEBROGUE_GL_PROC(func)                                                 \
+    gl.func = webrogueGLLoader(#func);                                         \
+    if (!gl.func) {                                                            \
+        return SDL_SetError("Couldn't load GL function %s: not found", #func); \
+    }
+    WEBROGUE_GL_PROC(glGetError);
+    WEBROGUE_GL_PROC(glPixelStorei);
+    WEBROGUE_GL_PROC(glGenTextures);
+    WEBROGUE_GL_PROC(glDeleteTextures);
+    WEBROGUE_GL_PROC(glBindTexture);
+    WEBROGUE_GL_PROC(glTexParameteri);
+    WEBROGUE_GL_PROC(glTexImage2D);
+    WEBROGUE_GL_PROC(glTexSubImage2D);
+    WEBROGUE_GL_PROC(glGenFramebuffers);
+    WEBROGUE_GL_PROC(glDeleteFramebuffers);
+    WEBROGUE_GL_PROC(glBindFramebuffer);
+    WEBROGUE_GL_PROC(glFramebufferTexture2D);
+    WEBROGUE_GL_PROC(glCheckFramebufferStatus);
+    WEBROGUE_GL_PROC(glBlitFramebuffer);
+#undef WEBROGUE_GL_PROC
+
+    gl.loaded = SDL_TRUE;
     return 0;
-    // SDL_Surface *framebuffer;
-    // SDL_DisplayMode mode;
-    // int w, h;
-
-    // SDL_N3DS_DestroyWindowFramebuffer(_this, window);
-
-    // SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(window), &mode);
-    // SDL_GetWindowSizeInPixels(window, &w, &h);
-    // framebuffer = SDL_CreateRGBSurfaceWithFormat(0, w, h, SDL_BYTESPERPIXEL(mode.format), mode.format);
+}
 
-    // if (!framebuffer) {
-    //     return SDL_OutOfMemory();
-    // }
+static void WEBROGUE_FreeFramebuffer(WEBROGUE_Framebuffer *framebuffer)
+{
+    if (!framebuffer) {
+        return;
+    }
+    if (gl.loaded) {
+        if (framebuffer->fbo) {
+            gl.glDeleteFramebuffers(1, &framebuffer->fbo);
+        }
+        if (framebuffer->texture) {
+            gl.glDeleteTextures(1, &framebuffer->texture);
+        }
+    }
+    SDL_FreeSurface(framebuffer->surface);
+    SDL_free(framebuffer);
+}
 
-    // SDL_SetWindowData(window, N3DS_SURFACE, framebuffer);
-    // *format = mode.format;
-    // *pixels = framebuffer->pixels;
-    // *pitch = framebuffer->pitch;
-    // return 0;
+int SDL_WEBROGUE_CreateWindowFramebuffer(_THIS, SDL_Window *window, Uint32 *format, void **pixels, int *pitch)
+{
+    const Uint32 surface_format = SDL_PIXELFORMAT_RGBA32; /* GL_RGBA / GL_UNSIGNED_BYTE byte order */
+    WEBROGUE_Framebuffer *framebuffer;
+    int w, h;
+
+    SDL_WEBROGUE_DestroyWindowFramebuffer(_this, window);
+
+    if (WEBROGUE_LoadFramebufferFunctions() < 0) {
+        return -1;
+    }
+
+    framebuffer = (WEBROGUE_Framebuffer *)SDL_calloc(1, sizeof(*framebuffer));
+    if (!framebuffer) {
+        return SDL_OutOfMemory();
+    }
+
+    SDL_GetWindowSizeInPixels(window, &w, &h);
+    framebuffer->surface = SDL_CreateRGBSurfaceWithFormat(0, w, h, SDL_BITSPERPIXEL(surface_format), surface_format);
+    if (!framebuffer->surface) {
+        WEBROGUE_FreeFramebuffer(framebuffer);
+        return -1;
+    }
+
+    gl.glGetError();
+
+    gl.glGenTextures(1, &framebuffer->texture);
+    gl.glBindTexture(GL_TEXTURE_2D, framebuffer->texture);
+    gl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    gl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    gl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    gl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    gl.glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+
+    gl.glGenFramebuffers(1, &framebuffer->fbo);
+    gl.glBindFramebuffer(GL_FRAMEBUFFER, framebuffer->fbo);
+    gl.glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, framebuffer->texture, 0);
+    if (gl.glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        gl.glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        WEBROGUE_FreeFramebuffer(framebuffer);
+        return SDL_SetError("%s: Unable to create the framebuffer object", __func__);
+    }
+    gl.glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (gl.glGetError() != GL_NO_ERROR) {
+        WEBROGUE_FreeFramebuffer(framebuffer);
+        return SDL_SetError("%s: Unable to create the framebuffer texture", __func__);
+    }
+
+    SDL_SetWindowData(window, WEBROGUE_SURFACE, framebuffer);
+    *format = surface_format;
+    *pixels = framebuffer->surface->pixels;
+    *pitch = framebuffer->surface->pitch;
+    return 0;
 }
 
 int SDL_WEBROGUE_UpdateWindowFramebuffer(_THIS, SDL_Window *window, const SDL_Rect *rects, int numrects)
 {
-    WR_NOT_IMPLEMENTED;
+    WEBROGUE_Framebuffer *framebuffer;
+    SDL_Surface *surface;
+    SDL_Rect bounds, rect;
+    int window_w, window_h;
+    int i;
+
+    framebuffer = (WEBROGUE_Framebuffer *)SDL_GetWindowData(window, WEBROGUE_SURFACE);
+    if (!framebuffer) {
+        return SDL_SetError("%s: Unable to get the window surface.", __func__);
+    }
+    surface = framebuffer->surface;
+
+    bounds.x = 0;
+    bounds.y = 0;
+    bounds.w = surface->w;
+    bounds.h = surface->h;
+
+    gl.glBindTexture(GL_TEXTURE_2D, framebuffer->texture);
+    gl.glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    gl.glPixelStorei(GL_UNPACK_ROW_LENGTH, surface->pitch / SDL_BYTESPERPIXEL(surface->format->format));
+    for (i = 0; i < numrects; ++i) {
+        if (!SDL_IntersectRect(&rects[i], &bounds, &rect)) {
+            continue;
+        }
+        gl.glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.w, rect.h, GL_RGBA, GL_UNSIGNED_BYTE,
+                           (const Uint8 *)surface->pixels + rect.y * surface->pitch + rect.x * surface->format->BytesPerPixel);
+    }
+    gl.glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+    /* Row 0 of the surface is the top of the window, so flip while blitting */
+    webrogue_gfx_window_size(&window_w, &window_h);
+    gl.glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer->fbo);
+    gl.glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    gl.glBlitFramebuffer(0, 0, surface->w, surface->h,
+                         0, window_h, surface->w, window_h - surface->h,
+                         GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    gl.glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    webrogue_gfx_present();
+
     return 0;
-    // SDL_WindowData *drv_data = (SDL_WindowData *)window->driverdata;
-    // SDL_Surface *surface;
-    // u16 width, height;
-    // void *framebuffer;
-    // u32 bufsize;
-
-    // surface = (SDL_Surface *)SDL_GetWindowData(window, N3DS_SURFACE);
-    // if (!surface) {
-    //     return SDL_SetError("%s: Unable to get the window surface.", __func__);
-    // }
-
-    // /* Get the N3DS internal framebuffer and its size */
-    // framebuffer = gfxGetFramebuffer(drv_data->screen, GFX_LEFT, &width, &height);
-    // bufsize = width * height * 4;
-
-    // if (surface->format->BytesPerPixel == 2)
-    //     CopyFramebuffertoN3DS_16(framebuffer, (Dimensions){ width, height },
-    //                              surface->pixels, (Dimensions){ surface->w, surface->h });
-    // else if (surface->format->BytesPerPixel == 3)
-    //     CopyFramebuffertoN3DS_24(framebuffer, (Dimensions){ width, height },
-    //                              surface->pixels, (Dimensions){ surface->w, surface->h });
-    // else
-    //     CopyFramebuffertoN3DS_32(framebuffer, (Dimensions){ width, height },
-    //                              surface->pixels, (Dimensions){ surface->w, surface->h });
-    // FlushN3DSBuffer(framebuffer, bufsize, drv_data->screen);
-
-    // return 0;
 }
 
-// SDL_FORCE_INLINE void
-// CopyFramebuffertoN3DS_16(u16 *dest, const Dimensions dest_dim, const u16 *source, const Dimensions source_dim)
-// {
-//     int rows = SDL_min(dest_dim.width, source_dim.height);
-//     int cols = SDL_min(dest_dim.height, source_dim.width);
-//     for (int y = 0; y < rows; ++y) {
-//         for (int x = 0; x < cols; ++x) {
-//             const u16 *s = source + GetSourceOffset(x, y, source_dim.width);
-//             u16 *d = dest + GetDestOffset(x, y, dest_dim.width);
-//             *d = *s;
-//         }
-//     }
-// }
-
-// SDL_FORCE_INLINE void
-// CopyFramebuffertoN3DS_24(u8 *dest, const Dimensions dest_dim, const u8 *source, const Dimensions source_dim)
-// {
-//     int rows = SDL_min(dest_dim.width, source_dim.height);
-//     int cols = SDL_min(dest_dim.height, source_dim.width);
-//     for (int y = 0; y < rows; ++y) {
-//         for (int x = 0; x < cols; ++x) {
-//             const u8 *s = source + GetSourceOffset(x, y, source_dim.width) * 3;
-//             u8 *d = dest + GetDestOffset(x, y, dest_dim.width) * 3;
-//             d[0] = s[0];
-//             d[1] = s[1];
-//             d[2] = s[2];
-//         }
-//     }
-// }
-
-// SDL_FORCE_INLINE void
-// CopyFramebuffertoN3DS_32(u32 *dest, const Dimensions dest_dim, const u32 *source, const Dimensions source_dim)
-// {
-//     int rows = SDL_min(dest_dim.width, source_dim.height);
-//     int cols = SDL_min(dest_dim.height, source_dim.width);
-//     for (int y = 0; y < rows; ++y) {
-//         for (int x = 0; x < cols; ++x) {
-//             const u32 *s = source + GetSourceOffset(x, y, source_dim.width);
-//             u32 *d = dest + GetDestOffset(x, y, dest_dim.width);
-//             *d = *s;
-//         }
-//     }
-// }
-
-// SDL_FORCE_INLINE int
-// GetDestOffset(int x, int y, int dest_width)
-// {
-//     return dest_width - y - 1 + dest_width * x;
-// }
-
-// SDL_FORCE_INLINE int
-// GetSourceOffset(int x, int y, int source_width)
-// {
-//     return x + y * source_width;
-// }
-
-// SDL_FORCE_INLINE void
-// FlushN3DSBuffer(const void *buffer, u32 bufsize, gfxScreen_t screen)
-// {
-//     GSPGPU_FlushDataCache(buffer, bufsize);
-//     gfxScreenSwapBuffers(screen, false);
-// }
-
 void SDL_WEBROGUE_DestroyWindowFramebuffer(_THIS, SDL_Window *window)
 {
-    WR_NOT_IMPLEMENTED;
-    return;
-    // SDL_Surface *surface;
-    // surface = (SDL_Surface *)SDL_SetWindowData(window, N3DS_SURFACE, NULL);
-    // SDL_FreeSurface(surface);
+    WEBROGUE_Framebuffer *framebuffer;
+
+    framebuffer = (WEBROGUE_Framebuffer *)SDL_SetWindowData(window, WEBROGUE_SURFACE, NULL);
+    WEBROGUE_FreeFramebuffer(framebuffer);
 }
 
 #endif /* SDL_VIDEO_DRIVER_WEBROGUE */
@@ -156,6 +156,17 @@ static int WEBROGUE_VideoInit(_THIS)
     return 0;
 }
 
+/* The window always covers the whole host surface, so that is the only mode */
+static void WEBROGUE_GetModeSize(int *w, int *h)
+{
+    webrogue_gfx_window_size(w, h);
+    if (*w <= 0 || *h <= 0) {
+        /* The host hasn't told us yet, fall back to a generous default */
+        *w = 2048;
+        *h = 2048;
+    }
+}
+
 SDL_FORCE_INLINE int
 AddWEBROGUEDisplay()
 {
@@ -177,9 +188,7 @@ AddWEBROGUEDisplay()
         return SDL_OutOfMemory();
     }
 
-    // FIXME
-    mode.w = 2048;
-    mode.h = 2048;
+    WEBROGUE_GetModeSize(&mode.w, &mode.h);
     mode.refresh_rate = 60;
     mode.format = SDL_PIXELFORMAT_RGBA8888;
     mode.driverdata = modedata;
@@ -213,8 +222,7 @@ static void WEBROGUE_GetDisplayModes(_THIS, SDL_VideoDisplay *display)
         return;
 
     SDL_zero(mode);
-    mode.w = 2048;
-    mode.h = 2048;
+    WEBROGUE_GetModeSize(&mode.w, &mode.h);
     mode.refresh_rate = 60;
     mode.format = SDL_PIXELFORMAT_RGBA8888;
     mode.driverdata = modedata;
@@ -238,11 +246,11 @@ static int WEBROGUE_SetDisplayMode(_THIS, SDL_VideoDisplay *display, SDL_Display
 static int WEBROGUE_GetDisplayBounds(_THIS, SDL_VideoDisplay *display, SDL_Rect *rect)
 {
     DisplayDriverData *driver_data = (DisplayDriverData *)display->driverdata;
+    int width, height;
     if (!driver_data) {
         WR_NOT_IMPLEMENTED;
         return -1;
     }
-    int width, height;
     webrogue_gfx_window_size(&width, &height);
     // FIXME use real data
     rect->x = 0;
@@ -270,12 +278,11 @@ static int WEBROGUE_CreateWindow(_THIS, SDL_Window *window)
 
 static void WEBROGUE_DestroyWindow(_THIS, SDL_Window *window)
 {
-    WR_NOT_IMPLEMENTED;
-    return;
-    // if (!window) {
-    //     return;
-    // }
-    // SDL_free(window->driverdata);
+    if (!window) {
+        return;
+    }
+    SDL_free(window->driverdata);
+    window->driverdata = NULL;
 }
 
 #endif /* SDL_VIDEO_DRIVER_WEBROGUE */
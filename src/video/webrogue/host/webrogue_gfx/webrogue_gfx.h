@@ -0,0 +1,55 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/*
+  Host-side stand-in for the webrogue_gfx interface.
+
+  This mirrors the entry points the webrogue video driver uses, so the driver
+  can be built and exercised on a regular desktop system (SDL_WEBROGUE_HOST).
+  The GL entry points handed out by webrogueGLLoader() only implement what the
+  framebuffer path needs, and operate on plain memory.
+*/
+
+#ifndef webrogue_gfx_h_
+#define webrogue_gfx_h_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void webrogue_gfx_make_window(void);
+void webrogue_gfx_present(void);
+void webrogue_gfx_window_size(int *width, int *height);
+void webrogue_gfx_init_ptrs(void);
+void *webrogueGLLoader(const char *procname);
+
+/* Host-only inspection helpers, used by the tests */
+void webrogue_gfx_host_set_window_size(int width, int height);
+int webrogue_gfx_host_present_count(void);
+unsigned long long webrogue_gfx_host_uploaded_bytes(void);
+/* Returns the presented RGBA pixel at (x, y), with (0, 0) at the top left */
+unsigned int webrogue_gfx_host_read_pixel(int x, int y);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* webrogue_gfx_h_ */
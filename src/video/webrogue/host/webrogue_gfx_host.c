@@ -0,0 +1,391 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../../SDL_internal.h"
+
+#ifdef SDL_VIDEO_DRIVER_WEBROGUE
+
+#include <webrogue_gfx/webrogue_gfx.h>
+#include "SDL_opengles2.h"
+
+#ifndef GL_READ_FRAMEBUFFER
+#define GL_READ_FRAMEBUFFER 0x8CA8
+#endif
+#ifndef GL_DRAW_FRAMEBUFFER
+#define GL_DRAW_FRAMEBUFFER 0x8CA9
+#endif
+#ifndef GL_UNPACK_ROW_LENGTH
+#define GL_UNPACK_ROW_LENGTH 0x0CF2
+#endif
+
+#define HOST_MAX_OBJECTS 16
+
+typedef struct
+{
+    SDL_bool used;
+    int w, h;
+    Uint8 *pixels;
+} HostTexture;
+
+typedef struct
+{
+    SDL_bool used;
+    GLuint texture;
+} HostFramebuffer;
+
+static struct
+{
+    int window_w, window_h;
+    Uint8 *screen; /* RGBA, bottom row first, like a GL default framebuffer */
+    int present_count;
+    Uint64 uploaded_bytes;
+
+    HostTexture textures[HOST_MAX_OBJECTS];
+    HostFramebuffer framebuffers[HOST_MAX_OBJECTS];
+    GLuint bound_texture;
+    GLuint read_framebuffer;
+    GLuint draw_framebuffer;
+    GLint unpack_row_length;
+    GLenum error;
+} host = { 640, 480 };
+
+static void HOST_SetError(GLenum error)
+{
+    if (host.error == GL_NO_ERROR) {
+        host.error = error;
+    }
+}
+
+static HostTexture *HOST_GetTexture(GLuint name)
+{
+    if (name == 0 || name > HOST_MAX_OBJECTS || !host.textures[name - 1].used) {
+        return NULL;
+    }
+    return &host.textures[name - 1];
+}
+
+static HostFramebuffer *HOST_GetFramebuffer(GLuint name)
+{
+    if (name == 0 || name > HOST_MAX_OBJECTS || !host.framebuffers[name - 1].used) {
+        return NULL;
+    }
+    return &host.framebuffers[name - 1];
+}
+
+static GLenum GL_APIENTRY HOST_glGetError(void)
+{
+    GLenum error = host.error;
+    host.error = GL_NO_ERROR;
+    return error;
+}
+
+static void GL_APIENTRY HOST_glPixelStorei(GLenum pname, GLint param)
+{
+    if (pname == GL_UNPACK_ROW_LENGTH) {
+        host.unpack_row_length = param;
+    }
+}
+
+static void GL_APIENTRY HOST_glGenTextures(GLsizei n, GLuint *textures)
+{
+    GLsizei i;
+    GLuint name;
+
+    for (i = 0; i < n; ++i) {
+        textures[i] = 0;
+        for (name = 0; name < HOST_MAX_OBJECTS; ++name) {
+            if (!host.textures[name].used) {
+                SDL_zero(host.textures[name]);
+                host.textures[name].used = SDL_TRUE;
+                textures[i] = name + 1;
+                break;
+            }
+        }
+        if (!textures[i]) {
+            HOST_SetError(GL_OUT_OF_MEMORY);
+        }
+    }
+}
+
+static void GL_APIENTRY HOST_glDeleteTextures(GLsizei n, const GLuint *textures)
+{
+    GLsizei i;
+
+    for (i = 0; i < n; ++i) {
+        HostTexture *texture = HOST_GetTexture(textures[i]);
+        if (texture) {
+            SDL_free(texture->pixels);
+            SDL_zerop(texture);
+        }
+        if (host.bound_texture == textures[i]) {
+            host.bound_texture = 0;
+        }
+    }
+}
+
+static void GL_APIENTRY HOST_glBindTexture(GLenum target, GLuint name)
+{
+    host.bound_texture = name;
+}
+
+static void GL_APIENTRY HOST_glTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+}
+
+static void GL_APIENTRY HOST_glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels)
+{
+    HostTexture *texture = HOST_GetTexture(host.bound_texture);
+
+    if (!texture || format != GL_RGBA || type != GL_UNSIGNED_BYTE || width < 0 || height < 0) {
+        HOST_SetError(GL_INVALID_OPERATION);
+        return;
+    }
+
+    SDL_free(texture->pixels);
+    texture->pixels = (Uint8 *)SDL_calloc(1, (size_t)width * height * 4);
+    if (!texture->pixels) {
+        texture->w = texture->h = 0;
+        HOST_SetError(GL_OUT_OF_MEMORY);
+        return;
+    }
+    texture->w = width;
+    texture->h = height;
+
+    if (pixels) {
+        SDL_memcpy(texture->pixels, pixels, (size_t)width * height * 4);
+        host.uploaded_bytes += (Uint64)width * height * 4;
+    }
+}
+
+static void GL_APIENTRY HOST_glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels)
+{
+    HostTexture *texture = HOST_GetTexture(host.bound_texture);
+    const Uint8 *src = (const Uint8 *)pixels;
+    int src_pitch;
+    int row;
+
+    if (!texture || format != GL_RGBA || type != GL_UNSIGNED_BYTE) {
+        HOST_SetError(GL_INVALID_OPERATION);
+        return;
+    }
+    if (xoffset < 0 || yoffset < 0 || width < 0 || height < 0 ||
+        xoffset + width > texture->w || yoffset + height > texture->h) {
+        HOST_SetError(GL_INVALID_VALUE);
+        return;
+    }
+
+    src_pitch = (host.unpack_row_length ? host.unpack_row_length : width) * 4;
+    for (row = 0; row < height; ++row) {
+        SDL_memcpy(texture->pixels + ((size_t)(yoffset + row) * texture->w + xoffset) * 4, src, (size_t)width * 4);
+        src += src_pitch;
+    }
+    host.uploaded_bytes += (Uint64)width * height * 4;
+}
+
+static void GL_APIENTRY HOST_glGenFramebuffers(GLsizei n, GLuint *framebuffers)
+{
+    GLsizei i;
+    GLuint name;
+
+    for (i = 0; i < n; ++i) {
+        framebuffers[i] = 0;
+        for (name = 0; name < HOST_MAX_OBJECTS; ++name) {
+            if (!host.framebuffers[name].used) {
+                SDL_zero(host.framebuffers[name]);
+                host.framebuffers[name].used = SDL_TRUE;
+                framebuffers[i] = name + 1;
+                break;
+            }
+        }
+        if (!framebuffers[i]) {
+            HOST_SetError(GL_OUT_OF_MEMORY);
+        }
+    }
+}
+
+static void GL_APIENTRY HOST_glDeleteFramebuffers(GLsizei n, const GLuint *framebuffers)
+{
+    GLsizei i;
+
+    for (i = 0; i < n; ++i) {
+        HostFramebuffer *framebuffer = HOST_GetFramebuffer(framebuffers[i]);
+        if (framebuffer) {
+            SDL_zerop(framebuffer);
+        }
+        if (host.read_framebuffer == framebuffers[i]) {
+            host.read_framebuffer = 0;
+        }
+        if (host.draw_framebuffer == framebuffers[i]) {
+            host.draw_framebuffer = 0;
+        }
+    }
+}
+
+static void GL_APIENTRY HOST_glBindFramebuffer(GLenum target, GLuint name)
+{
+    if (target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER) {
+        host.read_framebuffer = name;
+    }
+    if (target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER) {
+        host.draw_framebuffer = name;
+    }
+}
+
+static void GL_APIENTRY HOST_glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+    HostFramebuffer *framebuffer = HOST_GetFramebuffer(target == GL_READ_FRAMEBUFFER ? host.read_framebuffer : host.draw_framebuffer);
+
+    if (!framebuffer || attachment != GL_COLOR_ATTACHMENT0) {
+        HOST_SetError(GL_INVALID_OPERATION);
+        return;
+    }
+    framebuffer->texture = texture;
+}
+
+static GLenum GL_APIENTRY HOST_glCheckFramebufferStatus(GLenum target)
+{
+    HostFramebuffer *framebuffer = HOST_GetFramebuffer(target == GL_READ_FRAMEBUFFER ? host.read_framebuffer : host.draw_framebuffer);
+
+    if (!framebuffer || !HOST_GetTexture(framebuffer->texture)) {
+        return GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT;
+    }
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+static void GL_APIENTRY HOST_glBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)
+{
+    HostFramebuffer *framebuffer = HOST_GetFramebuffer(host.read_framebuffer);
+    HostTexture *texture = framebuffer ? HOST_GetTexture(framebuffer->texture) : NULL;
+    int x, y, xmin, xmax, ymin, ymax;
+
+    /* Only texture -> window blits are needed by the driver */
+    if (!texture || host.draw_framebuffer != 0 || dstX0 == dstX1 || dstY0 == dstY1) {
+        HOST_SetError(GL_INVALID_OPERATION);
+        return;
+    }
+
+    if (!host.screen) {
+        host.screen = (Uint8 *)SDL_calloc(1, (size_t)host.window_w * host.window_h * 4);
+        if (!host.screen) {
+            HOST_SetError(GL_OUT_OF_MEMORY);
+            return;
+        }
+    }
+
+    xmin = SDL_max(SDL_min(dstX0, dstX1), 0);
+    xmax = SDL_min(SDL_max(dstX0, dstX1), host.window_w);
+    ymin = SDL_max(SDL_min(dstY0, dstY1), 0);
+    ymax = SDL_min(SDL_max(dstY0, dstY1), host.window_h);
+
+    for (y = ymin; y < ymax; ++y) {
+        const int sy = srcY0 + (int)SDL_floor(((y + 0.5) - dstY0) * (srcY1 - srcY0) / (dstY1 - dstY0));
+        for (x = xmin; x < xmax; ++x) {
+            const int sx = srcX0 + (int)SDL_floor(((x + 0.5) - dstX0) * (srcX1 - srcX0) / (dstX1 - dstX0));
+            if (sx >= 0 && sx < texture->w && sy >= 0 && sy < texture->h) {
+                SDL_memcpy(host.screen + ((size_t)y * host.window_w + x) * 4,
+                           texture->pixels + ((size_t)sy * texture->w + sx) * 4, 4);
+            }
+        }
+    }
+}
+
+static const struct
+{
+    const char *name;
+    void *func;
+} host_procs[] = {
+    { "glBindFramebuffer", (void *)HOST_glBindFramebuffer },
+    { "glBindTexture", (void *)HOST_glBindTexture },
+    { "glBlitFramebuffer", (void *)HOST_glBlitFramebuffer },
+    { "glCheckFramebufferStatus", (void *)HOST_glCheckFramebufferStatus },
+    { "glDeleteFramebuffers", (void *)HOST_glDeleteFramebuffers },
+    { "glDeleteTextures", (void *)HOST_glDeleteTextures },
+    { "glFramebufferTexture2D", (void *)HOST_glFramebufferTexture2D },
+    { "glGenFramebuffers", (void *)HOST_glGenFramebuffers },
+    { "glGenTextures", (void *)HOST_glGenTextures },
+    { "glGetError", (void *)HOST_glGetError },
+    { "glPixelStorei", (void *)HOST_glPixelStorei },
+    { "glTexImage2D", (void *)HOST_glTexImage2D },
+    { "glTexParameteri", (void *)HOST_glTexParameteri },
+    { "glTexSubImage2D", (void *)HOST_glTexSubImage2D },
+};
+
+void webrogue_gfx_make_window(void)
+{
+}
+
+void webrogue_gfx_present(void)
+{
+    ++host.present_count;
+}
+
+void webrogue_gfx_window_size(int *width, int *height)
+{
+    *width = host.window_w;
+    *height = host.window_h;
+}
+
+void webrogue_gfx_init_ptrs(void)
+{
+}
+
+void *webrogueGLLoader(const char *procname)
+{
+    int i;
+
+    for (i = 0; i < SDL_arraysize(host_procs); ++i) {
+        if (SDL_strcmp(procname, host_procs[i].name) == 0) {
+            return host_procs[i].func;
+        }
+    }
+    return NULL;
+}
+
+void webrogue_gfx_host_set_window_size(int width, int height)
+{
+    SDL_free(host.screen);
+    host.screen = NULL;
+    host.window_w = width;
+    host.window_h = height;
+}
+
+int webrogue_gfx_host_present_count(void)
+{
+    return host.present_count;
+}
+
+unsigned long long webrogue_gfx_host_uploaded_bytes(void)
+{
+    return host.uploaded_bytes;
+}
+
+unsigned int webrogue_gfx_host_read_pixel(int x, int y)
+{
+    Uint32 pixel = 0;
+
+    if (host.screen && x >= 0 && x < host.window_w && y >= 0 && y < host.window_h) {
+        SDL_memcpy(&pixel, host.screen + ((size_t)(host.window_h - 1 - y) * host.window_w + x) * 4, 4);
+    }
+    return pixel;
+}
+
+#endif /* SDL_VIDEO_DRIVER_WEBROGUE */
+
+/* vi: set sts=4 ts=4 sw=4 expandtab: */
@@ -1213,6 +1213,400 @@ int audio_resampleLoss(void)
   return TEST_COMPLETED;
 }
 
+/**
+ * \brief Check that every channel of a multichannel stream is resampled like a mono stream.
+ *
+ * Different channel counts go through different (SIMD) resampling kernels,
+ * so this cross-checks them against each other.
+ */
+static int resample_stream(int channels, int rate_in, int rate_out, const float *input, int frames_in, float *output, int output_len)
+{
+  SDL_AudioStream *stream = SDL_NewAudioStream(AUDIO_F32SYS, channels, rate_in, AUDIO_F32SYS, channels, rate_out);
+  const int chunk = 1000;
+  int i, len = 0, got;
+
+  if (stream == NULL) {
+    return -1;
+  }
+  for (i = 0; i < frames_in; i += chunk) {
+    SDL_AudioStreamPut(stream, input + (i * channels), SDL_min(chunk, frames_in - i) * channels * (int)sizeof(float));
+  }
+  SDL_AudioStreamFlush(stream);
+  while ((got = SDL_AudioStreamGet(stream, ((Uint8 *)output) + len, output_len - len)) > 0) {
+    len += got;
+  }
+  SDL_FreeAudioStream(stream);
+  return len;
+}
+
+int audio_resampleChannels(void)
+{
+  const int channel_counts[] = { 2, 3, 4, 6, 8 };
+  const int rates[][2] = { { 44100, 48000 }, { 48000, 44100 }, { 22050, 44100 }, { 44100, 48001 } };
+  const int frames_in = 10000;
+  const int output_len = frames_in * 3 * 8 * (int)sizeof(float);
+  float *input = (float *)SDL_malloc(frames_in * 8 * sizeof(float));
+  float *output = (float *)SDL_malloc(output_len);
+  float *mono_in = (float *)SDL_malloc(frames_in * sizeof(float));
+  float *mono_out = (float *)SDL_malloc(output_len);
+  int r, c, chan, i;
+
+  SDLTest_AssertCheck(input && output && mono_in && mono_out, "Expected buffers to be allocated.");
+  if (!input || !output || !mono_in || !mono_out) {
+    SDL_free(input);
+    SDL_free(output);
+    SDL_free(mono_in);
+    SDL_free(mono_out);
+    return TEST_ABORTED;
+  }
+
+  for (r = 0; r < (int)SDL_arraysize(rates); ++r) {
+    const int rate_in = rates[r][0];
+    const int rate_out = rates[r][1];
+    for (c = 0; c < (int)SDL_arraysize(channel_counts); ++c) {
+      const int channels = channel_counts[c];
+      double max_error = 0;
+      int len, mono_len;
+
+      for (i = 0; i < frames_in; ++i) {
+        for (chan = 0; chan < channels; ++chan) {
+          input[(i * channels) + chan] = (float)sine_wave_sample(i, rate_in, 300 + 700 * chan, 0.0);
+        }
+      }
+      len = resample_stream(channels, rate_in, rate_out, input, frames_in, output, output_len);
+      SDLTest_AssertCheck(len > 0, "Expected %i channel stream from %i Hz to %i Hz to produce output, got %i bytes.", channels, rate_in, rate_out, len);
+
+      for (chan = 0; chan < channels && len > 0; ++chan) {
+        for (i = 0; i < frames_in; ++i) {
+          mono_in[i] = input[(i * channels) + chan];
+        }
+        mono_len = resample_stream(1, rate_in, rate_out, mono_in, frames_in, mono_out, output_len);
+        if (mono_len * channels != len) {
+          SDLTest_AssertCheck(SDL_FALSE, "Expected %i channel output of %i bytes to match mono output of %i bytes.", channels, len, mono_len);
+          break;
+        }
+        for (i = 0; i < mono_len / (int)sizeof(float); ++i) {
+          max_error = SDL_max(max_error, SDL_fabs(output[(i * channels) + chan] - mono_out[i]));
+        }
+      }
+      SDLTest_AssertCheck(max_error <= 1e-5, "Maximum difference to mono resampling for %i channels from %i Hz to %i Hz: %g, expected <= 1e-5.",
+                          channels, rate_in, rate_out, max_error);
+    }
+  }
+
+  SDL_free(input);
+  SDL_free(output);
+  SDL_free(mono_in);
+  SDL_free(mono_out);
+  return TEST_COMPLETED;
+}
+
+/**
+ * \brief Check the signal-to-noise ratio of every audio stream resampler quality.
+ *
+ * \sa SDL_AudioStreamSetResampleQuality
+ * \sa SDL_AudioStreamGetResampleQuality
+ */
+int audio_resampleQuality(void)
+{
+  /* 48001 Hz doesn't get a filter bank, so it checks the slower path */
+  const int rates[][2] = { { 44100, 48000 }, { 48000, 44100 }, { 44100, 48001 } };
+  const double min_signal_to_noise[] = { 20, 45, 60, 55 };
+  const int freq = 440;
+  const int frames_in = 48000;
+  const int skip = 64; /* frames at both ends that see the silent padding */
+  const int output_len = frames_in * 2 * (int)sizeof(float);
+  float *input = (float *)SDL_malloc(frames_in * sizeof(float));
+  float *output = (float *)SDL_malloc(output_len);
+  SDL_AudioStream *stream;
+  int ret, r, q, i;
+
+  SDLTest_AssertCheck(input && output, "Expected buffers to be allocated.");
+  if (!input || !output) {
+    SDL_free(input);
+    SDL_free(output);
+    return TEST_ABORTED;
+  }
+
+  ret = SDL_AudioStreamSetResampleQuality(NULL, SDL_AUDIO_RESAMPLE_LINEAR);
+  SDLTest_AssertCheck(ret < 0, "Expected SDL_AudioStreamSetResampleQuality(NULL, ...) to fail, got %i.", ret);
+
+  for (r = 0; r < (int)SDL_arraysize(rates); ++r) {
+    const int rate_in = rates[r][0];
+    const int rate_out = rates[r][1];
+
+    for (i = 0; i < frames_in; ++i) {
+      input[i] = (float)sine_wave_sample(i, rate_in, freq, 0.0);
+    }
+
+    for (q = SDL_AUDIO_RESAMPLE_ZERO_ORDER_HOLD; q <= SDL_AUDIO_RESAMPLE_HIGH; ++q) {
+      double sum_squared_error = 0;
+      double sum_squared_value = 0;
+      double signal_to_noise;
+      int len = 0, got, frames_out;
+
+      stream = SDL_NewAudioStream(AUDIO_F32SYS, 1, rate_in, AUDIO_F32SYS, 1, rate_out);
+      SDLTest_AssertCheck(stream != NULL, "Expected SDL_NewAudioStream to succeed.");
+      if (stream == NULL) {
+        continue;
+      }
+      SDLTest_AssertCheck(SDL_AudioStreamGetResampleQuality(stream) == SDL_AUDIO_RESAMPLE_HIGH, "Expected new streams to use SDL_AUDIO_RESAMPLE_HIGH.");
+      ret = SDL_AudioStreamSetResampleQuality(stream, (SDL_AudioResampleQuality)q);
+      SDLTest_AssertCheck(ret == 0, "Expected SDL_AudioStreamSetResampleQuality(stream, %i) to succeed, got %i.", q, ret);
+      SDLTest_AssertCheck(SDL_AudioStreamGetResampleQuality(stream) == (SDL_AudioResampleQuality)q, "Expected the resampler quality to be %i.", q);
+
+      /* One put, so the output lines up with the input exactly */
+      SDL_AudioStreamPut(stream, input, frames_in * (int)sizeof(float));
+      SDL_AudioStreamFlush(stream);
+      while ((got = SDL_AudioStreamGet(stream, ((Uint8 *)output) + len, output_len - len)) > 0) {
+        len += got;
+      }
+      frames_out = len / (int)sizeof(float);
+      SDLTest_AssertCheck(frames_out > frames_in * (rate_out / (double)rate_in) * 0.9, "Expected about %i output frames, got %i.",
+                          (int)((Sint64)frames_in * rate_out / rate_in), frames_out);
+
+      for (i = skip; i < frames_out - skip; ++i) {
+        const double target = sine_wave_sample(i, rate_out, freq, 0.0);
+        const double error = target - output[i];
+        sum_squared_error += error * error;
+        sum_squared_value += target * target;
+      }
+      signal_to_noise = 10 * SDL_log10(sum_squared_value / sum_squared_error);
+      SDLTest_AssertCheck(signal_to_noise >= min_signal_to_noise[q], "Quality %i from %i Hz to %i Hz: signal-to-noise ratio %f dB should be no less than %f dB.",
+                          q, rate_in, rate_out, signal_to_noise, min_signal_to_noise[q]);
+
+      ret = SDL_AudioStreamSetResampleQuality(stream, (SDL_AudioResampleQuality)(SDL_AUDIO_RESAMPLE_HIGH + 1));
+      SDLTest_AssertCheck(ret < 0, "Expected an invalid resampler quality to be rejected, got %i.", ret);
+      SDLTest_AssertCheck(SDL_AudioStreamGetResampleQuality(stream) == (SDL_AudioResampleQuality)q, "Expected a rejected quality to leave the stream alone.");
+      SDL_FreeAudioStream(stream);
+    }
+  }
+
+  SDL_free(input);
+  SDL_free(output);
+  return TEST_COMPLETED;
+}
+
+/* Native endian reference versions of the scalar mixing code in SDL_mixer.c */
+static void mix_reference(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, int samples, int volume)
+{
+  int i;
+
+  for (i = 0; i < samples; ++i) {
+    if (format == AUDIO_S16SYS) {
+      Sint16 *d = ((Sint16 *)dst) + i;
+      const int sum = ((((const Sint16 *)src)[i] * volume) / SDL_MIX_MAXVOLUME) + *d;
+      *d = (Sint16)SDL_clamp(sum, SDL_MIN_SINT16, SDL_MAX_SINT16);
+    } else if (format == AUDIO_S32SYS) {
+      Sint32 *d = ((Sint32 *)dst) + i;
+      const Sint64 sum = ((((Sint64)((const Sint32 *)src)[i]) * volume) / SDL_MIX_MAXVOLUME) + *d;
+      *d = (Sint32)SDL_clamp(sum, SDL_MIN_SINT32, SDL_MAX_SINT32);
+    } else {
+      float *d = ((float *)dst) + i;
+      const float scaled = (((const float *)src)[i] * (float)volume) * (1.0f / ((float)SDL_MIX_MAXVOLUME));
+      const double sum = ((double)scaled) + ((double)*d);
+      *d = (float)SDL_clamp(sum, -3.402823466e+38F, 3.402823466e+38F);
+    }
+  }
+}
+
+/**
+ * \brief Check that SDL_MixAudioFormat gives the same results for every buffer length, alignment and volume.
+ *
+ * \sa SDL_MixAudioFormat
+ */
+int audio_mixAudioFormat(void)
+{
+  const SDL_AudioFormat formats[] = { AUDIO_S16SYS, AUDIO_S32SYS, AUDIO_F32SYS };
+  const char *format_names[] = { "AUDIO_S16SYS", "AUDIO_S32SYS", "AUDIO_F32SYS" };
+  const int volumes[] = { 1, 37, 64, 100, 127, SDL_MIX_MAXVOLUME };
+  /* Odd lengths and offsets leave a tail and misalign the buffers for the SIMD code */
+  const int lengths[] = { 1, 7, 8, 31, 64, 1021 };
+  const int max_samples = 1021 + 3;
+  Uint8 *src = (Uint8 *)SDL_malloc(max_samples * 4);
+  Uint8 *dst = (Uint8 *)SDL_malloc(max_samples * 4);
+  Uint8 *expected = (Uint8 *)SDL_malloc(max_samples * 4);
+  int f, v, l, offset, i;
+
+  SDLTest_AssertCheck(src && dst && expected, "Expected buffers to be allocated.");
+  if (!src || !dst || !expected) {
+    SDL_free(src);
+    SDL_free(dst);
+    SDL_free(expected);
+    return TEST_ABORTED;
+  }
+
+  for (f = 0; f < (int)SDL_arraysize(formats); ++f) {
+    const SDL_AudioFormat format = formats[f];
+    const int size = SDL_AUDIO_BITSIZE(format) / 8;
+    int mismatches = 0;
+
+    for (v = 0; v < (int)SDL_arraysize(volumes); ++v) {
+      for (l = 0; l < (int)SDL_arraysize(lengths); ++l) {
+        for (offset = 0; offset < 3; ++offset) {
+          const int samples = lengths[l];
+
+          /* Random samples, with full scale ones mixed in so the clamping gets exercised */
+          for (i = 0; i < max_samples; ++i) {
+            const int extreme = SDLTest_RandomIntegerInRange(0, 3);
+            if (format == AUDIO_S16SYS) {
+              ((Sint16 *)src)[i] = extreme == 0 ? SDL_MAX_SINT16 : extreme == 1 ? SDL_MIN_SINT16 : SDLTest_RandomSint16();
+              ((Sint16 *)dst)[i] = extreme == 1 ? SDL_MIN_SINT16 : SDLTest_RandomSint16();
+            } else if (format == AUDIO_S32SYS) {
+              ((Sint32 *)src)[i] = extreme == 0 ? SDL_MAX_SINT32 : extreme == 1 ? SDL_MIN_SINT32 : SDLTest_RandomSint32();
+              ((Sint32 *)dst)[i] = extreme == 1 ? SDL_MIN_SINT32 : SDLTest_RandomSint32();
+            } else {
+              ((float *)src)[i] = extreme == 0 ? 3.0e38f : extreme == 1 ? -3.0e38f : SDLTest_RandomUnitFloat() * 2.0f - 1.0f;
+              ((float *)dst)[i] = extreme == 1 ? -3.0e38f : SDLTest_RandomUnitFloat() * 2.0f - 1.0f;
+            }
+          }
+          SDL_memcpy(expected, dst, max_samples * size);
+
+          mix_reference(expected + (offset * size), src + (offset * size), format, samples, volumes[v]);
+          SDL_MixAudioFormat(dst + (offset * size), src + (offset * size), format, samples * size, volumes[v]);
+          if (SDL_memcmp(dst, expected, max_samples * size) != 0) {
+            ++mismatches;
+          }
+        }
+      }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Expected SDL_MixAudioFormat to match the reference for %s, %i mismatches.", format_names[f], mismatches);
+  }
+
+  SDL_free(src);
+  SDL_free(dst);
+  SDL_free(expected);
+  return TEST_COMPLETED;
+}
+
+#define QUEUE_CHUNK 997
+#define QUEUE_CHUNKS 512
+
+static int SDLCALL queue_audio_thread(void *data)
+{
+  SDL_AudioDeviceID id = *(SDL_AudioDeviceID *)data;
+  Uint8 chunk[QUEUE_CHUNK];
+  int failures = 0;
+  int i;
+
+  SDL_memset(chunk, 0x55, sizeof(chunk));
+  for (i = 0; i < QUEUE_CHUNKS; ++i) {
+    failures += (SDL_QueueAudio(id, chunk, sizeof(chunk)) != 0);
+  }
+  return failures;
+}
+
+/**
+ * \brief Queue and dequeue audio while the device thread is running.
+ *
+ * \sa SDL_QueueAudio
+ * \sa SDL_DequeueAudio
+ * \sa SDL_GetQueuedAudioSize
+ * \sa SDL_ClearQueuedAudio
+ */
+int audio_queueAudio(void)
+{
+  SDL_AudioSpec desired, obtained;
+  SDL_AudioDeviceID id;
+  SDL_Thread *thread;
+  Uint8 chunk[QUEUE_CHUNK];
+  Uint8 *captured;
+  Uint32 queued;
+  Uint64 deadline;
+  int failures = 0;
+  int thread_failures = -1;
+  int i;
+
+  SDL_zero(desired);
+  desired.freq = 48000;
+  desired.format = AUDIO_S16SYS;
+  desired.channels = 2;
+  desired.samples = 1024;
+  desired.callback = NULL;
+
+  /* Earlier tests may have shut the driver down */
+  if (SDL_GetCurrentAudioDriver() == NULL) {
+    SDL_AudioInit(NULL);
+    SDLTest_AssertPass("Call to SDL_AudioInit(NULL)");
+  }
+
+  id = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+  SDLTest_AssertPass("Call to SDL_OpenAudioDevice(NULL, 0, ...)");
+  if (id == 0) {
+    SDLTest_Log("No playback device to test with: %s", SDL_GetError());
+    return TEST_SKIPPED;
+  }
+
+  /* The device starts paused, so nothing gets consumed yet. Queue far more
+     than the queue starts out with, from two threads at once. */
+  SDL_memset(chunk, 0x33, sizeof(chunk));
+  thread = SDL_CreateThread(queue_audio_thread, "QueueAudio", &id);
+  SDLTest_AssertCheck(thread != NULL, "Expected SDL_CreateThread to succeed.");
+  for (i = 0; i < QUEUE_CHUNKS; ++i) {
+    failures += (SDL_QueueAudio(id, chunk, sizeof(chunk)) != 0);
+  }
+  SDL_WaitThread(thread, &thread_failures);
+  SDLTest_AssertCheck(failures == 0 && thread_failures == 0, "Expected every SDL_QueueAudio call to succeed, %i and %i failed.", failures, thread_failures);
+  queued = SDL_GetQueuedAudioSize(id);
+  SDLTest_AssertCheck(queued == 2 * QUEUE_CHUNKS * QUEUE_CHUNK, "Expected %i bytes queued, got %" SDL_PRIu32 ".", 2 * QUEUE_CHUNKS * QUEUE_CHUNK, queued);
+
+  SDL_ClearQueuedAudio(id);
+  queued = SDL_GetQueuedAudioSize(id);
+  SDLTest_AssertCheck(queued == 0, "Expected nothing queued after SDL_ClearQueuedAudio, got %" SDL_PRIu32 ".", queued);
+
+  /* Let the device thread drain a few buffers' worth while we keep queueing. */
+  SDL_PauseAudioDevice(id, 0);
+  for (i = 0; i < 4; ++i) {
+    failures += (SDL_QueueAudio(id, chunk, obtained.size > sizeof(chunk) ? sizeof(chunk) : obtained.size) != 0);
+  }
+  SDLTest_AssertCheck(failures == 0, "Expected SDL_QueueAudio to succeed on a playing device.");
+  deadline = SDL_GetTicks64() + 5000;
+  while (SDL_GetQueuedAudioSize(id) > 0 && SDL_GetTicks64() < deadline) {
+    SDL_Delay(10);
+  }
+  queued = SDL_GetQueuedAudioSize(id);
+  SDLTest_AssertCheck(queued == 0, "Expected the device to play everything queued, %" SDL_PRIu32 " bytes left.", queued);
+  SDLTest_AssertCheck(SDL_DequeueAudio(id, chunk, sizeof(chunk)) == 0, "Expected SDL_DequeueAudio to do nothing on a playback device.");
+  SDL_CloseAudioDevice(id);
+
+  id = SDL_OpenAudioDevice(NULL, 1, &desired, &obtained, 0);
+  SDLTest_AssertPass("Call to SDL_OpenAudioDevice(NULL, 1, ...)");
+  if (id == 0) {
+    SDLTest_Log("No capture device to test with: %s", SDL_GetError());
+    return TEST_COMPLETED;
+  }
+
+  SDLTest_AssertCheck(SDL_QueueAudio(id, chunk, sizeof(chunk)) < 0, "Expected SDL_QueueAudio to fail on a capture device.");
+  SDL_PauseAudioDevice(id, 0);
+  deadline = SDL_GetTicks64() + 5000;
+  while (SDL_GetQueuedAudioSize(id) < obtained.size && SDL_GetTicks64() < deadline) {
+    SDL_Delay(10);
+  }
+  SDL_PauseAudioDevice(id, 1);
+  queued = SDL_GetQueuedAudioSize(id);
+  SDLTest_AssertCheck(queued >= obtained.size, "Expected at least %" SDL_PRIu32 " bytes captured, got %" SDL_PRIu32 ".", obtained.size, queued);
+
+  captured = (Uint8 *)SDL_malloc(queued ? queued : 1);
+  SDLTest_AssertCheck(captured != NULL, "Expected SDL_malloc to succeed.");
+  if (captured) {
+    const Uint32 dequeued = SDL_DequeueAudio(id, captured, queued);
+    SDLTest_AssertCheck(dequeued == queued, "Expected to dequeue %" SDL_PRIu32 " bytes, got %" SDL_PRIu32 ".", queued, dequeued);
+    if (SDL_strcmp(SDL_GetCurrentAudioDriver(), "dummy") == 0) {
+      /* The dummy driver captures silence. */
+      for (i = 0; i < (int)dequeued && captured[i] == obtained.silence; ++i) {
+      }
+      SDLTest_AssertCheck(i == (int)dequeued, "Expected the dummy driver to capture silence.");
+    }
+    SDL_free(captured);
+  }
+
+  SDL_ClearQueuedAudio(id);
+  queued = SDL_GetQueuedAudioSize(id);
+  SDLTest_AssertCheck(queued == 0, "Expected nothing queued after SDL_ClearQueuedAudio, got %" SDL_PRIu32 ".", queued);
+  SDL_CloseAudioDevice(id);
+  return TEST_COMPLETED;
+}
+
 /* ================= Test Case References ================== */
 
 /* Audio test cases */
@@ -1285,11 +1679,28 @@ static const SDLTest_TestCaseReference audioTest16 = {
     (SDLTest_TestCaseFp)audio_resampleLoss, "audio_resampleLoss", "Check signal-to-noise ratio and maximum error of audio resampling.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference audioTest17 = {
+    (SDLTest_TestCaseFp)audio_resampleChannels, "audio_resampleChannels", "Check that multichannel resampling matches mono resampling.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest18 = {
+    (SDLTest_TestCaseFp)audio_resampleQuality, "audio_resampleQuality", "Check signal-to-noise ratio of every audio stream resampler quality.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest19 = {
+    (SDLTest_TestCaseFp)audio_mixAudioFormat, "audio_mixAudioFormat", "Check SDL_MixAudioFormat against a reference for the native formats.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest20 = {
+    (SDLTest_TestCaseFp)audio_queueAudio, "audio_queueAudio", "Queue and dequeue audio while the device is running.", TEST_ENABLED
+};
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] = {
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
-    &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16, NULL
+    &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16, &audioTest17,
+    &audioTest18, &audioTest19, &audioTest20, NULL
 };
 
 /* Audio test suite (global) */
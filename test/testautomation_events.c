@@ -174,6 +174,208 @@ int events_addDelEventWatchWithUserdata(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * @brief Test retrieving several events at once, respecting poll cycles.
+ *
+ * @sa SDL_PollEvents
+ */
+int events_pollEventsBatch(void *arg)
+{
+    SDL_Event event;
+    SDL_Event events[16];
+    int i, result, count;
+
+    /* Start from an empty queue */
+    while (SDL_PollEvent(&event)) {
+    }
+
+    SDL_zero(event);
+    event.type = SDL_USEREVENT;
+    for (i = 0; i < 5; ++i) {
+        event.user.code = i;
+        SDL_PushEvent(&event);
+    }
+    SDLTest_AssertPass("Call to SDL_PushEvent() x5");
+
+    result = SDL_PollEvents(events, SDL_arraysize(events));
+    SDLTest_AssertPass("Call to SDL_PollEvents()");
+    SDLTest_AssertCheck(result == 5, "Check result from SDL_PollEvents, expected: 5, got: %d", result);
+    for (i = 0; i < result; ++i) {
+        SDLTest_AssertCheck(events[i].type == SDL_USEREVENT && events[i].user.code == i,
+                            "Check event %d, expected code %d, got type 0x%x code %d", i, i, events[i].type, events[i].user.code);
+    }
+
+    /* Nothing is left */
+    result = SDL_PollEvents(events, SDL_arraysize(events));
+    SDLTest_AssertCheck(result == 0, "Check result from SDL_PollEvents on an empty queue, expected: 0, got: %d", result);
+
+    /* Only as many events as requested are returned */
+    for (i = 0; i < 3; ++i) {
+        event.user.code = i;
+        SDL_PushEvent(&event);
+    }
+    result = SDL_PollEvents(events, 2);
+    SDLTest_AssertCheck(result == 2, "Check result from SDL_PollEvents, expected: 2, got: %d", result);
+    result = SDL_PollEvents(events, 2);
+    SDLTest_AssertCheck(result == 1, "Check result from SDL_PollEvents, expected: 1, got: %d", result);
+    SDLTest_AssertCheck(events[0].user.code == 2, "Check remaining event, expected code 2, got %d", events[0].user.code);
+    result = SDL_PollEvents(events, 2);
+    SDLTest_AssertCheck(result == 0, "Check result from SDL_PollEvents on an empty queue, expected: 0, got: %d", result);
+
+    /* Once per frame, every call gets the events of its frame */
+    for (count = 0; count < 4; ++count) {
+        for (i = 0; i < 2; ++i) {
+            event.user.code = count * 2 + i;
+            SDL_PushEvent(&event);
+        }
+        result = SDL_PollEvents(events, SDL_arraysize(events));
+        SDLTest_AssertCheck(result == 2 && events[0].user.code == count * 2,
+                            "Check frame %d, expected: 2 events starting with code %d, got: %d", count, count * 2, result);
+    }
+
+    /* A full batch leaves the rest for SDL_PollEvent() */
+    for (i = 0; i < 3; ++i) {
+        event.user.code = i;
+        SDL_PushEvent(&event);
+    }
+    result = SDL_PollEvents(events, 1);
+    SDLTest_AssertCheck(result == 1, "Check result from SDL_PollEvents, expected: 1, got: %d", result);
+    count = 0;
+    while (SDL_PollEvent(&event)) {
+        ++count;
+    }
+    SDLTest_AssertCheck(count == 2, "Check events left for SDL_PollEvent, expected: 2, got: %d", count);
+
+    /* The documented loop ends even when every batch adds more events */
+    event.type = SDL_USEREVENT;
+    for (i = 0; i < 3; ++i) {
+        event.user.code = i;
+        SDL_PushEvent(&event);
+    }
+    count = 0;
+    do {
+        result = SDL_PollEvents(events, SDL_arraysize(events));
+        for (i = 0; i < 3; ++i) {
+            event.user.code = i;
+            SDL_PushEvent(&event);
+        }
+        ++count;
+    } while (result == SDL_arraysize(events) && count < 100);
+    SDLTest_AssertCheck(count == 1, "Check batches with events arriving, expected: 1, got: %d", count);
+    result = SDL_PollEvents(events, SDL_arraysize(events));
+    SDLTest_AssertCheck(result == 3, "Check events left for the next call, expected: 3, got: %d", result);
+    result = SDL_PollEvents(events, SDL_arraysize(events));
+    SDLTest_AssertCheck(result == 0, "Check result from SDL_PollEvents on an empty queue, expected: 0, got: %d", result);
+
+    /* Invalid parameters */
+    result = SDL_PollEvents(NULL, 1);
+    SDLTest_AssertCheck(result == -1, "Check SDL_PollEvents(NULL, 1), expected: -1, got: %d", result);
+    result = SDL_PollEvents(events, 0);
+    SDLTest_AssertCheck(result == -1, "Check SDL_PollEvents(events, 0), expected: -1, got: %d", result);
+
+    /* Leave the queue clean for other tests */
+    while (SDL_PollEvent(&event)) {
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that consecutive motion events are merged when SDL_HINT_EVENT_COALESCE_MOTION is set
+ *
+ * \sa SDL_HINT_EVENT_COALESCE_MOTION
+ */
+int events_coalesceMotion(void *arg)
+{
+    SDL_Event event;
+    SDL_Event events[16];
+    int i, result;
+
+    /* Start from an empty queue */
+    SDL_PumpEvents();
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+    SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOTION, "1");
+    SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOTION, \"1\")");
+
+    /* A run of mouse motion collapses into one event with the summed deltas */
+    SDL_zero(event);
+    event.type = SDL_MOUSEMOTION;
+    event.motion.windowID = 1;
+    for (i = 1; i <= 4; ++i) {
+        event.motion.x = i * 10;
+        event.motion.y = i * 20;
+        event.motion.xrel = 10;
+        event.motion.yrel = -2;
+        SDL_PushEvent(&event);
+    }
+    SDLTest_AssertPass("Call to SDL_PushEvent() x4 with SDL_MOUSEMOTION");
+
+    /* A button press is a barrier, the motion after it starts a new run */
+    event.type = SDL_MOUSEBUTTONDOWN;
+    event.button.windowID = 1;
+    event.button.button = SDL_BUTTON_LEFT;
+    SDL_PushEvent(&event);
+    SDL_zero(event);
+    event.type = SDL_MOUSEMOTION;
+    event.motion.windowID = 1;
+    event.motion.xrel = 1;
+    SDL_PushEvent(&event);
+    SDL_PushEvent(&event);
+
+    /* Motion in another window is not merged */
+    event.motion.windowID = 2;
+    SDL_PushEvent(&event);
+
+    result = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+    SDLTest_AssertPass("Call to SDL_PeepEvents()");
+    SDLTest_AssertCheck(result == 4, "Check result from SDL_PeepEvents, expected: 4, got: %d", result);
+    if (result == 4) {
+        SDLTest_AssertCheck(events[0].type == SDL_MOUSEMOTION && events[0].motion.x == 40 && events[0].motion.y == 80,
+                            "Check merged position, expected: 40,80, got: %d,%d", events[0].motion.x, events[0].motion.y);
+        SDLTest_AssertCheck(events[0].motion.xrel == 40 && events[0].motion.yrel == -8,
+                            "Check merged deltas, expected: 40,-8, got: %d,%d", events[0].motion.xrel, events[0].motion.yrel);
+        SDLTest_AssertCheck(events[1].type == SDL_MOUSEBUTTONDOWN, "Check barrier event, expected: 0x%x, got: 0x%x", SDL_MOUSEBUTTONDOWN, events[1].type);
+        SDLTest_AssertCheck(events[2].type == SDL_MOUSEMOTION && events[2].motion.xrel == 2,
+                            "Check motion after the barrier, expected xrel: 2, got: %d", events[2].motion.xrel);
+        SDLTest_AssertCheck(events[3].type == SDL_MOUSEMOTION && events[3].motion.windowID == 2,
+                            "Check motion in another window, expected windowID: 2, got: %d", events[3].motion.windowID);
+    }
+
+    /* Fingers are merged per finger */
+    SDL_zero(event);
+    event.type = SDL_FINGERMOTION;
+    event.tfinger.touchId = 1;
+    for (i = 0; i < 3; ++i) {
+        event.tfinger.fingerId = 1;
+        event.tfinger.dx = 0.25f;
+        SDL_PushEvent(&event);
+    }
+    event.tfinger.fingerId = 2;
+    SDL_PushEvent(&event);
+    result = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+    SDLTest_AssertCheck(result == 2, "Check finger events, expected: 2, got: %d", result);
+    if (result == 2) {
+        SDLTest_AssertCheck(events[0].tfinger.fingerId == 1 && events[0].tfinger.dx == 0.75f,
+                            "Check merged finger delta, expected: 0.75, got: %f", events[0].tfinger.dx);
+        SDLTest_AssertCheck(events[1].tfinger.fingerId == 2, "Check second finger, expected: 2, got: %d", (int)events[1].tfinger.fingerId);
+    }
+
+    /* With the hint off every event is queued */
+    SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOTION, "0");
+    SDL_zero(event);
+    event.type = SDL_MOUSEMOTION;
+    for (i = 0; i < 3; ++i) {
+        SDL_PushEvent(&event);
+    }
+    result = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+    SDLTest_AssertCheck(result == 3, "Check uncoalesced events, expected: 3, got: %d", result);
+
+    SDL_ResetHint(SDL_HINT_EVENT_COALESCE_MOTION);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Events test cases */
@@ -189,9 +391,17 @@ static const SDLTest_TestCaseReference eventsTest3 = {
     (SDLTest_TestCaseFp)events_addDelEventWatchWithUserdata, "events_addDelEventWatchWithUserdata", "Adds and deletes an event watch function with userdata", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference eventsTest4 = {
+    (SDLTest_TestCaseFp)events_pollEventsBatch, "events_pollEventsBatch", "Retrieves several events with one call to SDL_PollEvents", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest5 = {
+    (SDLTest_TestCaseFp)events_coalesceMotion, "events_coalesceMotion", "Merges consecutive motion events with SDL_HINT_EVENT_COALESCE_MOTION", TEST_ENABLED
+};
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] = {
-    &eventsTest1, &eventsTest2, &eventsTest3, NULL
+    &eventsTest1, &eventsTest2, &eventsTest3, &eventsTest4, &eventsTest5, NULL
 };
 
 /* Events test suite (global) */
@@ -188,6 +188,108 @@ static int log_testHint(void *arg)
     return TEST_COMPLETED;
 }
 
+#define ASYNC_MESSAGES 1000
+
+typedef struct
+{
+    int received;
+    int out_of_order;
+    int last;
+    size_t longest;
+    SDL_sem *hold; /* the first message waits for this, when set */
+} AsyncLogState;
+
+static void SDLCALL TestAsyncLogOutput(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+    AsyncLogState *state = (AsyncLogState *)userdata;
+    int number = SDL_atoi(message);
+
+    if (category != SDL_LOG_CATEGORY_CUSTOM) {
+        /* The test harness */
+        original_function(original_userdata, category, priority, message);
+        return;
+    }
+    if (state->hold) {
+        SDL_SemWait(state->hold);
+        state->hold = NULL;
+    }
+    if (number <= state->last) {
+        ++state->out_of_order;
+    }
+    state->last = number;
+    state->longest = SDL_max(state->longest, SDL_strlen(message));
+    ++state->received;
+}
+
+/**
+ * Check that asynchronous logging delivers every message in order, and
+ * counts the ones it has to drop
+ */
+static int log_testAsync(void *arg)
+{
+    AsyncLogState state;
+    SDL_sem *hold;
+    char padding[1024];
+    int dropped;
+    int i;
+
+    SDL_SetHint(SDL_HINT_LOGGING, "info");
+    SDL_zero(state);
+    state.last = -1;
+    SDL_memset(padding, 'x', sizeof(padding) - 1);
+    padding[sizeof(padding) - 1] = '\0';
+    SDL_LogGetOutputFunction(&original_function, &original_userdata);
+    SDL_LogSetOutputFunction(TestAsyncLogOutput, &state);
+
+    SDL_LogFlush();
+    SDLTest_AssertPass("SDL_LogFlush() with asynchronous logging off");
+
+    SDLTest_AssertCheck(SDL_LogSetAsync(SDL_TRUE) == 0, "SDL_LogSetAsync(SDL_TRUE)");
+    for (i = 0; i < 100; ++i) {
+        SDL_LogMessage(SDL_LOG_CATEGORY_CUSTOM, SDL_LOG_PRIORITY_INFO, "%d %s\n", i, (i % 10) ? "" : padding);
+    }
+    SDL_LogFlush();
+    SDLTest_AssertPass("Log 100 messages and call SDL_LogFlush()");
+    SDLTest_AssertCheck(state.received == 100, "Check messages received, expected: 100, got: %d", state.received);
+    SDLTest_AssertCheck(state.out_of_order == 0, "Check messages out of order, expected: 0, got: %d", state.out_of_order);
+    SDLTest_AssertCheck(state.longest == sizeof(padding) + 2, "Check longest message, expected: %d, got: %d", (int)sizeof(padding) + 2, (int)state.longest);
+
+    /* Stall the output function so the ring fills up */
+    SDL_zero(state);
+    state.last = -1;
+    hold = SDL_CreateSemaphore(0);
+    state.hold = hold;
+    dropped = SDL_LogGetDroppedCount();
+    for (i = 0; i < ASYNC_MESSAGES; ++i) {
+        SDL_LogMessage(SDL_LOG_CATEGORY_CUSTOM, SDL_LOG_PRIORITY_INFO, "%d", i);
+    }
+    dropped = SDL_LogGetDroppedCount() - dropped;
+    SDL_SemPost(hold);
+    SDL_LogFlush();
+    SDL_DestroySemaphore(hold);
+    SDLTest_AssertPass("Log %d messages with the output function stalled", ASYNC_MESSAGES);
+    SDLTest_AssertCheck(dropped > 0, "Check messages dropped, expected: > 0, got: %d", dropped);
+    SDLTest_AssertCheck(state.received + dropped == ASYNC_MESSAGES, "Check messages received and dropped, expected: %d, got: %d", ASYNC_MESSAGES, state.received + dropped);
+    SDLTest_AssertCheck(state.out_of_order == 0, "Check messages out of order, expected: 0, got: %d", state.out_of_order);
+
+    /* Turning it off delivers what's left */
+    SDL_zero(state);
+    state.last = -1;
+    for (i = 0; i < 10; ++i) {
+        SDL_LogMessage(SDL_LOG_CATEGORY_CUSTOM, SDL_LOG_PRIORITY_INFO, "%d", i);
+    }
+    SDLTest_AssertCheck(SDL_LogSetAsync(SDL_FALSE) == 0, "SDL_LogSetAsync(SDL_FALSE)");
+    SDLTest_AssertCheck(state.received == 10, "Check messages received, expected: 10, got: %d", state.received);
+
+    SDL_LogMessage(SDL_LOG_CATEGORY_CUSTOM, SDL_LOG_PRIORITY_INFO, "%d", 10);
+    SDLTest_AssertCheck(state.received == 11, "Check synchronous message received, expected: 11, got: %d", state.received);
+    SDLTest_AssertCheck(state.out_of_order == 0, "Check messages out of order, expected: 0, got: %d", state.out_of_order);
+
+    SDL_LogSetOutputFunction(original_function, original_userdata);
+    SDL_SetHint(SDL_HINT_LOGGING, NULL);
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Log test cases */
@@ -195,9 +297,13 @@ static const SDLTest_TestCaseReference logTestHint = {
     (SDLTest_TestCaseFp)log_testHint, "log_testHint", "Check SDL_HINT_LOGGING functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference logTestAsync = {
+    (SDLTest_TestCaseFp)log_testAsync, "log_testAsync", "Check asynchronous logging", TEST_ENABLED
+};
+
 /* Sequence of Log test cases */
 static const SDLTest_TestCaseReference *logTests[] = {
-    &logTestHint, NULL
+    &logTestHint, &logTestAsync, NULL
 };
 
 /* Timer test suite (global) */
@@ -811,6 +811,925 @@ int render_testBlitBlend(void *arg)
     return TEST_COMPLETED;
 }
 
+/* Draws the same pseudo-random scene every time it is called */
+static void
+_drawSoftwareScene(SDL_Renderer *swrenderer, SDL_Texture *tface)
+{
+    Uint32 seed = 12345;
+    SDL_Rect viewport, clip, rect, src;
+    SDL_Point points[8];
+    SDL_Vertex verts[6];
+    Uint8 color[4];
+    int i, j;
+
+#define NEXT_RANDOM(n) ((int)((seed = seed * 1103515245 + 12345) >> 8) % (n))
+
+    SDL_SetRenderDrawColor(swrenderer, 32, 64, 96, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(swrenderer);
+
+    for (i = 0; i < 64; i++) {
+        viewport.x = NEXT_RANDOM(40) - 8;
+        viewport.y = NEXT_RANDOM(40) - 8;
+        viewport.w = 200 + NEXT_RANDOM(120);
+        viewport.h = 150 + NEXT_RANDOM(90);
+        SDL_RenderSetViewport(swrenderer, (i % 4) ? &viewport : NULL);
+
+        clip.x = NEXT_RANDOM(60);
+        clip.y = NEXT_RANDOM(60);
+        clip.w = 40 + NEXT_RANDOM(200);
+        clip.h = 40 + NEXT_RANDOM(150);
+        SDL_RenderSetClipRect(swrenderer, (i % 3) ? NULL : &clip);
+
+        for (j = 0; j < SDL_arraysize(color); j++) {
+            color[j] = (Uint8)NEXT_RANDOM(256);
+        }
+        SDL_SetRenderDrawColor(swrenderer, color[0], color[1], color[2], color[3]);
+        SDL_SetRenderDrawBlendMode(swrenderer, (SDL_BlendMode)(i % 3));
+
+        switch (i % 7) {
+        case 0:
+            rect.x = NEXT_RANDOM(320) - 20;
+            rect.y = NEXT_RANDOM(240) - 20;
+            rect.w = NEXT_RANDOM(160);
+            rect.h = NEXT_RANDOM(160);
+            SDL_RenderFillRect(swrenderer, &rect);
+            break;
+        case 1:
+            for (j = 0; j < SDL_arraysize(points); j++) {
+                points[j].x = NEXT_RANDOM(360) - 20;
+                points[j].y = NEXT_RANDOM(280) - 20;
+            }
+            SDL_RenderDrawLines(swrenderer, points, SDL_arraysize(points));
+            SDL_RenderDrawPoints(swrenderer, points, SDL_arraysize(points));
+            break;
+        case 2:
+        case 3:
+            rect.x = NEXT_RANDOM(320) - 20;
+            rect.y = NEXT_RANDOM(240) - 20;
+            rect.w = (i % 7 == 2) ? 42 : 8 + NEXT_RANDOM(200);
+            rect.h = (i % 7 == 2) ? 42 : 8 + NEXT_RANDOM(200);
+            src.x = NEXT_RANDOM(60);
+            src.y = NEXT_RANDOM(60);
+            src.w = 42;
+            src.h = 42;
+            color[0] = (Uint8)NEXT_RANDOM(256);
+            color[2] = (Uint8)NEXT_RANDOM(256);
+            SDL_SetTextureColorMod(tface, color[0], 255, color[2]);
+            SDL_SetTextureAlphaMod(tface, NEXT_RANDOM(256));
+            SDL_SetTextureBlendMode(tface, (SDL_BlendMode)(1 << (i % 4)));
+            SDL_RenderCopy(swrenderer, tface, &src, &rect);
+            break;
+        case 4:
+            rect.x = NEXT_RANDOM(320) - 20;
+            rect.y = NEXT_RANDOM(240) - 20;
+            rect.w = 20 + NEXT_RANDOM(100);
+            rect.h = 20 + NEXT_RANDOM(100);
+            SDL_SetTextureBlendMode(tface, SDL_BLENDMODE_BLEND);
+            SDL_RenderCopyEx(swrenderer, tface, NULL, &rect, NEXT_RANDOM(360), NULL, SDL_FLIP_NONE);
+            break;
+        default:
+            for (j = 0; j < SDL_arraysize(verts); j++) {
+                verts[j].position.x = (float)(NEXT_RANDOM(3600) - 200) / 10.0f;
+                verts[j].position.y = (float)(NEXT_RANDOM(2800) - 200) / 10.0f;
+                verts[j].color.r = NEXT_RANDOM(256);
+                verts[j].color.g = NEXT_RANDOM(256);
+                verts[j].color.b = NEXT_RANDOM(256);
+                verts[j].color.a = NEXT_RANDOM(256);
+                verts[j].tex_coord.x = (float)NEXT_RANDOM(100) / 100.0f;
+                verts[j].tex_coord.y = (float)NEXT_RANDOM(100) / 100.0f;
+            }
+            SDL_RenderGeometry(swrenderer, (i % 7 == 5) ? tface : NULL, verts, SDL_arraysize(verts), NULL, 0);
+            break;
+        }
+    }
+
+#undef NEXT_RANDOM
+}
+
+/* Renders the scene into the surface twice, to reuse the render threads */
+static int
+_renderSoftwareSceneTo(SDL_Surface *surface, SDL_Surface *face)
+{
+    SDL_Renderer *swrenderer;
+    SDL_Texture *tface;
+
+    swrenderer = SDL_CreateSoftwareRenderer(surface);
+    SDLTest_AssertCheck(swrenderer != NULL, "Verify SDL_CreateSoftwareRenderer() result");
+    if (swrenderer == NULL) {
+        return -1;
+    }
+
+    tface = SDL_CreateTextureFromSurface(swrenderer, face);
+    SDLTest_AssertCheck(tface != NULL, "Verify SDL_CreateTextureFromSurface() result");
+    if (tface == NULL) {
+        SDL_DestroyRenderer(swrenderer);
+        return -1;
+    }
+
+    _drawSoftwareScene(swrenderer, tface);
+    SDL_RenderPresent(swrenderer);
+    _drawSoftwareScene(swrenderer, tface);
+    SDL_RenderPresent(swrenderer);
+
+    SDL_DestroyTexture(tface);
+    SDL_DestroyRenderer(swrenderer);
+    return 0;
+}
+
+/**
+ * @brief Tests that the software renderer draws the same with SDL_HINT_RENDER_SOFTWARE_THREADS set
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/SDL_HINT_RENDER_SOFTWARE_THREADS
+ */
+int render_testSoftwareThreads(void *arg)
+{
+    static const char *threads[] = { "0", "2", "3", "4", "7" };
+    SDL_Surface *surfaces[SDL_arraysize(threads)];
+    SDL_Surface *indexed[2];
+    SDL_Color colors[256];
+    SDL_Surface *face;
+    int i, result;
+
+    face = SDLTest_ImageFace();
+    SDLTest_AssertCheck(face != NULL, "Verify SDLTest_ImageFace() result");
+    if (face == NULL) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(threads); i++) {
+        SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, threads[i]);
+        SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, \"%s\")", threads[i]);
+
+        surfaces[i] = SDL_CreateRGBSurface(0, 320, 240, 32, RENDER_COMPARE_RMASK, RENDER_COMPARE_GMASK, RENDER_COMPARE_BMASK, RENDER_COMPARE_AMASK);
+        SDLTest_AssertCheck(surfaces[i] != NULL, "Verify SDL_CreateRGBSurface() result");
+        if (surfaces[i] == NULL) {
+            return TEST_ABORTED;
+        }
+        if (_renderSoftwareSceneTo(surfaces[i], face) < 0) {
+            return TEST_ABORTED;
+        }
+
+        if (i > 0) {
+            result = SDLTest_CompareSurfaces(surfaces[i], surfaces[0], 0);
+            SDLTest_AssertCheck(result == 0, "Validate rendering with %s threads matches a single thread, expected: 0, got: %i", threads[i], result);
+        }
+    }
+
+    /* An indexed target, colors have to be mapped through its own palette */
+    for (i = 0; i < SDL_arraysize(colors); i++) {
+        colors[i].r = (Uint8)(((i >> 5) & 7) * 255 / 7);
+        colors[i].g = (Uint8)(((i >> 2) & 7) * 255 / 7);
+        colors[i].b = (Uint8)((i & 3) * 255 / 3);
+        colors[i].a = SDL_ALPHA_OPAQUE;
+    }
+    for (i = 0; i < SDL_arraysize(indexed); i++) {
+        SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, i ? "4" : "0");
+        SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, \"%s\")", i ? "4" : "0");
+
+        indexed[i] = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 8, SDL_PIXELFORMAT_INDEX8);
+        SDLTest_AssertCheck(indexed[i] != NULL, "Verify SDL_CreateRGBSurfaceWithFormat(SDL_PIXELFORMAT_INDEX8) result");
+        if (indexed[i] == NULL) {
+            return TEST_ABORTED;
+        }
+        SDL_SetPaletteColors(indexed[i]->format->palette, colors, 0, SDL_arraysize(colors));
+        if (_renderSoftwareSceneTo(indexed[i], face) < 0) {
+            return TEST_ABORTED;
+        }
+    }
+    result = SDLTest_CompareSurfaces(indexed[1], indexed[0], 0);
+    SDLTest_AssertCheck(result == 0, "Validate rendering to an INDEX8 surface with 4 threads matches a single thread, expected: 0, got: %i", result);
+
+    SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, NULL);
+    for (i = 0; i < SDL_arraysize(threads); i++) {
+        SDL_FreeSurface(surfaces[i]);
+    }
+    for (i = 0; i < SDL_arraysize(indexed); i++) {
+        SDL_FreeSurface(indexed[i]);
+    }
+    SDL_FreeSurface(face);
+
+    return TEST_COMPLETED;
+}
+
+/* Draws the same pseudo-random triangles every time it is called */
+static void
+_drawGeometryScene(SDL_Renderer *swrenderer, SDL_Texture **textures, int num_textures)
+{
+    static const int sizes[] = { 12, 160, 48, 900, 5 };
+    Uint32 seed = 54321;
+    SDL_Rect clip;
+    SDL_Vertex verts[6];
+    Uint8 color[4];
+    int i, j, k;
+
+#define NEXT_RANDOM(n) ((int)((seed = seed * 1103515245 + 12345) >> 8) % (n))
+
+    for (i = 0; i < 300; i++) {
+        const int size = sizes[i % SDL_arraysize(sizes)];
+        const int kind = (i / 5) % 4; /* uniform fill, gradient fill, textured, textured with colors */
+        SDL_Texture *texture = (kind >= 2) ? textures[(i / 20) % num_textures] : NULL;
+        const int cx = NEXT_RANDOM(600);
+        const int cy = NEXT_RANDOM(200);
+
+        clip.x = NEXT_RANDOM(300);
+        clip.y = NEXT_RANDOM(100);
+        clip.w = 8 + NEXT_RANDOM(300);
+        clip.h = 8 + NEXT_RANDOM(100);
+        SDL_RenderSetClipRect(swrenderer, (i % 7) ? NULL : &clip);
+
+        for (j = 0; j < SDL_arraysize(color); j++) {
+            color[j] = (Uint8)NEXT_RANDOM(256);
+        }
+        if (i % 3 == 0) {
+            color[3] = SDL_ALPHA_OPAQUE;
+        }
+        if (kind == 2) {
+            color[0] = color[1] = color[2] = 255;
+            if (i % 2 == 0) {
+                color[3] = SDL_ALPHA_OPAQUE;
+            }
+        }
+
+        for (j = 0; j < SDL_arraysize(verts); j++) {
+            verts[j].position.x = (float)(cx * 10 + NEXT_RANDOM(size * 10) - size * 5) / 10.0f;
+            verts[j].position.y = (float)(cy * 10 + NEXT_RANDOM(size * 10) - size * 5) / 10.0f;
+            verts[j].tex_coord.x = (float)NEXT_RANDOM(101) / 100.0f;
+            verts[j].tex_coord.y = (float)NEXT_RANDOM(101) / 100.0f;
+            verts[j].color.r = color[0];
+            verts[j].color.g = color[1];
+            verts[j].color.b = color[2];
+            verts[j].color.a = color[3];
+            if (kind == 1 || kind == 3) {
+                for (k = 0; k < SDL_arraysize(color); k++) {
+                    color[k] = (Uint8)NEXT_RANDOM(256);
+                }
+            }
+        }
+
+        if (texture) {
+            SDL_SetTextureBlendMode(texture, (SDL_BlendMode)((i / 2) % 5 == 4 ? 0 : 1 << ((i / 2) % 5)));
+        } else {
+            SDL_SetRenderDrawBlendMode(swrenderer, (SDL_BlendMode)((i / 2) % 5 == 4 ? 0 : 1 << ((i / 2) % 5)));
+        }
+        SDL_RenderGeometry(swrenderer, texture, verts, SDL_arraysize(verts), NULL, 0);
+    }
+
+#undef NEXT_RANDOM
+}
+
+/**
+ * @brief Tests that the software renderer draws triangles exactly as its per-pixel loop did
+ *
+ * The checksums were taken before SDL_triangle.c rasterized in blocks.
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/SDL_RenderGeometry
+ */
+int render_testSoftwareGeometry(void *arg)
+{
+    static const struct
+    {
+        Uint32 format;
+        Uint32 crc;
+    } targets[] = {
+        { SDL_PIXELFORMAT_ARGB8888, 0xd6fbbb9e },
+        { SDL_PIXELFORMAT_RGB888, 0x7d2d4f36 },
+        { SDL_PIXELFORMAT_ABGR8888, 0xa58a78da },
+        { SDL_PIXELFORMAT_RGB565, 0x83beed5f }
+    };
+    SDL_Texture *textures[3];
+    SDL_Surface *face, *opaque;
+    int i, j;
+
+    face = SDLTest_ImageFace();
+    SDLTest_AssertCheck(face != NULL, "Verify SDLTest_ImageFace() result");
+    if (face == NULL) {
+        return TEST_ABORTED;
+    }
+    opaque = SDL_ConvertSurfaceFormat(face, SDL_PIXELFORMAT_RGB888, 0);
+    SDLTest_AssertCheck(opaque != NULL, "Verify SDL_ConvertSurfaceFormat() result");
+    if (opaque == NULL) {
+        SDL_FreeSurface(face);
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(targets); i++) {
+        SDL_Surface *surface;
+        SDL_Renderer *swrenderer;
+        Uint32 crc = 0;
+
+        surface = SDL_CreateRGBSurfaceWithFormat(0, 600, 200, 0, targets[i].format);
+        SDLTest_AssertCheck(surface != NULL, "Verify SDL_CreateRGBSurfaceWithFormat() result");
+        if (surface == NULL) {
+            return TEST_ABORTED;
+        }
+
+        swrenderer = SDL_CreateSoftwareRenderer(surface);
+        SDLTest_AssertCheck(swrenderer != NULL, "Verify SDL_CreateSoftwareRenderer() result");
+        if (swrenderer == NULL) {
+            return TEST_ABORTED;
+        }
+
+        textures[0] = SDL_CreateTextureFromSurface(swrenderer, face);
+        textures[1] = SDL_CreateTextureFromSurface(swrenderer, opaque);
+        textures[2] = SDL_CreateTexture(swrenderer, targets[i].format, SDL_TEXTUREACCESS_STATIC, face->w, face->h);
+        SDLTest_AssertCheck(textures[0] && textures[1] && textures[2], "Verify SDL_CreateTexture() results");
+        if (!textures[0] || !textures[1] || !textures[2]) {
+            return TEST_ABORTED;
+        }
+        SDL_UpdateTexture(textures[2], NULL, opaque->pixels, opaque->pitch);
+
+        SDL_SetRenderDrawColor(swrenderer, 32, 64, 96, SDL_ALPHA_OPAQUE);
+        SDL_RenderClear(swrenderer);
+        _drawGeometryScene(swrenderer, textures, SDL_arraysize(textures));
+        SDL_RenderPresent(swrenderer);
+
+        for (j = 0; j < surface->h; j++) {
+            crc = SDL_crc32(crc, (Uint8 *)surface->pixels + j * surface->pitch, (size_t)surface->w * surface->format->BytesPerPixel);
+        }
+        SDLTest_AssertCheck(crc == targets[i].crc, "Validate %s checksum, expected: 0x%08" SDL_PRIx32 ", got: 0x%08" SDL_PRIx32,
+                            SDL_GetPixelFormatName(targets[i].format), targets[i].crc, crc);
+
+        for (j = 0; j < SDL_arraysize(textures); j++) {
+            SDL_DestroyTexture(textures[j]);
+        }
+        SDL_DestroyRenderer(swrenderer);
+        SDL_FreeSurface(surface);
+    }
+
+    SDL_FreeSurface(opaque);
+    SDL_FreeSurface(face);
+
+    return TEST_COMPLETED;
+}
+
+/* Reads pixel (x, y) of a 32-bit surface */
+static Uint32
+_getPixel32(SDL_Surface *surface, int x, int y)
+{
+    return *(Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch + x * 4);
+}
+
+/* Each channel of two ARGB8888 pixels is at most 'tolerance' apart */
+static SDL_bool
+_pixelsClose(Uint32 a, Uint32 b, int tolerance)
+{
+    int shift;
+
+    for (shift = 0; shift < 32; shift += 8) {
+        if (SDL_abs((int)((a >> shift) & 0xff) - (int)((b >> shift) & 0xff)) > tolerance) {
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+
+/* Computes what an ARGB8888 'face' copied to 'rect' with SDL_RenderCopyEx() at 'angle' degrees around its
+   center, linear sampling, color and alpha mod and blending leaves at x,y over an opaque 'clear'.
+   Returns SDL_FALSE for pixels outside of the rect or too close to its edge to be sure of. */
+static SDL_bool
+_rotatedReferencePixel(SDL_Surface *face, const SDL_Rect *rect, double angle, int x, int y,
+                       int modR, int modG, int modB, int modA, Uint32 clear, Uint32 *pixel)
+{
+    const double radians = angle * M_PI / 180.0;
+    const double c = SDL_cos(radians), s = SDL_sin(radians);
+    const double px = x + 0.5 - (rect->x + rect->w / 2.0), py = y + 0.5 - (rect->y + rect->h / 2.0);
+    const double u = c * px + s * py + rect->w / 2.0, v = -s * px + c * py + rect->h / 2.0;
+    double su, sv, wx, wy, channels[4];
+    int ix, iy, i, a, result;
+
+    if (u < 1.0 || v < 1.0 || u > rect->w - 1.0 || v > rect->h - 1.0) {
+        return SDL_FALSE;
+    }
+
+    /* Bilinear sample around the pixel center */
+    su = u * face->w / rect->w - 0.5;
+    sv = v * face->h / rect->h - 0.5;
+    ix = (int)SDL_floor(su);
+    iy = (int)SDL_floor(sv);
+    wx = su - ix;
+    wy = sv - iy;
+    for (i = 0; i < 4; i++) {
+        const int shift = i * 8;
+        const int x0 = SDL_max(ix, 0), x1 = SDL_min(ix + 1, face->w - 1);
+        const int y0 = SDL_max(iy, 0), y1 = SDL_min(iy + 1, face->h - 1);
+        const double top = ((_getPixel32(face, x0, y0) >> shift) & 0xff) * (1.0 - wx) + ((_getPixel32(face, x1, y0) >> shift) & 0xff) * wx;
+        const double bottom = ((_getPixel32(face, x0, y1) >> shift) & 0xff) * (1.0 - wx) + ((_getPixel32(face, x1, y1) >> shift) & 0xff) * wx;
+        channels[i] = top * (1.0 - wy) + bottom * wy;
+    }
+
+    /* Blue, green, red and alpha, modulated and blended over the clear color */
+    channels[0] = channels[0] * modB / 255.0;
+    channels[1] = channels[1] * modG / 255.0;
+    channels[2] = channels[2] * modR / 255.0;
+    a = (int)(channels[3] * modA / 255.0 + 0.5);
+    result = 0xff000000;
+    for (i = 0; i < 3; i++) {
+        const int d = (clear >> (i * 8)) & 0xff;
+        result |= (int)((channels[i] * a + d * (255 - a)) / 255.0 + 0.5) << (i * 8);
+    }
+    *pixel = (Uint32)result;
+    return SDL_TRUE;
+}
+
+/**
+ * @brief Tests rotating and flipping with SDL_RenderCopyEx on the software renderer
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/SDL_RenderCopyEx
+ */
+int render_testSoftwareCopyEx(void *arg)
+{
+    static const struct
+    {
+        double angle;
+        SDL_RendererFlip flip;
+        SDL_ScaleMode scale_mode;
+    } cases[] = {
+        { 0.0, SDL_FLIP_NONE, SDL_ScaleModeNearest },
+        { 0.0, SDL_FLIP_NONE, SDL_ScaleModeLinear },
+        { 90.0, SDL_FLIP_NONE, SDL_ScaleModeNearest },
+        { 180.0, SDL_FLIP_NONE, SDL_ScaleModeLinear },
+        { -90.0, SDL_FLIP_NONE, SDL_ScaleModeNearest },
+        { 0.0, SDL_FLIP_HORIZONTAL, SDL_ScaleModeNearest },
+        { 0.0, SDL_FLIP_VERTICAL, SDL_ScaleModeLinear },
+        { 90.0, SDL_FLIP_HORIZONTAL, SDL_ScaleModeNearest }
+    };
+    const Uint32 clear = 0xff204060;
+    SDL_Surface *image, *face, *surface;
+    SDL_Renderer *swrenderer;
+    SDL_Texture *tface;
+    SDL_Rect rect;
+    int i, x, y, mismatches, compared;
+    Uint32 pixel;
+
+    image = SDLTest_ImageFace();
+    SDLTest_AssertCheck(image != NULL, "Verify SDLTest_ImageFace() result");
+    if (image == NULL) {
+        return TEST_ABORTED;
+    }
+    face = SDL_ConvertSurfaceFormat(image, RENDER_COMPARE_FORMAT, 0);
+    SDL_FreeSurface(image);
+    SDLTest_AssertCheck(face != NULL, "Verify SDL_ConvertSurfaceFormat() result");
+    if (face == NULL) {
+        return TEST_ABORTED;
+    }
+    surface = SDL_CreateRGBSurface(0, 128, 128, 32, RENDER_COMPARE_RMASK, RENDER_COMPARE_GMASK, RENDER_COMPARE_BMASK, RENDER_COMPARE_AMASK);
+    SDLTest_AssertCheck(surface != NULL, "Verify SDL_CreateRGBSurface() result");
+    if (surface == NULL) {
+        return TEST_ABORTED;
+    }
+    swrenderer = SDL_CreateSoftwareRenderer(surface);
+    SDLTest_AssertCheck(swrenderer != NULL, "Verify SDL_CreateSoftwareRenderer() result");
+    if (swrenderer == NULL) {
+        return TEST_ABORTED;
+    }
+    tface = SDL_CreateTextureFromSurface(swrenderer, face);
+    SDLTest_AssertCheck(tface != NULL, "Verify SDL_CreateTextureFromSurface() result");
+    if (tface == NULL) {
+        return TEST_ABORTED;
+    }
+    SDL_SetTextureBlendMode(tface, SDL_BLENDMODE_NONE);
+
+    rect.x = 40;
+    rect.y = 30;
+    rect.w = face->w;
+    rect.h = face->h;
+
+    /* Multiples of 90 degrees and flips move whole pixels, with either sampling */
+    for (i = 0; i < SDL_arraysize(cases); i++) {
+        SDL_SetRenderDrawColor(swrenderer, 0x20, 0x40, 0x60, 0xff);
+        SDL_RenderClear(swrenderer);
+        SDL_SetTextureScaleMode(tface, cases[i].scale_mode);
+        SDL_RenderCopyEx(swrenderer, tface, NULL, &rect, cases[i].angle, NULL, cases[i].flip);
+        SDL_RenderPresent(swrenderer);
+
+        mismatches = 0;
+        for (y = 0; y < surface->h; y++) {
+            for (x = 0; x < surface->w; x++) {
+                int u = x - rect.x, v = y - rect.y;
+                Uint32 expected = clear;
+                if (u >= 0 && v >= 0 && u < rect.w && v < rect.h) {
+                    int su = u, sv = v, t;
+                    if (cases[i].angle == 90.0) {
+                        t = su;
+                        su = sv;
+                        sv = rect.w - 1 - t;
+                    } else if (cases[i].angle == 180.0) {
+                        su = rect.w - 1 - su;
+                        sv = rect.h - 1 - sv;
+                    } else if (cases[i].angle == -90.0) {
+                        t = su;
+                        su = rect.h - 1 - sv;
+                        sv = t;
+                    }
+                    if (cases[i].flip & SDL_FLIP_HORIZONTAL) {
+                        su = rect.w - 1 - su;
+                    }
+                    if (cases[i].flip & SDL_FLIP_VERTICAL) {
+                        sv = rect.h - 1 - sv;
+                    }
+                    expected = _getPixel32(face, su, sv);
+                }
+                if (_getPixel32(surface, x, y) != expected) {
+                    mismatches++;
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Validate pixels at %g degrees with flip %d and scale mode %d, expected: 0 mismatches, got: %i",
+                            cases[i].angle, (int)cases[i].flip, (int)cases[i].scale_mode, mismatches);
+    }
+
+    /* A rotated sprite stays inside its bounding circle and keeps its center */
+    SDL_SetRenderDrawColor(swrenderer, 0x20, 0x40, 0x60, 0xff);
+    SDL_RenderClear(swrenderer);
+    SDL_SetTextureScaleMode(tface, SDL_ScaleModeLinear);
+    SDL_SetTextureColorMod(tface, 128, 255, 255);
+    SDL_SetTextureBlendMode(tface, SDL_BLENDMODE_BLEND);
+    SDL_RenderCopyEx(swrenderer, tface, NULL, &rect, 33.0, NULL, SDL_FLIP_NONE);
+    SDL_RenderPresent(swrenderer);
+
+    mismatches = 0;
+    for (y = 0; y < surface->h; y++) {
+        for (x = 0; x < surface->w; x++) {
+            const int dx = 2 * (x - rect.x) + 1 - rect.w, dy = 2 * (y - rect.y) + 1 - rect.h;
+            if (dx * dx + dy * dy > 2 * (rect.w + 2) * (rect.w + 2) && _getPixel32(surface, x, y) != clear) {
+                mismatches++;
+            }
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Validate no pixels outside of the rotated rect, expected: 0, got: %i", mismatches);
+    pixel = _getPixel32(surface, rect.x + rect.w / 2, rect.y + rect.h / 2);
+    SDLTest_AssertCheck(pixel != clear, "Validate the center of the rotated rect is drawn, got: 0x%08" SDL_PRIx32, pixel);
+
+    /* Compare the inside of the rotated rect with bilinear sampling, color and alpha mod and blending done here */
+    SDL_SetTextureAlphaMod(tface, 192);
+    SDL_SetRenderDrawColor(swrenderer, 0x20, 0x40, 0x60, 0xff);
+    SDL_RenderClear(swrenderer);
+    SDL_RenderCopyEx(swrenderer, tface, NULL, &rect, 33.0, NULL, SDL_FLIP_NONE);
+    SDL_RenderPresent(swrenderer);
+
+    mismatches = 0;
+    compared = 0;
+    for (y = 0; y < surface->h; y++) {
+        for (x = 0; x < surface->w; x++) {
+            Uint32 expected;
+            if (!_rotatedReferencePixel(face, &rect, 33.0, x, y, 128, 255, 255, 192, clear, &expected)) {
+                continue;
+            }
+            compared++;
+            pixel = _getPixel32(surface, x, y);
+            /* The renderer weights samples in 1/256 steps and blends in integers */
+            if (!_pixelsClose(pixel, expected, 6)) {
+                if (mismatches == 0) {
+                    SDLTest_Log("First mismatch at %d,%d: expected 0x%08" SDL_PRIx32 ", got 0x%08" SDL_PRIx32, x, y, expected, pixel);
+                }
+                mismatches++;
+            }
+        }
+    }
+    SDLTest_AssertCheck(compared > rect.w * rect.h / 2, "Validate enough pixels were compared, got: %i", compared);
+    SDLTest_AssertCheck(mismatches == 0, "Validate pixels at 33 degrees against the reference, expected: 0 mismatches, got: %i", mismatches);
+
+    SDL_DestroyTexture(tface);
+    SDL_DestroyRenderer(swrenderer);
+    SDL_FreeSurface(surface);
+    SDL_FreeSurface(face);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests the per-frame counts of SDL_RenderGetStats
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_RenderGetStats
+ * http://wiki.libsdl.org/SDL_RenderPresent
+ */
+int render_testStats(void *arg)
+{
+    static Uint32 pixels[16 * 8];
+    SDL_RenderStats stats;
+    SDL_Texture *texture;
+    SDL_Rect rect;
+    Uint32 commands;
+    void *locked;
+    int pitch, i, ret;
+
+    ret = SDL_RenderGetStats(NULL, &stats);
+    SDLTest_AssertCheck(ret < 0, "Validate SDL_RenderGetStats(NULL) fails, got: %i", ret);
+    ret = SDL_RenderGetStats(renderer, NULL);
+    SDLTest_AssertCheck(ret < 0, "Validate SDL_RenderGetStats(renderer, NULL) fails, got: %i", ret);
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, 16, 8);
+    SDLTest_AssertCheck(texture != NULL, "Verify SDL_CreateTexture result is not NULL");
+    if (texture == NULL) {
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < SDL_arraysize(pixels); i++) {
+        pixels[i] = 0xFF000000 | (i * 0x010203);
+    }
+
+    /* Start a new frame */
+    _clearScreen();
+
+    /* 16x8 + 4x4 + 2x3 pixels of 4 bytes are uploaded */
+    ret = SDL_UpdateTexture(texture, NULL, pixels, 16 * 4);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture, expected: 0, got: %i", ret);
+    rect.x = 2;
+    rect.y = 2;
+    rect.w = 4;
+    rect.h = 4;
+    ret = SDL_UpdateTexture(texture, &rect, pixels, 16 * 4);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture, expected: 0, got: %i", ret);
+    rect.w = 2;
+    rect.h = 3;
+    ret = SDL_LockTexture(texture, &rect, &locked, &pitch);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_LockTexture, expected: 0, got: %i", ret);
+    if (ret == 0) {
+        SDL_UnlockTexture(texture);
+    }
+
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = 10;
+    rect.h = 10;
+    SDL_RenderFillRect(renderer, &rect);
+    for (i = 0; i < 3; i++) {
+        rect.x = 10 + i * 16;
+        SDL_RenderCopy(renderer, texture, NULL, &rect);
+    }
+    SDL_RenderPresent(renderer);
+
+    ret = SDL_RenderGetStats(renderer, &stats);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGetStats, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(stats.texture_upload_bytes == (16 * 8 + 4 * 4 + 2 * 3) * 4,
+                        "Verify uploaded bytes, expected: %i, got: %i", (16 * 8 + 4 * 4 + 2 * 3) * 4, (int)stats.texture_upload_bytes);
+    SDLTest_AssertCheck(stats.flushes >= 1, "Verify the frame was flushed, got: %i flushes", (int)stats.flushes);
+    SDLTest_AssertCheck(stats.fill_rects_commands + stats.geometry_commands >= 1, "Verify the fill was counted");
+    SDLTest_AssertCheck(stats.copy_commands + stats.geometry_commands >= 1, "Verify the copies were counted");
+    commands = stats.set_viewport_commands + stats.set_cliprect_commands + stats.set_draw_color_commands +
+               stats.clear_commands + stats.draw_points_commands + stats.draw_lines_commands +
+               stats.fill_rects_commands + stats.copy_commands + stats.copy_ex_commands + stats.geometry_commands;
+    SDLTest_AssertCheck(stats.commands == commands, "Verify commands is the sum of the types, expected: %i, got: %i", (int)commands, (int)stats.commands);
+    SDLTest_AssertCheck(stats.max_batch_commands >= 1 && stats.max_batch_commands <= stats.commands,
+                        "Verify max_batch_commands, got: %i", (int)stats.max_batch_commands);
+    SDLTest_AssertCheck(stats.max_batch_vertex_bytes <= stats.vertex_bytes, "Verify max_batch_vertex_bytes is at most vertex_bytes");
+    if (SDL_strcmp(SDL_GetCurrentVideoDriver(), "dummy") == 0) {
+        /* the software renderer makes one draw call per drawing command */
+        SDLTest_AssertCheck(stats.draw_calls == stats.fill_rects_commands + stats.copy_commands,
+                            "Verify draw calls, expected: %i, got: %i", (int)(stats.fill_rects_commands + stats.copy_commands), (int)stats.draw_calls);
+    }
+
+    /* An empty frame counts nothing */
+    SDL_RenderPresent(renderer);
+    ret = SDL_RenderGetStats(renderer, &stats);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGetStats, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(stats.flushes == 0 && stats.commands == 0 && stats.texture_upload_bytes == 0 && stats.draw_calls == 0,
+                        "Verify the counts were reset for the empty frame");
+
+    SDL_DestroyTexture(texture);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that the command array grows to the largest batch and is reused after that
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_RenderGetStats
+ */
+int render_testCommandPool(void *arg)
+{
+    SDL_RenderStats before, stats;
+    int count, i, ret;
+
+    /* Start from a flushed queue */
+    SDL_RenderPresent(renderer);
+    ret = SDL_RenderGetStats(renderer, &before);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGetStats, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(before.command_pool_high_water <= before.command_pool_size,
+                        "Verify the high water mark fits in the pool, got: %i of %i", (int)before.command_pool_high_water, (int)before.command_pool_size);
+
+    /* Queue more commands in one batch than the pool has room for */
+    count = (int)before.command_pool_size * 2 + 100;
+    for (i = 0; i < count; i++) {
+        SDL_SetRenderDrawColor(renderer, (Uint8)i, 0, 0, SDL_ALPHA_OPAQUE);
+        SDL_RenderDrawPoint(renderer, i % TESTRENDER_SCREEN_W, 0);
+    }
+    SDL_RenderPresent(renderer);
+    ret = SDL_RenderGetStats(renderer, &stats);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGetStats, expected: 0, got: %i", ret);
+    if (stats.max_batch_commands < (Uint32)count) {
+        SDLTest_Log("The renderer isn't batching commands, skipping the pool checks");
+        return TEST_SKIPPED;
+    }
+    SDLTest_AssertCheck(stats.command_pool_high_water >= (Uint32)count,
+                        "Verify the high water mark, expected: >= %i, got: %i", count, (int)stats.command_pool_high_water);
+    SDLTest_AssertCheck(stats.command_pool_size >= stats.command_pool_high_water,
+                        "Verify the pool grew to the batch, expected: >= %i, got: %i", (int)stats.command_pool_high_water, (int)stats.command_pool_size);
+    SDLTest_AssertCheck(stats.command_pool_grows > before.command_pool_grows,
+                        "Verify the pool grew, expected: > %i, got: %i", (int)before.command_pool_grows, (int)stats.command_pool_grows);
+    SDLTest_AssertCheck(stats.vertex_pool_high_water >= stats.max_batch_vertex_bytes && stats.vertex_pool_size >= stats.vertex_pool_high_water,
+                        "Verify the vertex pool, got: %i of %i bytes", (int)stats.vertex_pool_high_water, (int)stats.vertex_pool_size);
+    before = stats;
+
+    /* The same batch again reuses the array */
+    for (i = 0; i < count; i++) {
+        SDL_SetRenderDrawColor(renderer, (Uint8)i, 0, 0, SDL_ALPHA_OPAQUE);
+        SDL_RenderDrawPoint(renderer, i % TESTRENDER_SCREEN_W, 0);
+    }
+    SDL_RenderPresent(renderer);
+    ret = SDL_RenderGetStats(renderer, &stats);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGetStats, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(stats.command_pool_grows == before.command_pool_grows,
+                        "Verify the pool was reused, expected: %i grows, got: %i", (int)before.command_pool_grows, (int)stats.command_pool_grows);
+    SDLTest_AssertCheck(stats.command_pool_size == before.command_pool_size,
+                        "Verify the pool size, expected: %i, got: %i", (int)before.command_pool_size, (int)stats.command_pool_size);
+    SDLTest_AssertCheck(stats.command_pool_high_water == before.command_pool_high_water,
+                        "Verify the high water mark, expected: %i, got: %i", (int)before.command_pool_high_water, (int)stats.command_pool_high_water);
+
+    return TEST_COMPLETED;
+}
+
+/* Fills an opaque ARGB8888 surface with a pattern that differs for each seed */
+static SDL_Surface *
+_createAtlasImage(int w, int h, Uint32 seed)
+{
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+    int x, y;
+
+    if (surface) {
+        for (y = 0; y < h; y++) {
+            Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch);
+            for (x = 0; x < w; x++) {
+                seed = seed * 1103515245 + 12345;
+                row[x] = 0xFF000000 | (seed >> 8);
+            }
+        }
+    }
+    return surface;
+}
+
+/* Draws an atlas image at the top left and checks the pixels against the surface */
+static SDL_bool
+_drawsAtlasImage(SDL_TextureAtlas *atlas, int id, SDL_Surface *surface)
+{
+    static Uint32 pixels[TESTRENDER_SCREEN_W * TESTRENDER_SCREEN_H];
+    SDL_Texture *texture = NULL;
+    SDL_Rect src, dst;
+    int y;
+
+    if (SDL_QueryTextureAtlasImage(atlas, id, &texture, &src) < 0) {
+        return SDL_FALSE;
+    }
+    dst.x = 0;
+    dst.y = 0;
+    dst.w = src.w;
+    dst.h = src.h;
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, texture, &src, &dst);
+    if (SDL_RenderReadPixels(renderer, &dst, SDL_PIXELFORMAT_ARGB8888, pixels, dst.w * 4) < 0) {
+        return SDL_FALSE;
+    }
+    for (y = 0; y < dst.h; y++) {
+        if (SDL_memcmp(&pixels[y * dst.w], (Uint8 *)surface->pixels + y * surface->pitch, dst.w * 4) != 0) {
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+
+/**
+ * @brief Tests packing, drawing, updating, removing and evicting texture atlas images
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_CreateTextureAtlas
+ * http://wiki.libsdl.org/SDL_AddTextureAtlasImage
+ * http://wiki.libsdl.org/SDL_QueryTextureAtlasImage
+ */
+int render_testTextureAtlas(void *arg)
+{
+    SDL_TextureAtlas *atlas;
+    SDL_Surface *surfaces[12];
+    SDL_Surface *surface;
+    SDL_Texture *textures[12];
+    SDL_Rect rects[12];
+    int ids[12], evicting[8];
+    int i, j, ret, valid;
+
+    atlas = SDL_CreateTextureAtlas(renderer, SDL_PIXELFORMAT_IYUV, 64, 32, 0);
+    SDLTest_AssertCheck(atlas == NULL, "Verify YUV atlases are rejected");
+    atlas = SDL_CreateTextureAtlas(renderer, 0, 2, 2, 0);
+    SDLTest_AssertCheck(atlas == NULL, "Verify pages without room for an image are rejected");
+
+    atlas = SDL_CreateTextureAtlas(renderer, 0, 64, 32, 2);
+    SDLTest_AssertCheck(atlas != NULL, "Verify SDL_CreateTextureAtlas result is not NULL");
+    if (atlas == NULL) {
+        return TEST_ABORTED;
+    }
+
+    surface = _createAtlasImage(63, 8, 1);
+    ret = SDL_AddTextureAtlasImage(atlas, surface);
+    SDLTest_AssertCheck(ret < 0, "Verify images wider than a page minus the border are rejected, got: %i", ret);
+    SDL_FreeSurface(surface);
+
+    /* Pack images of mixed sizes and check they don't overlap, borders included */
+    for (i = 0; i < SDL_arraysize(surfaces); i++) {
+        surfaces[i] = _createAtlasImage(3 + (i * 7) % 17, 2 + (i * 5) % 9, 100 + i);
+        SDLTest_AssertCheck(surfaces[i] != NULL, "Verify test surface %i was created", i);
+        if (surfaces[i] == NULL) {
+            return TEST_ABORTED;
+        }
+        ids[i] = SDL_AddTextureAtlasImage(atlas, surfaces[i]);
+        SDLTest_AssertCheck(ids[i] > 0, "Validate SDL_AddTextureAtlasImage result for image %i, got: %i", i, ids[i]);
+    }
+    for (i = 0; i < SDL_arraysize(surfaces); i++) {
+        ret = SDL_QueryTextureAtlasImage(atlas, ids[i], &textures[i], &rects[i]);
+        SDLTest_AssertCheck(ret == 0, "Validate SDL_QueryTextureAtlasImage result for image %i, got: %i", i, ret);
+        SDLTest_AssertCheck(rects[i].w == surfaces[i]->w && rects[i].h == surfaces[i]->h &&
+                                rects[i].x >= 1 && rects[i].y >= 1 && rects[i].x + rects[i].w <= 63 && rects[i].y + rects[i].h <= 31,
+                            "Verify image %i is %ix%i inside the page, got: %i,%i %ix%i", i,
+                            surfaces[i]->w, surfaces[i]->h, rects[i].x, rects[i].y, rects[i].w, rects[i].h);
+        for (j = 0; j < i; j++) {
+            SDL_Rect a = rects[i], b = rects[j];
+            a.x -= 1;
+            a.y -= 1;
+            a.w += 2;
+            a.h += 2;
+            b.x -= 1;
+            b.y -= 1;
+            b.w += 2;
+            b.h += 2;
+            SDLTest_AssertCheck(textures[i] != textures[j] || !SDL_HasIntersection(&a, &b),
+                                "Verify images %i and %i don't overlap", i, j);
+        }
+    }
+    for (i = 0; i < SDL_arraysize(surfaces); i++) {
+        SDLTest_AssertCheck(_drawsAtlasImage(atlas, ids[i], surfaces[i]), "Verify image %i draws like its surface", i);
+    }
+
+    /* Replace the pixels of one image */
+    surface = _createAtlasImage(surfaces[0]->w, surfaces[0]->h, 1000);
+    ret = SDL_UpdateTextureAtlasImage(atlas, ids[0], surface);
+    SDLTest_AssertCheck(ret == 0, "Validate SDL_UpdateTextureAtlasImage result, got: %i", ret);
+    SDLTest_AssertCheck(_drawsAtlasImage(atlas, ids[0], surface), "Verify the updated image draws like the new surface");
+    SDLTest_AssertCheck(_drawsAtlasImage(atlas, ids[1], surfaces[1]), "Verify the image next to it didn't change");
+    SDL_FreeSurface(surface);
+    surface = _createAtlasImage(surfaces[0]->w + 1, surfaces[0]->h, 1000);
+    ret = SDL_UpdateTextureAtlasImage(atlas, ids[0], surface);
+    SDLTest_AssertCheck(ret < 0, "Verify updating with another size fails, got: %i", ret);
+    SDL_FreeSurface(surface);
+
+    /* Removed images fail and their space is used again */
+    ret = SDL_RemoveTextureAtlasImage(atlas, ids[5]);
+    SDLTest_AssertCheck(ret == 0, "Validate SDL_RemoveTextureAtlasImage result, got: %i", ret);
+    ret = SDL_QueryTextureAtlasImage(atlas, ids[5], NULL, NULL);
+    SDLTest_AssertCheck(ret < 0, "Verify a removed image can't be queried, got: %i", ret);
+    ret = SDL_RemoveTextureAtlasImage(atlas, ids[5]);
+    SDLTest_AssertCheck(ret < 0, "Verify a removed image can't be removed again, got: %i", ret);
+    i = SDL_AddTextureAtlasImage(atlas, surfaces[5]);
+    SDLTest_AssertCheck(i > 0 && i != ids[5], "Verify the image gets a new ID when added again, got: %i", i);
+    ret = SDL_QueryTextureAtlasImage(atlas, i, &textures[0], &rects[0]);
+    SDLTest_AssertCheck(ret == 0 && textures[0] == textures[5] && SDL_RectEquals(&rects[0], &rects[5]),
+                        "Verify the image went back to its old place");
+    ids[5] = i;
+
+    /* Two 64x32 pages hold four 30x14 images each, adding more evicts the least recently used page */
+    for (i = 0; i < SDL_arraysize(evicting); i++) {
+        surface = _createAtlasImage(30, 14, 2000 + i);
+        evicting[i] = SDL_AddTextureAtlasImage(atlas, surface);
+        SDLTest_AssertCheck(evicting[i] > 0, "Validate SDL_AddTextureAtlasImage result for 30x14 image %i, got: %i", i, evicting[i]);
+        if (i == SDL_arraysize(evicting) - 1) {
+            SDLTest_AssertCheck(_drawsAtlasImage(atlas, evicting[i], surface), "Verify the last 30x14 image draws like its surface");
+        }
+        SDL_FreeSurface(surface);
+    }
+    valid = 0;
+    for (i = 0; i < SDL_arraysize(ids); i++) {
+        if (SDL_QueryTextureAtlasImage(atlas, ids[i], NULL, NULL) == 0) {
+            valid++;
+        }
+    }
+    SDLTest_AssertCheck(valid == 0, "Verify the first images were evicted, %i left", valid);
+    for (i = SDL_arraysize(evicting) - 4; i < SDL_arraysize(evicting); i++) {
+        ret = SDL_QueryTextureAtlasImage(atlas, evicting[i], NULL, NULL);
+        SDLTest_AssertCheck(ret == 0, "Verify the recent 30x14 image %i is still there, got: %i", i, ret);
+    }
+
+    SDL_DestroyTextureAtlas(atlas);
+    for (i = 0; i < SDL_arraysize(surfaces); i++) {
+        SDL_FreeSurface(surfaces[i]);
+    }
+
+    return TEST_COMPLETED;
+}
+
 /**
  * @brief Checks to see if functionality is supported. Helper function.
  */
@@ -1127,6 +2046,128 @@ _clearScreen(void)
     return 0;
 }
 
+#define BATCH_COPIES 8
+
+/* Copies the texture to BATCH_COPIES places, flushing after each copy when asked to */
+static void
+_drawCopyBatch(SDL_Renderer *batchrenderer, SDL_Texture *texture, SDL_bool flush)
+{
+    SDL_Rect rect;
+    int i;
+
+    SDL_SetRenderDrawColor(batchrenderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(batchrenderer);
+    rect.w = 16;
+    rect.h = 16;
+    for (i = 0; i < BATCH_COPIES; i++) {
+        rect.x = (i % 4) * 20;
+        rect.y = (i / 4) * 20 + (i % 3) * 2;
+        SDL_RenderCopy(batchrenderer, texture, NULL, &rect);
+        if (flush) {
+            SDL_RenderFlush(batchrenderer);
+        }
+    }
+}
+
+/**
+ * @brief Tests that consecutive copies of the same texture are merged into one geometry command
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_RenderCopy
+ * http://wiki.libsdl.org/SDL_RenderGetStats
+ */
+int render_testCopyBatching(void *arg)
+{
+    const int pitch = TESTRENDER_SCREEN_W * 4;
+    const int size = pitch * TESTRENDER_SCREEN_H;
+    Uint8 *expected, *actual;
+    int tested = 0;
+    int i, ret;
+
+    expected = (Uint8 *)SDL_malloc(size);
+    actual = (Uint8 *)SDL_malloc(size);
+    SDLTest_AssertCheck(expected != NULL && actual != NULL, "Verify SDL_malloc() result");
+    if (expected == NULL || actual == NULL) {
+        SDL_free(expected);
+        SDL_free(actual);
+        return TEST_ABORTED;
+    }
+
+    /* Only the renderers that draw copies as geometry merge them, try them all */
+    for (i = 0; i < SDL_GetNumRenderDrivers(); i++) {
+        SDL_RendererInfo info;
+        SDL_RenderStats stats;
+        SDL_Window *batchwindow;
+        SDL_Renderer *batchrenderer;
+        SDL_Surface *image;
+        SDL_Texture *texture;
+
+        SDL_GetRenderDriverInfo(i, &info);
+        batchwindow = SDL_CreateWindow("render_testCopyBatching", 0, 0, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, SDL_WINDOW_HIDDEN);
+        if (batchwindow == NULL) {
+            continue;
+        }
+        /* A renderer picked by index only batches when asked to */
+        SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+        batchrenderer = SDL_CreateRenderer(batchwindow, i, 0);
+        SDL_SetHint(SDL_HINT_RENDER_BATCHING, NULL);
+        if (batchrenderer == NULL) {
+            SDLTest_Log("Renderer '%s' isn't available: %s", info.name, SDL_GetError());
+            SDL_DestroyWindow(batchwindow);
+            continue;
+        }
+        image = _createAtlasImage(16, 16, 777);
+        texture = image ? SDL_CreateTextureFromSurface(batchrenderer, image) : NULL;
+        SDL_FreeSurface(image);
+        SDLTest_AssertCheck(texture != NULL, "Verify texture creation on renderer '%s'", info.name);
+        if (texture == NULL) {
+            SDL_DestroyRenderer(batchrenderer);
+            SDL_DestroyWindow(batchwindow);
+            continue;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+
+        /* Flushing after every copy keeps them apart */
+        _drawCopyBatch(batchrenderer, texture, SDL_TRUE);
+        ret = SDL_RenderReadPixels(batchrenderer, NULL, SDL_PIXELFORMAT_ARGB8888, expected, pitch);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels on renderer '%s', expected: 0, got: %i", info.name, ret);
+        SDL_RenderPresent(batchrenderer);
+        SDL_RenderGetStats(batchrenderer, &stats);
+        if (stats.geometry_commands == 0) {
+            SDLTest_Log("Renderer '%s' copies without geometry, nothing to merge", info.name);
+        } else {
+            SDLTest_AssertCheck(stats.geometry_commands == BATCH_COPIES && stats.merged_copies == 0,
+                                "Verify flushed copies on renderer '%s' aren't merged, expected: %i commands, got: %i commands and %i merged",
+                                info.name, BATCH_COPIES, (int)stats.geometry_commands, (int)stats.merged_copies);
+
+            /* Queued back to back they become one command */
+            _drawCopyBatch(batchrenderer, texture, SDL_FALSE);
+            ret = SDL_RenderReadPixels(batchrenderer, NULL, SDL_PIXELFORMAT_ARGB8888, actual, pitch);
+            SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels on renderer '%s', expected: 0, got: %i", info.name, ret);
+            SDL_RenderPresent(batchrenderer);
+            SDL_RenderGetStats(batchrenderer, &stats);
+            SDLTest_AssertCheck(stats.geometry_commands == 1 && stats.merged_copies == BATCH_COPIES - 1,
+                                "Verify copies on renderer '%s' are merged, expected: 1 command and %i merged, got: %i commands and %i merged",
+                                info.name, BATCH_COPIES - 1, (int)stats.geometry_commands, (int)stats.merged_copies);
+            SDLTest_AssertCheck(SDL_memcmp(expected, actual, size) == 0, "Verify merged copies on renderer '%s' draw the same pixels", info.name);
+            tested++;
+        }
+
+        SDL_DestroyTexture(texture);
+        SDL_DestroyRenderer(batchrenderer);
+        SDL_DestroyWindow(batchwindow);
+    }
+
+    SDL_free(expected);
+    SDL_free(actual);
+
+    if (tested == 0) {
+        SDLTest_Log("No renderer draws copies as geometry here, skipping");
+        return TEST_SKIPPED;
+    }
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Render test cases */
@@ -1161,9 +2202,37 @@ static const SDLTest_TestCaseReference renderTest7 = {
     (SDLTest_TestCaseFp)render_testBlitBlend, "render_testBlitBlend", "Tests blitting with blending", TEST_DISABLED
 };
 
+static const SDLTest_TestCaseReference renderTest8 = {
+    (SDLTest_TestCaseFp)render_testSoftwareThreads, "render_testSoftwareThreads", "Tests software rendering with SDL_HINT_RENDER_SOFTWARE_THREADS", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest9 = {
+    (SDLTest_TestCaseFp)render_testStats, "render_testStats", "Tests the per-frame counts of SDL_RenderGetStats", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest10 = {
+    (SDLTest_TestCaseFp)render_testTextureAtlas, "render_testTextureAtlas", "Tests packing, updating and evicting texture atlas images", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest11 = {
+    (SDLTest_TestCaseFp)render_testSoftwareGeometry, "render_testSoftwareGeometry", "Tests software rendering of triangles against reference checksums", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest12 = {
+    (SDLTest_TestCaseFp)render_testSoftwareCopyEx, "render_testSoftwareCopyEx", "Tests rotating and flipping on the software renderer", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest13 = {
+    (SDLTest_TestCaseFp)render_testCommandPool, "render_testCommandPool", "Tests growth and reuse of the render command array", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest14 = {
+    (SDLTest_TestCaseFp)render_testCopyBatching, "render_testCopyBatching", "Tests merging consecutive texture copies into one geometry command", TEST_ENABLED
+};
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] = {
-    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, NULL
+    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, &renderTest8, &renderTest9, &renderTest10, &renderTest11, &renderTest12, &renderTest13, &renderTest14, NULL
 };
 
 /* Render test suite (global) */
@@ -713,6 +713,200 @@ stdlib_overflow(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Call to SDL_EnableMemoryTracking, SDL_GetMemoryStats and SDL_GetMemoryTagName
+ */
+static int
+stdlib_memoryStats(void *arg)
+{
+    SDL_MemoryStats before, allocated, reallocated, freed;
+    void *mem;
+    int i;
+
+    for (i = 0; i < SDL_NUM_MEMORY_TAGS; ++i) {
+        SDLTest_AssertCheck(SDL_GetMemoryTagName((SDL_MemoryTag)i) != NULL, "Check SDL_GetMemoryTagName(%d) has a name", i);
+    }
+    SDLTest_AssertCheck(SDL_GetMemoryTagName(SDL_NUM_MEMORY_TAGS) == NULL, "Check SDL_GetMemoryTagName(SDL_NUM_MEMORY_TAGS) fails");
+    SDLTest_AssertCheck(SDL_GetMemoryStats(SDL_NUM_MEMORY_TAGS, &before) < 0, "Check SDL_GetMemoryStats(SDL_NUM_MEMORY_TAGS) fails");
+
+    if (SDL_GetMemoryStats(SDL_MEMORY_TAG_OTHER, &before) < 0) {
+        /* Tracking is only on when running with --trackmem */
+        SDLTest_AssertCheck(SDL_EnableMemoryTracking() < 0, "Check tracking can't be enabled after SDL allocated memory");
+        return TEST_COMPLETED;
+    }
+
+    /* Take all the samples first, logging may allocate memory too */
+    mem = SDL_malloc(1000);
+    SDL_GetMemoryStats(SDL_MEMORY_TAG_OTHER, &allocated);
+    mem = SDL_realloc(mem, 3000);
+    SDL_GetMemoryStats(SDL_MEMORY_TAG_OTHER, &reallocated);
+    SDL_free(mem);
+    SDL_GetMemoryStats(SDL_MEMORY_TAG_OTHER, &freed);
+
+    SDLTest_AssertCheck(SDL_EnableMemoryTracking() == 0, "Check enabling tracking again succeeds");
+    SDLTest_AssertCheck(allocated.live_bytes == before.live_bytes + 1000,
+                        "Check SDL_malloc() adds 1000 live bytes, got %d", (int)(allocated.live_bytes - before.live_bytes));
+    SDLTest_AssertCheck(allocated.live_allocations == before.live_allocations + 1,
+                        "Check SDL_malloc() adds one live allocation, got %d", allocated.live_allocations - before.live_allocations);
+    SDLTest_AssertCheck(allocated.total_allocations == before.total_allocations + 1,
+                        "Check SDL_malloc() adds one allocation in total, got %d", (int)(allocated.total_allocations - before.total_allocations));
+    SDLTest_AssertCheck(reallocated.live_bytes == before.live_bytes + 3000,
+                        "Check SDL_realloc() grows the live bytes to 3000, got %d", (int)(reallocated.live_bytes - before.live_bytes));
+    SDLTest_AssertCheck(reallocated.live_allocations == allocated.live_allocations && reallocated.total_allocations == allocated.total_allocations,
+                        "Check SDL_realloc() doesn't count a new allocation");
+    SDLTest_AssertCheck(reallocated.peak_bytes >= reallocated.live_bytes, "Check the peak includes the reallocated block");
+    SDLTest_AssertCheck(freed.live_bytes == before.live_bytes && freed.live_allocations == before.live_allocations,
+                        "Check SDL_free() gives the memory back, %d bytes left", (int)(freed.live_bytes - before.live_bytes));
+
+    return TEST_COMPLETED;
+}
+
+#define SLAB_TEST_THREADS  4
+#define SLAB_TEST_MESSAGES 500
+
+/* Log messages longer than 255 characters are copied into blocks from the
+   slab allocator, the ones from 1024 characters up into SDL_malloc() blocks */
+static const int slab_message_lengths[] = { 300, 511, 512, 1000, 1023, 1024, 1025, 3000 };
+
+typedef struct
+{
+    SDL_LogOutputFunction original_function;
+    void *original_userdata;
+    int received;
+    int corrupted;
+} SlabLogState;
+
+static void SDLCALL SlabTestLogOutput(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+    SlabLogState *state = (SlabLogState *)userdata;
+    const int id = SDL_atoi(message);
+    const char *text = SDL_strchr(message, ':');
+    const char fill = (char)('a' + id % 26);
+
+    if (category != SDL_LOG_CATEGORY_CUSTOM) {
+        /* The test harness */
+        state->original_function(state->original_userdata, category, priority, message);
+        return;
+    }
+
+    ++state->received;
+    if (!text || (int)SDL_strlen(message) != slab_message_lengths[id % SDL_arraysize(slab_message_lengths)]) {
+        ++state->corrupted;
+        return;
+    }
+    for (++text; *text; ++text) {
+        if (*text != fill) {
+            ++state->corrupted;
+            return;
+        }
+    }
+}
+
+static void SlabTestLogMessage(int id)
+{
+    char text[3001];
+    const int length = slab_message_lengths[id % SDL_arraysize(slab_message_lengths)];
+    const int prefix = SDL_snprintf(text, sizeof(text), "%d:", id);
+
+    SDL_memset(text + prefix, 'a' + id % 26, length - prefix);
+    text[length] = '\0';
+    SDL_LogMessage(SDL_LOG_CATEGORY_CUSTOM, SDL_LOG_PRIORITY_INFO, "%s", text);
+}
+
+static int SDLCALL SlabTestLogThread(void *data)
+{
+    const int first = *(int *)data;
+    int i;
+
+    for (i = 0; i < SLAB_TEST_MESSAGES; ++i) {
+        SlabTestLogMessage(first + i);
+    }
+    return 0;
+}
+
+/**
+ * Round trips through the slab allocator, by way of log messages
+ */
+static int
+stdlib_slabAllocations(void *arg)
+{
+    const int num_lengths = (int)SDL_arraysize(slab_message_lengths);
+    SlabLogState state;
+    SDL_MemoryStats before, slabbed, passthrough;
+    SDL_Thread *threads[SLAB_TEST_THREADS];
+    int first[SLAB_TEST_THREADS];
+    SDL_bool tracking;
+    int async_on, async_off;
+    int created = 0;
+    int dropped;
+    int i;
+
+    SDL_zero(state);
+    SDL_LogGetOutputFunction(&state.original_function, &state.original_userdata);
+    SDL_SetHint(SDL_HINT_LOGGING, "info");
+    SDL_LogSetOutputFunction(SlabTestLogOutput, &state);
+
+    /* Every size class, freed on the thread that allocated it */
+    for (i = 0; i < 100 * num_lengths; ++i) {
+        SlabTestLogMessage(i);
+    }
+    SDLTest_AssertPass("Log %d messages of %d lengths", 100 * num_lengths, num_lengths);
+    SDLTest_AssertCheck(state.received == 100 * num_lengths, "Check messages received, expected: %d, got: %d", 100 * num_lengths, state.received);
+    SDLTest_AssertCheck(state.corrupted == 0, "Check messages corrupted, expected: 0, got: %d", state.corrupted);
+
+    /* The blocks freed above are used again, only the large messages call SDL_malloc() */
+    tracking = (SDL_GetMemoryStats(SDL_MEMORY_TAG_OTHER, &before) == 0);
+    for (i = 0; i < 100; ++i) {
+        SlabTestLogMessage(i % 5); /* up to 1023 characters */
+    }
+    SDL_GetMemoryStats(SDL_MEMORY_TAG_OTHER, &slabbed);
+    for (i = 0; i < 10; ++i) {
+        SlabTestLogMessage(5); /* 1024 characters */
+    }
+    SDL_GetMemoryStats(SDL_MEMORY_TAG_OTHER, &passthrough);
+    if (tracking) {
+        SDLTest_AssertCheck(slabbed.total_allocations == before.total_allocations,
+                            "Check messages up to 1023 characters don't call SDL_malloc(), got %d calls", (int)(slabbed.total_allocations - before.total_allocations));
+        SDLTest_AssertCheck(passthrough.total_allocations == slabbed.total_allocations + 10,
+                            "Check messages of 1024 characters call SDL_malloc() once each, expected: 10, got: %d", (int)(passthrough.total_allocations - slabbed.total_allocations));
+        SDLTest_AssertCheck(passthrough.live_bytes == before.live_bytes && passthrough.live_allocations == before.live_allocations,
+                            "Check the large messages are freed, %d bytes left", (int)(passthrough.live_bytes - before.live_bytes));
+    }
+
+    /* Asynchronous logging frees the blocks on the thread that outputs them.
+       The harness logs through the ring too while it's on, so the checks wait
+       until it's off, and the dropped count may include other messages. */
+    state.received = 0;
+    async_on = SDL_LogSetAsync(SDL_TRUE);
+    dropped = SDL_LogGetDroppedCount();
+    for (i = 0; i < SLAB_TEST_THREADS; ++i) {
+        first[i] = i * SLAB_TEST_MESSAGES;
+        threads[i] = SDL_CreateThread(SlabTestLogThread, "SlabTestLog", &first[i]);
+        if (threads[i]) {
+            ++created;
+        }
+    }
+    for (i = 0; i < SLAB_TEST_THREADS; ++i) {
+        if (threads[i]) {
+            SDL_WaitThread(threads[i], NULL);
+        }
+    }
+    SDL_LogFlush();
+    dropped = SDL_LogGetDroppedCount() - dropped;
+    async_off = SDL_LogSetAsync(SDL_FALSE);
+    SDLTest_AssertCheck(async_on == 0, "SDL_LogSetAsync(SDL_TRUE)");
+    SDLTest_AssertCheck(created == SLAB_TEST_THREADS, "Check threads created, expected: %d, got: %d", SLAB_TEST_THREADS, created);
+    SDLTest_AssertCheck(async_off == 0, "SDL_LogSetAsync(SDL_FALSE)");
+    SDLTest_AssertPass("Log %d messages on each of %d threads", SLAB_TEST_MESSAGES, SLAB_TEST_THREADS);
+    SDLTest_AssertCheck(state.received <= SLAB_TEST_THREADS * SLAB_TEST_MESSAGES && state.received + dropped >= SLAB_TEST_THREADS * SLAB_TEST_MESSAGES,
+                        "Check messages received and dropped, expected: %d, got: %d received and %d dropped", SLAB_TEST_THREADS * SLAB_TEST_MESSAGES, state.received, dropped);
+    SDLTest_AssertCheck(state.corrupted == 0, "Check messages corrupted, expected: 0, got: %d", state.corrupted);
+
+    SDL_LogSetOutputFunction(state.original_function, state.original_userdata);
+    SDL_SetHint(SDL_HINT_LOGGING, NULL);
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Standard C routine test cases */
@@ -736,6 +930,14 @@ static const SDLTest_TestCaseReference stdlibTestOverflow = {
     stdlib_overflow, "stdlib_overflow", "Overflow detection", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference stdlibTestMemoryStats = {
+    stdlib_memoryStats, "stdlib_memoryStats", "Memory tracking statistics", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference stdlibTestSlabAllocations = {
+    stdlib_slabAllocations, "stdlib_slabAllocations", "Slab allocator round trips", TEST_ENABLED
+};
+
 /* Sequence of Standard C routine test cases */
 static const SDLTest_TestCaseReference *stdlibTests[] = {
     &stdlibTest1,
@@ -743,6 +945,8 @@ static const SDLTest_TestCaseReference *stdlibTests[] = {
     &stdlibTest3,
     &stdlibTest4,
     &stdlibTestOverflow,
+    &stdlibTestMemoryStats,
+    &stdlibTestSlabAllocations,
     NULL
 };
 
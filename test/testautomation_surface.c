@@ -798,6 +798,149 @@ int surface_testOverflow(void *arg)
     return TEST_COMPLETED;
 }
 
+/* Size of the images for surface_testConvertThreads, big enough to be split */
+#define CONVERT_THREADS_WIDTH  640
+#define CONVERT_THREADS_HEIGHT 517
+
+static void _fillRandomPixels(void *pixels, size_t size, Uint32 seed)
+{
+    Uint8 *p = (Uint8 *)pixels;
+    size_t i;
+
+    for (i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        p[i] = (Uint8)(seed >> 16);
+    }
+}
+
+/* Convert between two formats without and with threads, return whether the output matches */
+static SDL_bool _convertPixelsThreaded(Uint32 src_format, const void *src, int src_pitch,
+                                       Uint32 dst_format, void *single, void *threaded, size_t size)
+{
+    const int w = CONVERT_THREADS_WIDTH;
+    const int h = CONVERT_THREADS_HEIGHT;
+    int dst_pitch = w * 4;
+    int ret1, ret2;
+
+    if (dst_format == SDL_PIXELFORMAT_YUY2 || dst_format == SDL_PIXELFORMAT_UYVY || dst_format == SDL_PIXELFORMAT_YVYU) {
+        dst_pitch = w * 2;
+    } else if (SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
+        dst_pitch = w;
+    }
+
+    SDL_memset(single, 0, size);
+    SDL_memset(threaded, 0, size);
+    SDL_ResetHint(SDL_HINT_SURFACE_CONVERT_THREADS);
+    ret1 = SDL_ConvertPixels(w, h, src_format, src, src_pitch, dst_format, single, dst_pitch);
+    SDL_SetHint(SDL_HINT_SURFACE_CONVERT_THREADS, "4");
+    ret2 = SDL_ConvertPixels(w, h, src_format, src, src_pitch, dst_format, threaded, dst_pitch);
+    SDL_ResetHint(SDL_HINT_SURFACE_CONVERT_THREADS);
+
+    SDLTest_AssertCheck(ret1 == 0 && ret2 == 0, "Validate results from SDL_ConvertPixels(%s -> %s), expected: 0, got: %d, %d",
+                        SDL_GetPixelFormatName(src_format), SDL_GetPixelFormatName(dst_format), ret1, ret2);
+    return SDL_memcmp(single, threaded, size) == 0;
+}
+
+/**
+ * @brief Tests that conversions split across threads match the single threaded ones
+ *
+ * @sa http://wiki.libsdl.org/SDL2/SDL_HINT_SURFACE_CONVERT_THREADS
+ */
+int surface_testConvertThreads(void *arg)
+{
+    static const Uint32 surface_formats[][2] = {
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565 },
+        { SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ABGR8888 },
+        { SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_ARGB8888 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_INDEX8 },
+        { SDL_PIXELFORMAT_ARGB2101010, SDL_PIXELFORMAT_RGBA8888 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888 }
+    };
+    static const Uint32 yuv_formats[] = {
+        SDL_PIXELFORMAT_YV12, SDL_PIXELFORMAT_IYUV, SDL_PIXELFORMAT_NV12,
+        SDL_PIXELFORMAT_NV21, SDL_PIXELFORMAT_YUY2, SDL_PIXELFORMAT_UYVY,
+        SDL_PIXELFORMAT_YVYU
+    };
+    static const Uint32 rgb_formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB24,
+        SDL_PIXELFORMAT_RGBA4444
+    };
+    const int w = CONVERT_THREADS_WIDTH;
+    const int h = CONVERT_THREADS_HEIGHT;
+    const size_t size = (size_t)w * 4 * h;
+    Uint8 *rgb = (Uint8 *)SDL_malloc(size);
+    Uint8 *yuv = (Uint8 *)SDL_malloc(size);
+    Uint8 *single = (Uint8 *)SDL_malloc(size);
+    Uint8 *threaded = (Uint8 *)SDL_malloc(size);
+    int i, j, ret;
+
+    SDLTest_AssertCheck(rgb && yuv && single && threaded, "Check that the buffers were allocated");
+    if (!rgb || !yuv || !single || !threaded) {
+        goto done;
+    }
+    _fillRandomPixels(rgb, size, 1);
+
+    for (i = 0; i < (int)SDL_arraysize(surface_formats); i++) {
+        SDL_Surface *src = SDL_CreateRGBSurfaceWithFormat(0, w, h, 0, surface_formats[i][0]);
+        SDL_Surface *converted[2] = { NULL, NULL };
+
+        SDLTest_AssertCheck(src != NULL, "Verify source surface is not NULL");
+        if (!src) {
+            continue;
+        }
+        _fillRandomPixels(src->pixels, (size_t)src->pitch * src->h, 2 + i);
+        if (src->format->palette) {
+            _fillRandomPixels(src->format->palette->colors, src->format->palette->ncolors * sizeof(SDL_Color), 3);
+        }
+
+        SDL_ResetHint(SDL_HINT_SURFACE_CONVERT_THREADS);
+        converted[0] = SDL_ConvertSurfaceFormat(src, surface_formats[i][1], 0);
+        SDL_SetHint(SDL_HINT_SURFACE_CONVERT_THREADS, "4");
+        converted[1] = SDL_ConvertSurfaceFormat(src, surface_formats[i][1], 0);
+        SDL_ResetHint(SDL_HINT_SURFACE_CONVERT_THREADS);
+
+        SDLTest_AssertCheck(converted[0] && converted[1], "Verify converted surfaces are not NULL");
+        if (converted[0] && converted[1]) {
+            SDLTest_AssertCheck(SDL_memcmp(converted[0]->pixels, converted[1]->pixels, (size_t)converted[0]->pitch * h) == 0,
+                                "Verify threaded %s -> %s conversion matches",
+                                SDL_GetPixelFormatName(surface_formats[i][0]), SDL_GetPixelFormatName(surface_formats[i][1]));
+        }
+        SDL_FreeSurface(converted[0]);
+        SDL_FreeSurface(converted[1]);
+        SDL_FreeSurface(src);
+    }
+
+    for (i = 0; i < (int)SDL_arraysize(yuv_formats); i++) {
+        const Uint32 format = yuv_formats[i];
+        const int yuv_pitch = (format == SDL_PIXELFORMAT_YUY2 || format == SDL_PIXELFORMAT_UYVY || format == SDL_PIXELFORMAT_YVYU) ? w * 2 : w;
+
+        SDLTest_AssertCheck(_convertPixelsThreaded(SDL_PIXELFORMAT_ARGB8888, rgb, w * 4, format, single, threaded, size),
+                            "Verify threaded ARGB8888 -> %s conversion matches", SDL_GetPixelFormatName(format));
+
+        _fillRandomPixels(yuv, size, 4 + i);
+        for (j = 0; j < (int)SDL_arraysize(rgb_formats); j++) {
+            SDLTest_AssertCheck(_convertPixelsThreaded(format, yuv, yuv_pitch, rgb_formats[j], single, threaded, size),
+                                "Verify threaded %s -> %s conversion matches", SDL_GetPixelFormatName(format), SDL_GetPixelFormatName(rgb_formats[j]));
+        }
+    }
+
+    SDL_ResetHint(SDL_HINT_SURFACE_CONVERT_THREADS);
+    ret = SDL_PremultiplyAlpha(w, h, SDL_PIXELFORMAT_ARGB8888, rgb, w * 4, SDL_PIXELFORMAT_ARGB8888, single, w * 4);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_PremultiplyAlpha, expected: 0, got: %d", ret);
+    SDL_SetHint(SDL_HINT_SURFACE_CONVERT_THREADS, "4");
+    ret = SDL_PremultiplyAlpha(w, h, SDL_PIXELFORMAT_ARGB8888, rgb, w * 4, SDL_PIXELFORMAT_ARGB8888, threaded, w * 4);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_PremultiplyAlpha, expected: 0, got: %d", ret);
+    SDL_ResetHint(SDL_HINT_SURFACE_CONVERT_THREADS);
+    SDLTest_AssertCheck(SDL_memcmp(single, threaded, size) == 0, "Verify threaded SDL_PremultiplyAlpha matches");
+
+done:
+    SDL_free(rgb);
+    SDL_free(yuv);
+    SDL_free(single);
+    SDL_free(threaded);
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Surface test cases */
@@ -856,11 +999,15 @@ static const SDLTest_TestCaseReference surfaceTestOverflow = {
     surface_testOverflow, "surface_testOverflow", "Test overflow detection.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTestConvertThreads = {
+    (SDLTest_TestCaseFp)surface_testConvertThreads, "surface_testConvertThreads", "Tests conversions split across threads.", TEST_ENABLED
+};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
-    &surfaceTest11, &surfaceTest12, &surfaceTestOverflow, NULL
+    &surfaceTest11, &surfaceTest12, &surfaceTestOverflow, &surfaceTestConvertThreads, NULL
 };
 
 /* Surface test suite (global) */
@@ -170,6 +170,85 @@ int timer_addRemoveTimer(void *arg)
     return TEST_COMPLETED;
 }
 
+/* Number of times the periodic nanosecond timer fires */
+#define NS_TIMER_FIRES 50
+
+/* Period of the nanosecond timer, deliberately not a whole number of milliseconds */
+#define NS_TIMER_INTERVAL (2 * SDL_NS_PER_MS + 500 * SDL_NS_PER_US)
+
+static Uint64 _nsTimerFired[NS_TIMER_FIRES];
+static SDL_atomic_t _nsTimerCount;
+
+/* Periodic callback that records when it ran */
+static Uint64 SDLCALL _timerTestCallbackNS(Uint64 interval, void *param)
+{
+    const int count = SDL_AtomicGet(&_nsTimerCount);
+
+    if (count < NS_TIMER_FIRES) {
+        _nsTimerFired[count] = SDL_GetPerformanceCounter();
+    }
+    SDL_AtomicSet(&_nsTimerCount, count + 1);
+    return (count + 1 < NS_TIMER_FIRES) ? interval : 0;
+}
+
+/**
+ * @brief Call to SDL_AddTimerNS and SDL_RemoveTimer
+ */
+int timer_addTimerNS(void *arg)
+{
+    const double ns_per_count = (double)SDL_NS_PER_SECOND / SDL_GetPerformanceFrequency();
+    SDL_TimerID id;
+    SDL_bool result;
+    Uint64 start;
+    double first, last, span, expected;
+    int i, early = 0;
+
+    /* A canceled nanosecond timer never fires */
+    SDL_AtomicSet(&_nsTimerCount, 0);
+    id = SDL_AddTimerNS(10 * SDL_NS_PER_SECOND, _timerTestCallbackNS, NULL);
+    SDLTest_AssertPass("Call to SDL_AddTimerNS(10s,...)");
+    SDLTest_AssertCheck(id > 0, "Check result value, expected: >0, got: %d", id);
+    result = SDL_RemoveTimer(id);
+    SDLTest_AssertCheck(result == SDL_TRUE, "Check result value, expected: %i, got: %i", SDL_TRUE, result);
+    SDLTest_AssertCheck(SDL_AtomicGet(&_nsTimerCount) == 0, "Check callback WAS NOT called, expected: 0, got: %i", SDL_AtomicGet(&_nsTimerCount));
+
+    /* A periodic timer fires on a fixed schedule */
+    start = SDL_GetPerformanceCounter();
+    id = SDL_AddTimerNS(NS_TIMER_INTERVAL, _timerTestCallbackNS, NULL);
+    SDLTest_AssertPass("Call to SDL_AddTimerNS(%" SDL_PRIu64 ",...)", NS_TIMER_INTERVAL);
+    SDLTest_AssertCheck(id > 0, "Check result value, expected: >0, got: %d", id);
+
+    for (i = 0; i < 100 && SDL_AtomicGet(&_nsTimerCount) < NS_TIMER_FIRES; ++i) {
+        SDL_Delay(20);
+    }
+    SDLTest_AssertCheck(SDL_AtomicGet(&_nsTimerCount) == NS_TIMER_FIRES, "Check callback count, expected: %i, got: %i", NS_TIMER_FIRES, SDL_AtomicGet(&_nsTimerCount));
+    if (SDL_AtomicGet(&_nsTimerCount) != NS_TIMER_FIRES) {
+        SDL_RemoveTimer(id);
+        return TEST_COMPLETED;
+    }
+
+    for (i = 0; i < NS_TIMER_FIRES; ++i) {
+        const double elapsed = (double)(_nsTimerFired[i] - start) * ns_per_count;
+        if (elapsed < (double)((i + 1) * NS_TIMER_INTERVAL)) {
+            ++early;
+        }
+    }
+    SDLTest_AssertCheck(early == 0, "Check no callback ran early, expected: 0, got: %i", early);
+
+    /* Every deadline is counted from the previous one, so lateness doesn't add up */
+    first = (double)(_nsTimerFired[0] - start) * ns_per_count;
+    last = (double)(_nsTimerFired[NS_TIMER_FIRES - 1] - start) * ns_per_count;
+    span = (last - first) / SDL_NS_PER_MS;
+    expected = (double)((NS_TIMER_FIRES - 1) * NS_TIMER_INTERVAL) / SDL_NS_PER_MS;
+    SDLTest_AssertCheck(SDL_fabs(span - expected) < 20.0, "Check schedule drift, expected: %.3f ms, got: %.3f ms", expected, span);
+
+    /* The timer canceled itself */
+    result = SDL_RemoveTimer(id);
+    SDLTest_AssertCheck(result == SDL_FALSE, "Check result value, expected: %i, got: %i", SDL_FALSE, result);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Timer test cases */
@@ -189,9 +268,13 @@ static const SDLTest_TestCaseReference timerTest4 = {
     (SDLTest_TestCaseFp)timer_addRemoveTimer, "timer_addRemoveTimer", "Call to SDL_AddTimer and SDL_RemoveTimer", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference timerTest5 = {
+    (SDLTest_TestCaseFp)timer_addTimerNS, "timer_addTimerNS", "Call to SDL_AddTimerNS and SDL_RemoveTimer", TEST_ENABLED
+};
+
 /* Sequence of Timer test cases */
 static const SDLTest_TestCaseReference *timerTests[] = {
-    &timerTest1, &timerTest2, &timerTest3, &timerTest4, NULL
+    &timerTest1, &timerTest2, &timerTest3, &timerTest4, &timerTest5, NULL
 };
 
 /* Timer test suite (global) */
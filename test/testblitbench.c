@@ -0,0 +1,194 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures how many pixels per second the alpha blitters in SDL_blit_A.c
+   blend for each CPU path, and checks that the SIMD paths match the scalar
+   ones bit for bit.  The path is picked with the SDL_BLIT_CPU_FEATURES
+   override that the blitter selection honours, an empty value means the
+   detected features. */
+
+#include "SDL.h"
+
+#define SURFACE_SIZE 256 /* a large sprite */
+#define DEFAULT_MS   100 /* time spent on each case and path */
+
+static const struct
+{
+    const char *name;
+    Uint32 src_format;
+    Uint32 dst_format;
+    int alpha_mod; /* 255 for per-pixel alpha */
+} cases[] = {
+    { "ARGB8888->ARGB8888", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, 255 },
+    { "ARGB8888->ABGR8888", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, 255 },
+    { "ARGB8888->RGB565", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565, 255 },
+    { "ABGR8888->BGR565", SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR565, 255 },
+    { "RGB888@100->RGB888", SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, 100 },
+    { "RGB888@128->RGB888", SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, 128 }
+};
+
+/* Values of SDL_BLIT_CPU_FEATURES, see SDL_blit.h */
+static const struct
+{
+    const char *name;
+    const char *features;
+    SDL_bool (*supported)(void);
+    SDL_bool exact; /* must match the scalar output */
+} paths[] = {
+    { "scalar", "0", NULL, SDL_TRUE },
+    { "MMX", "1", SDL_HasMMX, SDL_FALSE },
+    { "SSE4.1", "256", SDL_HasSSE41, SDL_TRUE },
+    { "AVX2", "64", SDL_HasAVX2, SDL_TRUE },
+    { "default", "", NULL, SDL_FALSE }
+};
+
+static void
+fill(SDL_Surface *surface, Uint32 seed)
+{
+    Uint8 *pixels = (Uint8 *)surface->pixels;
+    int x, y;
+
+    for (y = 0; y < surface->h; y++) {
+        Uint8 *row = pixels + y * surface->pitch;
+        for (x = 0; x < surface->w * surface->format->BytesPerPixel; x++) {
+            seed = seed * 1103515245 + 12345;
+            row[x] = (Uint8)(seed >> 16);
+        }
+    }
+
+    /* Make sure the fully transparent and fully opaque shortcuts get hit */
+    if (surface->format->Amask) {
+        for (y = 0; y < surface->h; y += 3) {
+            Uint32 *row = (Uint32 *)(pixels + y * surface->pitch);
+            for (x = 0; x < surface->w; x += 2) {
+                if (y % 2) {
+                    row[x] |= surface->format->Amask;
+                } else {
+                    row[x] &= ~surface->format->Amask;
+                }
+            }
+        }
+    }
+}
+
+/* Select a path and force the source's blit mapping to be rebuilt */
+static SDL_bool
+select_path(SDL_Surface *src, int path)
+{
+    SDL_setenv("SDL_BLIT_CPU_FEATURES", paths[path].features, 1);
+    return SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE) == 0 &&
+           SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND) == 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const double freq = (double)SDL_GetPerformanceFrequency();
+    const size_t dst_size = (size_t)SURFACE_SIZE * SURFACE_SIZE * 4;
+    SDL_Rect rect;
+    Uint8 *reference;
+    int ms = DEFAULT_MS;
+    int c, p, result = 0;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        ms = SDL_max(SDL_atoi(argv[1]), 1);
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    reference = (Uint8 *)SDL_malloc(dst_size);
+    if (!reference) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        SDL_Quit();
+        return 1;
+    }
+
+    /* Leave the right edge off so the tails get exercised */
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = SURFACE_SIZE - 3;
+    rect.h = SURFACE_SIZE;
+
+    SDL_Log("%dx%d pixels per call, MMX=%d SSE4.1=%d AVX2=%d NEON=%d\n", rect.w, rect.h,
+            SDL_HasMMX(), SDL_HasSSE41(), SDL_HasAVX2(), SDL_HasNEON());
+    SDL_Log("%-20s %-8s %12s\n", "case", "path", "Mpixels/s");
+
+    for (c = 0; c < (int)SDL_arraysize(cases); c++) {
+        SDL_Surface *src = SDL_CreateRGBSurfaceWithFormat(0, SURFACE_SIZE, SURFACE_SIZE, 0, cases[c].src_format);
+        SDL_Surface *dst = SDL_CreateRGBSurfaceWithFormat(0, SURFACE_SIZE, SURFACE_SIZE, 0, cases[c].dst_format);
+        size_t size;
+
+        if (!src || !dst) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surfaces: %s\n", SDL_GetError());
+            SDL_FreeSurface(src);
+            SDL_FreeSurface(dst);
+            result = 1;
+            break;
+        }
+        size = (size_t)dst->pitch * dst->h;
+        fill(src, 1 + c);
+        SDL_SetSurfaceAlphaMod(src, (Uint8)cases[c].alpha_mod);
+
+        for (p = 0; p < (int)SDL_arraysize(paths); p++) {
+            const Uint64 duration = (Uint64)(freq * ms / 1000.0);
+            Uint64 start, now;
+            Sint64 calls = 0;
+            SDL_Rect dstrect;
+
+            if (paths[p].supported && !paths[p].supported()) {
+                continue;
+            }
+            if (!select_path(src, p)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't set blend mode: %s\n", SDL_GetError());
+                result = 1;
+                continue;
+            }
+
+            /* One blit over known contents to check the output */
+            fill(dst, 1000 + c);
+            dstrect = rect;
+            SDL_BlitSurface(src, &rect, dst, &dstrect);
+            if (p == 0) {
+                SDL_memcpy(reference, dst->pixels, size);
+            } else if (paths[p].exact && SDL_memcmp(reference, dst->pixels, size) != 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: %s output differs from scalar\n", cases[c].name, paths[p].name);
+                result = 1;
+            }
+
+            start = SDL_GetPerformanceCounter();
+            do {
+                dstrect = rect;
+                SDL_BlitSurface(src, &rect, dst, &dstrect);
+                ++calls;
+                now = SDL_GetPerformanceCounter();
+            } while ((now - start) < duration);
+
+            SDL_Log("%-20s %-8s %12.1f\n", cases[c].name, paths[p].name,
+                    (double)calls * rect.w * rect.h / ((double)(now - start) / freq) / 1000000.0);
+        }
+
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(dst);
+    }
+
+    SDL_setenv("SDL_BLIT_CPU_FEATURES", "", 1);
+    SDL_free(reference);
+    SDL_Quit();
+    return result;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
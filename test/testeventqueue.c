@@ -0,0 +1,149 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures event queue push/poll throughput as the number of producer
+   threads grows, and checks that no event is lost or reordered per producer */
+
+#include "SDL.h"
+
+#define MAX_PRODUCERS 8
+#define BATCH_SIZE 64
+
+static int events_per_producer = 50000;
+static Uint32 event_type;
+static SDL_atomic_t producers_done;
+static SDL_atomic_t push_retries;
+
+static int SDLCALL
+Producer(void *data)
+{
+    const int id = (int)(size_t)data;
+    SDL_Event event;
+    int i;
+
+    SDL_zero(event);
+    event.type = event_type;
+    event.user.code = id;
+
+    for (i = 0; i < events_per_producer; ++i) {
+        event.user.data1 = (void *)(size_t)i;
+        while (SDL_PushEvent(&event) <= 0) {
+            /* The queue is full, give the consumer a chance to catch up */
+            SDL_AtomicIncRef(&push_retries);
+            SDL_Delay(0);
+        }
+    }
+
+    SDL_AtomicIncRef(&producers_done);
+    return 0;
+}
+
+static SDL_bool
+RunTest(int num_producers)
+{
+    SDL_Thread *threads[MAX_PRODUCERS];
+    int next_expected[MAX_PRODUCERS];
+    SDL_Event events[BATCH_SIZE];
+    const int total = num_producers * events_per_producer;
+    int received = 0, polls = 0;
+    Uint64 start, elapsed;
+    double seconds;
+    SDL_bool ok = SDL_TRUE;
+    int i;
+
+    SDL_AtomicSet(&producers_done, 0);
+    SDL_AtomicSet(&push_retries, 0);
+    SDL_zeroa(next_expected);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_producers; ++i) {
+        threads[i] = SDL_CreateThread(Producer, "Producer", (void *)(size_t)i);
+    }
+
+    while (received < total) {
+        const int count = SDL_PeepEvents(events, BATCH_SIZE, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+        ++polls;
+        if (count < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_PeepEvents() failed: %s\n", SDL_GetError());
+            ok = SDL_FALSE;
+            break;
+        }
+        for (i = 0; i < count; ++i) {
+            const int id = events[i].user.code;
+            const int seq = (int)(size_t)events[i].user.data1;
+            if (events[i].type != event_type) {
+                continue;
+            }
+            if (id < 0 || id >= num_producers) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Got event from unknown producer %d\n", id);
+                ok = SDL_FALSE;
+            } else {
+                if (seq != next_expected[id] && ok) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Producer %d: got event %d, expected %d\n", id, seq, next_expected[id]);
+                    ok = SDL_FALSE;
+                }
+                next_expected[id] = seq + 1;
+            }
+            ++received;
+        }
+        if (count == 0 && SDL_AtomicGet(&producers_done) == num_producers && !SDL_HasEvent(event_type)) {
+            break;
+        }
+    }
+    elapsed = SDL_GetPerformanceCounter() - start;
+
+    for (i = 0; i < num_producers; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+
+    if (received != total) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Received %d of %d events\n", received, total);
+        ok = SDL_FALSE;
+    }
+
+    seconds = (double)elapsed / SDL_GetPerformanceFrequency();
+    SDL_Log("%d producer(s): %d events in %.3f ms, %.2f M events/s, %d polls, %d full-queue retries\n",
+            num_producers, received, seconds * 1000.0, (received / seconds) / 1000000.0,
+            polls, SDL_AtomicGet(&push_retries));
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    int num_producers;
+    SDL_bool ok = SDL_TRUE;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        events_per_producer = SDL_max(SDL_atoi(argv[1]), 1);
+    }
+
+    if (SDL_Init(SDL_INIT_EVENTS) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    event_type = SDL_RegisterEvents(1);
+
+    for (num_producers = 1; num_producers <= MAX_PRODUCERS; num_producers *= 2) {
+        if (!RunTest(num_producers)) {
+            ok = SDL_FALSE;
+        }
+    }
+
+    SDL_Quit();
+    return ok ? 0 : 1;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,312 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures how SDL_ParallelFor() and SDL_RunJob() scale with the number of
+   job threads, and checks that every job runs exactly once and in order */
+
+#include "SDL.h"
+
+#define DEFAULT_ITEMS (1 << 20)
+
+/* Jobs in the small job and dependency passes */
+#define NUM_JOBS 100000
+
+/* Depth of the recursive fork/join pass, 2^depth leaves */
+#define TREE_DEPTH 14
+
+static int num_items = DEFAULT_ITEMS;
+static Uint32 *items;
+static Uint32 *expected;
+static SDL_atomic_t counted;
+
+static Uint32
+work(Uint32 x)
+{
+    int i;
+
+    /* Enough arithmetic that the threads aren't limited by memory */
+    for (i = 0; i < 64; ++i) {
+        x = x * 1664525 + 1013904223;
+        x ^= x >> 13;
+    }
+    return x;
+}
+
+static void SDLCALL
+work_range(void *userdata, int first, int end)
+{
+    Uint32 *out = (Uint32 *)userdata;
+    int i;
+
+    for (i = first; i < end; ++i) {
+        out[i] = work((Uint32)i);
+    }
+}
+
+static void SDLCALL
+count_job(void *userdata)
+{
+    SDL_AtomicIncRef(&counted);
+}
+
+typedef struct
+{
+    Uint32 *stage;
+    int index;
+} StageJob;
+
+static void SDLCALL
+first_stage_job(void *userdata)
+{
+    StageJob *job = (StageJob *)userdata;
+
+    job->stage[job->index] = work((Uint32)job->index);
+}
+
+static void SDLCALL
+second_stage_job(void *userdata)
+{
+    StageJob *job = (StageJob *)userdata;
+
+    /* Runs after the whole first stage, so every neighbor is there */
+    if (job->stage[job->index] != work((Uint32)job->index) ||
+        job->stage[(job->index + 1) % NUM_JOBS] != work((Uint32)((job->index + 1) % NUM_JOBS))) {
+        SDL_AtomicIncRef(&counted);
+    }
+}
+
+typedef struct
+{
+    int depth;
+    Uint32 sum;
+} TreeJob;
+
+static void SDLCALL
+tree_job(void *userdata)
+{
+    TreeJob *job = (TreeJob *)userdata;
+
+    if (job->depth == 0) {
+        job->sum = 1;
+    } else {
+        /* Fork both halves and wait, the waiting thread runs jobs meanwhile */
+        TreeJob children[2];
+        SDL_JobCounter *counter = SDL_CreateJobCounter();
+
+        children[0].depth = children[1].depth = job->depth - 1;
+        if (!counter) {
+            tree_job(&children[0]);
+            tree_job(&children[1]);
+        } else {
+            SDL_RunJob(tree_job, &children[0], counter, NULL);
+            SDL_RunJob(tree_job, &children[1], counter, NULL);
+            SDL_WaitJobCounter(counter);
+            SDL_DestroyJobCounter(counter);
+        }
+        job->sum = children[0].sum + children[1].sum;
+    }
+}
+
+static double
+elapsed_ms(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+static SDL_bool
+bench_parallel_for(double *ms)
+{
+    Uint64 start;
+
+    SDL_memset(items, 0, num_items * sizeof(*items));
+    start = SDL_GetPerformanceCounter();
+    if (SDL_ParallelFor(work_range, items, num_items, 0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_ParallelFor() failed: %s\n", SDL_GetError());
+        return SDL_FALSE;
+    }
+    *ms = elapsed_ms(start);
+
+    if (SDL_memcmp(items, expected, num_items * sizeof(*items)) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_ParallelFor() missed some items\n");
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static SDL_bool
+bench_small_jobs(double *ms)
+{
+    SDL_JobCounter *counter = SDL_CreateJobCounter();
+    Uint64 start;
+    int i;
+
+    if (!counter) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create a job counter: %s\n", SDL_GetError());
+        return SDL_FALSE;
+    }
+    SDL_AtomicSet(&counted, 0);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < NUM_JOBS; ++i) {
+        SDL_RunJob(count_job, NULL, counter, NULL);
+    }
+    SDL_WaitJobCounter(counter);
+    *ms = elapsed_ms(start);
+    SDL_DestroyJobCounter(counter);
+
+    if (SDL_AtomicGet(&counted) != NUM_JOBS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d of %d jobs ran\n", SDL_AtomicGet(&counted), NUM_JOBS);
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static SDL_bool
+bench_dependencies(double *ms)
+{
+    SDL_JobCounter *first = SDL_CreateJobCounter();
+    SDL_JobCounter *second = SDL_CreateJobCounter();
+    StageJob *jobs = (StageJob *)SDL_malloc(NUM_JOBS * sizeof(*jobs));
+    Uint32 *stage = (Uint32 *)SDL_calloc(NUM_JOBS, sizeof(*stage));
+    SDL_bool ok = SDL_FALSE;
+    Uint64 start;
+    int i;
+
+    if (!first || !second || !jobs || !stage) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        goto done;
+    }
+    SDL_AtomicSet(&counted, 0);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < NUM_JOBS; ++i) {
+        jobs[i].stage = stage;
+        jobs[i].index = i;
+        SDL_RunJob(first_stage_job, &jobs[i], first, NULL);
+    }
+    for (i = 0; i < NUM_JOBS; ++i) {
+        SDL_RunJob(second_stage_job, &jobs[i], second, first);
+    }
+    SDL_WaitJobCounter(second);
+    *ms = elapsed_ms(start);
+
+    if (SDL_GetJobCounterValue(first) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "The second stage finished before the first\n");
+    } else if (SDL_AtomicGet(&counted) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d jobs started before their dependencies\n", SDL_AtomicGet(&counted));
+    } else {
+        ok = SDL_TRUE;
+    }
+
+done:
+    SDL_free(stage);
+    SDL_free(jobs);
+    SDL_DestroyJobCounter(second);
+    SDL_DestroyJobCounter(first);
+    return ok;
+}
+
+static SDL_bool
+bench_fork_join(double *ms)
+{
+    TreeJob root;
+    Uint64 start;
+
+    root.depth = TREE_DEPTH;
+    start = SDL_GetPerformanceCounter();
+    tree_job(&root);
+    *ms = elapsed_ms(start);
+
+    if (root.sum != (1u << TREE_DEPTH)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Fork/join counted %u leaves, expected %u\n", root.sum, 1u << TREE_DEPTH);
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+/* Runs all the passes with a fresh pool of 'threads' job threads */
+static SDL_bool
+run_passes(int threads, double *parallel_ms)
+{
+    char value[16];
+    double small_ms = 0.0, deps_ms = 0.0, tree_ms = 0.0;
+    SDL_bool ok = SDL_TRUE;
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return SDL_FALSE;
+    }
+    SDL_snprintf(value, sizeof(value), "%d", threads);
+    SDL_SetHint(SDL_HINT_JOB_THREADS, value);
+
+    ok = bench_parallel_for(parallel_ms) && ok;
+    ok = bench_small_jobs(&small_ms) && ok;
+    ok = bench_dependencies(&deps_ms) && ok;
+    ok = bench_fork_join(&tree_ms) && ok;
+
+    SDL_Log("%2d job threads: parallel for %9.3f ms, %d jobs %8.3f ms, two stages %8.3f ms, fork/join %8.3f ms\n",
+            SDL_GetJobThreadCount(), *parallel_ms, NUM_JOBS, small_ms, deps_ms, tree_ms);
+
+    /* Stops the job threads, the next pass starts a new pool */
+    SDL_Quit();
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    SDL_bool ok = SDL_TRUE;
+    double serial_ms = 0.0, ms = 0.0;
+    int threads, max_threads;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    max_threads = SDL_GetCPUCount() - 1;
+    if (argc > 1) {
+        max_threads = SDL_max(SDL_atoi(argv[1]), 0);
+    }
+    if (argc > 2) {
+        num_items = SDL_max(SDL_atoi(argv[2]), 1);
+    }
+
+    items = (Uint32 *)SDL_malloc(num_items * sizeof(*items));
+    expected = (Uint32 *)SDL_malloc(num_items * sizeof(*expected));
+    if (!items || !expected) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        return 1;
+    }
+    work_range(expected, 0, num_items);
+
+    /* Zero threads runs everything on this thread, the baseline for the speedups */
+    for (threads = 0; threads <= max_threads; threads = threads ? threads * 2 : 1) {
+        ok = run_passes(threads, &ms) && ok;
+        if (threads == 0) {
+            serial_ms = ms;
+        } else if (ms > 0.0) {
+            SDL_Log("%2d job threads: parallel for speedup %.2fx\n", threads, serial_ms / ms);
+        }
+    }
+    if (max_threads > 0 && (max_threads & (max_threads - 1)) != 0) {
+        ok = run_passes(max_threads, &ms) && ok;
+        if (ms > 0.0) {
+            SDL_Log("%2d job threads: parallel for speedup %.2fx\n", max_threads, serial_ms / ms);
+        }
+    }
+
+    SDL_free(expected);
+    SDL_free(items);
+
+    SDL_Log("%s\n", ok ? "All job checks passed" : "Some job checks failed");
+    return ok ? 0 : 1;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -12,6 +12,9 @@
 
 /* Test the thread and mutex locking functions
    Also exercises the system's signal/thread interaction
+
+   With --bench [threads] it instead measures what locking costs with and
+   without contention, for mutexes, semaphores and condition variables
 */
 
 #include <signal.h>
@@ -88,6 +91,205 @@ Run(void *data)
     return 0;
 }
 
+/* Iterations of the uncontended measurements */
+#define BENCH_ITERATIONS 10000000
+
+/* Lock and unlock pairs per thread when contended */
+#define BENCH_CONTENDED_ITERATIONS 1000000
+
+/* Round trips between two threads */
+#define BENCH_ROUND_TRIPS 100000
+
+static SDL_sem *ping_sem;
+static SDL_sem *pong_sem;
+static SDL_cond *turn_cond;
+static int turn;
+static int shared_counter;
+
+static double
+elapsed_ns(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000000000.0 / SDL_GetPerformanceFrequency();
+}
+
+static void
+report(const char *what, int count, double ns)
+{
+    SDL_Log("%-36s %10d in %10.3f ms, %8.2f ns each\n", what, count, ns / 1000000.0, ns / count);
+}
+
+static int SDLCALL
+WarmupRun(void *data)
+{
+    return 0;
+}
+
+static int SDLCALL
+ContendedRun(void *data)
+{
+    int i;
+
+    for (i = 0; i < BENCH_CONTENDED_ITERATIONS; ++i) {
+        SDL_LockMutex(mutex);
+        ++shared_counter;
+        SDL_UnlockMutex(mutex);
+    }
+    return 0;
+}
+
+static int SDLCALL
+PongSemRun(void *data)
+{
+    int i;
+
+    for (i = 0; i < BENCH_ROUND_TRIPS; ++i) {
+        SDL_SemWait(ping_sem);
+        SDL_SemPost(pong_sem);
+    }
+    return 0;
+}
+
+static int SDLCALL
+PongCondRun(void *data)
+{
+    int i;
+
+    SDL_LockMutex(mutex);
+    for (i = 0; i < BENCH_ROUND_TRIPS; ++i) {
+        while (turn != 1) {
+            SDL_CondWait(turn_cond, mutex);
+        }
+        turn = 0;
+        SDL_CondSignal(turn_cond);
+    }
+    SDL_UnlockMutex(mutex);
+    return 0;
+}
+
+static int
+Bench(int num_threads)
+{
+    SDL_Thread *bench_threads[64];
+    Uint64 start;
+    int i, ok = 1;
+
+    mutex = SDL_CreateMutex();
+    ping_sem = SDL_CreateSemaphore(0);
+    pong_sem = SDL_CreateSemaphore(0);
+    turn_cond = SDL_CreateCond();
+    if (!mutex || !ping_sem || !pong_sem || !turn_cond) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create the locks: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    /* Some C libraries skip the atomic instructions until a second thread
+       has been started, which real programs always have */
+    SDL_WaitThread(SDL_CreateThread(WarmupRun, "Warmup", NULL), NULL);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < BENCH_ITERATIONS; ++i) {
+        SDL_LockMutex(mutex);
+        SDL_UnlockMutex(mutex);
+    }
+    report("uncontended lock/unlock", BENCH_ITERATIONS, elapsed_ns(start));
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < BENCH_ITERATIONS; ++i) {
+        SDL_LockMutex(mutex);
+        SDL_LockMutex(mutex);
+        SDL_UnlockMutex(mutex);
+        SDL_UnlockMutex(mutex);
+    }
+    report("uncontended recursive lock/unlock", BENCH_ITERATIONS, elapsed_ns(start));
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < BENCH_ITERATIONS; ++i) {
+        if (SDL_TryLockMutex(mutex) == 0) {
+            SDL_UnlockMutex(mutex);
+        }
+    }
+    report("uncontended trylock/unlock", BENCH_ITERATIONS, elapsed_ns(start));
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < BENCH_ITERATIONS; ++i) {
+        SDL_SemPost(ping_sem);
+        SDL_SemWait(ping_sem);
+    }
+    report("uncontended sem post/wait", BENCH_ITERATIONS, elapsed_ns(start));
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < BENCH_ITERATIONS; ++i) {
+        SDL_SemPost(ping_sem);
+        SDL_SemWaitTimeout(ping_sem, 10);
+    }
+    report("uncontended sem post/wait timeout", BENCH_ITERATIONS, elapsed_ns(start));
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < BENCH_ITERATIONS; ++i) {
+        SDL_CondSignal(turn_cond);
+    }
+    report("cond signal without waiters", BENCH_ITERATIONS, elapsed_ns(start));
+
+    shared_counter = 0;
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_threads; ++i) {
+        bench_threads[i] = SDL_CreateThread(ContendedRun, "Contended", NULL);
+    }
+    for (i = 0; i < num_threads; ++i) {
+        SDL_WaitThread(bench_threads[i], NULL);
+    }
+    report("contended lock/unlock", num_threads * BENCH_CONTENDED_ITERATIONS, elapsed_ns(start));
+    if (shared_counter != num_threads * BENCH_CONTENDED_ITERATIONS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Counted %d under the lock, expected %d\n",
+                     shared_counter, num_threads * BENCH_CONTENDED_ITERATIONS);
+        ok = 0;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    bench_threads[0] = SDL_CreateThread(PongSemRun, "PongSem", NULL);
+    for (i = 0; i < BENCH_ROUND_TRIPS; ++i) {
+        SDL_SemPost(ping_sem);
+        SDL_SemWait(pong_sem);
+    }
+    SDL_WaitThread(bench_threads[0], NULL);
+    report("sem round trip between threads", BENCH_ROUND_TRIPS, elapsed_ns(start));
+
+    turn = 0;
+    start = SDL_GetPerformanceCounter();
+    bench_threads[0] = SDL_CreateThread(PongCondRun, "PongCond", NULL);
+    SDL_LockMutex(mutex);
+    for (i = 0; i < BENCH_ROUND_TRIPS; ++i) {
+        turn = 1;
+        SDL_CondSignal(turn_cond);
+        while (turn != 0) {
+            SDL_CondWait(turn_cond, mutex);
+        }
+    }
+    SDL_UnlockMutex(mutex);
+    SDL_WaitThread(bench_threads[0], NULL);
+    report("cond round trip between threads", BENCH_ROUND_TRIPS, elapsed_ns(start));
+
+    if (SDL_SemWaitTimeout(ping_sem, 20) != SDL_MUTEX_TIMEDOUT) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "An empty semaphore didn't time out\n");
+        ok = 0;
+    }
+    SDL_LockMutex(mutex);
+    if (SDL_CondWaitTimeout(turn_cond, mutex, 20) != SDL_MUTEX_TIMEDOUT) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "A condition variable nobody signals didn't time out\n");
+        ok = 0;
+    }
+    SDL_UnlockMutex(mutex);
+
+    SDL_DestroyCond(turn_cond);
+    SDL_DestroySemaphore(pong_sem);
+    SDL_DestroySemaphore(ping_sem);
+    SDL_DestroyMutex(mutex);
+    mutex = NULL;
+
+    SDL_Log("%s\n", ok ? "All lock checks passed" : "Some lock checks failed");
+    return ok ? 0 : 1;
+}
+
 int main(int argc, char *argv[])
 {
     int i;
@@ -103,6 +305,14 @@ int main(int argc, char *argv[])
     }
     (void)atexit(SDL_Quit_Wrapper);
 
+    if (argc > 1 && SDL_strcmp(argv[1], "--bench") == 0) {
+        int num_threads = SDL_max(SDL_GetCPUCount(), 2);
+        if (argc > 2) {
+            num_threads = SDL_atoi(argv[2]);
+        }
+        return Bench(SDL_clamp(num_threads, 1, 64));
+    }
+
     SDL_AtomicSet(&doterminate, 0);
 
     mutex = SDL_CreateMutex();
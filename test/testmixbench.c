@@ -0,0 +1,123 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures how many samples per second SDL_MixAudioFormat() mixes for each
+   format and a few volume settings */
+
+#include "SDL.h"
+
+#define BUFFER_SAMPLES 4096 /* about what a mixer callback sees */
+#define DEFAULT_MS     100  /* time spent on each format and volume */
+
+static const struct
+{
+    SDL_AudioFormat format;
+    const char *name;
+} formats[] = {
+    { AUDIO_U8, "U8" },
+    { AUDIO_S8, "S8" },
+    { AUDIO_S16LSB, "S16LSB" },
+    { AUDIO_S16MSB, "S16MSB" },
+    { AUDIO_U16LSB, "U16LSB" },
+    { AUDIO_S32LSB, "S32LSB" },
+    { AUDIO_S32MSB, "S32MSB" },
+    { AUDIO_F32LSB, "F32LSB" },
+    { AUDIO_F32MSB, "F32MSB" }
+};
+
+static const int volumes[] = { SDL_MIX_MAXVOLUME, SDL_MIX_MAXVOLUME / 2, 1 };
+
+static Uint8 src[BUFFER_SAMPLES * 4];
+static Uint8 dst[BUFFER_SAMPLES * 4];
+
+static void
+fill(SDL_AudioFormat format)
+{
+    const int samples = BUFFER_SAMPLES;
+    int i;
+
+    /* Quiet enough that the mix doesn't clip all the time */
+    for (i = 0; i < samples; i++) {
+        const double value = 0.25 * SDL_sin(i * 0.01);
+        switch (SDL_AUDIO_BITSIZE(format)) {
+        case 8:
+            ((Sint8 *)src)[i] = (Sint8)(value * 127);
+            break;
+        case 16:
+            ((Sint16 *)src)[i] = (Sint16)(value * 32767);
+            break;
+        default:
+            if (SDL_AUDIO_ISFLOAT(format)) {
+                ((float *)src)[i] = (float)value;
+            } else {
+                ((Sint32 *)src)[i] = (Sint32)(value * 2147483647.0);
+            }
+            break;
+        }
+    }
+    SDL_memcpy(dst, src, sizeof(dst));
+}
+
+int main(int argc, char *argv[])
+{
+    const double freq = (double)SDL_GetPerformanceFrequency();
+    int ms = DEFAULT_MS;
+    int f, v;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        ms = SDL_max(SDL_atoi(argv[1]), 1);
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%d samples per call, SSE2=%d AVX2=%d NEON=%d\n", BUFFER_SAMPLES, SDL_HasSSE2(), SDL_HasAVX2(), SDL_HasNEON());
+    SDL_Log("%-8s %6s %14s\n", "format", "volume", "Msamples/s");
+
+    for (f = 0; f < (int)SDL_arraysize(formats); f++) {
+        const SDL_AudioFormat format = formats[f].format;
+        const Uint32 len = BUFFER_SAMPLES * (SDL_AUDIO_BITSIZE(format) / 8);
+
+        for (v = 0; v < (int)SDL_arraysize(volumes); v++) {
+            const Uint64 duration = (Uint64)(freq * ms / 1000.0);
+            Uint64 start, now;
+            Sint64 calls = 0;
+
+            fill(format);
+            SDL_MixAudioFormat(dst, src, format, len, volumes[v]); /* warm up */
+
+            start = SDL_GetPerformanceCounter();
+            do {
+                SDL_MixAudioFormat(dst, src, format, len, volumes[v]);
+                ++calls;
+                /* Keep the destination from sitting at the clipping limits */
+                if ((calls & 63) == 0) {
+                    SDL_memcpy(dst, src, len);
+                }
+                now = SDL_GetPerformanceCounter();
+            } while ((now - start) < duration);
+
+            SDL_Log("%-8s %6d %14.1f\n", formats[f].name, volumes[v],
+                    (double)calls * BUFFER_SAMPLES / ((double)(now - start) / freq) / 1000000.0);
+        }
+    }
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -12,6 +12,159 @@
 
 #include "SDL.h"
 
+#define BENCH_CHANNELS 2
+#define BENCH_SECONDS  4
+#define BENCH_CHUNK    1024 /* frames per SDL_AudioStreamPut(), like an audio callback */
+#define BENCH_PASSES   5    /* the fastest pass is reported */
+#define SNR_SKIP       64   /* output frames at each end that see the silent padding */
+
+static const char *quality_names[] = { "zero-order hold", "linear", "cubic", "high" };
+
+static float *make_tone(int rate, double tone)
+{
+    const int frames = rate * BENCH_SECONDS;
+    float *buf = (float *)SDL_malloc(sizeof(float) * BENCH_CHANNELS * frames);
+    int i, chan;
+
+    if (!buf) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory.\n");
+        return NULL;
+    }
+    for (i = 0; i < frames; i++) {
+        const float sample = (float)(0.5 * SDL_sin(2.0 * M_PI * tone * i / rate));
+        for (chan = 0; chan < BENCH_CHANNELS; chan++) {
+            buf[(i * BENCH_CHANNELS) + chan] = sample;
+        }
+    }
+    return buf;
+}
+
+static SDL_AudioStream *new_stream(SDL_AudioResampleQuality quality, int inrate, int outrate)
+{
+    SDL_AudioStream *stream = SDL_NewAudioStream(AUDIO_F32SYS, BENCH_CHANNELS, inrate, AUDIO_F32SYS, BENCH_CHANNELS, outrate);
+
+    if (!stream || SDL_AudioStreamSetResampleQuality(stream, quality) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't set up audio stream: %s\n", SDL_GetError());
+        SDL_FreeAudioStream(stream);
+        return NULL;
+    }
+    return stream;
+}
+
+/* Resample a pure tone and compare it against the exact tone at the output rate.
+   Everything goes in with one SDL_AudioStreamPut() call so the output lines up
+   with the input and only the filter is measured. */
+static SDL_bool measure_snr(SDL_AudioResampleQuality quality, int inrate, int outrate, double tone, double *snr)
+{
+    const int inframes = inrate * BENCH_SECONDS;
+    const int outframes = (int)((Sint64)inframes * outrate / inrate);
+    float *in = make_tone(inrate, tone);
+    float *out = (float *)SDL_malloc(sizeof(float) * BENCH_CHANNELS * outframes);
+    SDL_AudioStream *stream = new_stream(quality, inrate, outrate);
+    double signal = 0.0, noise = 0.0;
+    SDL_bool ok = SDL_FALSE;
+    int i, chan, got;
+
+    if (!in || !out || !stream) {
+        goto done;
+    }
+    if (SDL_AudioStreamPut(stream, in, inframes * BENCH_CHANNELS * sizeof(float)) < 0 ||
+        SDL_AudioStreamFlush(stream) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Resampling failed: %s\n", SDL_GetError());
+        goto done;
+    }
+    got = SDL_AudioStreamGet(stream, out, outframes * BENCH_CHANNELS * sizeof(float)) / (BENCH_CHANNELS * sizeof(float));
+
+    for (i = SNR_SKIP; i < got - SNR_SKIP; i++) {
+        const double expected = 0.5 * SDL_sin(2.0 * M_PI * tone * i / outrate);
+        for (chan = 0; chan < BENCH_CHANNELS; chan++) {
+            const double error = out[(i * BENCH_CHANNELS) + chan] - expected;
+            signal += expected * expected;
+            noise += error * error;
+        }
+    }
+    *snr = (noise > 0.0) ? 10.0 * SDL_log10(signal / noise) : 999.0;
+    ok = SDL_TRUE;
+
+done:
+    SDL_FreeAudioStream(stream);
+    SDL_free(out);
+    SDL_free(in);
+    return ok;
+}
+
+/* Stream audio through in callback sized chunks, returns the seconds the
+   fastest pass took or a negative value on error */
+static double measure_speed(SDL_AudioResampleQuality quality, int inrate, int outrate)
+{
+    const int inframes = inrate * BENCH_SECONDS;
+    const int outlen = (BENCH_CHUNK * outrate / inrate + 1) * BENCH_CHANNELS * sizeof(float);
+    float *in = make_tone(inrate, 1000.0);
+    float *out = (float *)SDL_malloc(outlen);
+    SDL_AudioStream *stream = new_stream(quality, inrate, outrate);
+    double seconds = -1.0;
+    int pass, i;
+
+    if (!in || !out || !stream) {
+        goto done;
+    }
+
+    for (pass = 0; pass < BENCH_PASSES; pass++) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        double elapsed;
+        for (i = 0; i + BENCH_CHUNK <= inframes; i += BENCH_CHUNK) {
+            if (SDL_AudioStreamPut(stream, in + (i * BENCH_CHANNELS), BENCH_CHUNK * BENCH_CHANNELS * sizeof(float)) < 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_AudioStreamPut() failed: %s\n", SDL_GetError());
+                goto done;
+            }
+            while (SDL_AudioStreamGet(stream, out, outlen) > 0) {
+            }
+        }
+        elapsed = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+        if (seconds < 0.0 || elapsed < seconds) {
+            seconds = elapsed;
+        }
+    }
+
+done:
+    SDL_FreeAudioStream(stream);
+    SDL_free(out);
+    SDL_free(in);
+    return seconds;
+}
+
+/* Report throughput and signal to noise ratio for every resampler quality */
+static int bench(void)
+{
+    static const int rates[][2] = { { 44100, 48000 }, { 48000, 44100 }, { 22050, 48000 } };
+    static const double tones[] = { 1000.0, 8000.0 };
+    int q, r, t;
+
+    SDL_Log("%d channels, %d frames per put\n", BENCH_CHANNELS, BENCH_CHUNK);
+    SDL_Log("%-16s %13s %10s %11s %12s %12s\n", "quality", "rates", "MFrames/s", "x realtime", "SNR @ 1 kHz", "SNR @ 8 kHz");
+    for (q = SDL_AUDIO_RESAMPLE_ZERO_ORDER_HOLD; q <= SDL_AUDIO_RESAMPLE_HIGH; q++) {
+        for (r = 0; r < (int)SDL_arraysize(rates); r++) {
+            const int inrate = rates[r][0];
+            const int outrate = rates[r][1];
+            double snr[SDL_arraysize(tones)];
+            double seconds;
+
+            for (t = 0; t < (int)SDL_arraysize(tones); t++) {
+                if (!measure_snr((SDL_AudioResampleQuality)q, inrate, outrate, tones[t], &snr[t])) {
+                    return 1;
+                }
+            }
+            seconds = measure_speed((SDL_AudioResampleQuality)q, inrate, outrate);
+            if (seconds < 0.0) {
+                return 1;
+            }
+            SDL_Log("%-16s %6d->%-6d %10.2f %11.0f %9.1f dB %9.1f dB\n", quality_names[q], inrate, outrate,
+                    (inrate * BENCH_SECONDS) / seconds / 1000000.0, BENCH_SECONDS / seconds, snr[0], snr[1]);
+        }
+    }
+    return 0;
+}
+
 int main(int argc, char **argv)
 {
     SDL_AudioSpec spec;
@@ -28,8 +181,20 @@ int main(int argc, char **argv)
     /* Enable standard application logging */
     SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
 
+    if (argc == 2 && SDL_strcmp(argv[1], "--bench") == 0) {
+        int retval;
+        if (SDL_Init(0) == -1) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+            return 2;
+        }
+        retval = bench();
+        SDL_Quit();
+        return retval;
+    }
+
     if (argc != 5) {
         SDL_Log("USAGE: %s in.wav out.wav newfreq newchans\n", argv[0]);
+        SDL_Log("       %s --bench\n", argv[0]);
         return 1;
     }
 
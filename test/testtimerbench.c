@@ -0,0 +1,247 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures how fast timers can be added, removed and fired when there are
+   many of them, and checks that every timer fires exactly as asked */
+
+#include "SDL.h"
+
+#define DEFAULT_TIMERS 20000
+
+/* Long enough that the timers never fire during the add/remove passes */
+#define IDLE_INTERVAL 1000000
+
+static int num_timers = DEFAULT_TIMERS;
+static SDL_TimerID *ids;
+static SDL_atomic_t fired;
+static SDL_atomic_t misfired;
+
+static Uint32 SDLCALL
+idle_callback(Uint32 interval, void *param)
+{
+    SDL_AtomicIncRef(&misfired);
+    return 0;
+}
+
+static Uint32 SDLCALL
+oneshot_callback(Uint32 interval, void *param)
+{
+    SDL_AtomicIncRef(&fired);
+    return 0;
+}
+
+static Uint32 SDLCALL
+repeat_callback(Uint32 interval, void *param)
+{
+    SDL_atomic_t *remaining = (SDL_atomic_t *)param;
+
+    SDL_AtomicIncRef(&fired);
+    return SDL_AtomicDecRef(remaining) ? 0 : interval;
+}
+
+static double
+elapsed_ms(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+static void
+report(const char *what, int count, double ms)
+{
+    SDL_Log("%-28s %6d timers in %9.3f ms, %8.2f K/s\n", what, count, ms, ms > 0.0 ? (count / ms) : 0.0);
+}
+
+static SDL_bool
+wait_for_fired(int expected, Uint32 timeout)
+{
+    const Uint64 deadline = SDL_GetTicks64() + timeout;
+
+    while (SDL_AtomicGet(&fired) < expected) {
+        if (SDL_GetTicks64() > deadline) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Only %d of %d timers fired\n", SDL_AtomicGet(&fired), expected);
+            return SDL_FALSE;
+        }
+        SDL_Delay(1);
+    }
+    return SDL_TRUE;
+}
+
+static SDL_bool
+bench_add_remove(void)
+{
+    Uint64 start;
+    SDL_bool ok = SDL_TRUE;
+    int i, removed = 0;
+
+    SDL_AtomicSet(&misfired, 0);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_timers; ++i) {
+        ids[i] = SDL_AddTimer(IDLE_INTERVAL + (i % 997), idle_callback, NULL);
+        if (!ids[i]) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_AddTimer() failed: %s\n", SDL_GetError());
+            return SDL_FALSE;
+        }
+    }
+    report("add", num_timers, elapsed_ms(start));
+
+    /* Remove in a scattered order, like timeouts that complete early */
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_timers; i += 2) {
+        removed += SDL_RemoveTimer(ids[i]);
+    }
+    for (i = 1; i < num_timers; i += 2) {
+        removed += SDL_RemoveTimer(ids[i]);
+    }
+    report("remove", num_timers, elapsed_ms(start));
+
+    if (removed != num_timers) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Removed %d of %d timers\n", removed, num_timers);
+        ok = SDL_FALSE;
+    }
+    if (SDL_RemoveTimer(ids[0])) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Removing a timer twice succeeded\n");
+        ok = SDL_FALSE;
+    }
+    if (SDL_AtomicGet(&misfired)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d removed timers fired\n", SDL_AtomicGet(&misfired));
+        ok = SDL_FALSE;
+    }
+    return ok;
+}
+
+static SDL_bool
+bench_fire(void)
+{
+    Uint64 start;
+    int i;
+
+    SDL_AtomicSet(&fired, 0);
+
+    /* Spread the deadlines over a few milliseconds */
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_timers; ++i) {
+        ids[i] = SDL_AddTimer(1 + (i % 8), oneshot_callback, NULL);
+    }
+    if (!wait_for_fired(num_timers, 10000)) {
+        return SDL_FALSE;
+    }
+    report("add and fire one-shot", num_timers, elapsed_ms(start));
+    return SDL_TRUE;
+}
+
+static SDL_bool
+bench_repeat(void)
+{
+    const int repeats = 10;
+    const int count = SDL_max(num_timers / repeats, 1);
+    SDL_atomic_t *remaining;
+    Uint64 start;
+    int i;
+
+    remaining = (SDL_atomic_t *)SDL_malloc(count * sizeof(*remaining));
+    if (!remaining) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        return SDL_FALSE;
+    }
+
+    SDL_AtomicSet(&fired, 0);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < count; ++i) {
+        SDL_AtomicSet(&remaining[i], repeats);
+        ids[i] = SDL_AddTimer(1 + (i % 4), repeat_callback, &remaining[i]);
+    }
+    if (!wait_for_fired(count * repeats, 10000)) {
+        SDL_free(remaining);
+        return SDL_FALSE;
+    }
+    report("fire repeating", count * repeats, elapsed_ms(start));
+
+    /* Give a buggy scheduler the chance to fire a finished timer again */
+    SDL_Delay(20);
+    SDL_free(remaining);
+    if (SDL_AtomicGet(&fired) != count * repeats) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Repeating timers fired %d times, expected %d\n", SDL_AtomicGet(&fired), count * repeats);
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static SDL_bool
+bench_churn(void)
+{
+    Uint64 start;
+    int i, expected = 0;
+
+    SDL_AtomicSet(&fired, 0);
+    SDL_AtomicSet(&misfired, 0);
+
+    /* Many timeouts that get canceled before they expire, mixed with a
+       few that do expire */
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_timers; ++i) {
+        if ((i % 10) == 0) {
+            SDL_AddTimer(1, oneshot_callback, NULL);
+            ++expected;
+        } else {
+            SDL_RemoveTimer(SDL_AddTimer(IDLE_INTERVAL, idle_callback, NULL));
+        }
+    }
+    if (!wait_for_fired(expected, 10000)) {
+        return SDL_FALSE;
+    }
+    report("add/cancel churn", num_timers, elapsed_ms(start));
+
+    if (SDL_AtomicGet(&misfired)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d canceled timers fired\n", SDL_AtomicGet(&misfired));
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+int main(int argc, char *argv[])
+{
+    SDL_bool ok = SDL_TRUE;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        num_timers = SDL_max(SDL_atoi(argv[1]), 2);
+    }
+
+    if (SDL_Init(SDL_INIT_TIMER) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    ids = (SDL_TimerID *)SDL_malloc(num_timers * sizeof(*ids));
+    if (!ids) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        SDL_Quit();
+        return 1;
+    }
+
+    ok = bench_add_remove() && ok;
+    ok = bench_fire() && ok;
+    ok = bench_repeat() && ok;
+    ok = bench_churn() && ok;
+
+    SDL_free(ids);
+    SDL_Quit();
+
+    SDL_Log("%s\n", ok ? "All timer checks passed" : "Some timer checks failed");
+    return ok ? 0 : 1;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
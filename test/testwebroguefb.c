@@ -0,0 +1,136 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Exercises the webrogue window framebuffer against the host-side
+   webrogue_gfx stand-in (configure SDL with -DSDL_WEBROGUE_HOST=ON) */
+
+#include "SDL.h"
+#include <webrogue_gfx/webrogue_gfx.h>
+
+#define WINDOW_W 320
+#define WINDOW_H 200
+
+static int failures = 0;
+
+static void
+check(SDL_bool condition, const char *what)
+{
+    if (!condition) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FAILED: %s\n", what);
+        ++failures;
+    } else {
+        SDL_Log("ok: %s\n", what);
+    }
+}
+
+static Uint32
+surface_pixel(SDL_Surface *surface, int x, int y)
+{
+    return *(Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch + x * 4);
+}
+
+static SDL_bool
+screen_matches(SDL_Surface *surface, const SDL_Rect *rect)
+{
+    int x, y;
+
+    for (y = rect->y; y < rect->y + rect->h; ++y) {
+        for (x = rect->x; x < rect->x + rect->w; ++x) {
+            if (webrogue_gfx_host_read_pixel(x, y) != surface_pixel(surface, x, y)) {
+                return SDL_FALSE;
+            }
+        }
+    }
+    return SDL_TRUE;
+}
+
+int main(int argc, char *argv[])
+{
+    SDL_Window *window;
+    SDL_Surface *surface;
+    SDL_Rect full, dirty[2];
+    unsigned long long uploaded;
+    int presents;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    webrogue_gfx_host_set_window_size(WINDOW_W, WINDOW_H);
+
+    if (SDL_VideoInit("webrogue") < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize webrogue video: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    window = SDL_CreateWindow("testwebroguefb", 0, 0, WINDOW_W, WINDOW_H, 0);
+    if (!window) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create window: %s\n", SDL_GetError());
+        SDL_VideoQuit();
+        return 1;
+    }
+
+    surface = SDL_GetWindowSurface(window);
+    if (!surface) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't get window surface: %s\n", SDL_GetError());
+        SDL_VideoQuit();
+        return 1;
+    }
+    check(surface->w == WINDOW_W && surface->h == WINDOW_H, "surface matches the host window size");
+
+    full.x = 0;
+    full.y = 0;
+    full.w = surface->w;
+    full.h = surface->h;
+
+    /* A full update uploads everything */
+    SDL_FillRect(surface, NULL, SDL_MapRGB(surface->format, 0x20, 0x40, 0x60));
+    uploaded = webrogue_gfx_host_uploaded_bytes();
+    presents = webrogue_gfx_host_present_count();
+    SDL_UpdateWindowSurface(window);
+    check(webrogue_gfx_host_uploaded_bytes() - uploaded == (unsigned long long)surface->w * surface->h * 4, "full update uploads the whole surface");
+    check(webrogue_gfx_host_present_count() == presents + 1, "full update presents once");
+    check(screen_matches(surface, &full), "full update reaches the screen");
+
+    /* Partial updates only upload the dirty rectangles */
+    dirty[0].x = 10;
+    dirty[0].y = 5;
+    dirty[0].w = 16;
+    dirty[0].h = 8;
+    dirty[1].x = surface->w - 4; /* partially offscreen, must be clipped */
+    dirty[1].y = surface->h - 4;
+    dirty[1].w = 32;
+    dirty[1].h = 32;
+    SDL_FillRect(surface, &dirty[0], SDL_MapRGB(surface->format, 0xFF, 0x00, 0x00));
+    SDL_FillRect(surface, &dirty[1], SDL_MapRGB(surface->format, 0x00, 0xFF, 0x00));
+    uploaded = webrogue_gfx_host_uploaded_bytes();
+    SDL_UpdateWindowSurfaceRects(window, dirty, SDL_arraysize(dirty));
+    check(webrogue_gfx_host_uploaded_bytes() - uploaded == (16 * 8 + 4 * 4) * 4, "partial update uploads only the dirty area");
+    check(screen_matches(surface, &full), "partial update reaches the screen");
+    check(webrogue_gfx_host_read_pixel(10, 5) == surface_pixel(surface, 10, 5) &&
+          webrogue_gfx_host_read_pixel(0, 0) != surface_pixel(surface, 10, 5), "surface is presented top-down");
+
+    /* Pixels outside the dirty rectangles are not sent */
+    SDL_FillRect(surface, NULL, SDL_MapRGB(surface->format, 0xFF, 0xFF, 0xFF));
+    SDL_UpdateWindowSurfaceRects(window, dirty, 1);
+    check(webrogue_gfx_host_read_pixel(0, 0) != surface_pixel(surface, 0, 0), "clean areas are left alone");
+
+    SDL_DestroyWindow(window);
+    SDL_VideoQuit();
+
+    if (failures) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    SDL_Log("All checks passed\n");
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */